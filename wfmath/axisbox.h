@@ -30,6 +30,7 @@
 #define WFMATH_AXIS_BOX_H
 
 #include <wfmath/intersect_decls.h>
+#include <wfmath/point.h>
 
 #include <iosfwd>
 
@@ -45,13 +46,35 @@ std::ostream& operator<<(std::ostream& os, const AxisBox<dim>& m);
 template<int dim>
 std::istream& operator>>(std::istream& is, AxisBox<dim>& m);
 
+// As for Barycenter(), the containers may have any allocator, the
+// pointer overloads work on arrays and borrowed buffers, and other
+// ranges of points can be passed as a pair of iterators.
+
 /// Get the axis-aligned bounding box for a set of boxes
-template<int dim, template<class, class> class container>
-AxisBox<dim> BoundingBox(const container<AxisBox<dim>, std::allocator<AxisBox<dim> > >& c);
+template<int dim, template<class, class> class container, class A>
+AxisBox<dim> BoundingBox(const container<AxisBox<dim>, A>& c);
 
 /// Get the axis-aligned bounding box for a set of points
-template<int dim, template<class, class> class container>
-AxisBox<dim> BoundingBox(const container<Point<dim>, std::allocator<Point<dim> > >& c);
+template<int dim, template<class, class> class container, class A>
+AxisBox<dim> BoundingBox(const container<Point<dim>, A>& c);
+
+/// Get the axis-aligned bounding box for the n boxes at b
+/**
+ * This and the overload for points below use SSE2 where it's
+ * available, and split sets of more than a few hundred thousand
+ * between threads, as many as the hardware has, unless threads is
+ * nonzero, when it's used instead.
+ **/
+template<int dim>
+AxisBox<dim> BoundingBox(const AxisBox<dim>* b, size_t n, unsigned threads = 0);
+
+/// Get the axis-aligned bounding box for the n points at p
+template<int dim>
+AxisBox<dim> BoundingBox(const Point<dim>* p, size_t n, unsigned threads = 0);
+
+/// Get the axis-aligned bounding box for the points in [begin, end)
+template<class Iter>
+AxisBox<_PointIterator<Iter>::value> BoundingBox(Iter begin, Iter end);
 
 /// A dim dimensional axis-aligned box
 /**
@@ -126,10 +126,10 @@ inline Ball<dim> AxisBox<dim>::boundingSphereSloppy() const
 }
 
 
-template<int dim, template<class, class> class container>
-AxisBox<dim> BoundingBox(const container<AxisBox<dim>, std::allocator<AxisBox<dim> > >& c)
+template<int dim, template<class, class> class container, class A>
+AxisBox<dim> BoundingBox(const container<AxisBox<dim>, A>& c)
 {
-  typename container<AxisBox<dim>, std::allocator<AxisBox<dim> > >::const_iterator i = c.begin(), end = c.end();
+  typename container<AxisBox<dim>, A>::const_iterator i = c.begin(), end = c.end();
 
   if(i == end) {
     return AxisBox<dim>();
@@ -154,11 +154,10 @@ AxisBox<dim> BoundingBox(const container<AxisBox<dim>, std::allocator<AxisBox<di
   return AxisBox<dim>(low, high, true);
 }
 
-template<int dim, template<class, class> class container>
-AxisBox<dim> BoundingBox(const container<Point<dim>, std::allocator<Point<dim> > >& c)
+// The bounding box of the points in [begin, end), for any iterator
+template<int dim, class Iter>
+AxisBox<dim> _BoundingBox(Iter i, Iter end)
 {
-  typename container<Point<dim>, std::allocator<Point<dim> > >::const_iterator i = c.begin(), end = c.end();
-
   if(i == end) {
     return AxisBox<dim>();
   }
@@ -180,6 +179,32 @@ AxisBox<dim> BoundingBox(const container<Point<dim>, std::allocator<Point<dim> >
   return AxisBox<dim>(low, high, true);
 }
 
+template<int dim, class Iter>
+inline AxisBox<dim> _BoundingBox(Iter begin, Iter end, std::true_type)
+{
+  size_t n = end - begin;
+  return BoundingBox(n ? &*begin : (const Point<dim>*) 0, n);
+}
+
+template<int dim, class Iter>
+inline AxisBox<dim> _BoundingBox(Iter begin, Iter end, std::false_type)
+{
+  return _BoundingBox<dim>(begin, end);
+}
+
+template<int dim, template<class, class> class container, class A>
+AxisBox<dim> BoundingBox(const container<Point<dim>, A>& c)
+{
+  return _BoundingBox<dim>(c.begin(), c.end());
+}
+
+template<class Iter>
+AxisBox<_PointIterator<Iter>::value> BoundingBox(Iter begin, Iter end)
+{
+  return _BoundingBox<_PointIterator<Iter>::value>(begin, end,
+                                                   typename _PointIterator<Iter>::contiguous());
+}
+
 // This is here, instead of defined in the class, to
 // avoid include order problems
 
@@ -0,0 +1,36 @@
+// axisbox_tree.cpp (AxisBoxTree<> implementation)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "axisbox_tree_funcs.h"
+
+namespace WFMath {
+
+template class AxisBoxTree<3>;
+template class AxisBoxTree<2>;
+
+}
@@ -0,0 +1,296 @@
+// axisbox_tree.h (A dynamic bounding volume tree of AxisBox<>)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifndef WFMATH_AXISBOX_TREE_H
+#define WFMATH_AXISBOX_TREE_H
+
+#include <wfmath/const.h>
+#include <wfmath/vector.h>
+#include <wfmath/point.h>
+#include <wfmath/axisbox.h>
+
+#include <vector>
+#include <utility>
+
+#include <cstddef>
+
+namespace WFMath {
+
+/// A stack of node indices for tree traversal
+/**
+ * Only trees deeper than the fixed part ever allocate.
+ **/
+class _TreeStack
+{
+ public:
+  _TreeStack() : m_size(0) {}
+
+  bool empty() const {return m_size == 0;}
+
+  void push(size_t i)
+  {
+    if(m_size < fixed_size)
+      m_fixed[m_size] = i;
+    else
+      m_extra.push_back(i);
+    ++m_size;
+  }
+  size_t pop()
+  {
+    --m_size;
+    if(m_size < fixed_size)
+      return m_fixed[m_size];
+    size_t i = m_extra.back();
+    m_extra.pop_back();
+    return i;
+  }
+
+ private:
+  enum {fixed_size = 64};
+
+  size_t m_fixed[fixed_size];
+  std::vector<size_t> m_extra;
+  size_t m_size;
+};
+
+/// A dynamic bounding volume tree of axis-aligned boxes
+/**
+ * This is a broadphase for finding which of many objects may overlap,
+ * without testing every pair. Each object is a leaf of a binary tree,
+ * stored as its bounding box grown by a margin (a "fat" box). Every
+ * inner node holds the union of the boxes below it. The tree is kept
+ * balanced by rotations on insertion and removal.
+ *
+ * An object which moves only needs updating in the tree when it leaves
+ * its fat box, so objects which move a little every tick are cheap.
+ * Queries report every leaf whose fat box overlaps or touches the
+ * query, so some of the results may not overlap the query's tight
+ * box. Use Intersect() on the shapes themselves to check these.
+ *
+ * Each leaf is identified by the handle returned by insert(). Handles
+ * stay the same until the leaf is removed, after which they may be
+ * reused.
+ *
+ * The visitor passed to the query functions is called with the handle
+ * of each leaf found (two handles for queryPairs()). It returns true
+ * to continue the query, or false to stop it.
+ **/
+template<int dim = 3>
+class AxisBoxTree
+{
+ public:
+  /// Construct an empty tree, whose leaves are fattened by margin on every side
+  explicit AxisBoxTree(CoordType margin = 0.1f);
+
+  /// The number of leaves in the tree
+  size_t size() const {return m_count;}
+  /// True if the tree has no leaves
+  bool empty() const {return m_count == 0;}
+  /// Remove all leaves
+  void clear();
+
+  /// The height of the tree, 0 if the root is a leaf, -1 if empty
+  int height() const {return m_root == nullNode ? -1 : m_nodes[m_root].height;}
+  /// The margin the leaves are fattened by
+  CoordType margin() const {return m_margin;}
+
+  /// Add a box to the tree, returning its handle
+  size_t insert(const AxisBox<dim>& box);
+  /// Add a shape to the tree by its bounding box, returning its handle
+  template<class Shape>
+  size_t insert(const Shape& s) {return insert(s.boundingBox());}
+  /// Remove a leaf from the tree
+  void remove(size_t handle);
+
+  /// Update the box of a leaf
+  /**
+   * This only changes the tree if box is no longer inside the fat box
+   * of the leaf, or the fat box has become much larger than box.
+   * Returns true if the tree was changed.
+   **/
+  bool move(size_t handle, const AxisBox<dim>& box);
+  /// Update the box of a leaf which is moving by displacement each tick
+  /**
+   * If the leaf has to be updated, its fat box is also stretched in the
+   * direction of motion, so that it is updated less often.
+   **/
+  bool move(size_t handle, const AxisBox<dim>& box, const Vector<dim>& displacement);
+  /// Update a leaf with the bounding box of a shape
+  template<class Shape>
+  bool move(size_t handle, const Shape& s) {return move(handle, s.boundingBox());}
+
+  /// The fat box stored for a leaf
+  const AxisBox<dim>& fatBox(size_t handle) const {return m_nodes[handle].box;}
+
+  /// Visit every leaf whose fat box overlaps box
+  template<class Visitor>
+  void query(const AxisBox<dim>& box, Visitor visit) const;
+  /// Append every leaf whose fat box overlaps box to out
+  void query(const AxisBox<dim>& box, std::vector<size_t>& out) const;
+
+  /// Visit every pair of leaves whose fat boxes overlap
+  /**
+   * Each pair is visited once, with the smaller handle first.
+   **/
+  template<class Visitor>
+  void queryPairs(Visitor visit) const;
+  /// Append every pair of leaves whose fat boxes overlap to out
+  void queryPairs(std::vector<std::pair<size_t, size_t> >& out) const;
+
+  /// Visit every leaf whose fat box is hit by a ray
+  /**
+   * The ray is the set of points start + t * dir, for 0 <= t <= max_t.
+   **/
+  template<class Visitor>
+  void raycast(const Point<dim>& start, const Vector<dim>& dir,
+               CoordType max_t, Visitor visit) const;
+  /// Append every leaf whose fat box is hit by a ray to out
+  void raycast(const Point<dim>& start, const Vector<dim>& dir,
+               CoordType max_t, std::vector<size_t>& out) const;
+
+ private:
+  static const size_t nullNode = (size_t) -1;
+
+  struct Node
+  {
+    AxisBox<dim> box;
+    // The next free node, for nodes on the free list
+    size_t parent;
+    size_t child1, child2;
+    // 0 for leaves, -1 for free nodes
+    int height;
+
+    bool isLeaf() const {return child1 == nullNode;}
+  };
+
+  size_t allocateNode();
+  void freeNode(size_t i);
+  void insertLeaf(size_t leaf);
+  void removeLeaf(size_t leaf);
+  size_t balance(size_t i);
+  // Recompute the boxes and heights from i to the root, rebalancing on the way
+  void refit(size_t i);
+  AxisBox<dim> fatten(const AxisBox<dim>& box) const;
+
+  static bool overlaps(const AxisBox<dim>& a, const AxisBox<dim>& b)
+  {
+    for(int i = 0; i < dim; ++i)
+      if(a.lowerBound(i) > b.upperBound(i) || b.lowerBound(i) > a.upperBound(i))
+        return false;
+    return true;
+  }
+  static bool rayHits(const AxisBox<dim>& b, const Point<dim>& start,
+                      const Vector<dim>& inv_dir, CoordType max_t);
+
+  std::vector<Node> m_nodes;
+  size_t m_root;
+  size_t m_free;
+  size_t m_count;
+  CoordType m_margin;
+};
+
+template<int dim>
+const size_t AxisBoxTree<dim>::nullNode;
+
+template<int dim>
+template<class Visitor>
+void AxisBoxTree<dim>::query(const AxisBox<dim>& box, Visitor visit) const
+{
+  if(m_root == nullNode)
+    return;
+
+  _TreeStack stack;
+  stack.push(m_root);
+
+  while(!stack.empty()) {
+    const Node& node = m_nodes[stack.pop()];
+
+    if(!overlaps(node.box, box))
+      continue;
+
+    if(node.isLeaf()) {
+      if(!visit((size_t) (&node - &m_nodes[0])))
+        return;
+    }
+    else {
+      stack.push(node.child1);
+      stack.push(node.child2);
+    }
+  }
+}
+
+template<int dim>
+template<class Visitor>
+void AxisBoxTree<dim>::queryPairs(Visitor visit) const
+{
+  bool keep_going = true;
+
+  for(size_t i = 0; i < m_nodes.size() && keep_going; ++i) {
+    if(m_nodes[i].height != 0)
+      continue;
+
+    query(m_nodes[i].box, [&](size_t other) {
+      if(other > i)
+        keep_going = visit(i, other);
+      return keep_going;
+    });
+  }
+}
+
+template<int dim>
+template<class Visitor>
+void AxisBoxTree<dim>::raycast(const Point<dim>& start, const Vector<dim>& dir,
+                               CoordType max_t, Visitor visit) const
+{
+  if(m_root == nullNode)
+    return;
+
+  // Division by zero gives an infinite slab, which rayHits() handles
+  Vector<dim> inv_dir;
+  for(int i = 0; i < dim; ++i)
+    inv_dir[i] = 1 / dir[i];
+
+  _TreeStack stack;
+  stack.push(m_root);
+
+  while(!stack.empty()) {
+    const Node& node = m_nodes[stack.pop()];
+
+    if(!rayHits(node.box, start, inv_dir, max_t))
+      continue;
+
+    if(node.isLeaf()) {
+      if(!visit((size_t) (&node - &m_nodes[0])))
+        return;
+    }
+    else {
+      stack.push(node.child1);
+      stack.push(node.child2);
+    }
+  }
+}
+
+} // namespace WFMath
+
+#endif  // WFMATH_AXISBOX_TREE_H
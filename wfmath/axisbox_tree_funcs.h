@@ -0,0 +1,466 @@
+// axisbox_tree_funcs.h (AxisBoxTree<> implementation)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+// The insertion heuristic and the rotations follow the dynamic tree
+// in Erin Catto's Box2D.
+
+#ifndef WFMATH_AXISBOX_TREE_FUNCS_H
+#define WFMATH_AXISBOX_TREE_FUNCS_H
+
+#include <wfmath/axisbox_tree.h>
+
+#include <algorithm>
+
+#include <cmath>
+
+#include <cassert>
+
+namespace WFMath {
+
+// The cost of a node in the insertion heuristic. This is the surface
+// area of the box for dim >= 3, and its perimeter for dim == 2, up to
+// a constant factor.
+template<int dim>
+CoordType _TreeBoxCost(const AxisBox<dim>& b)
+{
+  CoordType size[dim];
+
+  for(int i = 0; i < dim; ++i)
+    size[i] = b.upperBound(i) - b.lowerBound(i);
+
+  CoordType cost = 0;
+
+  if(dim < 3) {
+    for(int i = 0; i < dim; ++i)
+      cost += size[i];
+  }
+  else {
+    for(int i = 0; i < dim; ++i)
+      for(int j = i + 1; j < dim; ++j)
+        cost += size[i] * size[j];
+  }
+
+  return cost;
+}
+
+template<int dim>
+AxisBoxTree<dim>::AxisBoxTree(CoordType margin)
+  : m_root(nullNode), m_free(nullNode), m_count(0), m_margin(margin)
+{
+  assert(margin >= 0);
+}
+
+template<int dim>
+void AxisBoxTree<dim>::clear()
+{
+  m_nodes.clear();
+  m_root = nullNode;
+  m_free = nullNode;
+  m_count = 0;
+}
+
+template<int dim>
+size_t AxisBoxTree<dim>::allocateNode()
+{
+  size_t i;
+
+  if(m_free != nullNode) {
+    i = m_free;
+    m_free = m_nodes[i].parent;
+  }
+  else {
+    i = m_nodes.size();
+    m_nodes.push_back(Node());
+  }
+
+  Node& node = m_nodes[i];
+  node.parent = nullNode;
+  node.child1 = nullNode;
+  node.child2 = nullNode;
+  node.height = 0;
+
+  return i;
+}
+
+template<int dim>
+void AxisBoxTree<dim>::freeNode(size_t i)
+{
+  m_nodes[i].parent = m_free;
+  m_nodes[i].height = -1;
+  m_free = i;
+}
+
+template<int dim>
+AxisBox<dim> AxisBoxTree<dim>::fatten(const AxisBox<dim>& box) const
+{
+  Point<dim> low = box.lowCorner(), high = box.highCorner();
+
+  for(int i = 0; i < dim; ++i) {
+    low[i] -= m_margin;
+    high[i] += m_margin;
+  }
+
+  return AxisBox<dim>(low, high, true);
+}
+
+template<int dim>
+size_t AxisBoxTree<dim>::insert(const AxisBox<dim>& box)
+{
+  assert(box.isValid());
+
+  size_t leaf = allocateNode();
+  m_nodes[leaf].box = fatten(box);
+  insertLeaf(leaf);
+  ++m_count;
+
+  return leaf;
+}
+
+template<int dim>
+void AxisBoxTree<dim>::remove(size_t handle)
+{
+  assert(handle < m_nodes.size() && m_nodes[handle].height == 0);
+
+  removeLeaf(handle);
+  freeNode(handle);
+  --m_count;
+}
+
+template<int dim>
+bool AxisBoxTree<dim>::move(size_t handle, const AxisBox<dim>& box)
+{
+  Vector<dim> displacement;
+  displacement.zero();
+
+  return move(handle, box, displacement);
+}
+
+template<int dim>
+bool AxisBoxTree<dim>::move(size_t handle, const AxisBox<dim>& box,
+                            const Vector<dim>& displacement)
+{
+  assert(handle < m_nodes.size() && m_nodes[handle].height == 0);
+  assert(box.isValid());
+
+  const AxisBox<dim>& old = m_nodes[handle].box;
+  bool inside = true, too_big = false;
+
+  for(int i = 0; i < dim; ++i) {
+    if(box.lowerBound(i) < old.lowerBound(i) || box.upperBound(i) > old.upperBound(i))
+      inside = false;
+    // Also refit if the fat box is far larger than it needs to be,
+    // for example after a fast moving object stops
+    if(box.lowerBound(i) - old.lowerBound(i) > 4 * m_margin + std::fabs(displacement[i]) * 4
+       || old.upperBound(i) - box.upperBound(i) > 4 * m_margin + std::fabs(displacement[i]) * 4)
+      too_big = true;
+  }
+
+  if(inside && !too_big)
+    return false;
+
+  AxisBox<dim> fat = fatten(box);
+
+  // Stretch the box in the direction of motion, to cover a couple of ticks
+  for(int i = 0; i < dim; ++i) {
+    CoordType d = 2 * displacement[i];
+    if(d < 0)
+      fat.lowCorner()[i] += d;
+    else
+      fat.highCorner()[i] += d;
+  }
+
+  removeLeaf(handle);
+  m_nodes[handle].box = fat;
+  insertLeaf(handle);
+
+  return true;
+}
+
+template<int dim>
+void AxisBoxTree<dim>::insertLeaf(size_t leaf)
+{
+  if(m_root == nullNode) {
+    m_root = leaf;
+    m_nodes[leaf].parent = nullNode;
+    return;
+  }
+
+  // Find the best sibling for the new leaf, by descending into the child
+  // which would grow the least
+
+  const AxisBox<dim> leaf_box = m_nodes[leaf].box;
+  size_t index = m_root;
+
+  while(!m_nodes[index].isLeaf()) {
+    const Node& node = m_nodes[index];
+
+    CoordType area = _TreeBoxCost(node.box);
+    CoordType combined_area = _TreeBoxCost(Union(node.box, leaf_box));
+
+    // The cost of making a new parent for this node and the new leaf
+    CoordType cost = 2 * combined_area;
+    // The minimum cost of pushing the leaf further down the tree
+    CoordType inheritance = 2 * (combined_area - area);
+
+    CoordType cost1 = _TreeBoxCost(Union(m_nodes[node.child1].box, leaf_box)) + inheritance;
+    if(!m_nodes[node.child1].isLeaf())
+      cost1 -= _TreeBoxCost(m_nodes[node.child1].box);
+    CoordType cost2 = _TreeBoxCost(Union(m_nodes[node.child2].box, leaf_box)) + inheritance;
+    if(!m_nodes[node.child2].isLeaf())
+      cost2 -= _TreeBoxCost(m_nodes[node.child2].box);
+
+    if(cost < cost1 && cost < cost2)
+      break;
+
+    index = (cost1 < cost2) ? node.child1 : node.child2;
+  }
+
+  size_t sibling = index;
+
+  // Make a new parent for the leaf and its sibling. This may reallocate
+  // m_nodes, so no references are held across it.
+  size_t old_parent = m_nodes[sibling].parent;
+  size_t new_parent = allocateNode();
+
+  Node& parent = m_nodes[new_parent];
+  parent.parent = old_parent;
+  parent.box = Union(leaf_box, m_nodes[sibling].box);
+  parent.height = m_nodes[sibling].height + 1;
+  parent.child1 = sibling;
+  parent.child2 = leaf;
+
+  if(old_parent != nullNode) {
+    if(m_nodes[old_parent].child1 == sibling)
+      m_nodes[old_parent].child1 = new_parent;
+    else
+      m_nodes[old_parent].child2 = new_parent;
+  }
+  else
+    m_root = new_parent;
+
+  m_nodes[sibling].parent = new_parent;
+  m_nodes[leaf].parent = new_parent;
+
+  refit(m_nodes[leaf].parent);
+}
+
+template<int dim>
+void AxisBoxTree<dim>::removeLeaf(size_t leaf)
+{
+  if(leaf == m_root) {
+    m_root = nullNode;
+    return;
+  }
+
+  size_t parent = m_nodes[leaf].parent;
+  size_t grand_parent = m_nodes[parent].parent;
+  size_t sibling = (m_nodes[parent].child1 == leaf) ? m_nodes[parent].child2
+                                                    : m_nodes[parent].child1;
+
+  // Replace the parent with the sibling
+  if(grand_parent != nullNode) {
+    if(m_nodes[grand_parent].child1 == parent)
+      m_nodes[grand_parent].child1 = sibling;
+    else
+      m_nodes[grand_parent].child2 = sibling;
+    m_nodes[sibling].parent = grand_parent;
+    freeNode(parent);
+    refit(grand_parent);
+  }
+  else {
+    m_root = sibling;
+    m_nodes[sibling].parent = nullNode;
+    freeNode(parent);
+  }
+}
+
+template<int dim>
+void AxisBoxTree<dim>::refit(size_t i)
+{
+  while(i != nullNode) {
+    i = balance(i);
+
+    Node& node = m_nodes[i];
+    const Node& child1 = m_nodes[node.child1];
+    const Node& child2 = m_nodes[node.child2];
+
+    node.height = 1 + std::max(child1.height, child2.height);
+    node.box = Union(child1.box, child2.box);
+
+    i = node.parent;
+  }
+}
+
+// If the subtree at ia is unbalanced, rotate its taller child up to
+// take its place. Returns the index of the new root of the subtree.
+template<int dim>
+size_t AxisBoxTree<dim>::balance(size_t ia)
+{
+  Node& a = m_nodes[ia];
+
+  if(a.isLeaf() || a.height < 2)
+    return ia;
+
+  size_t ib = a.child1, ic = a.child2;
+  Node& b = m_nodes[ib];
+  Node& c = m_nodes[ic];
+
+  int diff = c.height - b.height;
+
+  if(diff > 1) {
+    // Rotate c up
+    size_t i_f = c.child1, i_g = c.child2;
+    Node& f = m_nodes[i_f];
+    Node& g = m_nodes[i_g];
+
+    c.child1 = ia;
+    c.parent = a.parent;
+    a.parent = ic;
+
+    if(c.parent != nullNode) {
+      if(m_nodes[c.parent].child1 == ia)
+        m_nodes[c.parent].child1 = ic;
+      else
+        m_nodes[c.parent].child2 = ic;
+    }
+    else
+      m_root = ic;
+
+    // Keep the taller of c's children with c
+    if(f.height > g.height) {
+      c.child2 = i_f;
+      a.child2 = i_g;
+      g.parent = ia;
+      a.box = Union(b.box, g.box);
+      c.box = Union(a.box, f.box);
+      a.height = 1 + std::max(b.height, g.height);
+      c.height = 1 + std::max(a.height, f.height);
+    }
+    else {
+      c.child2 = i_g;
+      a.child2 = i_f;
+      f.parent = ia;
+      a.box = Union(b.box, f.box);
+      c.box = Union(a.box, g.box);
+      a.height = 1 + std::max(b.height, f.height);
+      c.height = 1 + std::max(a.height, g.height);
+    }
+
+    return ic;
+  }
+
+  if(diff < -1) {
+    // Rotate b up
+    size_t i_d = b.child1, i_e = b.child2;
+    Node& d = m_nodes[i_d];
+    Node& e = m_nodes[i_e];
+
+    b.child1 = ia;
+    b.parent = a.parent;
+    a.parent = ib;
+
+    if(b.parent != nullNode) {
+      if(m_nodes[b.parent].child1 == ia)
+        m_nodes[b.parent].child1 = ib;
+      else
+        m_nodes[b.parent].child2 = ib;
+    }
+    else
+      m_root = ib;
+
+    // Keep the taller of b's children with b
+    if(d.height > e.height) {
+      b.child2 = i_d;
+      a.child1 = i_e;
+      e.parent = ia;
+      a.box = Union(c.box, e.box);
+      b.box = Union(a.box, d.box);
+      a.height = 1 + std::max(c.height, e.height);
+      b.height = 1 + std::max(a.height, d.height);
+    }
+    else {
+      b.child2 = i_e;
+      a.child1 = i_d;
+      d.parent = ia;
+      a.box = Union(c.box, d.box);
+      b.box = Union(a.box, e.box);
+      a.height = 1 + std::max(c.height, d.height);
+      b.height = 1 + std::max(a.height, e.height);
+    }
+
+    return ib;
+  }
+
+  return ia;
+}
+
+template<int dim>
+bool AxisBoxTree<dim>::rayHits(const AxisBox<dim>& b, const Point<dim>& start,
+                               const Vector<dim>& inv_dir, CoordType max_t)
+{
+  CoordType t_min = 0, t_max = max_t;
+
+  for(int i = 0; i < dim; ++i) {
+    CoordType t1 = (b.lowerBound(i) - start[i]) * inv_dir[i];
+    CoordType t2 = (b.upperBound(i) - start[i]) * inv_dir[i];
+
+    if(t1 > t2)
+      std::swap(t1, t2);
+
+    // A NaN here means the ray runs along a face of the box, which
+    // counts as a hit, and the comparisons below ignore it
+    if(t1 > t_min)
+      t_min = t1;
+    if(t2 < t_max)
+      t_max = t2;
+
+    if(t_min > t_max)
+      return false;
+  }
+
+  return true;
+}
+
+template<int dim>
+void AxisBoxTree<dim>::query(const AxisBox<dim>& box, std::vector<size_t>& out) const
+{
+  query(box, [&out](size_t handle) {out.push_back(handle); return true;});
+}
+
+template<int dim>
+void AxisBoxTree<dim>::queryPairs(std::vector<std::pair<size_t, size_t> >& out) const
+{
+  queryPairs([&out](size_t a, size_t b) {out.push_back(std::make_pair(a, b)); return true;});
+}
+
+template<int dim>
+void AxisBoxTree<dim>::raycast(const Point<dim>& start, const Vector<dim>& dir,
+                               CoordType max_t, std::vector<size_t>& out) const
+{
+  raycast(start, dir, max_t, [&out](size_t handle) {out.push_back(handle); return true;});
+}
+
+} // namespace WFMath
+
+#endif  // WFMATH_AXISBOX_TREE_FUNCS_H
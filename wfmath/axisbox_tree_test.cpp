@@ -0,0 +1,243 @@
+// axisbox_tree_test.cpp (AxisBoxTree<> test functions)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#ifndef DEBUG
+#define DEBUG
+#endif
+
+#include "const.h"
+#include "vector.h"
+#include "point.h"
+#include "axisbox.h"
+#include "ball.h"
+#include "axisbox_tree.h"
+#include "randgen.h"
+
+#include <vector>
+#include <algorithm>
+#include <iostream>
+
+#include <cmath>
+#include <cassert>
+
+using namespace WFMath;
+
+template<int dim>
+static AxisBox<dim> random_box(MTRand& rand, CoordType world, CoordType size)
+{
+  Point<dim> low, high;
+
+  for(int i = 0; i < dim; ++i) {
+    low[i] = (CoordType) (rand.rand() * world);
+    high[i] = low[i] + (CoordType) (rand.rand() * size);
+  }
+  low.setValid();
+  high.setValid();
+
+  return AxisBox<dim>(low, high, true);
+}
+
+template<int dim>
+static bool overlap(const AxisBox<dim>& a, const AxisBox<dim>& b)
+{
+  for(int i = 0; i < dim; ++i)
+    if(a.upperBound(i) < b.lowerBound(i) || b.upperBound(i) < a.lowerBound(i))
+      return false;
+  return true;
+}
+
+// Brute force ray test, by clipping the segment to each slab in turn
+template<int dim>
+static bool ray_hits(const AxisBox<dim>& b, const Point<dim>& start,
+                     const Vector<dim>& dir, CoordType max_t)
+{
+  CoordType t0 = 0, t1 = max_t;
+
+  for(int i = 0; i < dim; ++i) {
+    if(dir[i] == 0) {
+      if(start[i] < b.lowerBound(i) || start[i] > b.upperBound(i))
+        return false;
+      continue;
+    }
+    CoordType ta = (b.lowerBound(i) - start[i]) / dir[i];
+    CoordType tb = (b.upperBound(i) - start[i]) / dir[i];
+    t0 = std::max(t0, std::min(ta, tb));
+    t1 = std::min(t1, std::max(ta, tb));
+  }
+
+  return t0 <= t1;
+}
+
+// Check the tree against brute force over all the live leaves
+template<int dim>
+static void check_tree(const AxisBoxTree<dim>& tree, const std::vector<size_t>& handles,
+                       MTRand& rand)
+{
+  std::vector<size_t> found, expected;
+
+  for(int n = 0; n < 20; ++n) {
+    AxisBox<dim> box = random_box<dim>(rand, 100, 30);
+
+    found.clear();
+    expected.clear();
+    tree.query(box, found);
+    for(size_t i = 0; i < handles.size(); ++i)
+      if(overlap(tree.fatBox(handles[i]), box))
+        expected.push_back(handles[i]);
+
+    std::sort(found.begin(), found.end());
+    std::sort(expected.begin(), expected.end());
+    assert(found == expected);
+
+    Point<dim> start = box.lowCorner();
+    Vector<dim> dir;
+    for(int i = 0; i < dim; ++i)
+      dir[i] = (n % 4 == 0 && i == 0) ? 0 : (CoordType) (rand.rand() * 2 - 1);
+    dir.setValid();
+
+    found.clear();
+    expected.clear();
+    tree.raycast(start, dir, 60, found);
+    for(size_t i = 0; i < handles.size(); ++i)
+      if(ray_hits(tree.fatBox(handles[i]), start, dir, 60))
+        expected.push_back(handles[i]);
+
+    std::sort(found.begin(), found.end());
+    std::sort(expected.begin(), expected.end());
+    assert(found == expected);
+  }
+
+  std::vector<std::pair<size_t, size_t> > pairs, expected_pairs;
+  tree.queryPairs(pairs);
+  for(size_t i = 0; i < handles.size(); ++i)
+    for(size_t j = 0; j < handles.size(); ++j)
+      if(handles[i] < handles[j] && overlap(tree.fatBox(handles[i]), tree.fatBox(handles[j])))
+        expected_pairs.push_back(std::make_pair(handles[i], handles[j]));
+
+  std::sort(pairs.begin(), pairs.end());
+  std::sort(expected_pairs.begin(), expected_pairs.end());
+  assert(pairs == expected_pairs);
+
+  // The rotations keep the tree close to balanced
+  assert(tree.size() == handles.size());
+  assert(tree.height() <= 2 * std::log2((double) handles.size() + 1) + 2);
+}
+
+template<int dim>
+void test_axisbox_tree(MTRand& rand)
+{
+  std::cout << "Testing AxisBoxTree<" << dim << ">" << std::endl;
+
+  const size_t num = 300;
+
+  AxisBoxTree<dim> tree(0.5f);
+  std::vector<AxisBox<dim> > boxes;
+  std::vector<size_t> handles;
+
+  assert(tree.empty() && tree.height() == -1);
+
+  for(size_t i = 0; i < num; ++i) {
+    boxes.push_back(random_box<dim>(rand, 100, 5));
+    handles.push_back(tree.insert(boxes.back()));
+  }
+
+  for(size_t i = 0; i < num; ++i) {
+    for(int j = 0; j < dim; ++j) {
+      assert(tree.fatBox(handles[i]).lowerBound(j) == boxes[i].lowerBound(j) - 0.5f);
+      assert(tree.fatBox(handles[i]).upperBound(j) == boxes[i].upperBound(j) + 0.5f);
+    }
+  }
+
+  check_tree(tree, handles, rand);
+
+  // Small moves stay inside the fat boxes, large ones don't
+
+  Vector<dim> nudge, jump;
+  for(int j = 0; j < dim; ++j) {
+    nudge[j] = 0.25f;
+    jump[j] = 20;
+  }
+  nudge.setValid();
+  jump.setValid();
+
+  for(size_t i = 0; i < num; ++i) {
+    AxisBox<dim> moved = boxes[i];
+    assert(!tree.move(handles[i], moved.shift(nudge)));
+  }
+
+  for(size_t i = 0; i < num; i += 2) {
+    boxes[i].shift(jump);
+    assert(tree.move(handles[i], boxes[i], jump));
+    // The fat box is stretched along the motion
+    assert(tree.fatBox(handles[i]).upperBound(0) > boxes[i].upperBound(0) + 0.5f);
+    assert(tree.fatBox(handles[i]).lowerBound(0) == boxes[i].lowerBound(0) - 0.5f);
+  }
+
+  check_tree(tree, handles, rand);
+
+  // Remove a third of the leaves, then add shapes
+
+  std::vector<size_t> kept;
+  for(size_t i = 0; i < num; ++i) {
+    if(i % 3 == 0)
+      tree.remove(handles[i]);
+    else
+      kept.push_back(handles[i]);
+  }
+
+  check_tree(tree, kept, rand);
+
+  for(size_t i = 0; i < 50; ++i) {
+    Ball<dim> ball(random_box<dim>(rand, 100, 1).lowCorner(), 2);
+    kept.push_back(tree.insert(ball));
+    AxisBox<dim> bbox = ball.boundingBox();
+    assert(tree.fatBox(kept.back()).lowerBound(0) == bbox.lowerBound(0) - 0.5f);
+  }
+
+  check_tree(tree, kept, rand);
+
+  // Stopping early
+  size_t visits = 0;
+  tree.query(random_box<dim>(rand, 0, 200), [&visits](size_t) {return ++visits < 3;});
+  assert(visits == 3);
+
+  tree.clear();
+  assert(tree.empty() && tree.height() == -1);
+  std::vector<size_t> none;
+  tree.query(random_box<dim>(rand, 100, 100), none);
+  assert(none.empty());
+}
+
+int main()
+{
+  MTRand rand(29);
+
+  test_axisbox_tree<2>(rand);
+  test_axisbox_tree<3>(rand);
+
+  return 0;
+}
@@ -66,15 +66,23 @@ template<> Ball<3> Ball<3>::toLocalCoords(const Point<3>& origin,
 template Ball<2> BoundingSphere<2, std::vector>(std::vector<Point<2>,
                                                 std::allocator<Point<2> > > const&);
 
+template Ball<2> BoundingSphere<2>(const Point<2>*, size_t);
+
 template Ball<2> BoundingSphereSloppy<2, std::vector>(std::vector<Point<2>,
                                                       std::allocator<Point<2> > > const&);
 
+template Ball<2> BoundingSphereSloppy<2>(const Point<2>*, size_t);
+
 template Ball<3> BoundingSphere<3, std::vector>(std::vector<Point<3>,
                                                 std::allocator<Point<3> > > const&);
 
+template Ball<3> BoundingSphere<3>(const Point<3>*, size_t);
+
 template Ball<3> BoundingSphereSloppy<3, std::vector>(std::vector<Point<3>,
                                                       std::allocator<Point<3> > > const&);
 
+template Ball<3> BoundingSphereSloppy<3>(const Point<3>*, size_t);
+
 template Ball<2> Point<2>::boundingSphere() const;
 template Ball<2> Point<2>::boundingSphereSloppy() const;
 
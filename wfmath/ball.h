@@ -33,12 +33,65 @@ namespace WFMath {
 
 template<int dim> class Ball;
 
+// The container overloads take any container of Points with any
+// allocator. Points which are somewhere else, in an array or in a
+// buffer shared with other code, can be passed to the overloads taking
+// a pointer and a count instead, which don't copy them, and any other
+// range of points to the ones taking a pair of iterators.
+
 /// get the minimal bounding sphere for a set of points
-template<int dim, template<class, class> class container>
-Ball<dim> BoundingSphere(const container<Point<dim>, std::allocator<Point<dim> > >& c);
+template<int dim, template<class, class> class container, class A>
+Ball<dim> BoundingSphere(const container<Point<dim>, A>& c);
+/// get the minimal bounding sphere for the n points at p, without copying them
+template<int dim>
+Ball<dim> BoundingSphere(const Point<dim>* p, size_t n);
 /// get a bounding sphere for a set of points
-template<int dim, template<class, class> class container>
-Ball<dim> BoundingSphereSloppy(const container<Point<dim>, std::allocator<Point<dim> > >& c);
+template<int dim, template<class, class> class container, class A>
+Ball<dim> BoundingSphereSloppy(const container<Point<dim>, A>& c);
+/// get a bounding sphere for the n points at p, without copying them
+template<int dim>
+Ball<dim> BoundingSphereSloppy(const Point<dim>* p, size_t n);
+/// get the minimal bounding sphere for the points in [begin, end)
+template<class Iter>
+Ball<_PointIterator<Iter>::value> BoundingSphere(Iter begin, Iter end);
+/// get a bounding sphere for the points in [begin, end)
+template<class Iter>
+Ball<_PointIterator<Iter>::value> BoundingSphereSloppy(Iter begin, Iter end);
+
+// Bounding spheres between BoundingSphereSloppy() and BoundingSphere()
+// in both time and tightness. Each holds every one of the n points at
+// p, exactly, not just to within epsilon. Large sets of points are
+// split between threads, as many as the hardware has, unless threads
+// is nonzero, when it's used instead. They give an invalid Ball if n
+// is zero.
+
+/// get a bounding sphere for the n points at p by Ritter's algorithm
+/**
+ * The ball starts on the widest apart of the pairs of points which are
+ * extreme along an axis, and grows just enough to take in each point
+ * outside it in turn. It's usually a few percent bigger than minimal.
+ **/
+template<int dim>
+Ball<dim> BoundingSphereRitter(const Point<dim>* p, size_t n, unsigned threads = 0);
+/// get a bounding sphere for the n points at p by the EPOS algorithm
+/**
+ * This is Larsson's extremal points optimal sphere. The starting ball
+ * is the minimal one for the points which are extreme along (3^dim - 1)
+ * / 2 fixed directions, 13 in 3D, and then grows as in Ritter's
+ * algorithm. It's usually well within a percent of the minimal radius.
+ **/
+template<int dim>
+Ball<dim> BoundingSphereEPOS(const Point<dim>* p, size_t n, unsigned threads = 0);
+/// get a bounding sphere at most 1 + epsilon times the minimal radius
+/**
+ * This is a core set approximation: the minimal ball of a growing
+ * subset of the points, which only needs about 1 / epsilon of them,
+ * widened to reach the farthest point. Each round is one pass over the
+ * points, so a smaller epsilon takes longer.
+ **/
+template<int dim>
+Ball<dim> BoundingSphereCoreSet(const Point<dim>* p, size_t n, CoordType epsilon,
+                                unsigned threads = 0);
 
 template<int dim>
 std::ostream& operator<<(std::ostream& os, const Ball<dim>& m);
@@ -29,7 +29,13 @@
 #include <wfmath/ball.h>
 
 #include <wfmath/axisbox.h>
+#include <wfmath/vector.h>
 #include <wfmath/miniball.h>
+// The bounding sphere templates below use all of Miniball, so code
+// which instantiates them for itself needs its definitions too
+#include <wfmath/miniball_funcs.h>
+
+#include <iterator>
 
 #include <cassert>
 
@@ -53,56 +59,89 @@ AxisBox<dim> Ball<dim>::boundingBox() const
   return AxisBox<dim>(p_low, p_high, true);
 }
 
-template<int dim, template<class, class> class container>
-Ball<dim> BoundingSphere(const container<Point<dim>, std::allocator<Point<dim> > >& c)
+// Build the ball for the points in m, and convert it
+template<int dim, class P>
+Ball<dim> _BoundingSphere(_miniball::Miniball<dim, P>& m, bool valid)
+{
+  m.build();
+
+#ifndef NDEBUG
+  double dummy;
+#endif
+  // accuracy() is relative to the squared radius, which is zero if
+  // all the points are the same
+  assert("Check that bounding sphere is good to library accuracy" &&
+         (m.squared_radius() <= 0 || m.accuracy(dummy) < numeric_constants<CoordType>::epsilon()));
+
+  const double* w = m.center();
+  Point<dim> center;
+
+  for(int j = 0; j < dim; ++j)
+    center[j] = w[j];
+
+  center.setValid(valid);
+
+  return Ball<dim>(center, std::sqrt(m.squared_radius()));
+}
+
+// The minimal bounding sphere of the points in [begin, end), for any
+// iterator which can be passed over twice
+template<int dim, class Iter>
+Ball<dim> _BoundingSphere(Iter begin, Iter end)
 {
   _miniball::Miniball<dim> m;
   _miniball::Wrapped_array<dim> w;
 
-  typename container<Point<dim>, std::allocator<Point<dim> > >::const_iterator i, end = c.end();
   bool valid = true;
 
-  for(i = c.begin(); i != end; ++i) {
+  m.reserve((int) std::distance(begin, end));
+
+  for(Iter i = begin; i != end; ++i) {
     valid = valid && i->isValid();
     for(int j = 0; j < dim; ++j)
       w[j] = (*i)[j];
     m.check_in(w);
   }
 
-  m.build();
+  return _BoundingSphere(m, valid);
+}
 
-#ifndef NDEBUG
-  double dummy;
-#endif
-  assert("Check that bounding sphere is good to library accuracy" &&
-         m.accuracy(dummy) < numeric_constants<CoordType>::epsilon());
+template<int dim, template<class, class> class container, class A>
+Ball<dim> BoundingSphere(const container<Point<dim>, A>& c)
+{
+  return _BoundingSphere<dim>(c.begin(), c.end());
+}
 
-  w = m.center();
-  Point<dim> center;
+template<int dim>
+Ball<dim> BoundingSphere(const Point<dim>* p, size_t n)
+{
+  _miniball::Miniball<dim, Point<dim> > m;
+  bool valid = true;
 
-  for(int j = 0; j < dim; ++j)
-    center[j] = w[j];
+  for(size_t i = 0; i < n; ++i)
+    valid = valid && p[i].isValid();
 
-  center.setValid(valid);
+  m.use_points(p, n);
 
-  return Ball<dim>(center, std::sqrt(m.squared_radius()));
+  return _BoundingSphere(m, valid);
 }
 
-template<int dim, template<class, class> class container>
-Ball<dim> BoundingSphereSloppy(const container<Point<dim>, std::allocator<Point<dim> > >& c)
+// The sloppy bounding sphere of the points in [begin, end), for
+// any iterator which can be compared and passed over twice
+template<int dim, class Iter>
+Ball<dim> _BoundingSphereSloppy(Iter begin, Iter end)
 {
   // This is based on the algorithm given by Jack Ritter
   // in Volume 2, Number 4 of Ray Tracing News
   // <http://www.acm.org/tog/resources/RTNews/html/rtnews7b.html>
 
-  typename container<Point<dim>, std::allocator<Point<dim> > >::const_iterator i = c.begin(),
-						end = c.end();
+  Iter i = begin;
   if (i == end) {
     return Ball<dim>();
   }
 
   CoordType min[dim], max[dim];
-  typename container<Point<dim>, std::allocator<Point<dim> > >::const_iterator min_p[dim], max_p[dim];
+  Iter min_p[dim], max_p[dim];
   bool valid = i->isValid();
 
   for(int j = 0; j < dim; ++j) {
@@ -140,7 +179,7 @@ Ball<dim> BoundingSphereSloppy(const container<Point<dim>, std::allocator<Point<
   Point<dim> center = Midpoint(*(min_p[direction]), *(max_p[direction]));
   CoordType dist = SloppyDistance(*(min_p[direction]), center);
 
-  for(i = c.begin(); i != end; ++i) {
+  for(i = begin; i != end; ++i) {
     if(i == min_p[direction] || i == max_p[direction])
       continue; // We already have these
 
@@ -162,6 +201,46 @@ Ball<dim> BoundingSphereSloppy(const container<Point<dim>, std::allocator<Point<
   return Ball<dim>(center, dist);
 }
 
+template<int dim, template<class, class> class container, class A>
+Ball<dim> BoundingSphereSloppy(const container<Point<dim>, A>& c)
+{
+  return _BoundingSphereSloppy<dim>(c.begin(), c.end());
+}
+
+template<int dim>
+Ball<dim> BoundingSphereSloppy(const Point<dim>* p, size_t n)
+{
+  return _BoundingSphereSloppy<dim>(p, p + n);
+}
+
+template<int dim, class Iter>
+inline Ball<dim> _BoundingSphere(Iter begin, Iter end, std::true_type)
+{
+  size_t n = end - begin;
+  return BoundingSphere(n ? &*begin : (const Point<dim>*) 0, n);
+}
+
+template<int dim, class Iter>
+inline Ball<dim> _BoundingSphere(Iter begin, Iter end, std::false_type)
+{
+  return _BoundingSphere<dim>(begin, end);
+}
+
+template<class Iter>
+Ball<_PointIterator<Iter>::value> BoundingSphere(Iter begin, Iter end)
+{
+  return _BoundingSphere<_PointIterator<Iter>::value>(begin, end,
+                                                      typename _PointIterator<Iter>::contiguous());
+}
+
+// The sloppy sphere reads the points in place already, so there's
+// nothing to gain from the pointer overload
+template<class Iter>
+Ball<_PointIterator<Iter>::value> BoundingSphereSloppy(Iter begin, Iter end)
+{
+  return _BoundingSphereSloppy<_PointIterator<Iter>::value>(begin, end);
+}
+
 // These two are here, instead of defined in the class, to
 // avoid include order problems
 
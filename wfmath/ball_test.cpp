@@ -30,12 +30,315 @@
 #define DEBUG
 #endif
 
+#include "vector.h"
+#include "point.h"
 #include "ball.h"
+#include "randgen.h"
+
+// For the container functions on a vector with its own allocator,
+// which the library doesn't instantiate
+#include "point_funcs.h"
+#include "axisbox_funcs.h"
+#include "ball_funcs.h"
+
+#include <iostream>
+#include <vector>
+#include <list>
+#include <deque>
+#include <cmath>
 
 #include <cassert>
 
 using namespace WFMath;
 
+template<int dim>
+static void check_bounds(const Ball<dim>& b, const std::vector<Point<dim> >& points)
+{
+  CoordType tolerance = b.radius() * 1e-5f + 1e-6f;
+
+  for(size_t i = 0; i < points.size(); ++i)
+    assert(Distance(b.center(), points[i]) <= b.radius() + tolerance);
+}
+
+// The smallest circle through two or three of the points which holds
+// all of them
+static CoordType brute_force_radius(const std::vector<Point<2> >& points)
+{
+  CoordType best = -1;
+  size_t n = points.size();
+
+  for(size_t i = 0; i < n; ++i) {
+    for(size_t j = i; j < n; ++j) {
+      for(size_t k = j; k < n; ++k) {
+        Point<2> center;
+        if(k == j) {
+          center = Midpoint(points[i], points[j]);
+        }
+        else {
+          // The circumcenter
+          double ax = points[i][0], ay = points[i][1], bx = points[j][0], by = points[j][1],
+                 cx = points[k][0], cy = points[k][1];
+          double d = 2 * (ax * (by - cy) + bx * (cy - ay) + cx * (ay - by));
+          if(std::fabs(d) < 1e-9)
+            continue;
+          double a2 = ax * ax + ay * ay, b2 = bx * bx + by * by, c2 = cx * cx + cy * cy;
+          center = Point<2>((CoordType) ((a2 * (by - cy) + b2 * (cy - ay) + c2 * (ay - by)) / d),
+                            (CoordType) ((a2 * (cx - bx) + b2 * (ax - cx) + c2 * (bx - ax)) / d));
+        }
+        CoordType r = 0;
+        for(size_t m = 0; m < n; ++m)
+          r = std::max(r, Distance(center, points[m]));
+        if(best < 0 || r < best)
+          best = r;
+      }
+    }
+  }
+
+  return best;
+}
+
+template<int dim>
+static Point<dim> random_point(MTRand& rand)
+{
+  Point<dim> p;
+  for(int i = 0; i < dim; ++i)
+    p[i] = (CoordType) (rand.rand() * 20 - 10);
+  p.setValid();
+  return p;
+}
+
+// One of five kinds of point set, some of them hard for one builder
+// or another
+template<int dim>
+static std::vector<Point<dim> > make_points(MTRand& rand, size_t n, int kind)
+{
+  std::vector<Point<dim> > points;
+  for(size_t i = 0; i < n; ++i) {
+    switch(kind) {
+      case 0:
+        points.push_back(random_point<dim>(rand));
+        break;
+      case 1:
+        // Repeats
+        points.push_back(i % 3 == 0 || points.empty() ? random_point<dim>(rand)
+                                                      : points[i / 2]);
+        break;
+      case 2: {
+        // All on one sphere
+        Vector<dim> v = random_point<dim>(rand) - Point<dim>().setToOrigin();
+        if(v.sqrMag() < 0.01f)
+          v[0] = 1;
+        points.push_back(Point<dim>().setToOrigin() + v * (5 / v.mag()));
+        break;
+      }
+      case 3:
+        // On a line
+        points.push_back(Point<dim>().setToOrigin());
+        points.back()[0] = (CoordType) (rand.rand() * 20 - 10);
+        break;
+      default:
+        // Sorted along x, the worst order for move-to-front
+        points.push_back(random_point<dim>(rand));
+        points.back()[0] = (CoordType) i;
+        break;
+    }
+  }
+  return points;
+}
+
+// Stands in for an arena: a different allocator type, which counts
+// what's still allocated
+static long arena_bytes = 0;
+
+template<class T>
+struct ArenaAllocator
+{
+  typedef T value_type;
+
+  ArenaAllocator() {}
+  template<class U>
+  ArenaAllocator(const ArenaAllocator<U>&) {}
+
+  T* allocate(size_t n)
+  {
+    arena_bytes += (long) (n * sizeof(T));
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T* p, size_t n)
+  {
+    arena_bytes -= (long) (n * sizeof(T));
+    std::allocator<T>().deallocate(p, n);
+  }
+};
+
+template<class T, class U>
+bool operator==(const ArenaAllocator<T>&, const ArenaAllocator<U>&) {return true;}
+template<class T, class U>
+bool operator!=(const ArenaAllocator<T>&, const ArenaAllocator<U>&) {return false;}
+
+// The container functions take any allocator, and the pointer ones
+// give the same answers as the container ones
+template<int dim>
+static void test_inputs(MTRand& rand)
+{
+  std::cout << "Testing " << dim << "D container, array and iterator inputs" << std::endl;
+
+  const size_t sizes[] = {1, 2, 7, 100, 3000};
+
+  for(size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+    std::vector<Point<dim> > points = make_points<dim>(rand, sizes[s], (int) s);
+    size_t n = points.size();
+
+    {
+      std::vector<Point<dim>, ArenaAllocator<Point<dim> > > arena(points.begin(), points.end());
+      std::vector<CoordType, ArenaAllocator<CoordType> > weights(n, 2);
+      std::vector<AxisBox<dim>, ArenaAllocator<AxisBox<dim> > > boxes;
+      for(size_t i = 0; i < n; ++i)
+        boxes.push_back(points[i].boundingBox());
+      assert(arena_bytes > 0);
+
+      assert(BoundingSphere(arena) == BoundingSphere(points));
+      assert(BoundingSphereSloppy(arena) == BoundingSphereSloppy(points));
+      assert(BoundingBox(arena) == BoundingBox(points));
+      assert(BoundingBox(boxes) == BoundingBox(points));
+      assert(Barycenter(arena) == Barycenter(points));
+      assert(Barycenter(arena, weights) == Barycenter(points));
+    }
+    assert(arena_bytes == 0);
+
+    // A bare array, such as a span of a buffer owned by someone else
+    const Point<dim>* p = &points[0];
+    assert(BoundingSphere(p, n) == BoundingSphere(points));
+    Ball<dim> sloppy = BoundingSphereSloppy(p, n);
+    assert(sloppy == BoundingSphereSloppy(points) && sloppy.isValid());
+    check_bounds(sloppy, points);
+    assert(BoundingBox(p, n) == BoundingBox(points));
+
+    // Other containers still work
+    std::list<Point<dim> > point_list(points.begin(), points.end());
+    assert(BoundingSphereSloppy(point_list) == sloppy);
+
+    // And so do ranges of them
+    std::deque<Point<dim> > point_deque(points.begin(), points.end());
+    assert(BoundingSphere(point_list.begin(), point_list.end()) == BoundingSphere(points));
+    assert(BoundingSphere(point_deque.begin(), point_deque.end()) == BoundingSphere(points));
+    assert(BoundingSphere(points.begin(), points.end()) == BoundingSphere(p, n));
+    assert(BoundingSphere(p, p + n) == BoundingSphere(p, n));
+    assert(BoundingSphereSloppy(point_list.begin(), point_list.end()) == sloppy);
+    assert(BoundingSphereSloppy(point_deque.cbegin(), point_deque.cend()) == sloppy);
+    assert(BoundingBox(point_list.begin(), point_list.end()) == BoundingBox(points));
+    assert(BoundingBox(point_deque.begin(), point_deque.end()) == BoundingBox(points));
+    assert(BoundingBox(points.cbegin(), points.cend()) == BoundingBox(p, n));
+    assert(Barycenter(point_list.begin(), point_list.end()) == Barycenter(points));
+    assert(Barycenter(point_deque.begin(), point_deque.end()) == Barycenter(points));
+    assert(Barycenter(points.begin(), points.end()) == Barycenter(p, n));
+  }
+
+  assert(!BoundingSphereSloppy((const Point<dim>*) 0, 0).isValid());
+
+  std::list<Point<dim> > none;
+  std::vector<Point<dim> > empty;
+  assert(!BoundingSphereSloppy(none.begin(), none.end()).isValid());
+  assert(!Barycenter(none.begin(), none.end()).isValid());
+  assert(!Barycenter(empty.begin(), empty.end()).isValid());
+}
+
+template<int dim>
+static void test_bounding_sphere(MTRand& rand)
+{
+  std::cout << "Testing " << dim << "D bounding spheres" << std::endl;
+
+  const size_t sizes[] = {1, 2, 3, 5, 10, 100, 1000, 5000};
+
+  for(size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+    for(int k = 0; k < 5; ++k) {
+      std::vector<Point<dim> > points = make_points<dim>(rand, sizes[s], k);
+
+      Ball<dim> b = BoundingSphere(points);
+      Ball<dim> span = BoundingSphere(&points[0], points.size());
+      assert(b == span && b.isValid());
+      check_bounds(b, points);
+    }
+  }
+}
+
+// Every point must be inside, with no tolerance
+template<int dim>
+static void check_contains(const Ball<dim>& b, const std::vector<Point<dim> >& points)
+{
+  double r2 = (double) b.radius() * b.radius();
+
+  for(size_t i = 0; i < points.size(); ++i) {
+    double d2 = 0;
+    for(int j = 0; j < dim; ++j)
+      d2 += ((double) points[i][j] - b.center()[j]) * ((double) points[i][j] - b.center()[j]);
+    assert(d2 <= r2);
+  }
+}
+
+template<int dim>
+static void test_approximate(MTRand& rand)
+{
+  std::cout << "Testing " << dim << "D approximate bounding spheres" << std::endl;
+
+  // The largest is big enough to be split between threads by default
+  const size_t sizes[] = {1, 2, 3, 10, 1000, 100000};
+  const CoordType epsilons[] = {0.1f, 0.01f, 0};
+
+  assert(!BoundingSphereRitter<dim>(0, 0).isValid());
+  assert(!BoundingSphereEPOS<dim>(0, 0).isValid());
+  assert(!BoundingSphereCoreSet<dim>(0, 0, 0.1f).isValid());
+
+  for(size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+    for(int k = 0; k < 5; ++k) {
+      std::vector<Point<dim> > points = make_points<dim>(rand, sizes[s], k);
+      const Point<dim>* p = &points[0];
+      size_t n = points.size();
+      CoordType exact = BoundingSphere(p, n).radius(),
+                tolerance = exact * 1e-5f + 1e-6f;
+
+      // One slice, the default, and more slices than there are points
+      // in the small sets
+      for(unsigned threads = 1; threads <= 5; threads += 2) {
+        unsigned t = (threads == 3) ? 0 : threads;
+
+        Ball<dim> b = BoundingSphereRitter(p, n, t);
+        assert(b.isValid());
+        check_contains(b, points);
+        assert(b.radius() >= exact - tolerance && b.radius() <= 2 * exact + tolerance);
+
+        b = BoundingSphereEPOS(p, n, t);
+        assert(b.isValid());
+        check_contains(b, points);
+        assert(b.radius() >= exact - tolerance && b.radius() <= 2 * exact + tolerance);
+
+        for(size_t e = 0; e < sizeof(epsilons) / sizeof(epsilons[0]); ++e) {
+          b = BoundingSphereCoreSet(p, n, epsilons[e], t);
+          assert(b.isValid());
+          check_contains(b, points);
+          assert(b.radius() >= exact - tolerance);
+          assert(b.radius() <= (1 + epsilons[e]) * exact + tolerance);
+        }
+      }
+    }
+  }
+}
+
+static void test_minimal(MTRand& rand)
+{
+  std::cout << "Testing bounding spheres are minimal" << std::endl;
+
+  for(int k = 0; k < 200; ++k) {
+    std::vector<Point<2> > points;
+    for(int i = 0, n = 1 + rand.randInt(7); i < n; ++i)
+      points.push_back(random_point<2>(rand));
+
+    Ball<2> b = BoundingSphere(&points[0], points.size());
+    check_bounds(b, points);
+    assert(std::fabs(b.radius() - brute_force_radius(points)) < 1e-4f);
+  }
+}
+
 int main()
 {
   Ball<2> b1(Point<2>(0,0), 1);
@@ -46,5 +349,15 @@ int main()
 
   assert(!b2.isValid());
 
+  MTRand rand(21);
+
+  test_bounding_sphere<2>(rand);
+  test_bounding_sphere<3>(rand);
+  test_minimal(rand);
+  test_inputs<2>(rand);
+  test_inputs<3>(rand);
+  test_approximate<2>(rand);
+  test_approximate<3>(rand);
+
   return 0;
 }
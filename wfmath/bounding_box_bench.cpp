@@ -0,0 +1,105 @@
+// bounding_box_bench.cpp (BoundingBox() and Barycenter() benchmark)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-17
+
+// Compares the container and array versions of BoundingBox() and
+// Barycenter() on a million random points, and boxes.
+
+#include "const.h"
+#include "vector.h"
+#include "point.h"
+#include "axisbox.h"
+#include "randgen.h"
+#include "timestamp.h"
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+using namespace WFMath;
+
+static const int points = 1000000;
+static const int repeats = 20;
+
+static void report(const char* name, const TimeStamp& start, const TimeStamp& end)
+{
+  long ms = (end - start).milliseconds();
+  std::cout << name << ": " << ms << " ms, "
+            << ((double) ms / repeats) << " ms per set" << std::endl;
+}
+
+int main()
+{
+  MTRand rand(1);
+
+  std::vector<Point<3> > set;
+  std::vector<AxisBox<3> > boxes;
+  for(int n = 0; n < points; ++n) {
+    set.push_back(Point<3>((CoordType) (rand.rand() * 200 - 100), (CoordType) (rand.rand() * 200 - 100),
+                           (CoordType) (rand.rand() * 200 - 100)));
+    boxes.push_back(AxisBox<3>(set.back(), set.back() + Vector<3>(1, 2, 1), true));
+  }
+
+  std::cout << "BoundingBox() and Barycenter() of " << points << " points, " << repeats
+            << " times" << std::endl;
+
+  AxisBox<3> b1, b2, b3, b4;
+  Point<3> c1, c2;
+
+  TimeStamp start = TimeStamp::now();
+  for(int r = 0; r < repeats; ++r)
+    b1 = BoundingBox(set);
+  report("BoundingBox(std::vector<Point<3> >)", start, TimeStamp::now());
+
+  start = TimeStamp::now();
+  for(int r = 0; r < repeats; ++r)
+    b2 = BoundingBox(&set[0], set.size());
+  report("BoundingBox(const Point<3>*, size_t)", start, TimeStamp::now());
+
+  start = TimeStamp::now();
+  for(int r = 0; r < repeats; ++r)
+    b3 = BoundingBox(boxes);
+  report("BoundingBox(std::vector<AxisBox<3> >)", start, TimeStamp::now());
+
+  start = TimeStamp::now();
+  for(int r = 0; r < repeats; ++r)
+    b4 = BoundingBox(&boxes[0], boxes.size());
+  report("BoundingBox(const AxisBox<3>*, size_t)", start, TimeStamp::now());
+
+  start = TimeStamp::now();
+  for(int r = 0; r < repeats; ++r)
+    c1 = Barycenter(set);
+  report("Barycenter(std::vector<Point<3> >)", start, TimeStamp::now());
+
+  start = TimeStamp::now();
+  for(int r = 0; r < repeats; ++r)
+    c2 = Barycenter(&set[0], set.size());
+  report("Barycenter(const Point<3>*, size_t)", start, TimeStamp::now());
+
+  // The container version sums in CoordType, which drifts a little
+  bool close = true;
+  for(int j = 0; j < 3; ++j)
+    close = close && std::fabs(c1[j] - c2[j]) < 0.1f;
+
+  return b1 == b2 && b3 == b4 && close ? 0 : 1;
+}
@@ -0,0 +1,440 @@
+// bounding_sphere.cpp (Approximate bounding spheres of point sets)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-17
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "vector.h"
+#include "point.h"
+#include "ball.h"
+#include "miniball.h"
+#include "miniball_funcs.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include <cmath>
+
+// All three builders work in double, and end the same way, with a pass
+// which finds the distance to the farthest point from the center once
+// it's been rounded to CoordType. That distance, rounded up, is the
+// radius, so every point is inside the ball whatever the builder did.
+//
+// Each pass over the points is split into slices, one per thread. The
+// passes which find extremes take the best over the slices. Ritter's
+// growth pass can't be split like that, so each slice grows its own
+// copy of the starting ball, and the slices' balls are merged into the
+// smallest ball holding them all, which holds every point.
+
+namespace WFMath {
+
+// Below this many points a slice costs more to start than it saves
+static const size_t _min_points_per_thread = 1 << 15;
+
+template<int dim>
+struct _Sphere
+{
+  double c[dim];
+  double r;
+};
+
+template<int dim>
+static double _SquaredDistance(const Point<dim>& p, const double* c)
+{
+  double d2 = 0;
+  for(int j = 0; j < dim; ++j) {
+    double d = p[j] - c[j];
+    d2 += d * d;
+  }
+  return d2;
+}
+
+// The number of directions EPOS looks for extreme points along, which
+// are those with each coordinate -1, 0 or 1, and the first nonzero one
+// 1. There are (3^dim - 1) / 2 of them, so 13 in 3D.
+template<int dim>
+struct _EPOSCount {enum {value = 3 * _EPOSCount<dim - 1>::value + 1};};
+template<>
+struct _EPOSCount<0> {enum {value = 0};};
+
+// The directions, the coordinate axes first
+template<int dim>
+static void _EPOSNormals(CoordType normals[][dim])
+{
+  int k = 0;
+
+  for(int j = 0; j < dim; ++j, ++k)
+    for(int m = 0; m < dim; ++m)
+      normals[k][m] = (m == j) ? 1 : 0;
+
+  int count = 1;
+  for(int j = 0; j < dim; ++j)
+    count *= 3;
+
+  for(int code = 0; code < count; ++code) {
+    CoordType v[dim];
+    int first = -1, nonzero = 0;
+    for(int j = 0, c = code; j < dim; ++j, c /= 3) {
+      v[j] = (CoordType) (c % 3 - 1);
+      if(v[j] != 0) {
+        ++nonzero;
+        if(first < 0)
+          first = j;
+      }
+    }
+    if(nonzero > 1 && v[first] > 0) {
+      for(int m = 0; m < dim; ++m)
+        normals[k][m] = v[m];
+      ++k;
+    }
+  }
+}
+
+// The indices of the points with the lowest and highest projections
+// onto each of the first k normals, lowest first. The projections are
+// only used to pick points, so they're done in CoordType.
+template<int dim, int k>
+static std::vector<size_t> _ExtremePoints(const Point<dim>* p, size_t n, unsigned threads)
+{
+  CoordType normals[_EPOSCount<dim>::value][dim];
+  _EPOSNormals<dim>(normals);
+
+  std::vector<CoordType> low(k * threads), high(k * threads);
+  std::vector<size_t> low_i(k * threads), high_i(k * threads);
+
+  // Keeping track of the indices as it goes makes each projection a
+  // branch, so each block of points is first scanned for the lowest
+  // and highest projections alone, and only scanned again for the
+  // indices if it beats those so far, which is rare after the first few
+  _ForSlices(n, threads, [&](size_t begin, size_t end, unsigned t) {
+    const size_t block = 256;
+    CoordType lo[k], hi[k];
+    size_t lo_i[k], hi_i[k];
+    for(int m = 0; m < k; ++m) {
+      lo[m] = std::numeric_limits<CoordType>::infinity();
+      hi[m] = -lo[m];
+      lo_i[m] = hi_i[m] = begin;
+    }
+    for(size_t b = begin; b < end; b += block) {
+      size_t b_end = std::min(b + block, end);
+      CoordType b_lo[k], b_hi[k];
+      for(int m = 0; m < k; ++m) {
+        b_lo[m] = lo[m];
+        b_hi[m] = hi[m];
+      }
+      for(size_t i = b; i < b_end; ++i) {
+        for(int m = 0; m < k; ++m) {
+          CoordType d = 0;
+          for(int j = 0; j < dim; ++j)
+            d += normals[m][j] * p[i][j];
+          b_lo[m] = std::min(b_lo[m], d);
+          b_hi[m] = std::max(b_hi[m], d);
+        }
+      }
+      for(int m = 0; m < k; ++m) {
+        if(b_lo[m] >= lo[m] && b_hi[m] <= hi[m])
+          continue;
+        for(size_t i = b; i < b_end; ++i) {
+          CoordType d = 0;
+          for(int j = 0; j < dim; ++j)
+            d += normals[m][j] * p[i][j];
+          if(d < lo[m]) {
+            lo[m] = d;
+            lo_i[m] = i;
+          }
+          if(d > hi[m]) {
+            hi[m] = d;
+            hi_i[m] = i;
+          }
+        }
+      }
+    }
+    std::copy(lo, lo + k, &low[k * t]);
+    std::copy(hi, hi + k, &high[k * t]);
+    std::copy(lo_i, lo_i + k, &low_i[k * t]);
+    std::copy(hi_i, hi_i + k, &high_i[k * t]);
+  });
+
+  std::vector<size_t> extremes(2 * k);
+  for(int m = 0; m < k; ++m) {
+    size_t lo = m, hi = m;
+    for(unsigned t = 1; t < threads; ++t) {
+      if(low[k * t + m] < low[lo])
+        lo = k * t + m;
+      if(high[k * t + m] > high[hi])
+        hi = k * t + m;
+    }
+    extremes[2 * m] = low_i[lo];
+    extremes[2 * m + 1] = high_i[hi];
+  }
+
+  return extremes;
+}
+
+// Grow s to hold each of the points from begin to end, as in Ritter's
+// algorithm, by moving it towards any point outside it just far enough
+// to take it in
+template<int dim>
+static void _Grow(const Point<dim>* p, size_t begin, size_t end, _Sphere<dim>& s)
+{
+  double r2 = s.r * s.r;
+
+  for(size_t i = begin; i < end; ++i) {
+    double d2 = _SquaredDistance(p[i], s.c);
+    if(d2 <= r2)
+      continue;
+    double d = std::sqrt(d2), r = (s.r + d) / 2, shift = (r - s.r) / d;
+    for(int j = 0; j < dim; ++j)
+      s.c[j] += (p[i][j] - s.c[j]) * shift;
+    s.r = r;
+    r2 = r * r;
+  }
+}
+
+// The smallest ball holding both a and b
+template<int dim>
+static _Sphere<dim> _Merge(const _Sphere<dim>& a, const _Sphere<dim>& b)
+{
+  double d2 = 0;
+  for(int j = 0; j < dim; ++j)
+    d2 += (b.c[j] - a.c[j]) * (b.c[j] - a.c[j]);
+  double d = std::sqrt(d2);
+
+  if(d + b.r <= a.r)
+    return a;
+  if(d + a.r <= b.r)
+    return b;
+
+  _Sphere<dim> s;
+  s.r = (d + a.r + b.r) / 2;
+  double shift = (s.r - a.r) / d;
+  for(int j = 0; j < dim; ++j)
+    s.c[j] = a.c[j] + (b.c[j] - a.c[j]) * shift;
+  return s;
+}
+
+template<int dim>
+static _Sphere<dim> _GrowAll(const Point<dim>* p, size_t n, const _Sphere<dim>& start,
+                             unsigned threads)
+{
+  std::vector<_Sphere<dim> > slices(threads, start);
+
+  _ForSlices(n, threads, [&](size_t begin, size_t end, unsigned t) {
+    _Grow(p, begin, end, slices[t]);
+  });
+
+  _Sphere<dim> s = slices[0];
+  for(unsigned t = 1; t < threads; ++t)
+    s = _Merge(s, slices[t]);
+  return s;
+}
+
+// The exact smallest ball holding the points
+template<int dim>
+static _Sphere<dim> _Exact(const std::vector<Point<dim> >& points)
+{
+  _miniball::Miniball<dim, Point<dim> > m;
+  m.use_points(&points[0], (int) points.size());
+  m.build();
+
+  _Sphere<dim> s;
+  for(int j = 0; j < dim; ++j)
+    s.c[j] = m.center()[j];
+  s.r = std::sqrt(m.squared_radius());
+  return s;
+}
+
+template<int dim>
+static Point<dim> _Round(const _Sphere<dim>& s)
+{
+  Point<dim> c;
+  for(int j = 0; j < dim; ++j)
+    c[j] = (CoordType) s.c[j];
+  return c;
+}
+
+// The farthest point from c, and its squared distance, and whether all
+// the points are valid
+template<int dim>
+static size_t _Farthest(const Point<dim>* p, size_t n, const Point<dim>& c,
+                        unsigned threads, double& max_d2, bool& valid)
+{
+  std::vector<double> d2s(threads, -1);
+  std::vector<size_t> far(threads, 0);
+  std::vector<char> valids(threads, 1);
+  double center[dim];
+  for(int j = 0; j < dim; ++j)
+    center[j] = c[j];
+
+  _ForSlices(n, threads, [&](size_t begin, size_t end, unsigned t) {
+    double best = -1;
+    size_t best_i = begin;
+    bool ok = true;
+    for(size_t i = begin; i < end; ++i) {
+      double d2 = _SquaredDistance(p[i], center);
+      if(d2 > best) {
+        best = d2;
+        best_i = i;
+      }
+      ok = ok && p[i].isValid();
+    }
+    d2s[t] = best;
+    far[t] = best_i;
+    valids[t] = ok;
+  });
+
+  size_t best = 0;
+  valid = true;
+  for(unsigned t = 0; t < threads; ++t) {
+    if(d2s[t] > d2s[best])
+      best = t;
+    valid = valid && valids[t];
+  }
+  max_d2 = d2s[best];
+  return far[best];
+}
+
+// The ball around c reaching the farthest point, which is max_d2 away
+template<int dim>
+static Ball<dim> _Finish(Point<dim> c, double max_d2, bool valid)
+{
+  CoordType r = (CoordType) std::sqrt(max_d2);
+  while((double) r * r < max_d2)
+    r = std::nextafter(r, std::numeric_limits<CoordType>::max());
+
+  c.setValid(valid);
+  return Ball<dim>(c, r);
+}
+
+template<int dim>
+static Ball<dim> _FinishAll(const Point<dim>* p, size_t n, const _Sphere<dim>& s,
+                            unsigned threads)
+{
+  Point<dim> c = _Round(s);
+  double max_d2;
+  bool valid;
+  _Farthest(p, n, c, threads, max_d2, valid);
+  return _Finish(c, max_d2, valid);
+}
+
+template<int dim>
+Ball<dim> BoundingSphereRitter(const Point<dim>* p, size_t n, unsigned threads)
+{
+  if(n == 0)
+    return Ball<dim>();
+
+  threads = _NumThreads(n, threads, _min_points_per_thread);
+
+  // Start with the ball on the widest apart of the pairs of points
+  // which are extreme along an axis
+  std::vector<size_t> extremes = _ExtremePoints<dim, dim>(p, n, threads);
+
+  size_t lo = extremes[0], hi = extremes[1];
+  double widest = -1;
+  for(int j = 0; j < dim; ++j) {
+    const Point<dim> &a = p[extremes[2 * j]], &b = p[extremes[2 * j + 1]];
+    double d2 = 0;
+    for(int m = 0; m < dim; ++m)
+      d2 += ((double) b[m] - a[m]) * ((double) b[m] - a[m]);
+    if(d2 > widest) {
+      widest = d2;
+      lo = extremes[2 * j];
+      hi = extremes[2 * j + 1];
+    }
+  }
+
+  _Sphere<dim> s;
+  for(int j = 0; j < dim; ++j)
+    s.c[j] = ((double) p[lo][j] + p[hi][j]) / 2;
+  s.r = std::sqrt(widest) / 2;
+
+  return _FinishAll(p, n, _GrowAll(p, n, s, threads), threads);
+}
+
+template<int dim>
+Ball<dim> BoundingSphereEPOS(const Point<dim>* p, size_t n, unsigned threads)
+{
+  if(n == 0)
+    return Ball<dim>();
+
+  threads = _NumThreads(n, threads, _min_points_per_thread);
+
+  std::vector<size_t> extremes = _ExtremePoints<dim, _EPOSCount<dim>::value>(p, n, threads);
+  std::vector<Point<dim> > points;
+  for(size_t i = 0; i < extremes.size(); ++i)
+    points.push_back(p[extremes[i]]);
+
+  return _FinishAll(p, n, _GrowAll(p, n, _Exact(points), threads), threads);
+}
+
+template<int dim>
+Ball<dim> BoundingSphereCoreSet(const Point<dim>* p, size_t n, CoordType epsilon,
+                                unsigned threads)
+{
+  if(n == 0)
+    return Ball<dim>();
+
+  threads = _NumThreads(n, threads, _min_points_per_thread);
+
+  // The exact ball of a subset is no bigger than the exact ball of all
+  // the points, so once no point is more than 1 + epsilon times its
+  // radius from its center, that distance is at most 1 + epsilon times
+  // the minimal radius. Until then, the farthest point joins the subset.
+  // Starting from the EPOS points, it usually takes only a few rounds,
+  // even for a small epsilon.
+  std::vector<size_t> extremes = _ExtremePoints<dim, _EPOSCount<dim>::value>(p, n, threads);
+  std::vector<Point<dim> > core;
+  for(size_t i = 0; i < extremes.size(); ++i)
+    core.push_back(p[extremes[i]]);
+
+  double limit = (1 + (double) epsilon) * (1 + (double) epsilon), old_r = -1;
+  Point<dim> c;
+  double max_d2;
+  bool valid;
+
+  while(true) {
+    _Sphere<dim> s = _Exact(core);
+    c = _Round(s);
+    size_t far = _Farthest(p, n, c, threads, max_d2, valid);
+    // Stop if the subset's ball has stopped growing, which only happens
+    // when rounding puts the farthest point outside it by a hair
+    if(max_d2 <= s.r * s.r * limit || s.r <= old_r)
+      break;
+    old_r = s.r;
+    core.push_back(p[far]);
+  }
+
+  return _Finish(c, max_d2, valid);
+}
+
+template Ball<2> BoundingSphereRitter<2>(const Point<2>*, size_t, unsigned);
+template Ball<3> BoundingSphereRitter<3>(const Point<3>*, size_t, unsigned);
+template Ball<2> BoundingSphereEPOS<2>(const Point<2>*, size_t, unsigned);
+template Ball<3> BoundingSphereEPOS<3>(const Point<3>*, size_t, unsigned);
+template Ball<2> BoundingSphereCoreSet<2>(const Point<2>*, size_t, CoordType, unsigned);
+template Ball<3> BoundingSphereCoreSet<3>(const Point<3>*, size_t, CoordType, unsigned);
+
+} // namespace WFMath
@@ -0,0 +1,145 @@
+// bounding_sphere_bench.cpp (BoundingSphere() benchmark)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-17
+
+// Times BoundingSphere() on 100000 random points, copied from a
+// std::vector and used in place, and the approximate builders, with
+// how much bigger their radius is than the minimal one.
+
+#include "const.h"
+#include "vector.h"
+#include "point.h"
+#include "ball.h"
+#include "randgen.h"
+#include "timestamp.h"
+
+#include <iostream>
+#include <vector>
+
+using namespace WFMath;
+
+static const int points = 100000;
+static const int repeats = 20;
+
+static void report(const char* name, const TimeStamp& start, const TimeStamp& end)
+{
+  long ms = (end - start).milliseconds();
+  std::cout << name << ": " << ms << " ms, "
+            << ((double) ms / repeats) << " ms per set" << std::endl;
+}
+
+static void report(const char* name, const TimeStamp& start, const TimeStamp& end,
+                   CoordType radius, CoordType exact)
+{
+  long ms = (end - start).milliseconds();
+  std::cout << name << ": " << ms << " ms, "
+            << ((double) ms / repeats) << " ms per set, radius "
+            << (radius / exact) << " of minimal" << std::endl;
+}
+
+// Times the approximate builders on set, and checks none of them is
+// smaller than the minimal ball
+static bool approximate(const std::vector<Point<3> >& set)
+{
+  const Point<3>* p = &set[0];
+  size_t n = set.size();
+  CoordType exact = BoundingSphere(p, n).radius();
+  bool bigger = true;
+  Ball<3> b;
+
+  TimeStamp start = TimeStamp::now();
+  for(int r = 0; r < repeats; ++r)
+    b = BoundingSphereSloppy(set);
+  report("BoundingSphereSloppy()", start, TimeStamp::now(), b.radius(), exact);
+  bigger = bigger && b.radius() >= exact * (1 - 1e-5f);
+
+  start = TimeStamp::now();
+  for(int r = 0; r < repeats; ++r)
+    b = BoundingSphereRitter(p, n);
+  report("BoundingSphereRitter()", start, TimeStamp::now(), b.radius(), exact);
+  bigger = bigger && b.radius() >= exact * (1 - 1e-5f);
+
+  start = TimeStamp::now();
+  for(int r = 0; r < repeats; ++r)
+    b = BoundingSphereEPOS(p, n);
+  report("BoundingSphereEPOS()", start, TimeStamp::now(), b.radius(), exact);
+  bigger = bigger && b.radius() >= exact * (1 - 1e-5f);
+
+  const char* names[] = {"BoundingSphereCoreSet(0.1)", "BoundingSphereCoreSet(0.01)",
+                         "BoundingSphereCoreSet(0.001)"};
+  const CoordType epsilons[] = {0.1f, 0.01f, 0.001f};
+  for(int e = 0; e < 3; ++e) {
+    start = TimeStamp::now();
+    for(int r = 0; r < repeats; ++r)
+      b = BoundingSphereCoreSet(p, n, epsilons[e]);
+    report(names[e], start, TimeStamp::now(), b.radius(), exact);
+    bigger = bigger && b.radius() >= exact * (1 - 1e-5f);
+  }
+
+  return bigger;
+}
+
+int main()
+{
+  MTRand rand(1);
+
+  std::vector<Point<3> > set, sphere;
+  for(int n = 0; n < points; ++n) {
+    set.push_back(Point<3>((CoordType) (rand.rand() * 20 - 10), (CoordType) (rand.rand() * 20 - 10),
+                           (CoordType) (rand.rand() * 20 - 10)));
+    // Close to a sphere, where every point may be on the minimal ball
+    Vector<3> v = set.back() - Point<3>().setToOrigin();
+    sphere.push_back(Point<3>().setToOrigin() + v * ((10 + (CoordType) rand.rand() * 0.01f) / v.mag()));
+  }
+
+  std::cout << "Bounding spheres of " << points << " points, " << repeats << " times"
+            << std::endl;
+
+  CoordType copied = 0, in_place = 0;
+
+  TimeStamp start = TimeStamp::now();
+  for(int r = 0; r < repeats; ++r)
+    copied += BoundingSphere(set).radius();
+  report("BoundingSphere(std::vector<Point<3> >)", start, TimeStamp::now());
+
+  start = TimeStamp::now();
+  for(int r = 0; r < repeats; ++r)
+    in_place += BoundingSphere(&set[0], set.size()).radius();
+  report("BoundingSphere(const Point<3>*, size_t)", start, TimeStamp::now());
+
+  bool bigger = approximate(set);
+
+  std::cout << "Bounding spheres of " << points << " points near a sphere, " << repeats
+            << " times" << std::endl;
+
+  CoordType on_sphere = 0;
+
+  start = TimeStamp::now();
+  for(int r = 0; r < repeats; ++r)
+    on_sphere += BoundingSphere(&sphere[0], sphere.size()).radius();
+  report("BoundingSphere(const Point<3>*, size_t)", start, TimeStamp::now());
+
+  bigger = approximate(sphere) && bigger;
+
+  return copied == in_place && on_sphere > 0 && bigger ? 0 : 1;
+}
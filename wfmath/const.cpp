@@ -30,6 +30,8 @@
 #include <wfmath/const.h>
 
 #include <cmath>
+#include <cstring>
+#include <cstdint>
 
 #include <cassert>
 
@@ -83,8 +85,28 @@ float _ScaleEpsilon(float x1, float x2, float epsilon)
 {
     // Get the exponent of the smaller of the two numbers (using the
     // smaller of the two gives us a tighter epsilon value).
+    float smaller = std::fabs(x1) < std::fabs(x2) ? x1 : x2;
+
+    // This is called by every Dot(), Cross() and SquaredDistance(),
+    // so read the exponent out of the bits instead of calling frexp()
+    // and ldexp(). For a normal number with biased exponent e, frexp()
+    // returns e - 126, and 2^(e - 126) is the float with biased exponent
+    // e + 1. Multiplying by a power of two rounds the same way ldexp()
+    // does, so the answer is identical.
+    std::uint32_t bits;
+    std::memcpy(&bits, &smaller, sizeof(bits));
+    std::uint32_t biased = (bits >> 23) & 0xff;
+
+    if (biased != 0 && biased < 0xfe) {
+        std::uint32_t pow2_bits = (biased + 1) << 23;
+        float pow2;
+        std::memcpy(&pow2, &pow2_bits, sizeof(pow2));
+        return epsilon * pow2;
+    }
+
+    // Zero, denormals, and numbers too large for the above
     int exponent;
-    (void) std::frexp(std::fabs(x1) < std::fabs(x2) ? x1 : x2, &exponent);   
+    (void) std::frexp(smaller, &exponent);
 
     // Scale epsilon by the exponent.
     return std::ldexp(epsilon, exponent);
@@ -133,6 +133,15 @@ struct numeric_constants<double>
   }
 };
 
+/// How many corners a Polygon or Line holds before it allocates
+/**
+ * The library and the code using it must agree on this, so changing it
+ * means building the library with the same value.
+ **/
+#ifndef WFMATH_INLINE_CORNERS
+#define WFMATH_INLINE_CORNERS 8
+#endif
+
 /// How long we can let RotMatrix and Quaternion go before fixing normalization
 #define WFMATH_MAX_NORM_AGE ((WFMATH_PRECISION_FUDGE_FACTOR * 2) / 3)
 
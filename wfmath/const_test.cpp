@@ -32,6 +32,9 @@
 
 #include "const.h"
 
+#include <cmath>
+#include <limits>
+
 #include <cassert>
 
 using namespace WFMath;
@@ -50,9 +53,37 @@ static void TestEqual()
         assert(!Equal(1000100.0, 1000000.0, 1.0e-6));
 }
 
+// _ScaleEpsilon(float, float, float) reads the exponent from the bits
+// directly, it must agree exactly with frexp() and ldexp()
+static void TestScaleEpsilon()
+{
+        const float eps = numeric_constants<float>::epsilon();
+        const float values[] = {0.0f, -0.0f, 1.0f, -1.0f, 0.75f, 3.0e-7f,
+                                std::numeric_limits<float>::min(),
+                                std::numeric_limits<float>::denorm_min(),
+                                std::numeric_limits<float>::min() / 3,
+                                std::numeric_limits<float>::max(),
+                                std::numeric_limits<float>::max() / 3};
+
+        for (float x : values) {
+                int exponent;
+                (void) std::frexp(x, &exponent);
+                assert(_ScaleEpsilon(x, x, eps) == std::ldexp(eps, exponent));
+        }
+
+        for (int exp = -150; exp <= 128; ++exp) {
+                float x = std::ldexp(1.3f, exp);
+                int exponent;
+                (void) std::frexp(x, &exponent);
+                assert(_ScaleEpsilon(x, -2 * x, eps) == std::ldexp(eps, exponent));
+                assert(_ScaleEpsilon(-2 * x, x, 1.0f) == std::ldexp(1.0f, exponent));
+        }
+}
+
 int main()
 {
   TestEqual();
+  TestScaleEpsilon();
 
   return 0;
 }
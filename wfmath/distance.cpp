@@ -0,0 +1,181 @@
+// distance.cpp (Distance and closest point functions for shapes)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "distance.h"
+
+#include <vector>
+
+#include <cmath>
+
+namespace WFMath {
+
+template<int dim>
+CoordType _ClosestPoints(const Segment<dim>& s1, const Segment<dim>& s2,
+                         Point<dim>& c1, Point<dim>& c2, CoordType, CoordType)
+{
+  // Minimize |s1(t1) - s2(t2)| over the square [0, 1] x [0, 1]
+  const Point<dim> &p1 = s1.endpoint(0), &p2 = s2.endpoint(0);
+  Vector<dim> d1 = s1.endpoint(1) - p1, d2 = s2.endpoint(1) - p2, r = p1 - p2;
+  CoordType a = d1.sqrMag(), e = d2.sqrMag(), f = Dot(d2, r);
+  CoordType t1 = 0, t2 = 0;
+
+  if(a > 0 || e > 0) {
+    if(!(a > 0))
+      t2 = std::min(std::max(f / e, (CoordType) 0), (CoordType) 1);
+    else {
+      CoordType c = Dot(d1, r);
+      if(!(e > 0))
+        t1 = std::min(std::max(-c / a, (CoordType) 0), (CoordType) 1);
+      else {
+        // The closest point of the lines, clamped to s1, then the
+        // closest point of s2 to that, clamped, then s1 again
+        CoordType b = Dot(d1, d2), denom = a * e - b * b;
+        if(denom > 0)
+          t1 = std::min(std::max((b * f - c * e) / denom, (CoordType) 0), (CoordType) 1);
+        t2 = (b * t1 + f) / e;
+        if(t2 < 0) {
+          t2 = 0;
+          t1 = std::min(std::max(-c / a, (CoordType) 0), (CoordType) 1);
+        }
+        else if(t2 > 1) {
+          t2 = 1;
+          t1 = std::min(std::max((b - c) / a, (CoordType) 0), (CoordType) 1);
+        }
+      }
+    }
+  }
+
+  c1 = p1 + d1 * t1;
+  c2 = p2 + d2 * t2;
+  return (c1 - c2).sqrMag();
+}
+
+// The coordinates of the corners in the plane of the polygon
+static void _PlaneCoords(const std::vector<Point<2> >& corners,
+                         std::vector<CoordType>& x, std::vector<CoordType>& y)
+{
+  for(size_t i = 0; i < corners.size(); ++i) {
+    x[i] = corners[i][0];
+    y[i] = corners[i][1];
+  }
+}
+
+static void _PlaneCoords(const std::vector<Point<3> >& corners,
+                         std::vector<CoordType>& x, std::vector<CoordType>& y)
+{
+  // Drop the largest component of Newell's normal
+  const size_t n = corners.size();
+  CoordType normal[3] = {0, 0, 0};
+  for(size_t i = 0; i < n; ++i) {
+    const Point<3> &p = corners[i], &q = corners[(i + 1) % n];
+    for(int j = 0; j < 3; ++j)
+      normal[j] += (p[(j + 1) % 3] - q[(j + 1) % 3]) * (p[(j + 2) % 3] + q[(j + 2) % 3]);
+  }
+  int drop = 0;
+  for(int j = 1; j < 3; ++j)
+    if(std::fabs(normal[j]) > std::fabs(normal[drop]))
+      drop = j;
+
+  for(size_t i = 0; i < n; ++i) {
+    x[i] = corners[i][(drop + 1) % 3];
+    y[i] = corners[i][(drop + 2) % 3];
+  }
+}
+
+template<int dim>
+void _Triangulate(const Polygon<dim>& poly, std::vector<_Triangle<dim> >& out)
+{
+  out.clear();
+  const size_t n = poly.numCorners();
+  if(n < 3)
+    return;
+
+  std::vector<Point<dim> > corners(n);
+  std::vector<CoordType> x(n), y(n);
+  for(size_t i = 0; i < n; ++i)
+    corners[i] = poly.getCorner(i);
+  _PlaneCoords(corners, x, y);
+
+  // Twice the signed area, to tell convex corners from reflex ones
+  CoordType area = 0;
+  for(size_t i = 0; i < n; ++i) {
+    size_t j = (i + 1) % n;
+    area += x[i] * y[j] - x[j] * y[i];
+  }
+  const CoordType sign = (area < 0) ? -1 : 1;
+
+  // The corners not yet clipped off, as a circular linked list
+  std::vector<size_t> next(n), prev(n);
+  for(size_t i = 0; i < n; ++i) {
+    next[i] = (i + 1) % n;
+    prev[i] = (i + n - 1) % n;
+  }
+
+  auto turn = [&](size_t a, size_t b, size_t c) {
+    return sign * ((x[b] - x[a]) * (y[c] - y[a]) - (x[c] - x[a]) * (y[b] - y[a]));
+  };
+
+  size_t remaining = n, cur = 0, tried = 0;
+  while(remaining > 3) {
+    size_t a = prev[cur], c = next[cur];
+    bool ear = turn(a, cur, c) > 0;
+
+    // An ear has no other corner inside it, or on its edges
+    for(size_t k = next[c]; ear && k != a; k = next[k])
+      ear = !(turn(a, cur, k) >= 0 && turn(cur, c, k) >= 0 && turn(c, a, k) >= 0);
+
+    // If a whole lap finds no ear, the polygon crosses itself or is
+    // degenerate, so clip anyway
+    if(ear || tried == remaining) {
+      _Triangle<dim> t = {{corners[a], corners[cur], corners[c]}};
+      out.push_back(t);
+      next[a] = c;
+      prev[c] = a;
+      --remaining;
+      tried = 0;
+      cur = c;
+    }
+    else {
+      ++tried;
+      cur = next[cur];
+    }
+  }
+
+  _Triangle<dim> t = {{corners[prev[cur]], corners[cur], corners[next[cur]]}};
+  out.push_back(t);
+}
+
+template CoordType _ClosestPoints<3>(const Segment<3>&, const Segment<3>&,
+                                     Point<3>&, Point<3>&, CoordType, CoordType);
+template CoordType _ClosestPoints<2>(const Segment<2>&, const Segment<2>&,
+                                     Point<2>&, Point<2>&, CoordType, CoordType);
+
+template void _Triangulate<3>(const Polygon<3>&, std::vector<_Triangle<3> >&);
+template void _Triangulate<2>(const Polygon<2>&, std::vector<_Triangle<2> >&);
+
+} // namespace WFMath
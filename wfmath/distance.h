@@ -0,0 +1,385 @@
+// distance.h (Distance and closest point functions for shapes)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifndef WFMATH_DISTANCE_H
+#define WFMATH_DISTANCE_H
+
+#include <wfmath/const.h>
+#include <wfmath/vector.h>
+#include <wfmath/point.h>
+#include <wfmath/axisbox.h>
+#include <wfmath/ball.h>
+#include <wfmath/segment.h>
+#include <wfmath/rotbox.h>
+#include <wfmath/polygon.h>
+#include <wfmath/gjk.h>
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+#include <cmath>
+
+namespace WFMath {
+
+// A triangle of a Polygon which is not convex
+template<int dim>
+struct _Triangle
+{
+  Point<dim> corners[3];
+};
+
+template<int dim>
+inline Point<dim> Support(const _Triangle<dim>& t, const Vector<dim>& dir)
+{
+  CoordType d1 = Dot(t.corners[1] - t.corners[0], dir),
+            d2 = Dot(t.corners[2] - t.corners[0], dir);
+  if(d1 > 0 && d1 >= d2)
+    return t.corners[1];
+  return (d2 > 0) ? t.corners[2] : t.corners[0];
+}
+
+/// Split a polygon into triangles, by ear clipping
+/**
+ * The polygon should not cross itself. If it does, the triangles still
+ * cover all of its corners, but may not match its area.
+ **/
+template<int dim>
+void _Triangulate(const Polygon<dim>& poly, std::vector<_Triangle<dim> >& out);
+
+// The functions below return the squared distance between two shapes,
+// and set c1 and c2 to the closest points of each. They may stop early
+// once the distance is known to be more than stop, or less than accept,
+// and then only the comparison of the result with those is meaningful.
+
+template<int dim, template<int> class Shape1, template<int> class Shape2>
+inline CoordType _GJKClosestPoints(const Shape1<dim>& s1, const Shape2<dim>& s2,
+                                   Point<dim>& c1, Point<dim>& c2,
+                                   CoordType stop, CoordType accept)
+{
+  _GJKSimplex<dim> simplex;
+  CoordType sqr = _GJKRun(s1, s2, simplex, (GJKCache<dim>*) 0, stop, accept);
+  simplex.closestPoints(c1, c2);
+  return sqr;
+}
+
+// Every pair without an exact answer below goes to GJK
+template<int dim, template<int> class Shape1, template<int> class Shape2>
+inline CoordType _ClosestPoints(const Shape1<dim>& s1, const Shape2<dim>& s2,
+                                Point<dim>& c1, Point<dim>& c2,
+                                CoordType stop, CoordType accept)
+{
+  return _GJKClosestPoints(s1, s2, c1, c2, stop, accept);
+}
+
+template<int dim>
+inline CoordType _ClosestPoints(const Point<dim>& p1, const Point<dim>& p2,
+                                Point<dim>& c1, Point<dim>& c2, CoordType, CoordType)
+{
+  c1 = p1;
+  c2 = p2;
+  return (p1 - p2).sqrMag();
+}
+
+template<int dim>
+inline CoordType _ClosestPoints(const Point<dim>& p, const AxisBox<dim>& b,
+                                Point<dim>& c1, Point<dim>& c2, CoordType, CoordType)
+{
+  c1 = p;
+  c2 = p;
+  for(int i = 0; i < dim; ++i) {
+    if(p[i] < b.lowCorner()[i])
+      c2[i] = b.lowCorner()[i];
+    else if(p[i] > b.highCorner()[i])
+      c2[i] = b.highCorner()[i];
+  }
+  return (c1 - c2).sqrMag();
+}
+
+template<int dim>
+inline CoordType _ClosestPoints(const Point<dim>& p, const Segment<dim>& s,
+                                Point<dim>& c1, Point<dim>& c2, CoordType, CoordType)
+{
+  Vector<dim> d = s.endpoint(1) - s.endpoint(0);
+  CoordType sqr = d.sqrMag(), t = 0;
+  if(sqr > 0) {
+    t = Dot(p - s.endpoint(0), d) / sqr;
+    t = (t < 0) ? 0 : ((t > 1) ? 1 : t);
+  }
+  c1 = p;
+  c2 = s.endpoint(0) + d * t;
+  return (c1 - c2).sqrMag();
+}
+
+template<int dim>
+inline CoordType _ClosestPoints(const Point<dim>& p, const RotBox<dim>& r,
+                                Point<dim>& c1, Point<dim>& c2, CoordType, CoordType)
+{
+  // Clamp p to the box in the box's coordinates
+  Vector<dim> local = Prod(r.orientation(), p - r.corner0());
+  bool inside = true;
+  for(int i = 0; i < dim; ++i) {
+    CoordType low = r.size()[i] < 0 ? r.size()[i] : 0,
+              high = r.size()[i] > 0 ? r.size()[i] : 0;
+    if(local[i] < low) {
+      local[i] = low;
+      inside = false;
+    }
+    else if(local[i] > high) {
+      local[i] = high;
+      inside = false;
+    }
+  }
+  c1 = p;
+  c2 = inside ? p : r.corner0() + Prod(local, r.orientation());
+  return (c1 - c2).sqrMag();
+}
+
+template<int dim>
+inline CoordType _ClosestPoints(const AxisBox<dim>& b1, const AxisBox<dim>& b2,
+                                Point<dim>& c1, Point<dim>& c2, CoordType, CoordType)
+{
+  c1 = b1.lowCorner();
+  c2 = b2.lowCorner();
+  for(int i = 0; i < dim; ++i) {
+    CoordType low = std::max(b1.lowCorner()[i], b2.lowCorner()[i]),
+              high = std::min(b1.highCorner()[i], b2.highCorner()[i]);
+    if(low <= high)
+      c1[i] = c2[i] = (low + high) / 2;
+    else if(b1.highCorner()[i] < b2.lowCorner()[i]) {
+      c1[i] = b1.highCorner()[i];
+      c2[i] = b2.lowCorner()[i];
+    }
+    else {
+      c1[i] = b1.lowCorner()[i];
+      c2[i] = b2.highCorner()[i];
+    }
+  }
+  return (c1 - c2).sqrMag();
+}
+
+template<int dim>
+CoordType _ClosestPoints(const Segment<dim>& s1, const Segment<dim>& s2,
+                         Point<dim>& c1, Point<dim>& c2, CoordType, CoordType);
+
+// Balls are the distance from their center, less the radius
+
+template<int dim, template<int> class Shape>
+inline CoordType _BallClosestPoints(const Ball<dim>& b, const Shape<dim>& s,
+                                    Point<dim>& c1, Point<dim>& c2,
+                                    CoordType stop, CoordType accept)
+{
+  CoordType r = b.radius();
+  CoordType dist = std::sqrt(_ClosestPoints(b.center(), s, c1, c2, stop + r, accept + r));
+  if(dist <= r) {
+    // c2 is in both shapes
+    c1 = c2;
+    return 0;
+  }
+  c1 = b.center() + (c2 - b.center()) * (r / dist);
+  return (dist - r) * (dist - r);
+}
+
+template<int dim, template<int> class Shape>
+inline CoordType _ClosestPoints(const Ball<dim>& b, const Shape<dim>& s,
+                                Point<dim>& c1, Point<dim>& c2,
+                                CoordType stop, CoordType accept)
+{
+  return _BallClosestPoints(b, s, c1, c2, stop, accept);
+}
+
+template<int dim, template<int> class Shape>
+inline CoordType _ClosestPoints(const Shape<dim>& s, const Ball<dim>& b,
+                                Point<dim>& c1, Point<dim>& c2,
+                                CoordType stop, CoordType accept)
+{
+  return _BallClosestPoints(b, s, c2, c1, stop, accept);
+}
+
+template<int dim>
+inline CoordType _ClosestPoints(const Ball<dim>& b1, const Ball<dim>& b2,
+                                Point<dim>& c1, Point<dim>& c2,
+                                CoordType stop, CoordType accept)
+{
+  return _BallClosestPoints(b1, b2, c1, c2, stop, accept);
+}
+
+// Convex polygons go to GJK, others are split into triangles
+
+template<int dim, template<int> class Shape>
+CoordType _PolygonClosestPoints(const Polygon<dim>& p, const Shape<dim>& s,
+                                Point<dim>& c1, Point<dim>& c2,
+                                CoordType stop, CoordType accept)
+{
+  if(p.numCorners() == 0)
+    return std::numeric_limits<CoordType>::max();
+  if(p.numCorners() < 4 || p.isConvex())
+    return _GJKClosestPoints(p, s, c1, c2, stop, accept);
+
+  std::vector<_Triangle<dim> > triangles;
+  _Triangulate(p, triangles);
+
+  CoordType best = std::numeric_limits<CoordType>::max();
+  for(size_t i = 0; i < triangles.size(); ++i) {
+    Point<dim> t1, t2;
+    CoordType sqr = _ClosestPoints(triangles[i], s, t1, t2, stop, accept);
+    if(sqr < best) {
+      best = sqr;
+      c1 = t1;
+      c2 = t2;
+    }
+    if(best < accept * accept)
+      break;
+  }
+  return best;
+}
+
+template<int dim, template<int> class Shape>
+inline CoordType _ClosestPoints(const Polygon<dim>& p, const Shape<dim>& s,
+                                Point<dim>& c1, Point<dim>& c2,
+                                CoordType stop, CoordType accept)
+{
+  return _PolygonClosestPoints(p, s, c1, c2, stop, accept);
+}
+
+template<int dim, template<int> class Shape>
+inline CoordType _ClosestPoints(const Shape<dim>& s, const Polygon<dim>& p,
+                                Point<dim>& c1, Point<dim>& c2,
+                                CoordType stop, CoordType accept)
+{
+  return _PolygonClosestPoints(p, s, c2, c1, stop, accept);
+}
+
+// GJK works on the convex hull of both polygons, so a polygon which
+// isn't convex must be split even when the other one is. Splitting p1
+// splits p2 in turn, as each triangle then meets it as the Shape.
+template<int dim>
+inline CoordType _ClosestPoints(const Polygon<dim>& p1, const Polygon<dim>& p2,
+                                Point<dim>& c1, Point<dim>& c2,
+                                CoordType stop, CoordType accept)
+{
+  bool convex1 = p1.numCorners() < 4 || p1.isConvex();
+  bool convex2 = p2.numCorners() < 4 || p2.isConvex();
+  if(convex1 && !convex2)
+    return _PolygonClosestPoints(p2, p1, c2, c1, stop, accept);
+  return _PolygonClosestPoints(p1, p2, c1, c2, stop, accept);
+}
+
+template<int dim>
+inline CoordType _ClosestPoints(const Ball<dim>& b, const Polygon<dim>& p,
+                                Point<dim>& c1, Point<dim>& c2,
+                                CoordType stop, CoordType accept)
+{
+  return _BallClosestPoints(b, p, c1, c2, stop, accept);
+}
+
+template<int dim>
+inline CoordType _ClosestPoints(const Polygon<dim>& p, const Ball<dim>& b,
+                                Point<dim>& c1, Point<dim>& c2,
+                                CoordType stop, CoordType accept)
+{
+  return _BallClosestPoints(b, p, c2, c1, stop, accept);
+}
+
+// The other orders of the exact pairs
+
+template<int dim>
+inline CoordType _ClosestPoints(const AxisBox<dim>& b, const Point<dim>& p,
+                                Point<dim>& c1, Point<dim>& c2,
+                                CoordType stop, CoordType accept)
+{
+  return _ClosestPoints(p, b, c2, c1, stop, accept);
+}
+
+template<int dim>
+inline CoordType _ClosestPoints(const Segment<dim>& s, const Point<dim>& p,
+                                Point<dim>& c1, Point<dim>& c2,
+                                CoordType stop, CoordType accept)
+{
+  return _ClosestPoints(p, s, c2, c1, stop, accept);
+}
+
+template<int dim>
+inline CoordType _ClosestPoints(const RotBox<dim>& r, const Point<dim>& p,
+                                Point<dim>& c1, Point<dim>& c2,
+                                CoordType stop, CoordType accept)
+{
+  return _ClosestPoints(p, r, c2, c1, stop, accept);
+}
+
+/// The squared distance between two shapes, 0 if they overlap
+/**
+ * Distance(), SquaredDistance(), ClosestPoints() and DistanceLessThan()
+ * work for every pair of Point, AxisBox, Ball, Segment, RotBox and
+ * Polygon, in either order, like Intersect(). Pairs of points, boxes,
+ * segments and balls have exact formulas. The rest use GJK, see gjk.h.
+ *
+ * A Polygon which is not strictly convex is split into triangles on
+ * every call, which costs time proportional to the square of the
+ * number of corners, and a GJK query for each triangle.
+ **/
+template<int dim, template<int> class Shape1, template<int> class Shape2>
+inline CoordType SquaredDistance(const Shape1<dim>& s1, const Shape2<dim>& s2)
+{
+  Point<dim> c1, c2;
+  return _ClosestPoints(s1, s2, c1, c2, std::numeric_limits<CoordType>::max(), 0);
+}
+
+/// The distance between two shapes, 0 if they overlap
+template<int dim, template<int> class Shape1, template<int> class Shape2>
+inline CoordType Distance(const Shape1<dim>& s1, const Shape2<dim>& s2)
+{
+  return std::sqrt(SquaredDistance(s1, s2));
+}
+
+/// The distance between two shapes, and the closest points of each
+/**
+ * If the shapes overlap, this returns 0, and c1 and c2 are both set
+ * to a point which is in both shapes.
+ **/
+template<int dim, template<int> class Shape1, template<int> class Shape2>
+inline CoordType ClosestPoints(const Shape1<dim>& s1, const Shape2<dim>& s2,
+                               Point<dim>& c1, Point<dim>& c2)
+{
+  return std::sqrt(_ClosestPoints(s1, s2, c1, c2,
+                                  std::numeric_limits<CoordType>::max(), 0));
+}
+
+/// True if the distance between two shapes is less than r
+/**
+ * This stops as soon as the answer is known, which for shapes far
+ * apart, or overlapping, is usually the first or second GJK step.
+ **/
+template<int dim, template<int> class Shape1, template<int> class Shape2>
+inline bool DistanceLessThan(const Shape1<dim>& s1, const Shape2<dim>& s2, CoordType r)
+{
+  if(!(r > 0))
+    return false;
+  Point<dim> c1, c2;
+  return _ClosestPoints(s1, s2, c1, c2, r, r) < r * r;
+}
+
+} // namespace WFMath
+
+#endif  // WFMATH_DISTANCE_H
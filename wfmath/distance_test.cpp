@@ -0,0 +1,294 @@
+// distance_test.cpp (Distance and closest point test functions)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#ifndef DEBUG
+#define DEBUG
+#endif
+
+#include "const.h"
+#include "vector.h"
+#include "point.h"
+#include "rotmatrix.h"
+#include "axisbox.h"
+#include "ball.h"
+#include "segment.h"
+#include "rotbox.h"
+#include "polygon.h"
+#include "intersect.h"
+#include "polygon_intersect.h"
+#include "distance.h"
+#include "randgen.h"
+
+#include <iostream>
+
+#include <cassert>
+#include <cmath>
+
+using namespace WFMath;
+
+static const CoordType tolerance = 1e-3f;
+
+static CoordType random_coord(MTRand& rand, CoordType low, CoordType high)
+{
+  return low + (high - low) * (CoordType) rand.rand();
+}
+
+template<int dim>
+static Point<dim> random_point(MTRand& rand)
+{
+  Point<dim> p;
+  p.setToOrigin();
+  for(int i = 0; i < dim; ++i)
+    p[i] = random_coord(rand, -3, 3);
+  return p;
+}
+
+template<int dim>
+static Vector<dim> random_size(MTRand& rand)
+{
+  Vector<dim> v;
+  for(int i = 0; i < dim; ++i)
+    v[i] = random_coord(rand, 0.2f, 2);
+  v.setValid();
+  return v;
+}
+
+static RotMatrix<2> random_rotation(MTRand& rand, const RotMatrix<2>&)
+{
+  RotMatrix<2> m;
+  return m.rotation(random_coord(rand, -3, 3));
+}
+
+static RotMatrix<3> random_rotation(MTRand& rand, const RotMatrix<3>&)
+{
+  RotMatrix<3> m;
+  Vector<3> axis(random_coord(rand, -1, 1), 1, random_coord(rand, -1, 1));
+  return m.rotation(axis, random_coord(rand, -3, 3));
+}
+
+template<int dim>
+struct RandomShapes
+{
+  MTRand& rand;
+
+  Point<dim> point() {return random_point<dim>(rand);}
+  Ball<dim> ball() {return Ball<dim>(point(), random_coord(rand, 0.1f, 1.5f));}
+  AxisBox<dim> box()
+  {
+    Point<dim> low = point();
+    return AxisBox<dim>(low, low + random_size<dim>(rand));
+  }
+  Segment<dim> segment()
+  {
+    Point<dim> p = point();
+    return Segment<dim>(p, p + random_size<dim>(rand) - random_size<dim>(rand));
+  }
+  RotBox<dim> rotbox()
+  {
+    return RotBox<dim>(point(), random_size<dim>(rand),
+                       random_rotation(rand, RotMatrix<dim>()));
+  }
+};
+
+// Check the answers for a pair against GJK, and against the other order
+template<int dim, template<int> class Shape1, template<int> class Shape2>
+static void check_pair(const Shape1<dim>& s1, const Shape2<dim>& s2)
+{
+  Point<dim> c1, c2, r1, r2, g1, g2;
+  CoordType dist = ClosestPoints(s1, s2, c1, c2);
+
+  assert(dist >= 0);
+  assert(Equal(dist * dist, SquaredDistance(s1, s2)) || dist < tolerance);
+  assert(Equal(dist, Distance(s1, s2)) || dist < tolerance);
+  assert(std::fabs(dist - GJKDistance(s1, s2, g1, g2)) < tolerance);
+  assert(std::fabs(dist - ClosestPoints(s2, s1, r2, r1)) < tolerance);
+
+  assert(std::fabs((c1 - c2).mag() - dist) < tolerance);
+  assert(Intersect(Ball<dim>(c1, tolerance), s1, false));
+  assert(Intersect(Ball<dim>(c2, tolerance), s2, false));
+
+  if(dist > tolerance)
+    assert(!Intersect(s1, s2, false));
+
+  assert(!DistanceLessThan(s1, s2, 0));
+  assert(DistanceLessThan(s1, s2, dist + tolerance));
+  if(dist > tolerance)
+    assert(!DistanceLessThan(s1, s2, dist - tolerance));
+}
+
+template<int dim>
+static void test_random_pairs(MTRand& rand)
+{
+  std::cout << "Testing " << dim << "D distances" << std::endl;
+
+  RandomShapes<dim> r = {rand};
+
+  for(int i = 0; i < 300; ++i) {
+    check_pair(r.point(), r.point());
+    check_pair(r.point(), r.box());
+    check_pair(r.point(), r.ball());
+    check_pair(r.point(), r.segment());
+    check_pair(r.point(), r.rotbox());
+    check_pair(r.box(), r.box());
+    check_pair(r.box(), r.ball());
+    check_pair(r.box(), r.segment());
+    check_pair(r.box(), r.rotbox());
+    check_pair(r.ball(), r.ball());
+    check_pair(r.ball(), r.segment());
+    check_pair(r.ball(), r.rotbox());
+    check_pair(r.segment(), r.segment());
+    check_pair(r.segment(), r.rotbox());
+    check_pair(r.rotbox(), r.rotbox());
+  }
+
+  // Parallel and degenerate segments
+  Point<dim> origin;
+  origin.setToOrigin();
+  Vector<dim> x, y;
+  x.zero();
+  y.zero();
+  x[0] = 1;
+  y[1] = 1;
+  Segment<dim> s1(origin, origin + x * 2), s2(origin + x + y, origin + x * 4 + y);
+  Point<dim> c1, c2;
+  assert(Equal(ClosestPoints(s1, s2, c1, c2), 1));
+  assert(Equal(Distance(s1, Segment<dim>(origin + x * 3, origin + x * 3)), 1));
+  assert(Equal(Distance(Segment<dim>(origin, origin), s2), std::sqrt((CoordType) 2)));
+}
+
+// The distance from a point to a polygon, from its edges
+static CoordType brute_distance(const Polygon<2>& poly, const Point<2>& p)
+{
+  if(Intersect(poly, p, false))
+    return 0;
+  CoordType best = std::numeric_limits<CoordType>::max();
+  for(size_t i = 0; i < poly.numCorners(); ++i) {
+    Segment<2> edge(poly[i], poly[(i + 1) % poly.numCorners()]);
+    best = std::min(best, Distance(edge, p));
+  }
+  return best;
+}
+
+static void test_polygons(MTRand& rand)
+{
+  std::cout << "Testing polygon distances" << std::endl;
+
+  // An L shape, which is not convex
+  Polygon<2> l;
+  l.addCorner(0, Point<2>(0, 0));
+  l.addCorner(1, Point<2>(3, 0));
+  l.addCorner(2, Point<2>(3, 1));
+  l.addCorner(3, Point<2>(1, 1));
+  l.addCorner(4, Point<2>(1, 3));
+  l.addCorner(5, Point<2>(0, 3));
+  assert(!l.isConvex());
+
+  // The notch is empty, though the convex hull covers it
+  assert(Equal(Distance(l, Point<2>(1.8f, 1.8f)), 0.8f));
+  assert(Equal(Distance(Point<2>(1.8f, 1.8f), l), 0.8f));
+  assert(Equal(Distance(l, Ball<2>(Point<2>(1.8f, 1.8f), 0.5f)), 0.3f));
+  assert(Distance(l, Point<2>(0.5f, 2)) == 0);
+  assert(DistanceLessThan(l, Point<2>(1.8f, 1.8f), 0.85f));
+  assert(!DistanceLessThan(l, Point<2>(1.8f, 1.8f), 0.75f));
+
+  for(int i = 0; i < 200; ++i) {
+    Point<2> p = random_point<2>(rand);
+    Point<2> c1, c2;
+    CoordType dist = ClosestPoints(l, p, c1, c2);
+    assert(std::fabs(dist - brute_distance(l, p)) < tolerance);
+    assert(c2 == p);
+    assert(Intersect(Ball<2>(c1, tolerance), l, false));
+  }
+
+  // Two L shapes, one inside the notch of the other
+  Polygon<2> l2 = l;
+  for(size_t i = 0; i < l2.numCorners(); ++i)
+    l2.moveCorner(i, Point<2>(5, 5) - (l[i] - Point<2>(0, 0)));
+  assert(Equal(Distance(l, l2), std::sqrt((CoordType) 2)));
+
+  // A triangle in the notch of a C shape: the answer mustn't depend
+  // on which polygon comes first
+  Polygon<2> c;
+  c.addCorner(0, Point<2>(0, 0));
+  c.addCorner(1, Point<2>(6, 0));
+  c.addCorner(2, Point<2>(6, 1));
+  c.addCorner(3, Point<2>(1, 1));
+  c.addCorner(4, Point<2>(1, 5));
+  c.addCorner(5, Point<2>(6, 5));
+  c.addCorner(6, Point<2>(6, 6));
+  c.addCorner(7, Point<2>(0, 6));
+  assert(!c.isConvex());
+  Polygon<2> t;
+  t.addCorner(0, Point<2>(3, 3));
+  t.addCorner(1, Point<2>(5, 2.5f));
+  t.addCorner(2, Point<2>(5, 3.5f));
+  assert(t.isConvex());
+  assert(Equal(Distance(t, c), 1.5f));
+  assert(Equal(Distance(c, t), 1.5f));
+  assert(!DistanceLessThan(t, c, 1.4f) && !DistanceLessThan(c, t, 1.4f));
+
+  // Random pairs, convex and not, in both orders
+  for(int i = 0; i < 200; ++i) {
+    Polygon<2> tri;
+    Point<2> corner = random_point<2>(rand);
+    for(int j = 0; j < 3; ++j)
+      tri.addCorner(j, Point<2>(corner[0] + random_coord(rand, -1, 1),
+                                corner[1] + random_coord(rand, -1, 1)));
+    CoordType d1 = Distance(tri, l), d2 = Distance(l, tri);
+    assert(std::fabs(d1 - d2) < tolerance);
+    for(size_t j = 0; j < tri.numCorners(); ++j)
+      assert(d1 <= brute_distance(l, tri[j]) + tolerance);
+  }
+
+  // The same L shape in a tilted plane in 3D
+  RotMatrix<3> m;
+  m.rotation(Vector<3>(1, 2, 0), 0.6f);
+  Point<3> origin(1, -2, 0.5f);
+  Polygon<3> l3;
+  for(size_t i = 0; i < l.numCorners(); ++i)
+    l3.addCorner(i, origin + Prod(Vector<3>(l[i][0], l[i][1], 0), m));
+  assert(!l3.isConvex());
+
+  Vector<3> up = Prod(Vector<3>(0, 0, 1), m);
+  Point<3> above_notch = origin + Prod(Vector<3>(2, 2, 0), m) + up;
+  Point<3> above_inside = origin + Prod(Vector<3>(0.5f, 2, 0), m) + up * 2;
+  assert(Equal(Distance(l3, above_notch), std::sqrt((CoordType) 2)));
+  assert(Equal(Distance(l3, above_inside), 2));
+  assert(Equal(Distance(l3, Segment<3>(above_notch, above_inside)), std::sqrt((CoordType) 325) / 13));
+  assert(Distance(l3, Ball<3>(above_inside, 2.5f)) == 0);
+}
+
+int main()
+{
+  MTRand rand(7);
+
+  test_random_pairs<2>(rand);
+  test_random_pairs<3>(rand);
+  test_polygons(rand);
+
+  return 0;
+}
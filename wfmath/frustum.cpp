@@ -0,0 +1,929 @@
+// frustum.cpp (Frustum<> implementation)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-17
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "frustum.h"
+#include "intersect.h"
+#include "distance.h"
+#include "quaternion.h"
+#include "rotbox_funcs.h"
+#include "intersect_many.h"
+#include "point_array_funcs.h"
+#include "simd.h"
+
+#include <algorithm>
+#include <vector>
+#include <cmath>
+
+#include <cassert>
+
+namespace WFMath {
+
+// The projections below are plain sums, rather than Dot(), which
+// rounds small values to zero, so that the vector loops in
+// IntersectMany() can make exactly the same sums.
+
+template<int dim>
+static inline CoordType _PlaneDot(const Vector<dim>& n, const Point<dim>& p)
+{
+  CoordType ans = 0;
+  for(int j = 0; j < dim; ++j)
+    ans += n[j] * p[j];
+  return ans;
+}
+
+// The lowest and highest projections of the box from low to high
+template<int dim>
+static inline void _BoxProject(const Vector<dim>& n, const Point<dim>& low,
+                               const Point<dim>& high, CoordType& lo, CoordType& hi)
+{
+  lo = hi = 0;
+  for(int j = 0; j < dim; ++j) {
+    if(n[j] > 0) {
+      lo += n[j] * low[j];
+      hi += n[j] * high[j];
+    }
+    else {
+      lo += n[j] * high[j];
+      hi += n[j] * low[j];
+    }
+  }
+}
+
+// The corners of a view in its own frame
+static void _ViewCorners(CoordType fov, CoordType aspect, CoordType near_dist,
+                         CoordType far_dist, Point<3>* corners)
+{
+  assert(0 < fov && fov < numeric_constants<CoordType>::pi());
+  assert(0 < near_dist && near_dist < far_dist);
+
+  CoordType tan_v = std::tan(fov / 2), tan_h = aspect * tan_v;
+
+  for(int i = 0; i < 8; ++i) {
+    CoordType dist = (i & 4) ? far_dist : near_dist;
+    corners[i] = Point<3>(dist, (i & 1) ? dist * tan_h : -dist * tan_h,
+                          (i & 2) ? dist * tan_v : -dist * tan_v);
+  }
+}
+
+template<>
+Frustum<3>::Frustum(const Point<3>& position, const Quaternion& orientation, CoordType fov,
+                    CoordType aspect, CoordType near_dist, CoordType far_dist)
+{
+  _ViewCorners(fov, aspect, near_dist, far_dist, m_corners);
+  for(int i = 0; i < 8; ++i)
+    m_corners[i] = m_corners[i].toParentCoords(position, orientation);
+  build();
+}
+
+template<>
+Frustum<3>::Frustum(const Point<3>& position, const RotMatrix<3>& orientation, CoordType fov,
+                    CoordType aspect, CoordType near_dist, CoordType far_dist)
+{
+  _ViewCorners(fov, aspect, near_dist, far_dist, m_corners);
+  for(int i = 0; i < 8; ++i)
+    m_corners[i] = m_corners[i].toParentCoords(position, orientation);
+  build();
+}
+
+template<>
+void Frustum<3>::build()
+{
+  Point<3> center = getCenter();
+
+  for(int k = 0; k < 3; ++k) {
+    int k1 = 1 << ((k + 1) % 3), k2 = 1 << ((k + 2) % 3);
+    for(int s = 0; s < 2; ++s) {
+      // The face runs around c0, c0 | k1, c0 | k1 | k2 and c0 | k2,
+      // and its normal is the cross product of the diagonals
+      int c0 = s << k;
+      const Point<3>& a = m_corners[c0];
+      Vector<3> d1 = m_corners[c0 | k1 | k2] - a;
+      Vector<3> d2 = m_corners[c0 | k1] - m_corners[c0 | k2];
+      Vector<3> n(d1[1] * d2[2] - d1[2] * d2[1], d1[2] * d2[0] - d1[0] * d2[2],
+                  d1[0] * d2[1] - d1[1] * d2[0]);
+
+      CoordType mag = n.mag();
+      if(mag > 0)
+        n /= mag;
+
+      CoordType side = 0;
+      for(int j = 0; j < 3; ++j)
+        side += n[j] * (center[j] - a[j]);
+      if(side > 0)
+        n = -n;
+
+      // The corners of a face may not be quite flat, so take the
+      // furthest of them
+      CoordType offset = _PlaneDot(n, a);
+      offset = std::max(offset, _PlaneDot(n, m_corners[c0 | k1]));
+      offset = std::max(offset, _PlaneDot(n, m_corners[c0 | k2]));
+      offset = std::max(offset, _PlaneDot(n, m_corners[c0 | k1 | k2]));
+
+      m_normal[2 * k + s] = n;
+      m_offset[2 * k + s] = offset;
+    }
+  }
+
+  Point<3> low = m_corners[0], high = m_corners[0];
+  for(int i = 1; i < 8; ++i) {
+    for(int j = 0; j < 3; ++j) {
+      low[j] = std::min(low[j], m_corners[i][j]);
+      high[j] = std::max(high[j], m_corners[i][j]);
+    }
+  }
+  m_bbox = AxisBox<3>(low, high, true);
+
+  buildCrossAxes();
+}
+
+// These are the edge-edge axes of the separating axis test between the
+// frustum and an AxisBox, with the projection of the frustum onto each
+
+template<>
+void Frustum<3>::buildCrossAxes()
+{
+  // The far plane's edges are parallel to the near plane's, so only
+  // two of those are needed, and then the four running from one to
+  // the other
+  Vector<3> edges[6];
+  edges[0] = m_corners[1] - m_corners[0];
+  edges[1] = m_corners[2] - m_corners[0];
+  for(int i = 0; i < 4; ++i)
+    edges[2 + i] = m_corners[4 + i] - m_corners[i];
+
+  m_num_cross = 0;
+
+  for(int e = 0; e < 6; ++e) {
+    for(int j = 0; j < 3; ++j) {
+      // Coordinate axis j crossed with the edge
+      int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+      Vector<3>& axis = m_cross_axis[m_num_cross];
+      axis[j] = 0;
+      axis[j1] = -edges[e][j2];
+      axis[j2] = edges[e][j1];
+      axis.setValid();
+
+      // An edge parallel to axis j adds nothing to the planes and the
+      // axes of the box
+      if(!(axis.sqrMag() > numeric_constants<CoordType>::epsilon()
+                           * numeric_constants<CoordType>::epsilon() * edges[e].sqrMag()))
+        continue;
+
+      CoordType low = _PlaneDot(axis, m_corners[0]), high = low;
+      for(int i = 1; i < 8; ++i) {
+        CoordType val = _PlaneDot(axis, m_corners[i]);
+        low = std::min(low, val);
+        high = std::max(high, val);
+      }
+
+      m_cross_low[m_num_cross] = low;
+      m_cross_high[m_num_cross] = high;
+      ++m_num_cross;
+    }
+  }
+}
+
+template<int dim>
+bool Frustum<dim>::isEqualTo(const Frustum<dim>& f, CoordType epsilon) const
+{
+  for(size_t i = 0; i < numCorners(); ++i)
+    if(!m_corners[i].isEqualTo(f.m_corners[i], epsilon))
+      return false;
+
+  return true;
+}
+
+template<int dim>
+bool Frustum<dim>::isValid() const
+{
+  for(size_t i = 0; i < numCorners(); ++i)
+    if(!m_corners[i].isValid())
+      return false;
+
+  return true;
+}
+
+template<int dim>
+Point<dim> Frustum<dim>::getCenter() const
+{
+  Point<dim> center;
+  center.setToOrigin();
+
+  for(size_t i = 0; i < numCorners(); ++i)
+    for(int j = 0; j < dim; ++j)
+      center[j] += m_corners[i][j];
+
+  for(int j = 0; j < dim; ++j)
+    center[j] /= numCorners();
+
+  return center;
+}
+
+template<int dim>
+Frustum<dim>& Frustum<dim>::shift(const Vector<dim>& v)
+{
+  for(size_t i = 0; i < numCorners(); ++i)
+    m_corners[i] += v;
+  build();
+  return *this;
+}
+
+template<int dim>
+Frustum<dim>& Frustum<dim>::rotatePoint(const RotMatrix<dim>& m, const Point<dim>& p)
+{
+  for(size_t i = 0; i < numCorners(); ++i)
+    m_corners[i].rotate(m, p);
+  build();
+  return *this;
+}
+
+template<>
+Frustum<3>& Frustum<3>::rotatePoint(const Quaternion& q, const Point<3>& p)
+{
+  for(size_t i = 0; i < numCorners(); ++i)
+    m_corners[i].rotate(q, p);
+  build();
+  return *this;
+}
+
+template<int dim>
+Ball<dim> Frustum<dim>::boundingSphere() const
+{
+  Point<dim> center = getCenter();
+  CoordType max_sqr = 0;
+
+  for(size_t i = 0; i < numCorners(); ++i)
+    max_sqr = std::max(max_sqr, SquaredDistance(center, m_corners[i]));
+
+  return Ball<dim>(center, std::sqrt(max_sqr));
+}
+
+template<int dim>
+Ball<dim> Frustum<dim>::boundingSphereSloppy() const
+{
+  Point<dim> center = getCenter();
+  CoordType max_mag = 0;
+
+  for(size_t i = 0; i < numCorners(); ++i)
+    max_mag = std::max(max_mag, (m_corners[i] - center).sloppyMag());
+
+  return Ball<dim>(center, max_mag);
+}
+
+template<int dim>
+bool Intersect(const Frustum<dim>& f, const Point<dim>& p, bool proper)
+{
+  for(int i = 0; i < f.numPlanes(); ++i)
+    if(_Greater(_PlaneDot(f.planeNormal(i), p), f.planeOffset(i), proper))
+      return false;
+
+  return true;
+}
+
+template<int dim>
+bool Contains(const Point<dim>& p, const Frustum<dim>& f, bool proper)
+{
+  if(proper)
+    return false;
+
+  for(size_t i = 0; i < f.numCorners(); ++i)
+    if(f.getCorner(i) != p)
+      return false;
+
+  return true;
+}
+
+// The first plane which has the whole box outside it, or -1 if there
+// isn't one. inside is set if the box is inside all of the planes.
+template<int dim>
+static int _PlaneSeparates(const Frustum<dim>& f, const Point<dim>& low,
+                           const Point<dim>& high, bool proper, bool& inside)
+{
+  inside = true;
+
+  for(int i = 0; i < f.numPlanes(); ++i) {
+    CoordType lo, hi;
+    _BoxProject(f.planeNormal(i), low, high, lo, hi);
+    if(_Greater(lo, f.planeOffset(i), proper))
+      return i;
+    if(hi > f.planeOffset(i))
+      inside = false;
+  }
+
+  return -1;
+}
+
+// True if the axis with the given number, as for SeparatingAxisCache,
+// separates the frustum and the box
+template<int dim>
+static bool _AxisSeparates(const Frustum<dim>& f, const AxisBox<dim>& b, int axis, bool proper)
+{
+  CoordType lo, hi;
+
+  if(axis < f.numPlanes()) {
+    _BoxProject(f.planeNormal(axis), b.lowCorner(), b.highCorner(), lo, hi);
+    return _Greater(lo, f.planeOffset(axis), proper);
+  }
+
+  if(axis == f.numPlanes())
+    return !Intersect(f.boundingBox(), b, proper);
+
+  int i = axis - f.numPlanes() - 1;
+  if(i >= f.numCrossAxes())
+    return false;
+
+  _BoxProject(f.crossAxis(i), b.lowCorner(), b.highCorner(), lo, hi);
+  return _Greater(lo, f.crossHigh(i), proper) || _Less(hi, f.crossLow(i), proper);
+}
+
+// The first axis which separates the frustum and the box, or -1 if
+// they intersect
+template<int dim>
+static int _SeparatingAxis(const Frustum<dim>& f, const AxisBox<dim>& b, bool proper)
+{
+  bool inside;
+  int plane = _PlaneSeparates(f, b.lowCorner(), b.highCorner(), proper, inside);
+  if(plane >= 0 || inside)
+    return plane;
+
+  for(int axis = f.numPlanes(); axis <= f.numPlanes() + f.numCrossAxes(); ++axis)
+    if(_AxisSeparates(f, b, axis, proper))
+      return axis;
+
+  return -1;
+}
+
+template<int dim>
+bool Intersect(const Frustum<dim>& f, const AxisBox<dim>& b, bool proper)
+{
+  return _SeparatingAxis(f, b, proper) < 0;
+}
+
+template<int dim>
+bool Intersect(const Frustum<dim>& f, const AxisBox<dim>& b, bool proper,
+               SeparatingAxisCache& cache)
+{
+  if(cache.axis() >= 0 && _AxisSeparates(f, b, cache.axis(), proper))
+    return false;
+
+  int axis = _SeparatingAxis(f, b, proper);
+  if(axis < 0)
+    return true;
+
+  cache.setAxis(axis);
+  return false;
+}
+
+template<int dim>
+bool Contains(const Frustum<dim>& f, const AxisBox<dim>& b, bool proper)
+{
+  for(int i = 0; i < f.numPlanes(); ++i) {
+    CoordType lo, hi;
+    _BoxProject(f.planeNormal(i), b.lowCorner(), b.highCorner(), lo, hi);
+    if(_Greater(hi, f.planeOffset(i), proper))
+      return false;
+  }
+
+  return true;
+}
+
+template<int dim>
+bool Contains(const AxisBox<dim>& b, const Frustum<dim>& f, bool proper)
+{
+  return Contains(b, f.boundingBox(), proper);
+}
+
+// As _PlaneSeparates(), for a ball
+template<int dim>
+static int _BallPlaneSeparates(const Frustum<dim>& f, const Ball<dim>& b, bool proper,
+                               bool& inside)
+{
+  inside = true;
+
+  for(int i = 0; i < f.numPlanes(); ++i) {
+    CoordType s = _PlaneDot(f.planeNormal(i), b.center()) - f.planeOffset(i);
+    if(_Greater(s, b.radius(), proper))
+      return i;
+    if(s > 0)
+      inside = false;
+  }
+
+  return -1;
+}
+
+// A ball outside none of the planes, with its center outside at least
+// one, may still miss the frustum near an edge or a corner. If the
+// center is outside just one plane, and its foot on that plane is
+// inside the others, that's the nearest point of the frustum, and
+// otherwise the distance from GJK settles it.
+template<int dim>
+static bool _BallIntersect(const Frustum<dim>& f, const Ball<dim>& b, bool proper, bool inside)
+{
+  if(inside)
+    return !proper || b.radius() > 0;
+
+  int plane = -1;
+  CoordType dist = 0;
+
+  for(int i = 0; i < f.numPlanes(); ++i) {
+    CoordType s = _PlaneDot(f.planeNormal(i), b.center()) - f.planeOffset(i);
+    if(s > 0) {
+      if(plane >= 0) {
+        plane = -1;
+        break;
+      }
+      plane = i;
+      dist = s;
+    }
+  }
+
+  if(plane >= 0 && Intersect(f, b.center() - dist * f.planeNormal(plane), false))
+    return _LessEq(dist * dist, b.radius() * b.radius(), proper);
+
+  return _LessEq(SquaredDistance(b.center(), f), b.radius() * b.radius(), proper);
+}
+
+template<int dim>
+bool Intersect(const Frustum<dim>& f, const Ball<dim>& b, bool proper)
+{
+  bool inside;
+  if(_BallPlaneSeparates(f, b, proper, inside) >= 0)
+    return false;
+
+  return _BallIntersect(f, b, proper, inside);
+}
+
+template<int dim>
+bool Intersect(const Frustum<dim>& f, const Ball<dim>& b, bool proper,
+               SeparatingAxisCache& cache)
+{
+  int axis = cache.axis();
+  if(axis >= 0 && axis < f.numPlanes()
+     && _Greater(_PlaneDot(f.planeNormal(axis), b.center()) - f.planeOffset(axis),
+                 b.radius(), proper))
+    return false;
+
+  bool inside;
+  axis = _BallPlaneSeparates(f, b, proper, inside);
+  if(axis >= 0) {
+    cache.setAxis(axis);
+    return false;
+  }
+
+  return _BallIntersect(f, b, proper, inside);
+}
+
+template<int dim>
+bool Contains(const Frustum<dim>& f, const Ball<dim>& b, bool proper)
+{
+  for(int i = 0; i < f.numPlanes(); ++i)
+    if(_Greater(_PlaneDot(f.planeNormal(i), b.center()) + b.radius(), f.planeOffset(i), proper))
+      return false;
+
+  return true;
+}
+
+template<int dim>
+bool Contains(const Ball<dim>& b, const Frustum<dim>& f, bool proper)
+{
+  for(size_t i = 0; i < f.numCorners(); ++i)
+    if(!Contains(b, f.getCorner(i), proper))
+      return false;
+
+  return true;
+}
+
+// A RotBox is tested in the frame of the frustum, rather than rotating
+// the frustum into the frame of the box, which would mean working out
+// its planes and cross axes again for each box. The axes are the same
+// ones, since rotating both shapes doesn't change their projections.
+
+// The lowest and highest projections of the RotBox onto n
+template<int dim>
+static void _RotBoxProject(const Vector<dim>& n, const RotBox<dim>& r,
+                           CoordType& lo, CoordType& hi)
+{
+  lo = hi = _PlaneDot(n, r.corner0());
+  for(int j = 0; j < dim; ++j) {
+    // Row j of the orientation is the direction of the box's axis j
+    CoordType d = 0;
+    for(int k = 0; k < dim; ++k)
+      d += n[k] * r.orientation().elem(j, k);
+    d *= r.size()[j];
+    if(d > 0)
+      hi += d;
+    else
+      lo += d;
+  }
+}
+
+// The lowest and highest projections of the frustum onto n
+template<int dim>
+static void _FrustumProject(const Frustum<dim>& f, const Vector<dim>& n,
+                            CoordType& lo, CoordType& hi)
+{
+  lo = hi = _PlaneDot(n, f.getCorner(0));
+  for(size_t i = 1; i < f.numCorners(); ++i) {
+    CoordType val = _PlaneDot(n, f.getCorner(i));
+    lo = std::min(lo, val);
+    hi = std::max(hi, val);
+  }
+}
+
+// The edges buildCrossAxes() uses, one along each of the first dim - 1
+// axes of the view, and the ones from the near plane to the far one
+template<int dim>
+static inline int _FrustumNumEdges()
+{
+  return (dim - 1) + (1 << (dim - 1));
+}
+
+template<int dim>
+static Vector<dim> _FrustumEdge(const Frustum<dim>& f, int e)
+{
+  const int half = 1 << (dim - 1);
+  if(e < dim - 1)
+    return f.getCorner(1 << e) - f.getCorner(0);
+  e -= dim - 1;
+  return f.getCorner(half + e) - f.getCorner(e);
+}
+
+// As _AxisSeparates(), for a RotBox. Cross axis e * dim + j is edge e
+// of the frustum crossed with axis j of the box, so the numbers don't
+// depend on which of them are skipped.
+template<int dim>
+static bool _RotBoxAxisSeparates(const Frustum<dim>& f, const RotBox<dim>& r, int axis,
+                                 bool proper)
+{
+  CoordType lo, hi;
+
+  if(axis < f.numPlanes()) {
+    _RotBoxProject(f.planeNormal(axis), r, lo, hi);
+    return _Greater(lo, f.planeOffset(axis), proper);
+  }
+
+  Vector<dim> u[dim];
+  for(int j = 0; j < dim; ++j) {
+    for(int k = 0; k < dim; ++k)
+      u[j][k] = r.orientation().elem(j, k);
+    u[j].setValid();
+  }
+
+  // The box's own axes, where it runs from corner0 to corner0 + size
+  if(axis == f.numPlanes()) {
+    for(int j = 0; j < dim; ++j) {
+      _FrustumProject(f, u[j], lo, hi);
+      CoordType start = _PlaneDot(u[j], r.corner0());
+      if(_Greater(lo, start + r.size()[j], proper) || _Less(hi, start, proper))
+        return true;
+    }
+    return false;
+  }
+
+  int i = axis - f.numPlanes() - 1;
+  if(i >= _FrustumNumEdges<dim>() * dim)
+    return false;
+
+  Vector<dim> edge = _FrustumEdge(f, i / dim);
+  Vector<dim> n = Cross(u[i % dim], edge);
+  // As in buildCrossAxes(), an edge parallel to the box's axis adds
+  // nothing to the other axes
+  if(!(n.sqrMag() > numeric_constants<CoordType>::epsilon()
+                    * numeric_constants<CoordType>::epsilon() * edge.sqrMag()))
+    return false;
+
+  CoordType flo, fhi;
+  _FrustumProject(f, n, flo, fhi);
+  _RotBoxProject(n, r, lo, hi);
+  return _Greater(lo, fhi, proper) || _Less(hi, flo, proper);
+}
+
+// As _SeparatingAxis(), for a RotBox
+template<int dim>
+static int _RotBoxSeparatingAxis(const Frustum<dim>& f, const RotBox<dim>& r, bool proper)
+{
+  bool inside = true;
+  for(int i = 0; i < f.numPlanes(); ++i) {
+    CoordType lo, hi;
+    _RotBoxProject(f.planeNormal(i), r, lo, hi);
+    if(_Greater(lo, f.planeOffset(i), proper))
+      return i;
+    if(hi > f.planeOffset(i))
+      inside = false;
+  }
+  if(inside)
+    return -1;
+
+  const int last = f.numPlanes() + _FrustumNumEdges<dim>() * dim;
+  for(int axis = f.numPlanes(); axis <= last; ++axis)
+    if(_RotBoxAxisSeparates(f, r, axis, proper))
+      return axis;
+
+  return -1;
+}
+
+template<int dim>
+bool Intersect(const Frustum<dim>& f, const RotBox<dim>& r, bool proper)
+{
+  return _RotBoxSeparatingAxis(f, r, proper) < 0;
+}
+
+template<int dim>
+bool Intersect(const Frustum<dim>& f, const RotBox<dim>& r, bool proper,
+               SeparatingAxisCache& cache)
+{
+  if(cache.axis() >= 0 && _RotBoxAxisSeparates(f, r, cache.axis(), proper))
+    return false;
+
+  int axis = _RotBoxSeparatingAxis(f, r, proper);
+  if(axis < 0)
+    return true;
+
+  cache.setAxis(axis);
+  return false;
+}
+
+template<int dim>
+bool Contains(const Frustum<dim>& f, const RotBox<dim>& r, bool proper)
+{
+  for(size_t i = 0; i < r.numCorners(); ++i)
+    if(!Intersect(f, r.getCorner(i), proper))
+      return false;
+
+  return true;
+}
+
+template<int dim>
+bool Contains(const RotBox<dim>& r, const Frustum<dim>& f, bool proper)
+{
+  for(size_t i = 0; i < f.numCorners(); ++i)
+    if(!Contains(r, f.getCorner(i), proper))
+      return false;
+
+  return true;
+}
+
+// The vector loops below test the planes of the frustum against a group
+// of candidates, with the same sums and comparisons as _PlaneSeparates()
+// and _BallPlaneSeparates(). Each candidate is outside a plane, inside
+// all of them, or neither, which the scalar code has to settle. The
+// loops set the bits of those inside in mask, and of those left over in
+// unsure, and return the number of candidates they processed. The
+// normals are packed plane by plane.
+
+#ifdef WFMATH_AVX_DISPATCH
+WFMATH_TARGET_AVX
+static size_t _FrustumBoxesAVX(const CoordType* normal, const CoordType* offset, int dim,
+                               const CoordType* const* lo, const CoordType* const* hi,
+                               size_t n, bool proper, unsigned* mask, unsigned* unsure)
+{
+  const __m256 eps = _mm256_set1_ps(numeric_constants<CoordType>::epsilon());
+  size_t i = 0;
+
+  for(; i + 8 <= n; i += 8) {
+    __m256 apart = _mm256_setzero_ps(), across = _mm256_setzero_ps();
+    for(int p = 0; p < 2 * dim; ++p) {
+      __m256 pl = _mm256_setzero_ps(), ph = _mm256_setzero_ps();
+      for(int j = 0; j < dim; ++j) {
+        CoordType nj = normal[p * dim + j];
+        __m256 n8 = _mm256_set1_ps(nj);
+        const CoordType* near_side = nj > 0 ? lo[j] : hi[j];
+        const CoordType* far_side = nj > 0 ? hi[j] : lo[j];
+        pl = _mm256_add_ps(pl, _mm256_mul_ps(n8, _mm256_loadu_ps(near_side + i)));
+        ph = _mm256_add_ps(ph, _mm256_mul_ps(n8, _mm256_loadu_ps(far_side + i)));
+      }
+      __m256 d = _mm256_set1_ps(offset[p]);
+      apart = _mm256_or_ps(apart, proper ? _mm256_cmp_ps(pl, d, _CMP_GE_OQ)
+                                         : _mm256_cmp_ps(_mm256_sub_ps(pl, d), eps, _CMP_GT_OQ));
+      across = _mm256_or_ps(across, _mm256_cmp_ps(ph, d, _CMP_GT_OQ));
+    }
+    unsigned a = _mm256_movemask_ps(apart), c = _mm256_movemask_ps(across);
+    mask[i / 32] |= (~a & ~c & 0xff) << (i % 32);
+    unsure[i / 32] |= (~a & c & 0xff) << (i % 32);
+  }
+  return i;
+}
+
+WFMATH_TARGET_AVX
+static size_t _FrustumBallsAVX(const CoordType* normal, const CoordType* offset, int dim,
+                               const CoordType* const* c, const CoordType* radii,
+                               size_t n, bool proper, unsigned* mask, unsigned* unsure)
+{
+  const __m256 zero = _mm256_setzero_ps();
+  const __m256 eps = _mm256_set1_ps(numeric_constants<CoordType>::epsilon());
+  size_t i = 0;
+
+  for(; i + 8 <= n; i += 8) {
+    __m256 r = _mm256_loadu_ps(radii + i);
+    __m256 apart = zero, across = zero;
+    for(int p = 0; p < 2 * dim; ++p) {
+      __m256 s = zero;
+      for(int j = 0; j < dim; ++j)
+        s = _mm256_add_ps(s, _mm256_mul_ps(_mm256_set1_ps(normal[p * dim + j]),
+                                           _mm256_loadu_ps(c[j] + i)));
+      s = _mm256_sub_ps(s, _mm256_set1_ps(offset[p]));
+      apart = _mm256_or_ps(apart, proper ? _mm256_cmp_ps(s, r, _CMP_GE_OQ)
+                                         : _mm256_cmp_ps(_mm256_sub_ps(s, r), eps, _CMP_GT_OQ));
+      across = _mm256_or_ps(across, _mm256_cmp_ps(s, zero, _CMP_GT_OQ));
+    }
+    unsigned a = _mm256_movemask_ps(apart), x = _mm256_movemask_ps(across);
+    // Inside all the planes is a hit, unless proper and the radius is zero
+    unsigned solid = proper ? _mm256_movemask_ps(_mm256_cmp_ps(r, zero, _CMP_GT_OQ)) : 0xff;
+    mask[i / 32] |= (~a & ~x & solid & 0xff) << (i % 32);
+    unsure[i / 32] |= (~a & x & 0xff) << (i % 32);
+  }
+  return i;
+}
+#endif
+
+static size_t _FrustumBoxes(const CoordType* normal, const CoordType* offset, int dim,
+                            const CoordType* const* lo, const CoordType* const* hi,
+                            size_t n, bool proper, unsigned* mask, unsigned* unsure)
+{
+  size_t i = 0;
+
+#ifdef WFMATH_AVX_DISPATCH
+  if(_CpuHasAVX())
+    i = _FrustumBoxesAVX(normal, offset, dim, lo, hi, n, proper, mask, unsure);
+#endif
+#if defined(__SSE2__)
+  const __m128 eps = _mm_set1_ps(numeric_constants<CoordType>::epsilon());
+
+  for(; i + 4 <= n; i += 4) {
+    __m128 apart = _mm_setzero_ps(), across = _mm_setzero_ps();
+    for(int p = 0; p < 2 * dim; ++p) {
+      __m128 pl = _mm_setzero_ps(), ph = _mm_setzero_ps();
+      for(int j = 0; j < dim; ++j) {
+        CoordType nj = normal[p * dim + j];
+        __m128 n4 = _mm_set1_ps(nj);
+        const CoordType* near_side = nj > 0 ? lo[j] : hi[j];
+        const CoordType* far_side = nj > 0 ? hi[j] : lo[j];
+        pl = _mm_add_ps(pl, _mm_mul_ps(n4, _mm_loadu_ps(near_side + i)));
+        ph = _mm_add_ps(ph, _mm_mul_ps(n4, _mm_loadu_ps(far_side + i)));
+      }
+      __m128 d = _mm_set1_ps(offset[p]);
+      apart = _mm_or_ps(apart, proper ? _mm_cmpge_ps(pl, d)
+                                      : _mm_cmpgt_ps(_mm_sub_ps(pl, d), eps));
+      across = _mm_or_ps(across, _mm_cmpgt_ps(ph, d));
+    }
+    unsigned a = _mm_movemask_ps(apart), c = _mm_movemask_ps(across);
+    mask[i / 32] |= (~a & ~c & 0xf) << (i % 32);
+    unsure[i / 32] |= (~a & c & 0xf) << (i % 32);
+  }
+#endif
+
+  return i;
+}
+
+static size_t _FrustumBalls(const CoordType* normal, const CoordType* offset, int dim,
+                            const CoordType* const* c, const CoordType* radii,
+                            size_t n, bool proper, unsigned* mask, unsigned* unsure)
+{
+  size_t i = 0;
+
+#ifdef WFMATH_AVX_DISPATCH
+  if(_CpuHasAVX())
+    i = _FrustumBallsAVX(normal, offset, dim, c, radii, n, proper, mask, unsure);
+#endif
+#if defined(__SSE2__)
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 eps = _mm_set1_ps(numeric_constants<CoordType>::epsilon());
+
+  for(; i + 4 <= n; i += 4) {
+    __m128 r = _mm_loadu_ps(radii + i);
+    __m128 apart = zero, across = zero;
+    for(int p = 0; p < 2 * dim; ++p) {
+      __m128 s = zero;
+      for(int j = 0; j < dim; ++j)
+        s = _mm_add_ps(s, _mm_mul_ps(_mm_set1_ps(normal[p * dim + j]), _mm_loadu_ps(c[j] + i)));
+      s = _mm_sub_ps(s, _mm_set1_ps(offset[p]));
+      apart = _mm_or_ps(apart, proper ? _mm_cmpge_ps(s, r)
+                                      : _mm_cmpgt_ps(_mm_sub_ps(s, r), eps));
+      across = _mm_or_ps(across, _mm_cmpgt_ps(s, zero));
+    }
+    unsigned a = _mm_movemask_ps(apart), x = _mm_movemask_ps(across);
+    unsigned solid = proper ? _mm_movemask_ps(_mm_cmpgt_ps(r, zero)) : 0xf;
+    mask[i / 32] |= (~a & ~x & solid & 0xf) << (i % 32);
+    unsure[i / 32] |= (~a & x & 0xf) << (i % 32);
+  }
+#endif
+
+  return i;
+}
+
+template<int dim>
+static void _PackPlanes(const Frustum<dim>& f, CoordType* normal, CoordType* offset)
+{
+  for(int p = 0; p < 2 * dim; ++p) {
+    for(int j = 0; j < dim; ++j)
+      normal[p * dim + j] = f.planeNormal(p)[j];
+    offset[p] = f.planeOffset(p);
+  }
+}
+
+template<int dim>
+size_t IntersectMany(const Frustum<dim>& f, const PointArray<dim>& lows,
+                     const PointArray<dim>& highs, bool proper, unsigned* mask)
+{
+  assert(lows.size() == highs.size());
+
+  const size_t n = lows.size();
+  std::fill(mask, mask + (n + 31) / 32, 0u);
+  std::vector<unsigned> unsure((n + 31) / 32);
+
+  CoordType normal[2 * dim * dim], offset[2 * dim];
+  _PackPlanes(f, normal, offset);
+
+  const CoordType* lo[dim];
+  const CoordType* hi[dim];
+  for(int j = 0; j < dim; ++j) {
+    lo[j] = lows.elements(j);
+    hi[j] = highs.elements(j);
+  }
+
+  size_t done = _FrustumBoxes(normal, offset, dim, lo, hi, n, proper, mask,
+                              unsure.empty() ? 0 : &unsure[0]);
+
+  for(size_t i = 0; i < n; ++i)
+    if((i >= done || IntersectManyHit(&unsure[0], i))
+       && Intersect(f, AxisBox<dim>(lows.get(i), highs.get(i), true), proper))
+      mask[i / 32] |= 1u << (i % 32);
+
+  return _CountHits(mask, n);
+}
+
+template<int dim>
+size_t IntersectMany(const Frustum<dim>& f, const PointArray<dim>& centers,
+                     const CoordType* radii, bool proper, unsigned* mask)
+{
+  const size_t n = centers.size();
+  std::fill(mask, mask + (n + 31) / 32, 0u);
+  std::vector<unsigned> unsure((n + 31) / 32);
+
+  CoordType normal[2 * dim * dim], offset[2 * dim];
+  _PackPlanes(f, normal, offset);
+
+  const CoordType* c[dim];
+  for(int j = 0; j < dim; ++j)
+    c[j] = centers.elements(j);
+
+  size_t done = _FrustumBalls(normal, offset, dim, c, radii, n, proper, mask,
+                              unsure.empty() ? 0 : &unsure[0]);
+
+  for(size_t i = 0; i < n; ++i)
+    if((i >= done || IntersectManyHit(&unsure[0], i))
+       && Intersect(f, Ball<dim>(centers.get(i), radii[i]), proper))
+      mask[i / 32] |= 1u << (i % 32);
+
+  return _CountHits(mask, n);
+}
+
+template class Frustum<3>;
+
+template bool Intersect<3>(const Frustum<3>&, const Point<3>&, bool);
+template bool Contains<3>(const Point<3>&, const Frustum<3>&, bool);
+template bool Intersect<3>(const Frustum<3>&, const AxisBox<3>&, bool);
+template bool Contains<3>(const Frustum<3>&, const AxisBox<3>&, bool);
+template bool Contains<3>(const AxisBox<3>&, const Frustum<3>&, bool);
+template bool Intersect<3>(const Frustum<3>&, const Ball<3>&, bool);
+template bool Contains<3>(const Frustum<3>&, const Ball<3>&, bool);
+template bool Contains<3>(const Ball<3>&, const Frustum<3>&, bool);
+template bool Intersect<3>(const Frustum<3>&, const RotBox<3>&, bool);
+template bool Contains<3>(const Frustum<3>&, const RotBox<3>&, bool);
+template bool Contains<3>(const RotBox<3>&, const Frustum<3>&, bool);
+
+template bool Intersect<3>(const Frustum<3>&, const AxisBox<3>&, bool, SeparatingAxisCache&);
+template bool Intersect<3>(const Frustum<3>&, const Ball<3>&, bool, SeparatingAxisCache&);
+template bool Intersect<3>(const Frustum<3>&, const RotBox<3>&, bool, SeparatingAxisCache&);
+
+template size_t IntersectMany<3>(const Frustum<3>&, const PointArray<3>&,
+                                 const PointArray<3>&, bool, unsigned*);
+template size_t IntersectMany<3>(const Frustum<3>&, const PointArray<3>&,
+                                 const CoordType*, bool, unsigned*);
+
+} // namespace WFMath
@@ -0,0 +1,277 @@
+// frustum.h (A view frustum, for culling against bounding volumes)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-17
+
+#ifndef WFMATH_FRUSTUM_H
+#define WFMATH_FRUSTUM_H
+
+#include <wfmath/const.h>
+#include <wfmath/vector.h>
+#include <wfmath/point.h>
+#include <wfmath/rotmatrix.h>
+#include <wfmath/axisbox.h>
+#include <wfmath/ball.h>
+#include <wfmath/rotbox.h>
+#include <wfmath/intersect_decls.h>
+#include <wfmath/point_array.h>
+
+#include <cstddef>
+
+namespace WFMath {
+
+/// The part of space a perspective view can see
+/**
+ * A frustum is the pyramid between a near and a far plane, with its
+ * apex at the viewer. It's bounded by 2 * dim planes, and has 2^dim
+ * corners. Only Frustum<3> is instantiated, since it's built from a
+ * 3D view.
+ *
+ * The view looks along the x axis of its frame, with z up. Corners 0
+ * to 3 are on the near plane, and 4 to 7 on the far one. Bit 0 of the
+ * index of a corner is set for those on the positive y side of the
+ * frame, bit 1 for those on the positive z side, and bit 2 for those
+ * on the far plane. Plane 2 * k + s is the face holding the corners
+ * with bit k of their index equal to s, so planes 0 to 3 are the
+ * sides, 4 is the near plane and 5 the far one.
+ *
+ * Each plane is kept as its unit outward normal and an offset, and a
+ * point p is on the inside of plane i when the sum over j of
+ * planeNormal(i)[j] * p[j] is no more than planeOffset(i).
+ *
+ * This class implements the movement and bounding functions of the
+ * shape interface, as described in the fake class Shape, and the
+ * Intersect() and Contains() functions below.
+ **/
+template<int dim = 3>
+class Frustum
+{
+ public:
+  /// Construct an uninitialized frustum
+  Frustum() : m_num_cross(0) {}
+  /// 3D only: construct the frustum of a view
+  /**
+   * The viewer is at position, and orientation rotates the frame of
+   * the view into the parent frame, as for Point::toParentCoords().
+   * fov is the angle between the top and bottom planes, in radians,
+   * and must be less than pi. aspect is the width of the view over
+   * its height, and near_dist and far_dist are the distances to the
+   * near and far planes, with 0 < near_dist < far_dist.
+   **/
+  Frustum(const Point<dim>& position, const Quaternion& orientation, CoordType fov,
+          CoordType aspect, CoordType near_dist, CoordType far_dist);
+  /// 3D only: construct the frustum of a view, with a RotMatrix orientation
+  Frustum(const Point<dim>& position, const RotMatrix<dim>& orientation, CoordType fov,
+          CoordType aspect, CoordType near_dist, CoordType far_dist);
+
+  bool isEqualTo(const Frustum& f, CoordType epsilon = numeric_constants<CoordType>::epsilon()) const;
+
+  bool operator==(const Frustum& f) const	{return isEqualTo(f);}
+  bool operator!=(const Frustum& f) const	{return !isEqualTo(f);}
+
+  bool isValid() const;
+
+  // Descriptive characteristics
+
+  size_t numCorners() const {return 1 << dim;}
+  const Point<dim>& getCorner(size_t i) const	{return m_corners[i];}
+  Point<dim> getCenter() const;
+
+  /// The number of bounding planes, 2 * dim
+  int numPlanes() const {return 2 * dim;}
+  /// The unit outward normal of plane i
+  const Vector<dim>& planeNormal(int i) const	{return m_normal[i];}
+  /// The largest value of Dot(planeNormal(i), p - origin) over the frustum
+  CoordType planeOffset(int i) const		{return m_offset[i];}
+
+  /// The number of edge-edge separating axes used by Intersect() with a box
+  /**
+   * These are the cross products of the edges of the frustum with the
+   * coordinate axes, leaving out any which are parallel. There are at
+   * most 18.
+   **/
+  int numCrossAxes() const {return m_num_cross;}
+  /// Cross axis i, not normalized
+  const Vector<dim>& crossAxis(int i) const	{return m_cross_axis[i];}
+  /// The lowest projection of the frustum onto crossAxis(i)
+  CoordType crossLow(int i) const		{return m_cross_low[i];}
+  /// The highest projection of the frustum onto crossAxis(i)
+  CoordType crossHigh(int i) const		{return m_cross_high[i];}
+
+  // Movement functions
+
+  Frustum& shift(const Vector<dim>& v);
+  Frustum& moveCornerTo(const Point<dim>& p, size_t corner)
+  {return shift(p - getCorner(corner));}
+  Frustum& moveCenterTo(const Point<dim>& p)
+  {return shift(p - getCenter());}
+
+  Frustum& rotateCorner(const RotMatrix<dim>& m, size_t corner)
+  {return rotatePoint(m, getCorner(corner));}
+  Frustum& rotateCenter(const RotMatrix<dim>& m)
+  {return rotatePoint(m, getCenter());}
+  Frustum& rotatePoint(const RotMatrix<dim>& m, const Point<dim>& p);
+
+  // 3D rotation functions
+  Frustum& rotateCorner(const Quaternion& q, size_t corner)
+  {return rotatePoint(q, getCorner(corner));}
+  Frustum& rotateCenter(const Quaternion& q)
+  {return rotatePoint(q, getCenter());}
+  Frustum& rotatePoint(const Quaternion& q, const Point<dim>& p);
+
+  // Intersection functions
+
+  const AxisBox<dim>& boundingBox() const {return m_bbox;}
+  Ball<dim> boundingSphere() const;
+  Ball<dim> boundingSphereSloppy() const;
+
+ private:
+  // Work out the planes, bounding box and cross axes from the corners
+  void build();
+  void buildCrossAxes();
+
+  Point<dim> m_corners[1 << dim];
+  Vector<dim> m_normal[2 * dim];
+  CoordType m_offset[2 * dim];
+  AxisBox<dim> m_bbox;
+
+  // One edge along each of the first dim - 1 axes of the frame, and
+  // the 2^(dim - 1) edges from the near plane to the far one, each
+  // crossed with the dim coordinate axes
+  enum {maxCrossAxes = ((dim - 1) + (1 << (dim - 1))) * dim};
+  int m_num_cross;
+  Vector<dim> m_cross_axis[maxCrossAxes];
+  CoordType m_cross_low[maxCrossAxes], m_cross_high[maxCrossAxes];
+};
+
+template<>
+Frustum<3>::Frustum(const Point<3>& position, const Quaternion& orientation, CoordType fov,
+                    CoordType aspect, CoordType near_dist, CoordType far_dist);
+template<>
+Frustum<3>::Frustum(const Point<3>& position, const RotMatrix<3>& orientation, CoordType fov,
+                    CoordType aspect, CoordType near_dist, CoordType far_dist);
+template<>
+Frustum<3>& Frustum<3>::rotatePoint(const Quaternion& q, const Point<3>& p);
+template<>
+void Frustum<3>::build();
+template<>
+void Frustum<3>::buildCrossAxes();
+
+/// The corner of a frustum which is furthest in the direction dir
+/**
+ * This lets GJKIntersect(), Distance() and the other GJK functions
+ * take a Frustum.
+ **/
+template<int dim>
+Point<dim> Support(const Frustum<dim>& f, const Vector<dim>& dir)
+{
+  size_t best = 0;
+  CoordType best_dot = 0;
+  for(size_t i = 1; i < f.numCorners(); ++i) {
+    CoordType d = 0;
+    for(int j = 0; j < dim; ++j)
+      d += (f.getCorner(i)[j] - f.getCorner(0)[j]) * dir[j];
+    if(d > best_dot) {
+      best_dot = d;
+      best = i;
+    }
+  }
+  return f.getCorner(best);
+}
+
+// Intersect() with a box is a separating axis test, which tries the
+// planes of the frustum first, since they settle most boxes, then the
+// axes of the box, then the cross axes. A ball is tested against the
+// planes, and one which is outside none of them but has its center
+// outside some is settled by its distance from the frustum, found by
+// GJK, since it may still miss the frustum near an edge.
+
+template<int dim>
+bool Intersect(const Frustum<dim>& f, const Point<dim>& p, bool proper);
+template<int dim>
+bool Contains(const Point<dim>& p, const Frustum<dim>& f, bool proper);
+
+template<int dim>
+bool Intersect(const Frustum<dim>& f, const AxisBox<dim>& b, bool proper);
+template<int dim>
+bool Contains(const Frustum<dim>& f, const AxisBox<dim>& b, bool proper);
+template<int dim>
+bool Contains(const AxisBox<dim>& b, const Frustum<dim>& f, bool proper);
+
+template<int dim>
+bool Intersect(const Frustum<dim>& f, const Ball<dim>& b, bool proper);
+template<int dim>
+bool Contains(const Frustum<dim>& f, const Ball<dim>& b, bool proper);
+template<int dim>
+bool Contains(const Ball<dim>& b, const Frustum<dim>& f, bool proper);
+
+template<int dim>
+bool Intersect(const Frustum<dim>& f, const RotBox<dim>& r, bool proper);
+template<int dim>
+bool Contains(const Frustum<dim>& f, const RotBox<dim>& r, bool proper);
+template<int dim>
+bool Contains(const RotBox<dim>& r, const Frustum<dim>& f, bool proper);
+
+// Plane coherency: a shape which was outside the frustum last frame is
+// usually outside the same plane this frame. Given a cache, these try
+// the axis in it first, and record the one which rejects the shape.
+// The axes are numbered 0 to 2 * dim - 1 for the planes, 2 * dim for
+// the axes of the box, and 2 * dim + 1 + i for cross axis i. A Ball is
+// only ever rejected by a plane, or by its distance from the frustum,
+// which isn't recorded. For a RotBox, 2 * dim stands for the box's own
+// axes, and 2 * dim + 1 + e * dim + j for edge e of the frustum, as for
+// the cross axes, crossed with axis j of the box.
+
+template<int dim>
+bool Intersect(const Frustum<dim>& f, const AxisBox<dim>& b, bool proper,
+               SeparatingAxisCache& cache);
+template<int dim>
+bool Intersect(const Frustum<dim>& f, const Ball<dim>& b, bool proper,
+               SeparatingAxisCache& cache);
+template<int dim>
+bool Intersect(const Frustum<dim>& f, const RotBox<dim>& r, bool proper,
+               SeparatingAxisCache& cache);
+
+/// Intersect() for a Frustum and many AxisBoxes
+/**
+ * This works like IntersectMany() for an AxisBox, with the candidates
+ * and the mask laid out the same way. The planes are tested against
+ * eight boxes at a time with AVX, or four with SSE2, and only the
+ * boxes which cross a plane without being outside any go on to the
+ * rest of the test, one at a time. Each bit is exactly what Intersect()
+ * gives. Returns the number of boxes which intersect the frustum.
+ **/
+template<int dim>
+size_t IntersectMany(const Frustum<dim>& f, const PointArray<dim>& lows,
+                     const PointArray<dim>& highs, bool proper, unsigned* mask);
+
+/// Intersect() for a Frustum and many Balls
+/**
+ * This works like IntersectMany() for a Frustum and many AxisBoxes.
+ **/
+template<int dim>
+size_t IntersectMany(const Frustum<dim>& f, const PointArray<dim>& centers,
+                     const CoordType* radii, bool proper, unsigned* mask);
+
+} // namespace WFMath
+
+#endif  // WFMATH_FRUSTUM_H
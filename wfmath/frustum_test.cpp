@@ -0,0 +1,357 @@
+// frustum_test.cpp (Frustum<> test functions)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-17
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#ifndef DEBUG
+#define DEBUG
+#endif
+
+#include "const.h"
+#include "vector.h"
+#include "point.h"
+#include "rotmatrix.h"
+#include "quaternion.h"
+#include "axisbox.h"
+#include "ball.h"
+#include "rotbox.h"
+#include "frustum.h"
+#include "intersect.h"
+#include "intersect_many.h"
+#include "distance.h"
+#include "point_array.h"
+#include "randgen.h"
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+#include <cassert>
+
+using namespace WFMath;
+
+// Shapes further apart than this must miss, and shapes which still
+// meet when shrunk by it must hit
+static const CoordType margin = 1e-3f;
+
+static CoordType random_coord(MTRand& rand, CoordType low, CoordType high)
+{
+  return low + (high - low) * (CoordType) rand.rand();
+}
+
+static Point<3> random_point(MTRand& rand, CoordType size)
+{
+  return Point<3>(random_coord(rand, -size, size), random_coord(rand, -size, size),
+                  random_coord(rand, -size, size));
+}
+
+static Quaternion random_orientation(MTRand& rand)
+{
+  Vector<3> axis = random_point(rand, 1) - Point<3>(0, 0, 0);
+  if(axis.sqrMag() < 0.01f)
+    axis = Vector<3>(0, 0, 1);
+  return Quaternion(axis.normalize(), random_coord(rand, 0, 6.2f));
+}
+
+static Frustum<3> random_frustum(MTRand& rand)
+{
+  return Frustum<3>(random_point(rand, 2), random_orientation(rand),
+                    random_coord(rand, 0.3f, 2), random_coord(rand, 0.5f, 2),
+                    random_coord(rand, 0.1f, 1), random_coord(rand, 2, 6));
+}
+
+static AxisBox<3> shrink(const AxisBox<3>& b)
+{
+  Vector<3> d(margin, margin, margin);
+  return AxisBox<3>(b.lowCorner() + d, b.highCorner() - d, true);
+}
+
+static RotBox<3> shrink(const RotBox<3>& r)
+{
+  Vector<3> d(margin, margin, margin);
+  return RotBox<3>(r.corner0() + d * r.orientation(), r.size() - 2 * d, r.orientation());
+}
+
+static void test_exact()
+{
+  std::cout << "Testing a fixed frustum" << std::endl;
+
+  // A square view along x, with its corners at (1, +-1, +-1) and
+  // (10, +-10, +-10)
+  Frustum<3> f(Point<3>(0, 0, 0), Quaternion(Quaternion::Identity()),
+               numeric_constants<CoordType>::pi() / 2, 1, 1, 10);
+
+  assert(f.isValid());
+  assert(f.numCorners() == 8 && f.numPlanes() == 6);
+  assert(f.getCorner(0).isEqualTo(Point<3>(1, -1, -1), 1e-5f));
+  assert(f.getCorner(3).isEqualTo(Point<3>(1, 1, 1), 1e-5f));
+  assert(f.getCorner(5).isEqualTo(Point<3>(10, 10, -10), 1e-5f));
+  assert(f.planeNormal(4).isEqualTo(Vector<3>(-1, 0, 0)));
+  assert(f.planeNormal(5).isEqualTo(Vector<3>(1, 0, 0)));
+  assert(std::fabs(f.planeOffset(5) - 10) < 1e-5f);
+  assert(f.boundingBox().isEqualTo(AxisBox<3>(Point<3>(1, -10, -10), Point<3>(10, 10, 10)),
+                                   1e-5f));
+
+  RotMatrix<3> m;
+  Frustum<3> g(Point<3>(0, 0, 0), m.identity(), numeric_constants<CoordType>::pi() / 2,
+               1, 1, 10);
+  assert(f == g);
+
+  assert(Intersect(f, Point<3>(5, 0, 0), true));
+  assert(!Intersect(f, Point<3>(5, 6, 0), false));
+  assert(!Intersect(f, Point<3>(0.5f, 0, 0), false));
+  assert(!Intersect(f, Point<3>(11, 0, 0), false));
+  // On the far plane
+  assert(Intersect(f, Point<3>(10, 0, 0), false));
+  assert(!Intersect(f, Point<3>(10, 0, 0), true));
+
+  // Across the positive y side, and touching the far plane
+  SeparatingAxisCache cache;
+  assert(Intersect(f, AxisBox<3>(Point<3>(4, 4, -1), Point<3>(6, 6, 1)), false));
+  assert(Intersect(f, AxisBox<3>(Point<3>(4, 4, -1), Point<3>(6, 6, 1)), true, cache));
+  assert(cache.axis() == -1);
+  assert(Intersect(f, AxisBox<3>(Point<3>(10, -1, -1), Point<3>(12, 1, 1)), false));
+  assert(!Intersect(f, AxisBox<3>(Point<3>(10, -1, -1), Point<3>(12, 1, 1)), true, cache));
+  assert(cache.axis() == 5);
+  assert(!Intersect(f, AxisBox<3>(Point<3>(-2, -1, -1), Point<3>(0, 1, 1)), false, cache));
+  assert(cache.axis() == 4);
+
+  assert(Contains(f, AxisBox<3>(Point<3>(4, -1, -1), Point<3>(6, 1, 1)), true));
+  assert(!Contains(f, AxisBox<3>(Point<3>(4, 3, -1), Point<3>(6, 5, 1)), false));
+  assert(Contains(AxisBox<3>(Point<3>(1, -10, -10), Point<3>(10, 10, 10)), f, false));
+  assert(!Contains(AxisBox<3>(Point<3>(1, -10, -10), Point<3>(10, 10, 10)), f, true));
+
+  assert(Intersect(f, Ball<3>(Point<3>(5, 0, 0), 1), true));
+  assert(Contains(f, Ball<3>(Point<3>(5, 0, 0), 1), true));
+  // 5 / sqrt(2) from the sides
+  assert(!Contains(f, Ball<3>(Point<3>(5, 0, 0), 4), false));
+  assert(!Intersect(f, Ball<3>(Point<3>(-1, 0, 0), 1.5f), false));
+  assert(Intersect(f, Ball<3>(Point<3>(-1, 0, 0), 2.5f), false));
+  // Outside none of the planes, but off the corner at (1, 1, 1)
+  assert(!Intersect(f, Ball<3>(Point<3>(0.5f, 1.5f, 1.5f), 0.8f), false));
+  assert(Intersect(f, Ball<3>(Point<3>(0.5f, 1.5f, 1.5f), 0.9f), false));
+  assert(!Contains(Ball<3>(Point<3>(5.5f, 0, 0), 10), f, false));
+  assert(Contains(Ball<3>(Point<3>(5.5f, 0, 0), 15), f, false));
+
+  // A box turned 45 degrees about x, well inside
+  Quaternion q(0, numeric_constants<CoordType>::pi() / 4);
+  RotMatrix<3> qm;
+  qm.fromQuaternion(q);
+  RotBox<3> r(Point<3>(5, -1, -1), Vector<3>(1, 2, 2), qm);
+  assert(Intersect(f, r, true));
+  assert(Contains(f, r, true));
+
+  Frustum<3> moved(f);
+  moved.shift(Vector<3>(1, 2, 3));
+  assert(moved.getCorner(0).isEqualTo(Point<3>(2, 1, 2), 1e-5f));
+  assert(Intersect(moved, Point<3>(6, 2, 3), true));
+  moved.rotatePoint(q, moved.getCorner(0));
+  assert(moved.getCorner(0).isEqualTo(Point<3>(2, 1, 2), 1e-5f));
+}
+
+static void test_random(MTRand& rand)
+{
+  std::cout << "Testing random frusta against boxes and balls" << std::endl;
+
+  int hits = 0, misses = 0, cached_misses = 0;
+
+  for(int k = 0; k < 200; ++k) {
+    Frustum<3> f = random_frustum(rand);
+
+    // A Quaternion and the matching RotMatrix give the same frustum
+    Quaternion q = random_orientation(rand);
+    RotMatrix<3> m;
+    m.fromQuaternion(q);
+    Frustum<3> fq(f), fm(f);
+    fq.rotatePoint(q, Point<3>(1, 2, 3));
+    fm.rotatePoint(m, Point<3>(1, 2, 3));
+    assert(fq.isEqualTo(fm, 1e-4f));
+
+    // A stale cache, carried from one shape to the next
+    SeparatingAxisCache box_cache, ball_cache, rot_cache;
+
+    for(int n = 0; n < 50; ++n) {
+      Point<3> low = random_point(rand, 8);
+      AxisBox<3> box(low, low + Vector<3>(random_coord(rand, 0.01f, 3),
+                                          random_coord(rand, 0.01f, 3),
+                                          random_coord(rand, 0.01f, 3)), true);
+      Ball<3> ball(random_point(rand, 8), random_coord(rand, 0.01f, 2));
+      RotBox<3> rot(random_point(rand, 8),
+                    Vector<3>(random_coord(rand, 0.01f, 3), random_coord(rand, 0.01f, 3),
+                              random_coord(rand, 0.01f, 3)),
+                    RotMatrix<3>().fromQuaternion(random_orientation(rand)));
+
+      for(int j = 0; j < 2; ++j) {
+        bool proper = (j == 1);
+
+        bool got = Intersect(f, box, proper);
+        assert(got == Intersect(f, box, proper, box_cache));
+        if(Distance(f, box) > margin)
+          assert(!got);
+        if(Distance(f, shrink(box)) < 1e-5f)
+          assert(got);
+        hits += got;
+        misses += !got;
+        cached_misses += !got && box_cache.axis() >= 0;
+
+        got = Intersect(f, ball, proper);
+        assert(got == Intersect(f, ball, proper, ball_cache));
+        if(Distance(f, ball) > margin)
+          assert(!got);
+        if(Distance(f, Ball<3>(ball.center(), ball.radius() - margin)) < 1e-5f)
+          assert(got);
+        hits += got;
+        misses += !got;
+
+        got = Intersect(f, rot, proper);
+        assert(got == Intersect(f, rot, proper, rot_cache));
+        // Asking again finds the same answer, by the axis just cached
+        int axis = rot_cache.axis();
+        assert(got == Intersect(f, rot, proper, rot_cache));
+        assert(rot_cache.axis() == axis);
+        if(Distance(f, rot) > margin)
+          assert(!got);
+        if(Distance(f, shrink(rot)) < 1e-5f)
+          assert(got);
+        hits += got;
+        misses += !got;
+
+        // Containment is the same as containing all of the corners
+        bool all_in = true;
+        for(size_t i = 0; i < box.numCorners(); ++i)
+          all_in = all_in && Intersect(f, box.getCorner(i), proper);
+        assert(Contains(f, box, proper) == all_in);
+
+        bool box_holds = true, ball_holds = true;
+        for(size_t i = 0; i < f.numCorners(); ++i) {
+          box_holds = box_holds && Contains(box, f.getCorner(i), proper);
+          ball_holds = ball_holds && Contains(ball, f.getCorner(i), proper);
+        }
+        assert(Contains(box, f, proper) == box_holds);
+        assert(Contains(ball, f, proper) == ball_holds);
+
+        if(Contains(f, ball, proper))
+          assert(Intersect(f, ball, proper));
+      }
+    }
+  }
+
+  assert(hits > 1000 && misses > 1000 && cached_misses > 100);
+
+  // A RotBox drifting past a frustum, frame by frame, where the cache
+  // carries the axis which last rejected it
+  int frames_out = 0, cross_misses = 0;
+  for(int k = 0; k < 50; ++k) {
+    Frustum<3> f = random_frustum(rand);
+    RotBox<3> rot(random_point(rand, 8),
+                  Vector<3>(random_coord(rand, 0.01f, 3), random_coord(rand, 0.01f, 3),
+                            random_coord(rand, 0.01f, 3)),
+                  RotMatrix<3>().fromQuaternion(random_orientation(rand)));
+    Vector<3> step = (random_point(rand, 8) - rot.corner0()) / 40;
+    SeparatingAxisCache cache;
+
+    for(int frame = 0; frame < 40; ++frame) {
+      bool got = Intersect(f, rot, false);
+      assert(got == Intersect(f, rot, false, cache));
+      frames_out += !got;
+      cross_misses += !got && cache.axis() > f.numPlanes();
+      rot.shift(step);
+    }
+  }
+  assert(frames_out > 100 && cross_misses > 0);
+}
+
+static void test_many(MTRand& rand)
+{
+  std::cout << "Testing a frustum against many candidates" << std::endl;
+
+  // Sizes on both sides of the SIMD widths and the mask words
+  const size_t sizes[] = {0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 200};
+
+  int hits = 0;
+
+  for(int k = 0; k < 10; ++k) {
+    Frustum<3> f = random_frustum(rand);
+
+    for(size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+      size_t n = sizes[s];
+      PointArray<3> lows, highs, centers;
+      std::vector<CoordType> radii;
+
+      for(size_t i = 0; i < n; ++i) {
+        Point<3> low = random_point(rand, 6);
+        lows.push_back(low);
+        highs.push_back(low + Vector<3>(random_coord(rand, 0, 2), random_coord(rand, 0, 2),
+                                        random_coord(rand, 0, 2)));
+        centers.push_back(random_point(rand, 6));
+        // Some points, which never intersect properly
+        radii.push_back(rand.randInt(7) == 0 ? 0 : random_coord(rand, 0, 2));
+      }
+
+      for(int j = 0; j < 2; ++j) {
+        bool proper = (j == 1);
+        std::vector<unsigned> mask((n + 31) / 32 + 1, ~0u);
+
+        size_t count = IntersectMany(f, lows, highs, proper, &mask[0]), expected = 0;
+        for(size_t i = 0; i < n; ++i) {
+          bool got = Intersect(f, AxisBox<3>(lows.get(i), highs.get(i), true), proper);
+          assert(IntersectManyHit(&mask[0], i) == got);
+          expected += got;
+        }
+        assert(count == expected);
+        if(n % 32 != 0)
+          assert((mask[n / 32] >> (n % 32)) == 0);
+        assert(mask.back() == ~0u);
+        hits += count;
+
+        count = IntersectMany(f, centers, radii.empty() ? 0 : &radii[0], proper, &mask[0]);
+        expected = 0;
+        for(size_t i = 0; i < n; ++i) {
+          bool got = Intersect(f, Ball<3>(centers.get(i), radii[i]), proper);
+          assert(IntersectManyHit(&mask[0], i) == got);
+          expected += got;
+        }
+        assert(count == expected);
+        if(n % 32 != 0)
+          assert((mask[n / 32] >> (n % 32)) == 0);
+        assert(mask.back() == ~0u);
+        hits += count;
+      }
+    }
+  }
+
+  assert(hits > 1000);
+}
+
+int main()
+{
+  MTRand rand(20);
+
+  test_exact();
+  test_random(rand);
+  test_many(rand);
+
+  return 0;
+}
@@ -0,0 +1,593 @@
+// gjk.cpp (Distance and penetration queries between convex shapes, by GJK and EPA)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gjk.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include <cmath>
+
+namespace WFMath {
+
+template<int dim>
+bool _GJKSimplex<dim>::add(const Point<dim>& p1, const Point<dim>& p2,
+                           const Vector<dim>& dir)
+{
+  Vector<dim> w = p1 - p2;
+  CoordType eps = numeric_constants<CoordType>::epsilon();
+
+  for(int i = 0; i < m_size; ++i)
+    if((w - m_w[i]).sqrMag() <= eps * eps * w.sqrMag())
+      return false;
+
+  m_w[m_size] = w;
+  m_dir[m_size] = dir;
+  m_p1[m_size] = p1;
+  m_p2[m_size] = p2;
+  m_lambda[m_size] = 0;
+  ++m_size;
+  return true;
+}
+
+template<int dim>
+Vector<dim> _GJKSimplex<dim>::reduce()
+{
+  // The closest point of the simplex to the origin is in the interior
+  // of one face (or edge, or vertex), and is the closest point of the
+  // affine hull of that face. So it's the closest of the affine hull
+  // points whose barycentric coordinates are all positive. There are
+  // at most 15 faces to try in 3D. This is done in double, since the
+  // Gram matrices of thin faces are badly conditioned.
+  double best_sqr = std::numeric_limits<double>::max();
+  double best_lambda[dim + 1];
+  int best_idx[dim + 1], best_count = 0;
+
+  for(int mask = 1; mask < (1 << m_size); ++mask) {
+    // A nonzero mask always writes idx[0], but the compiler can't tell
+    int idx[dim + 1] = {0}, count = 0;
+    for(int i = 0; i < m_size; ++i)
+      if(mask & (1 << i))
+        idx[count++] = i;
+
+    // Solve for the coordinates mu of the closest point
+    // w0 + sum(mu_i * (w_i - w0)) of the affine hull
+    double e[dim][dim], w0[dim];
+    for(int j = 0; j < dim; ++j)
+      w0[j] = m_w[idx[0]][j];
+    for(int i = 1; i < count; ++i)
+      for(int j = 0; j < dim; ++j)
+        e[i - 1][j] = (double) m_w[idx[i]][j] - w0[j];
+
+    const int n = count - 1;
+    double gram[dim][dim + 1], max_diag = 0;
+    for(int i = 0; i < n; ++i) {
+      for(int j = 0; j < n; ++j) {
+        gram[i][j] = 0;
+        for(int k = 0; k < dim; ++k)
+          gram[i][j] += e[i][k] * e[j][k];
+      }
+      gram[i][n] = 0;
+      for(int k = 0; k < dim; ++k)
+        gram[i][n] -= e[i][k] * w0[k];
+      if(gram[i][i] > max_diag)
+        max_diag = gram[i][i];
+    }
+
+    // Gaussian elimination with partial pivoting
+    bool degenerate = false;
+    for(int i = 0; i < n && !degenerate; ++i) {
+      int pivot = i;
+      for(int j = i + 1; j < n; ++j)
+        if(std::fabs(gram[j][i]) > std::fabs(gram[pivot][i]))
+          pivot = j;
+      if(std::fabs(gram[pivot][i]) <= 1e-12 * max_diag) {
+        degenerate = true;
+        break;
+      }
+      if(pivot != i)
+        for(int k = 0; k <= n; ++k)
+          std::swap(gram[i][k], gram[pivot][k]);
+      for(int j = i + 1; j < n; ++j) {
+        double f = gram[j][i] / gram[i][i];
+        for(int k = i; k <= n; ++k)
+          gram[j][k] -= f * gram[i][k];
+      }
+    }
+    if(degenerate)
+      continue;
+
+    double lambda[dim + 1], sum = 0;
+    bool inside = true;
+    for(int i = n - 1; i >= 0; --i) {
+      double mu = gram[i][n];
+      for(int k = i + 1; k < n; ++k)
+        mu -= gram[i][k] * lambda[k + 1];
+      mu /= gram[i][i];
+      lambda[i + 1] = mu;
+      sum += mu;
+      inside = inside && mu > 0;
+    }
+    lambda[0] = 1 - sum;
+    if(!inside || !(lambda[0] > 0))
+      continue;
+
+    double sqr = 0;
+    for(int k = 0; k < dim; ++k) {
+      double v = w0[k];
+      for(int i = 0; i < n; ++i)
+        v += lambda[i + 1] * e[i][k];
+      sqr += v * v;
+    }
+
+    if(sqr < best_sqr || (sqr == best_sqr && count < best_count)) {
+      best_sqr = sqr;
+      best_count = count;
+      for(int i = 0; i < count; ++i) {
+        best_idx[i] = idx[i];
+        best_lambda[i] = lambda[i];
+      }
+    }
+  }
+
+  // Keep only the vertices of the closest face. best_idx is increasing,
+  // so this never overwrites a vertex before it is moved.
+  for(int i = 0; i < best_count; ++i) {
+    int j = best_idx[i];
+    m_w[i] = m_w[j];
+    m_dir[i] = m_dir[j];
+    m_p1[i] = m_p1[j];
+    m_p2[i] = m_p2[j];
+    m_lambda[i] = (CoordType) best_lambda[i];
+  }
+  m_size = best_count;
+
+  Vector<dim> v = m_w[0];
+  for(int k = 0; k < dim; ++k) {
+    double sum = 0;
+    for(int i = 0; i < m_size; ++i)
+      sum += best_lambda[i] * m_w[i][k];
+    v[k] = (CoordType) sum;
+  }
+  return v;
+}
+
+template<int dim>
+void _GJKSimplex<dim>::closestPoints(Point<dim>& p1, Point<dim>& p2) const
+{
+  p1 = m_p1[0];
+  p2 = m_p2[0];
+  for(int i = 1; i < m_size; ++i) {
+    p1 += (m_p1[i] - m_p1[0]) * m_lambda[i];
+    p2 += (m_p2[i] - m_p2[0]) * m_lambda[i];
+  }
+}
+
+template<int dim>
+CoordType _GJKSimplex<dim>::maxSqrMag() const
+{
+  CoordType max = 0;
+  for(int i = 0; i < m_size; ++i) {
+    CoordType sqr = m_w[i].sqrMag();
+    if(sqr > max)
+      max = sqr;
+  }
+  return max;
+}
+
+template<int dim>
+void _GJKSimplex<dim>::save(GJKCache<dim>& cache) const
+{
+  for(int i = 0; i < m_size; ++i)
+    cache.m_dirs[i] = m_dir[i];
+  cache.m_size = m_size;
+}
+
+template class _GJKSimplex<2>;
+template class _GJKSimplex<3>;
+
+// The cross product without the rounding to zero of Cross(), which
+// matters for the normals of small faces
+static inline Vector<3> _ExactCross(const Vector<3>& a, const Vector<3>& b)
+{
+  return Vector<3>(a[1] * b[2] - a[2] * b[1],
+                   a[2] * b[0] - a[0] * b[2],
+                   a[0] * b[1] - a[1] * b[0]);
+}
+
+// The answer when the Minkowski difference of the cores is flat, so
+// that the origin is on its boundary and the cores only touch
+template<int dim>
+static void _EPAFlat(const _GJKSimplex<dim>& simplex, const Vector<dim>& n,
+                     Vector<dim>& normal, CoordType& depth,
+                     Point<dim>& p1, Point<dim>& p2)
+{
+  CoordType mag = n.mag();
+  normal = n;
+  if(mag > 0)
+    normal /= mag;
+  else {
+    normal.zero();
+    normal[0] = 1;
+  }
+  depth = 0;
+  simplex.closestPoints(p1, p2);
+}
+
+void _EPA(const _GJKSupport<2>& pair, const _GJKSimplex<2>& simplex,
+          Vector<2>& normal, CoordType& depth, Point<2>& p1, Point<2>& p2)
+{
+  const int max_iterations = 64, max_verts = max_iterations + 3;
+  const CoordType eps = numeric_constants<CoordType>::epsilon();
+
+  // The polygon, kept counterclockwise
+  Vector<2> w[max_verts];
+  Point<2> a[max_verts], b[max_verts];
+  int n = simplex.size();
+  CoordType scale = 0;
+
+  for(int i = 0; i < n; ++i) {
+    w[i] = simplex.vertex(i);
+    a[i] = simplex.point1(i);
+    b[i] = simplex.point2(i);
+    scale = std::max(scale, w[i].mag());
+  }
+
+  // Blow a point or a segment up to a triangle
+  if(n == 1) {
+    static const CoordType dirs[4][2] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
+    for(int i = 0; i < 4 && n == 1; ++i) {
+      pair.support(Vector<2>(dirs[i][0], dirs[i][1]), a[1], b[1]);
+      w[1] = a[1] - b[1];
+      if((w[1] - w[0]).mag() > eps * std::max(scale, w[1].mag()))
+        n = 2;
+    }
+    if(n == 1) {
+      _EPAFlat(simplex, Vector<2>(1, 0), normal, depth, p1, p2);
+      return;
+    }
+    scale = std::max(scale, w[1].mag());
+  }
+  if(n == 2) {
+    Vector<2> perp(w[0][1] - w[1][1], w[1][0] - w[0][0]);
+    for(int i = 0; i < 2 && n == 2; ++i) {
+      Vector<2> dir = (i == 0) ? perp : -perp;
+      pair.support(dir, a[2], b[2]);
+      w[2] = a[2] - b[2];
+      if(std::fabs(Dot(w[2] - w[0], perp)) > eps * std::max(scale, w[2].mag()) * perp.mag())
+        n = 3;
+    }
+    if(n == 2) {
+      _EPAFlat(simplex, perp, normal, depth, p1, p2);
+      return;
+    }
+  }
+  Vector<2> e1 = w[1] - w[0], e2 = w[2] - w[0];
+  if(e1[0] * e2[1] - e1[1] * e2[0] < 0) {
+    std::swap(w[1], w[2]);
+    std::swap(a[1], a[2]);
+    std::swap(b[1], b[2]);
+  }
+  for(int i = 0; i < n; ++i)
+    scale = std::max(scale, w[i].mag());
+
+  int best = 0;
+  Vector<2> best_normal(1, 0);
+  CoordType best_dist = 0;
+
+  for(int iter = 0; ; ++iter) {
+    // Find the edge closest to the origin. Rounding can leave several
+    // edges along one flat side of the difference, so of those take the
+    // one the origin projects onto.
+    best_dist = std::numeric_limits<CoordType>::max();
+    bool best_onto = false;
+    for(int i = 0; i < n; ++i) {
+      Vector<2> e = w[(i + 1) % n] - w[i];
+      CoordType len = e.mag();
+      if(len == 0)
+        continue;
+      Vector<2> out(e[1] / len, -e[0] / len);
+      CoordType dist = Dot(out, w[i]), along = -Dot(w[i], e);
+      bool onto = along >= 0 && along <= len * len;
+      if(dist < best_dist - eps * scale
+         || (dist <= best_dist + eps * scale && onto && !best_onto)) {
+        best_dist = dist;
+        best_onto = onto;
+        best = i;
+        best_normal = out;
+      }
+    }
+
+    if(iter == max_iterations || n == max_verts)
+      break;
+
+    Point<2> new_a, new_b;
+    pair.support(best_normal, new_a, new_b);
+    Vector<2> new_w = new_a - new_b;
+    if(Dot(best_normal, new_w) - best_dist <= eps * scale)
+      break;
+
+    // Insert the new vertex after best
+    for(int i = n; i > best + 1; --i) {
+      w[i] = w[i - 1];
+      a[i] = a[i - 1];
+      b[i] = b[i - 1];
+    }
+    w[best + 1] = new_w;
+    a[best + 1] = new_a;
+    b[best + 1] = new_b;
+    ++n;
+    scale = std::max(scale, new_w.mag());
+  }
+
+  int next = (best + 1) % n;
+  Vector<2> e = w[next] - w[best];
+  CoordType t = 0, sqr = e.sqrMag();
+  if(sqr > 0)
+    t = std::min(std::max(Dot(best_normal * best_dist - w[best], e) / sqr,
+                          (CoordType) 0), (CoordType) 1);
+
+  normal = best_normal;
+  depth = std::max(best_dist, (CoordType) 0);
+  p1 = a[best] + (a[next] - a[best]) * t;
+  p2 = b[best] + (b[next] - b[best]) * t;
+}
+
+namespace {
+
+struct _EPAFace
+{
+  int v[3];
+  Vector<3> normal;
+  CoordType dist;
+};
+
+}
+
+void _EPA(const _GJKSupport<3>& pair, const _GJKSimplex<3>& simplex,
+          Vector<3>& normal, CoordType& depth, Point<3>& p1, Point<3>& p2)
+{
+  const int max_iterations = 64, max_verts = max_iterations + 4;
+  // A convex polytope with V vertices has at most 2V - 4 faces, leave
+  // room for rounding making it a little less than convex
+  const int max_faces = 4 * max_verts;
+  const CoordType eps = numeric_constants<CoordType>::epsilon();
+
+  Vector<3> w[max_verts];
+  Point<3> a[max_verts], b[max_verts];
+  int n = simplex.size();
+  CoordType scale = 0;
+
+  for(int i = 0; i < n; ++i) {
+    w[i] = simplex.vertex(i);
+    a[i] = simplex.point1(i);
+    b[i] = simplex.point2(i);
+    scale = std::max(scale, w[i].mag());
+  }
+
+  // Blow a point, segment or triangle up to a tetrahedron
+  if(n == 1) {
+    for(int i = 0; i < 6 && n == 1; ++i) {
+      Vector<3> dir;
+      dir.zero();
+      dir[i / 2] = (i % 2 == 0) ? 1 : -1;
+      pair.support(dir, a[1], b[1]);
+      w[1] = a[1] - b[1];
+      if((w[1] - w[0]).mag() > eps * std::max(scale, w[1].mag()))
+        n = 2;
+    }
+    if(n == 1) {
+      _EPAFlat(simplex, Vector<3>(1, 0, 0), normal, depth, p1, p2);
+      return;
+    }
+    scale = std::max(scale, w[1].mag());
+  }
+  if(n == 2) {
+    Vector<3> e = w[1] - w[0], axis;
+    axis.zero();
+    int least = 0;
+    for(int i = 1; i < 3; ++i)
+      if(std::fabs(e[i]) < std::fabs(e[least]))
+        least = i;
+    axis[least] = 1;
+    Vector<3> d1 = _ExactCross(e, axis), d2 = _ExactCross(e, d1);
+    for(int i = 0; i < 4 && n == 2; ++i) {
+      Vector<3> dir = (i < 2) ? d1 : d2;
+      if(i % 2 != 0)
+        dir = -dir;
+      pair.support(dir, a[2], b[2]);
+      w[2] = a[2] - b[2];
+      if(_ExactCross(e, w[2] - w[0]).mag()
+         > eps * std::max(scale, w[2].mag()) * e.mag())
+        n = 3;
+    }
+    if(n == 2) {
+      _EPAFlat(simplex, d1, normal, depth, p1, p2);
+      return;
+    }
+    scale = std::max(scale, w[2].mag());
+  }
+  Vector<3> plane = _ExactCross(w[1] - w[0], w[2] - w[0]);
+  if(n == 3) {
+    for(int i = 0; i < 2 && n == 3; ++i) {
+      Vector<3> dir = (i == 0) ? plane : -plane;
+      pair.support(dir, a[3], b[3]);
+      w[3] = a[3] - b[3];
+      if(std::fabs(Dot(w[3] - w[0], plane))
+         > eps * std::max(scale, w[3].mag()) * plane.mag())
+        n = 4;
+    }
+    if(n == 3) {
+      _EPAFlat(simplex, plane, normal, depth, p1, p2);
+      return;
+    }
+  }
+  for(int i = 0; i < n; ++i)
+    scale = std::max(scale, w[i].mag());
+
+  // The tetrahedron's centroid stays inside the polytope as it grows,
+  // and orients the normals of new faces outwards
+  Vector<3> center = (w[0] + w[1] + w[2] + w[3]) / 4;
+
+  _EPAFace faces[max_faces];
+  int num_faces = 0;
+
+  auto make_face = [&](int i, int j, int k) {
+    _EPAFace& f = faces[num_faces++];
+    Vector<3> nrm = _ExactCross(w[j] - w[i], w[k] - w[i]);
+    if(Dot(nrm, w[i] - center) < 0) {
+      nrm = -nrm;
+      std::swap(j, k);
+    }
+    f.v[0] = i;
+    f.v[1] = j;
+    f.v[2] = k;
+    CoordType mag = nrm.mag();
+    if(mag > 0) {
+      f.normal = nrm / mag;
+      f.dist = Dot(f.normal, w[i]);
+    }
+    else {
+      // A sliver, which is never the closest face, and never seen
+      // from a new vertex
+      f.normal = nrm;
+      f.dist = std::numeric_limits<CoordType>::max();
+    }
+  };
+
+  make_face(0, 1, 2);
+  make_face(0, 3, 1);
+  make_face(0, 2, 3);
+  make_face(1, 3, 2);
+
+  // The barycentric coordinates of the closest point of a face's plane
+  // to the origin, returns true if they're inside the face
+  auto project = [&](const _EPAFace& f, CoordType& u, CoordType& v) {
+    Vector<3> e1 = w[f.v[1]] - w[f.v[0]], e2 = w[f.v[2]] - w[f.v[0]],
+              e3 = f.normal * f.dist - w[f.v[0]];
+    CoordType d11 = Dot(e1, e1), d12 = Dot(e1, e2), d22 = Dot(e2, e2),
+              d31 = Dot(e3, e1), d32 = Dot(e3, e2);
+    CoordType denom = d11 * d22 - d12 * d12;
+    u = v = 0;
+    if(!(denom > 0))
+      return false;
+    u = (d22 * d31 - d12 * d32) / denom;
+    v = (d11 * d32 - d12 * d31) / denom;
+    return u >= 0 && v >= 0 && u + v <= 1;
+  };
+
+  int best = 0;
+  CoordType u, v;
+
+  for(int iter = 0; ; ++iter) {
+    best = 0;
+    for(int i = 1; i < num_faces; ++i)
+      if(faces[i].dist < faces[best].dist)
+        best = i;
+
+    // Rounding can leave several faces along one flat side of the
+    // difference, so of those take the one the origin projects onto
+    if(!project(faces[best], u, v)) {
+      CoordType u2, v2;
+      for(int i = 0; i < num_faces; ++i) {
+        if(i != best && faces[i].dist <= faces[best].dist + eps * scale
+           && project(faces[i], u2, v2)) {
+          best = i;
+          u = u2;
+          v = v2;
+          break;
+        }
+      }
+    }
+
+    if(iter == max_iterations || n == max_verts)
+      break;
+
+    const Vector<3>& dir = faces[best].normal;
+    Point<3> new_a, new_b;
+    pair.support(dir, new_a, new_b);
+    Vector<3> new_w = new_a - new_b;
+    CoordType tol = eps * std::max(scale, new_w.mag());
+    if(Dot(dir, new_w) - faces[best].dist <= tol)
+      break;
+
+    // The edges of the faces which can see the new vertex. Those which
+    // only appear once, and not reversed, form the horizon.
+    int edges[3 * max_faces][2], num_edges = 0, num_visible = 0;
+    bool visible[max_faces];
+    for(int i = 0; i < num_faces; ++i) {
+      const _EPAFace& f = faces[i];
+      visible[i] = (i == best) || Dot(f.normal, new_w - w[f.v[0]]) > tol;
+      if(!visible[i])
+        continue;
+      ++num_visible;
+      for(int j = 0; j < 3; ++j) {
+        int from = f.v[j], to = f.v[(j + 1) % 3];
+        int k = 0;
+        while(k < num_edges && !(edges[k][0] == to && edges[k][1] == from))
+          ++k;
+        if(k < num_edges) {
+          edges[k][0] = edges[num_edges - 1][0];
+          edges[k][1] = edges[num_edges - 1][1];
+          --num_edges;
+        }
+        else {
+          edges[num_edges][0] = from;
+          edges[num_edges][1] = to;
+          ++num_edges;
+        }
+      }
+    }
+
+    if(num_faces - num_visible + num_edges > max_faces)
+      break;
+
+    int kept = 0;
+    for(int i = 0; i < num_faces; ++i)
+      if(!visible[i])
+        faces[kept++] = faces[i];
+    num_faces = kept;
+
+    w[n] = new_w;
+    a[n] = new_a;
+    b[n] = new_b;
+    for(int i = 0; i < num_edges; ++i)
+      make_face(edges[i][0], edges[i][1], n);
+    ++n;
+    scale = std::max(scale, new_w.mag());
+  }
+
+  const _EPAFace& f = faces[best];
+  normal = f.normal;
+  depth = std::max(f.dist, (CoordType) 0);
+  p1 = a[f.v[0]] + (a[f.v[1]] - a[f.v[0]]) * u + (a[f.v[2]] - a[f.v[0]]) * v;
+  p2 = b[f.v[0]] + (b[f.v[1]] - b[f.v[0]]) * u + (b[f.v[2]] - b[f.v[0]]) * v;
+}
+
+} // namespace WFMath
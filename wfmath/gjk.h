@@ -0,0 +1,395 @@
+// gjk.h (Distance and penetration queries between convex shapes, by GJK and EPA)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifndef WFMATH_GJK_H
+#define WFMATH_GJK_H
+
+#include <wfmath/const.h>
+#include <wfmath/vector.h>
+#include <wfmath/point.h>
+#include <wfmath/axisbox.h>
+#include <wfmath/ball.h>
+#include <wfmath/segment.h>
+#include <wfmath/rotbox.h>
+#include <wfmath/polygon.h>
+
+#include <limits>
+
+#include <cmath>
+
+namespace WFMath {
+
+/// The point of a shape which is furthest in the direction dir
+/**
+ * These are the support functions GJKIntersect(), GJKDistance() and
+ * GJKPenetration() work from. Any shape with a Support() overload can
+ * be passed to them. A Polygon which is not convex is treated as its
+ * convex hull.
+ **/
+template<int dim>
+inline Point<dim> Support(const Point<dim>& p, const Vector<dim>&)
+{
+  return p;
+}
+
+template<int dim>
+inline Point<dim> Support(const Segment<dim>& s, const Vector<dim>& dir)
+{
+  return (Dot(s.endpoint(1) - s.endpoint(0), dir) > 0) ? s.endpoint(1) : s.endpoint(0);
+}
+
+template<int dim>
+inline Point<dim> Support(const AxisBox<dim>& b, const Vector<dim>& dir)
+{
+  Point<dim> p = b.lowCorner();
+  for(int i = 0; i < dim; ++i)
+    if(dir[i] > 0)
+      p[i] = b.highCorner()[i];
+  return p;
+}
+
+template<int dim>
+inline Point<dim> Support(const Ball<dim>& b, const Vector<dim>& dir)
+{
+  CoordType mag = dir.mag();
+  return (mag > 0) ? b.center() + dir * (b.radius() / mag) : b.center();
+}
+
+template<int dim>
+inline Point<dim> Support(const RotBox<dim>& r, const Vector<dim>& dir)
+{
+  // The components of dir along the box's axes, which are the rows of
+  // the orientation
+  Vector<dim> local = Prod(r.orientation(), dir), dist = r.size();
+  for(int i = 0; i < dim; ++i)
+    if(!(local[i] * dist[i] > 0))
+      dist[i] = 0;
+  return r.corner0() + Prod(dist, r.orientation());
+}
+
+template<int dim>
+inline Point<dim> Support(const Polygon<dim>& poly, const Vector<dim>& dir)
+{
+  size_t best = 0;
+  CoordType best_dot = 0;
+  for(size_t i = 0; i < poly.numCorners(); ++i) {
+    CoordType d = Dot(poly.getCorner(i) - poly.getCorner(0), dir);
+    if(d > best_dot) {
+      best_dot = d;
+      best = i;
+    }
+  }
+  return poly.getCorner(best);
+}
+
+// GJK runs on the "core" of each shape, which is the shape shrunk by a
+// margin. Balls are their center, with the radius as the margin, so
+// round shapes converge in a few steps instead of approximating the
+// sphere by ever more vertices.
+template<class Shape, int dim>
+inline Point<dim> _SupportCore(const Shape& s, const Vector<dim>& dir)
+{
+  return Support(s, dir);
+}
+
+template<int dim>
+inline Point<dim> _SupportCore(const Ball<dim>& b, const Vector<dim>&)
+{
+  return b.center();
+}
+
+template<class Shape>
+inline CoordType _SupportMargin(const Shape&)
+{
+  return 0;
+}
+
+template<int dim>
+inline CoordType _SupportMargin(const Ball<dim>& b)
+{
+  return b.radius();
+}
+
+template<int dim> class _GJKSimplex;
+
+/// The simplex of the last GJK query on a pair of shapes, to start the next one from
+/**
+ * Pass the same cache to each query on a pair of shapes which move a
+ * little between queries, and the query starts from the support
+ * directions which found the answer last time, instead of from
+ * scratch. This usually leaves only one or two steps to take. A cache
+ * from a different pair of shapes gives the right answer, only more
+ * slowly.
+ **/
+template<int dim = 3>
+class GJKCache
+{
+ public:
+  /// Construct an empty cache
+  GJKCache() : m_size(0) {}
+
+  /// True if there is no simplex to start from
+  bool empty() const {return m_size == 0;}
+  /// Forget the stored simplex
+  void clear() {m_size = 0;}
+
+  friend class _GJKSimplex<dim>;
+
+ private:
+  Vector<dim> m_dirs[dim + 1];
+  int m_size;
+};
+
+// The simplex of points in the Minkowski difference of two shapes, and
+// Johnson's distance subalgorithm on it
+template<int dim>
+class _GJKSimplex
+{
+ public:
+  _GJKSimplex() : m_size(0) {}
+
+  int size() const {return m_size;}
+  const Vector<dim>& vertex(int i) const {return m_w[i];}
+  const Vector<dim>& direction(int i) const {return m_dir[i];}
+  const Point<dim>& point1(int i) const {return m_p1[i];}
+  const Point<dim>& point2(int i) const {return m_p2[i];}
+
+  // Add p1 - p2, where p1 and p2 are the support points of the shapes
+  // in directions dir and -dir. Returns false if p1 - p2 is already
+  // a vertex.
+  bool add(const Point<dim>& p1, const Point<dim>& p2, const Vector<dim>& dir);
+  // Shrink the simplex to the vertices of the face closest to the
+  // origin, and return the closest point of that face
+  Vector<dim> reduce();
+  // The points on the two shapes which give the closest point
+  void closestPoints(Point<dim>& p1, Point<dim>& p2) const;
+  // The largest squared magnitude of the vertices, for scaling tolerances
+  CoordType maxSqrMag() const;
+
+  void load(const GJKCache<dim>& cache, int& size, const Vector<dim>*& dirs) const
+  {size = cache.m_size; dirs = cache.m_dirs;}
+  void save(GJKCache<dim>& cache) const;
+
+ private:
+  Vector<dim> m_w[dim + 1], m_dir[dim + 1];
+  Point<dim> m_p1[dim + 1], m_p2[dim + 1];
+  CoordType m_lambda[dim + 1];
+  int m_size;
+};
+
+// The support mapping of the Minkowski difference of two shapes, which
+// EPA reaches through a virtual call so that it can live in gjk.cpp
+template<int dim>
+class _GJKSupport
+{
+ public:
+  virtual ~_GJKSupport() {}
+  virtual void support(const Vector<dim>& dir, Point<dim>& p1, Point<dim>& p2) const = 0;
+};
+
+template<int dim, class Shape1, class Shape2>
+class _GJKShapePair : public _GJKSupport<dim>
+{
+ public:
+  _GJKShapePair(const Shape1& s1, const Shape2& s2) : m_s1(s1), m_s2(s2) {}
+
+  virtual void support(const Vector<dim>& dir, Point<dim>& p1, Point<dim>& p2) const
+  {
+    p1 = _SupportCore(m_s1, dir);
+    p2 = _SupportCore(m_s2, -dir);
+  }
+
+ private:
+  const Shape1& m_s1;
+  const Shape2& m_s2;
+};
+
+// Expanding polytope algorithm, starting from a simplex which contains
+// the origin. Finds the smallest displacement of the second shape
+// which separates the cores.
+void _EPA(const _GJKSupport<2>& pair, const _GJKSimplex<2>& simplex,
+          Vector<2>& normal, CoordType& depth, Point<2>& p1, Point<2>& p2);
+void _EPA(const _GJKSupport<3>& pair, const _GJKSimplex<3>& simplex,
+          Vector<3>& normal, CoordType& depth, Point<3>& p1, Point<3>& p2);
+
+// Run GJK on the cores of two shapes, leaving the final simplex in
+// simplex. Returns the squared distance between the cores, 0 if they
+// overlap. Stops as soon as the distance is known to be more than stop,
+// or less than accept.
+template<int dim, class Shape1, class Shape2>
+CoordType _GJKRun(const Shape1& s1, const Shape2& s2, _GJKSimplex<dim>& simplex,
+                  GJKCache<dim>* cache, CoordType stop, CoordType accept = 0)
+{
+  int num_cached = 0;
+  const Vector<dim>* cached = 0;
+  if(cache)
+    simplex.load(*cache, num_cached, cached);
+
+  if(num_cached == 0) {
+    Vector<dim> dir;
+    dir.zero();
+    dir[0] = 1;
+    simplex.add(_SupportCore(s1, dir), _SupportCore(s2, -dir), dir);
+  }
+  else {
+    for(int i = 0; i < num_cached; ++i)
+      simplex.add(_SupportCore(s1, cached[i]), _SupportCore(s2, -cached[i]), cached[i]);
+  }
+
+  Vector<dim> v = simplex.reduce();
+  CoordType vv = v.sqrMag();
+  const CoordType eps = numeric_constants<CoordType>::epsilon();
+  bool overlap = false;
+
+  for(int iter = 0; iter < 64; ++iter) {
+    if(simplex.size() == dim + 1 || vv <= eps * eps * simplex.maxSqrMag()) {
+      overlap = true;
+      break;
+    }
+    if(vv < accept * accept)
+      break;
+
+    Vector<dim> dir = -v;
+    Point<dim> p1 = _SupportCore(s1, dir), p2 = _SupportCore(s2, v);
+    Vector<dim> w = p1 - p2;
+    CoordType vw = Dot(v, w);
+
+    // w is a lower bound on the distance, in the direction of v
+    if(vw > 0 && vw * vw > stop * stop * vv)
+      break;
+    // No vertex is much closer than the current one
+    if(vv - vw <= eps * vv)
+      break;
+    if(!simplex.add(p1, p2, dir))
+      break;
+
+    Vector<dim> next = simplex.reduce();
+    CoordType next_vv = next.sqrMag();
+    v = next;
+    if(!(next_vv < vv)) {
+      vv = next_vv;
+      break;
+    }
+    vv = next_vv;
+  }
+
+  if(cache)
+    simplex.save(*cache);
+
+  return overlap ? 0 : vv;
+}
+
+/// True if two convex shapes overlap or touch
+/**
+ * This works for any pair of Point, Segment, AxisBox, Ball, RotBox and
+ * convex Polygon, with the same tolerance as the non-proper
+ * Intersect(). If cache is given, the query starts from the simplex of
+ * the last query with the same cache, and updates it.
+ **/
+template<int dim, template<int> class Shape1, template<int> class Shape2>
+bool GJKIntersect(const Shape1<dim>& s1, const Shape2<dim>& s2, GJKCache<dim>* cache = 0)
+{
+  _GJKSimplex<dim> simplex;
+  CoordType margin = _SupportMargin(s1) + _SupportMargin(s2);
+  CoordType stop = margin + numeric_constants<CoordType>::epsilon() * (1 + margin);
+  return _GJKRun(s1, s2, simplex, cache, stop) <= stop * stop;
+}
+
+/// The distance between two convex shapes, 0 if they overlap
+/**
+ * closest1 and closest2 are set to the closest points of s1 and s2. If
+ * the shapes overlap, they're both set to the same point, which is in
+ * both shapes.
+ **/
+template<int dim, template<int> class Shape1, template<int> class Shape2>
+CoordType GJKDistance(const Shape1<dim>& s1, const Shape2<dim>& s2,
+                      Point<dim>& closest1, Point<dim>& closest2,
+                      GJKCache<dim>* cache = 0)
+{
+  _GJKSimplex<dim> simplex;
+  CoordType r1 = _SupportMargin(s1), r2 = _SupportMargin(s2);
+  CoordType dist = std::sqrt(_GJKRun(s1, s2, simplex, cache,
+                                     std::numeric_limits<CoordType>::max()));
+
+  Point<dim> p1, p2;
+  simplex.closestPoints(p1, p2);
+
+  if(dist <= r1 + r2) {
+    // Pick the point between the cores which is within both margins
+    closest1 = (r1 + r2 > 0) ? p1 + (p2 - p1) * (r1 / (r1 + r2)) : p1;
+    closest2 = closest1;
+    return 0;
+  }
+
+  Vector<dim> n = (p2 - p1) / dist;
+  closest1 = p1 + n * r1;
+  closest2 = p2 - n * r2;
+  return dist - r1 - r2;
+}
+
+/// Find how far two convex shapes overlap
+/**
+ * Returns false if the shapes don't overlap, and leaves the other
+ * arguments unchanged. Otherwise, moving s2 by depth * normal is the
+ * smallest motion which separates the shapes. point1 and point2 are
+ * the deepest points of each shape inside the other, so that
+ * point1 - point2 == depth * normal.
+ *
+ * Balls are handled exactly, other shapes to within a small tolerance.
+ **/
+template<int dim, template<int> class Shape1, template<int> class Shape2>
+bool GJKPenetration(const Shape1<dim>& s1, const Shape2<dim>& s2,
+                    Vector<dim>& normal, CoordType& depth,
+                    Point<dim>& point1, Point<dim>& point2,
+                    GJKCache<dim>* cache = 0)
+{
+  _GJKSimplex<dim> simplex;
+  CoordType r1 = _SupportMargin(s1), r2 = _SupportMargin(s2);
+  CoordType dist = std::sqrt(_GJKRun(s1, s2, simplex, cache, r1 + r2));
+
+  if(dist > r1 + r2)
+    return false;
+
+  Point<dim> p1, p2;
+  if(dist > 0) {
+    // Only the margins overlap, which the cores' closest points give
+    // exactly
+    simplex.closestPoints(p1, p2);
+    normal = (p2 - p1) / dist;
+    depth = r1 + r2 - dist;
+  }
+  else {
+    _EPA(_GJKShapePair<dim, Shape1<dim>, Shape2<dim> >(s1, s2), simplex,
+         normal, depth, p1, p2);
+    depth += r1 + r2;
+  }
+
+  point1 = p1 + normal * r1;
+  point2 = p2 - normal * r2;
+  return true;
+}
+
+} // namespace WFMath
+
+#endif  // WFMATH_GJK_H
@@ -0,0 +1,367 @@
+// gjk_test.cpp (GJK and EPA test functions)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#ifndef DEBUG
+#define DEBUG
+#endif
+
+#include "const.h"
+#include "vector.h"
+#include "point.h"
+#include "rotmatrix.h"
+#include "axisbox.h"
+#include "ball.h"
+#include "segment.h"
+#include "rotbox.h"
+#include "polygon.h"
+#include "intersect.h"
+#include "polygon_intersect.h"
+#include "gjk.h"
+#include "randgen.h"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <cassert>
+#include <cmath>
+
+using namespace WFMath;
+
+static const CoordType tolerance = 1e-3f;
+
+static CoordType random_coord(MTRand& rand, CoordType low, CoordType high)
+{
+  return low + (high - low) * (CoordType) rand.rand();
+}
+
+template<int dim>
+static Point<dim> random_point(MTRand& rand, CoordType world)
+{
+  Point<dim> p;
+  p.setToOrigin();
+  for(int i = 0; i < dim; ++i)
+    p[i] = random_coord(rand, -world, world);
+  return p;
+}
+
+template<int dim>
+static Vector<dim> random_size(MTRand& rand)
+{
+  Vector<dim> v;
+  for(int i = 0; i < dim; ++i)
+    v[i] = random_coord(rand, 0.2f, 2);
+  v.setValid();
+  return v;
+}
+
+static RotMatrix<2> random_rotation(MTRand& rand, const RotMatrix<2>&)
+{
+  RotMatrix<2> m;
+  return m.rotation(random_coord(rand, -3, 3));
+}
+
+static RotMatrix<3> random_rotation(MTRand& rand, const RotMatrix<3>&)
+{
+  RotMatrix<3> m;
+  Vector<3> axis(random_coord(rand, -1, 1), random_coord(rand, -1, 1), 1);
+  return m.rotation(axis, random_coord(rand, -3, 3));
+}
+
+// Shapes near the origin, so that random pairs overlap about half the time
+template<int dim>
+struct RandomShapes
+{
+  MTRand& rand;
+  CoordType world;
+
+  Point<dim> point() {return random_point<dim>(rand, world);}
+  Ball<dim> ball() {return Ball<dim>(point(), random_coord(rand, 0.1f, 2));}
+  AxisBox<dim> box()
+  {
+    Point<dim> low = point();
+    return AxisBox<dim>(low, low + random_size<dim>(rand));
+  }
+  Segment<dim> segment()
+  {
+    Point<dim> p = point();
+    Vector<dim> v = random_size<dim>(rand) - random_size<dim>(rand);
+    return Segment<dim>(p, p + v * 2);
+  }
+  RotBox<dim> rotbox()
+  {
+    return RotBox<dim>(point(), random_size<dim>(rand),
+                       random_rotation(rand, RotMatrix<dim>()));
+  }
+};
+
+// A convex polygon with its corners on a circle
+static Polygon<2> random_convex(MTRand& rand, CoordType world)
+{
+  Point<2> center = random_point<2>(rand, world);
+  CoordType radius = random_coord(rand, 0.3f, 2);
+  int n = 3 + (int) (rand.rand() * 8);
+
+  std::vector<CoordType> angles;
+  for(int i = 0; i < n; ++i)
+    angles.push_back(random_coord(rand, 0, 2 * numeric_constants<CoordType>::pi()));
+  std::sort(angles.begin(), angles.end());
+
+  Polygon<2> poly;
+  for(int i = 0; i < n; ++i)
+    poly.addCorner(i, center + Vector<2>(std::cos(angles[i]), std::sin(angles[i])) * radius);
+  return poly;
+}
+
+template<class Shape, int dim>
+static Shape shifted(const Shape& s, const Vector<dim>& v)
+{
+  Shape copy = s;
+  copy.shift(v);
+  return copy;
+}
+
+template<int dim>
+static Polygon<dim> shifted(const Polygon<dim>& s, const Vector<dim>& v)
+{
+  Polygon<dim> copy = s;
+  for(size_t i = 0; i < copy.numCorners(); ++i)
+    copy.moveCorner(i, copy.getCorner(i) + v);
+  return copy;
+}
+
+// Check the GJK answers for a pair of shapes against the exact
+// Intersect(), and against each other
+template<int dim, template<int> class Shape1, template<int> class Shape2>
+static void check_pair(const Shape1<dim>& s1, const Shape2<dim>& s2)
+{
+  Point<dim> c1, c2;
+  CoordType dist = GJKDistance(s1, s2, c1, c2);
+  bool hit = GJKIntersect(s1, s2);
+
+  assert(dist >= 0);
+  assert(Intersect(Ball<dim>(c1, tolerance), s1, false));
+  assert(Intersect(Ball<dim>(c2, tolerance), s2, false));
+
+  if(dist > tolerance) {
+    assert(!hit);
+    assert(!Intersect(s1, s2, false));
+    assert(std::fabs((c1 - c2).mag() - dist) < tolerance);
+    return;
+  }
+  if(dist > 0)
+    return;
+
+  assert(hit);
+  assert(c1 == c2);
+
+  Vector<dim> normal;
+  CoordType depth;
+  Point<dim> p1, p2;
+  assert(GJKPenetration(s1, s2, normal, depth, p1, p2));
+  assert(depth >= 0);
+  assert(std::fabs(normal.mag() - 1) < tolerance);
+  assert((p1 - p2 - normal * depth).mag() < tolerance);
+
+  if(depth > tolerance) {
+    assert(Intersect(s1, s2, false));
+    // Moving by a little less than depth along the normal can't separate
+    // the shapes, and moving by a little more must
+    assert(GJKIntersect(s1, shifted(s2, normal * (depth * 0.9f))));
+    assert(!GJKIntersect(s1, shifted(s2, normal * (depth + tolerance))));
+  }
+}
+
+template<int dim>
+static void test_random_pairs(MTRand& rand)
+{
+  std::cout << "Testing " << dim << "D random pairs" << std::endl;
+
+  RandomShapes<dim> r = {rand, 2};
+
+  for(int i = 0; i < 300; ++i) {
+    check_pair(r.ball(), r.ball());
+    check_pair(r.ball(), r.box());
+    check_pair(r.box(), r.box());
+    check_pair(r.point(), r.box());
+    check_pair(r.point(), r.rotbox());
+    check_pair(r.segment(), r.box());
+    check_pair(r.segment(), r.ball());
+    check_pair(r.ball(), r.rotbox());
+    check_pair(r.rotbox(), r.rotbox());
+    check_pair(r.box(), r.rotbox());
+  }
+}
+
+static void test_random_polygons(MTRand& rand)
+{
+  std::cout << "Testing convex polygons" << std::endl;
+
+  RandomShapes<2> r = {rand, 2};
+
+  for(int i = 0; i < 300; ++i) {
+    Polygon<2> poly = random_convex(rand, 2);
+    assert(poly.isConvex());
+    check_pair(poly, random_convex(rand, 2));
+    check_pair(poly, r.box());
+    check_pair(poly, r.ball());
+    check_pair(poly, r.rotbox());
+    check_pair(r.point(), poly);
+  }
+
+  // A polygon in 3D
+  Polygon<3> poly;
+  poly.addCorner(0, Point<3>(0, 0, 0));
+  poly.addCorner(1, Point<3>(2, 0, 0));
+  poly.addCorner(2, Point<3>(0, 2, 1));
+  Point<3> c1, c2;
+  CoordType dist = GJKDistance(poly, Ball<3>(Point<3>(0, 0, -2), 1), c1, c2);
+  assert(Equal(dist, 1));
+  assert(c1 == Point<3>(0, 0, 0));
+  assert(c2 == Point<3>(0, 0, -1));
+  assert(GJKIntersect(poly, Ball<3>(Point<3>(0.5f, 0.5f, 0), 0.5f)));
+}
+
+template<int dim>
+static void test_exact()
+{
+  std::cout << "Testing " << dim << "D exact answers" << std::endl;
+
+  Point<dim> origin;
+  origin.setToOrigin();
+  Vector<dim> x, ones;
+  x.zero();
+  x[0] = 1;
+  ones.zero();
+  for(int i = 0; i < dim; ++i)
+    ones[i] = 1;
+
+  Point<dim> c1, c2;
+  Vector<dim> normal;
+  CoordType depth;
+
+  // Balls
+  Ball<dim> b1(origin, 1), b2(origin + x * 3, 1.5f);
+  assert(Equal(GJKDistance(b1, b2, c1, c2), 0.5f));
+  assert(c1 == origin + x);
+  assert(c2 == origin + x * 1.5f);
+  assert(!GJKPenetration(b1, b2, normal, depth, c1, c2));
+
+  b2.center() = origin + x * 2;
+  assert(GJKPenetration(b1, b2, normal, depth, c1, c2));
+  assert(Equal(depth, 0.5f));
+  assert(normal == x);
+  assert(c1 == origin + x);
+  assert(c2 == origin + x * 0.5f);
+
+  // Concentric balls
+  assert(GJKPenetration(b1, Ball<dim>(origin, 2), normal, depth, c1, c2));
+  assert(Equal(depth, 3));
+
+  // Point and box
+  AxisBox<dim> box(origin, origin + ones * 2);
+  Point<dim> p = origin + ones * 3;
+  assert(Equal(GJKDistance(p, box, c1, c2), std::sqrt((CoordType) dim)));
+  assert(c2 == origin + ones * 2);
+
+  // Boxes, which overlap least along x
+  AxisBox<dim> box2(origin + ones * 0.5f + x, origin + ones * 3.5f + x);
+  assert(GJKPenetration(box, box2, normal, depth, c1, c2));
+  assert(Equal(depth, 0.5f));
+  assert(normal == x);
+
+  // Ball with its center inside a box
+  Ball<dim> inside(origin + ones * 0.5f + x * 0.8f, 1);
+  assert(GJKPenetration(box, inside, normal, depth, c1, c2));
+  assert(Equal(depth, 1.5f));
+  assert(Equal(normal[0], 0) && Equal(normal.mag(), 1));
+
+  // Touching boxes
+  AxisBox<dim> box3(origin + x * 2, origin + x * 3 + ones);
+  assert(GJKIntersect(box, box3));
+  assert(Equal(GJKDistance(box, box3, c1, c2), 0));
+  assert(!GJKIntersect(box, shifted(box3, x * 0.01f)));
+}
+
+template<int dim>
+static void test_warm_start(MTRand& rand)
+{
+  std::cout << "Testing " << dim << "D warm start" << std::endl;
+
+  RandomShapes<dim> r = {rand, 2};
+  RotBox<dim> moving = r.rotbox();
+  RotBox<dim> fixed = r.rotbox();
+  Ball<dim> ball = r.ball();
+  Vector<dim> step = r.point() - r.point();
+  step /= 20;
+
+  GJKCache<dim> cache, ball_cache, pen_cache;
+  assert(cache.empty());
+
+  for(int i = 0; i < 100; ++i) {
+    moving.shift(step);
+    if(i % 25 == 0)
+      step = -step;
+
+    Point<dim> c1, c2, w1, w2;
+    CoordType dist = GJKDistance(moving, fixed, c1, c2);
+    CoordType warm = GJKDistance(moving, fixed, w1, w2, &cache);
+    assert(std::fabs(dist - warm) < tolerance);
+    assert(!cache.empty());
+
+    assert(GJKIntersect(moving, ball) == GJKIntersect(moving, ball, &ball_cache)
+           || std::fabs(GJKDistance(moving, ball, c1, c2)) < tolerance);
+
+    Vector<dim> n1, n2;
+    CoordType d1, d2;
+    bool pen = GJKPenetration(moving, fixed, n1, d1, c1, c2);
+    assert(pen == GJKPenetration(moving, fixed, n2, d2, w1, w2, &pen_cache)
+           || dist < tolerance);
+    if(pen)
+      assert(std::fabs(d1 - d2) < tolerance);
+  }
+
+  cache.clear();
+  assert(cache.empty());
+}
+
+int main()
+{
+  MTRand rand(42);
+
+  test_exact<2>();
+  test_exact<3>();
+
+  test_random_pairs<2>(rand);
+  test_random_pairs<3>(rand);
+  test_random_polygons(rand);
+
+  test_warm_start<2>(rand);
+  test_warm_start<3>(rand);
+
+  return 0;
+}
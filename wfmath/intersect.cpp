@@ -64,19 +64,44 @@ namespace WFMath {
 // line, but passes through the upper right corner of a. Thus,
 // this line separates b from B(a), and they do not intersect. QED.
 
-template<>
-bool Intersect<2>(const RotBox<2>& r, const AxisBox<2>& b, bool proper)
+// The bounding box of b in the frame of r, with corner0 fixed
+template<int dim>
+static AxisBox<dim> _LocalBoundingBox(const RotBox<dim>& r, const AxisBox<dim>& b)
 {
-  const AxisBox<2> b2 = r.boundingBox();
-  if(!Intersect(b2, b, proper))
-    return false;
+  RotMatrix<dim> m = r.orientation().inverse();
+
+  return RotBox<dim>(Point<dim>(b.lowCorner()).rotate(m, r.corner0()),
+                     b.highCorner() - b.lowCorner(), m).boundingBox();
+}
+
+// Axis 0 is the axes of the bounding box of r, and axis 1 the axes of r
+// itself, where the bounding box of b in the frame of r is checked
+template<int dim>
+static bool _BoxAxesSeparate(const RotBox<dim>& r, const AxisBox<dim>& b, int axis,
+                             bool proper)
+{
+  if(axis == 0)
+    return !Intersect(r.boundingBox(), b, proper);
+
+  const AxisBox<dim> b4(r.corner0(), r.corner0() + r.size());
+  return !Intersect(_LocalBoundingBox(r, b), b4, proper);
+}
+
+// The functions below return the number of the first axis which
+// separates the boxes, or -1 if they intersect
+
+static int _SeparatingAxis(const RotBox<2>& r, const AxisBox<2>& b, bool proper)
+{
+  for(int axis = 0; axis < 2; ++axis)
+    if(_BoxAxesSeparate(r, b, axis, proper))
+      return axis;
 
-  RotMatrix<2> m = r.m_orient.inverse();
+  return -1;
+}
 
-  const AxisBox<2> b3 = RotBox<2>(Point<2>(b.m_low).rotate(m, r.m_corner0),
-                             b.m_high - b.m_low, m).boundingBox();
-  const AxisBox<2> b4(r.m_corner0, r.m_corner0 + r.m_size);
-  return Intersect(b3, b4, proper);
+static bool _AxisSeparates(const RotBox<2>& r, const AxisBox<2>& b, int axis, bool proper)
+{
+  return axis < 2 && _BoxAxesSeparate(r, b, axis, proper);
 }
 
 // The 3d implementation is based on the following theorem:
@@ -109,140 +134,205 @@ bool Intersect<2>(const RotBox<2>& r, const AxisBox<2>& b, bool proper)
 // UNC Chapel Hill
 // 1996
 
-template<>
-bool Intersect<3>(const RotBox<3>& r, const AxisBox<3>& b, bool proper)
+// Normal to the plane parallel to edge i of the RotBox and axis j,
+// ignoring the size of both since we only care about the direction.
+// Edge i of the RotBox points along row i of m.
+static Vector<3> _CrossAxis(const RotMatrix<3>& m, int i, int j)
+{
+  Vector<3> axis;
+
+  switch(j) {
+    case 0:
+      axis[0] = 0;
+      axis[1] = -m.elem(i, 2);
+      axis[2] =  m.elem(i, 1);
+      break;
+    case 1:
+      axis[0] =  m.elem(i, 2);
+      axis[1] = 0;
+      axis[2] = -m.elem(i, 0);
+      break;
+    case 2:
+      axis[0] = -m.elem(i, 1);
+      axis[1] =  m.elem(i, 0);
+      axis[2] = 0;
+      break;
+    default:
+      assert(false);
+  }
+
+  return axis;
+}
+
+// Parallel edges, this reduces to the 2d case above. Once we've
+// checked the bounding box intersections, we know they intersect.
+// We don't need to scale WFMATH_EPSILON, det(m_orient) = 1
+// essentially takes care of that.
+static bool _ParallelEdges(const Vector<3>& axis)
+{
+  return axis.sqrMag() < numeric_constants<CoordType>::epsilon() * numeric_constants<CoordType>::epsilon();
+}
+
+// Project both boxes on the normal for edge i and axis j, check for
+// a separating plane
+static bool _CrossAxisSeparates(const RotBox<3>& r, const AxisBox<3>& b,
+                                const Vector<3>& axis, int i, int j, bool proper)
+{
+  Vector<3> sep = b.lowCorner() - r.corner0();
+  Vector<3> b_size = b.highCorner() - b.lowCorner();
+  const RotMatrix<3> &m = r.orientation();
+
+  // We only need to project two axes per box, the one parallel
+  // to the plane doesn't contribute
+
+  const int next[] = {1, 2, 0};
+  CoordType val;
+  CoordType b_low, b_high, r_low, r_high, dist;
+  int k;
+
+  // AxisBox projection
+
+  k = next[j];
+
+  val = axis[k] * b_size[k];
+
+  if(val > 0) {
+    b_high = val;
+    b_low = 0;
+  }
+  else {
+    b_low = val;
+    b_high = 0;
+  }
+
+  k = next[k];
+
+  val = axis[k] * b_size[k];
+
+  if(val > 0)
+    b_high += val;
+  else
+    b_low += val;
+
+  // RotBox projection
+
+  k = next[i];
+
+  val = Dot(m.row(k), axis) * r.size()[k];
+
+  if(val > 0) {
+    r_high = val;
+    r_low = 0;
+  }
+  else {
+    r_low = val;
+    r_high = 0;
+  }
+
+  k = next[k];
+
+  val = Dot(m.row(k), axis) * r.size()[k];
+
+  if(val > 0)
+    r_high += val;
+  else
+    r_low += val;
+
+  // Distance between basepoints for boxes along this axis
+
+  dist = Dot(sep, axis);
+
+  return _Greater(r_low - dist, b_high, proper)
+      || _Less(r_high - dist, b_low, proper);
+}
+
+static int _SeparatingAxis(const RotBox<3>& r, const AxisBox<3>& b, bool proper)
 {
   // Checking intersection of each with the bounding box of
   // the other in the coordinate system of the first will take care
   // of the "plane parallel to face" case
 
-  const AxisBox<3> b2 = r.boundingBox();
-  if(!Intersect(b2, b, proper))
-    return false;
-
-  RotMatrix<3> minv = r.m_orient.inverse();
-  Vector<3> b_size = b.m_high - b.m_low;
-
-  const AxisBox<3> b3 = RotBox<3>(Point<3>(b.m_low).rotate(minv, r.m_corner0),
-                             b_size, minv).boundingBox();
-  const AxisBox<3> b4(r.m_corner0, r.m_corner0 + r.m_size);
-  if(!Intersect(b3, b4, proper))
-    return false;
+  for(int axis = 0; axis < 2; ++axis)
+    if(_BoxAxesSeparate(r, b, axis, proper))
+      return axis;
 
   // Now for the "plane parallel to at least one edge of each" case
 
-  Vector<3> sep =  b.m_low - r.m_corner0;
-  const RotMatrix<3> &m = r.m_orient;
-
   // Generate normals to the 9 possible separating planes
 
   for(int i = 0; i < 3; ++i) {
-    // Generate edge vectors for the RotBox, ignore size, only care about direction
-// Just access m_orient directly below instead of using r_vec
-//    Vector<3> r_vec = m.row(i);
-
     for(int j = 0; j < 3; ++j) {
-      Vector<3> axis;
-
-      // Cross product, ignore size of b since we only care about direction
-
-      switch(j) {
-        case 0:
-          axis[0] = 0;
-          axis[1] = -m.elem(i, 2);
-          axis[2] =  m.elem(i, 1);
-          break;
-        case 1:
-          axis[0] =  m.elem(i, 2);
-          axis[1] = 0;
-          axis[2] = -m.elem(i, 0);
-          break;
-        case 2:
-          axis[0] = -m.elem(i, 1);
-          axis[1] =  m.elem(i, 0);
-          axis[2] = 0;
-          break;
-        default:
-          assert(false);
-      }
-
-      if(axis.sqrMag() < numeric_constants<CoordType>::epsilon() * numeric_constants<CoordType>::epsilon()) {
-        // Parallel edges, this reduces to the 2d case above. We've already
-        // checked the bounding box intersections, so we know they intersect.
-        // We don't need to scale WFMATH_EPSILON, det(m_orient) = 1
-        // essentially takes care of that.
-        return true;
-      }
-
-      // Project both boxes on this axis, check for separating plane.
-
-      // We only need to project two axes per box, the one parallel
-      // to the plane doesn't contribute
-
-      const int next[] = {1, 2, 0};
-      CoordType val;
-      CoordType b_low, b_high, r_low, r_high, dist;
-      int k;
-
-      // AxisBox projection
-
-      k = next[j];
-
-      val = axis[k] * b_size[k];
-
-      if(val > 0) {
-        b_high = val;
-        b_low = 0;
-      }
-      else {
-        b_low = val;
-        b_high = 0;
-      }
-
-      k = next[k];
-
-      val = axis[k] * b_size[k];
-
-      if(val > 0)
-        b_high += val;
-      else
-        b_low += val;
-
-      // RotBox projection
-
-      k = next[i];
-
-      val = Dot(m.row(k), axis) * r.m_size[k];
-
-      if(val > 0) {
-        r_high = val;
-        r_low = 0;
-      }
-      else {
-        r_low = val;
-        r_high = 0;
-      }
-
-      k = next[k];
-
-      val = Dot(m.row(k), axis) * r.m_size[k];
-
-      if(val > 0)
-        r_high += val;
-      else
-        r_low += val;
-
-      // Distance between basepoints for boxes along this axis
-
-      dist = Dot(sep, axis);
-
-      if(_Greater(r_low - dist, b_high, proper)
-        || _Less(r_high - dist, b_low, proper))
-        return false;
+      Vector<3> axis = _CrossAxis(r.orientation(), i, j);
+
+      if(_ParallelEdges(axis))
+        return -1;
+
+      if(_CrossAxisSeparates(r, b, axis, i, j, proper))
+        return 2 + 3 * i + j;
     }
   }
 
-  return true;
+  return -1;
+}
+
+static bool _AxisSeparates(const RotBox<3>& r, const AxisBox<3>& b, int axis, bool proper)
+{
+  if(axis < 2)
+    return _BoxAxesSeparate(r, b, axis, proper);
+  if(axis >= 11)
+    return false;
+
+  // _SeparatingAxis() stops at the first pair of parallel edges, and
+  // never tries the axes after it
+  const int n = axis - 2;
+  for(int k = 0; k < n; ++k)
+    if(_ParallelEdges(_CrossAxis(r.orientation(), k / 3, k % 3)))
+      return false;
+
+  Vector<3> normal = _CrossAxis(r.orientation(), n / 3, n % 3);
+  return !_ParallelEdges(normal)
+      && _CrossAxisSeparates(r, b, normal, n / 3, n % 3, proper);
+}
+
+template<int dim>
+static bool _CachedIntersect(const RotBox<dim>& r, const AxisBox<dim>& b, bool proper,
+                             SeparatingAxisCache& cache)
+{
+  if(cache.axis() >= 0 && _AxisSeparates(r, b, cache.axis(), proper))
+    return false;
+
+  int axis = _SeparatingAxis(r, b, proper);
+  if(axis < 0)
+    return true;
+
+  cache.setAxis(axis);
+  return false;
+}
+
+template<>
+bool Intersect<2>(const RotBox<2>& r, const AxisBox<2>& b, bool proper)
+{
+  return _SeparatingAxis(r, b, proper) < 0;
+}
+
+template<>
+bool Intersect<3>(const RotBox<3>& r, const AxisBox<3>& b, bool proper)
+{
+  return _SeparatingAxis(r, b, proper) < 0;
+}
+
+template<>
+bool Intersect<2>(const RotBox<2>& r, const AxisBox<2>& b, bool proper,
+                  SeparatingAxisCache& cache)
+{
+  return _CachedIntersect(r, b, proper, cache);
+}
+
+template<>
+bool Intersect<3>(const RotBox<3>& r, const AxisBox<3>& b, bool proper,
+                  SeparatingAxisCache& cache)
+{
+  return _CachedIntersect(r, b, proper, cache);
 }
 
 // force a bunch of instantiations
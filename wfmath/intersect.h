@@ -343,8 +343,8 @@ bool Intersect(const Segment<dim>& s1, const Segment<dim>& s2, bool proper)
     CoordType coord1 = (v2sqr * proj1delta - proj12 * proj2delta) / denom;
     CoordType coord2 = -(v1sqr * proj2delta - proj12 * proj1delta) / denom;
 
-    return _LessEq(coord1, 0, proper) && _LessEq(coord1, 1, proper)
-           && _GreaterEq(coord2, 0, proper) && _GreaterEq(coord2, 1, proper);
+    return _GreaterEq(coord1, 0, proper) && _LessEq(coord1, 1, proper)
+           && _GreaterEq(coord2, 0, proper) && _LessEq(coord2, 1, proper);
   }
   else {
     // Parallel segments, see if one contains an endpoint of the other
@@ -480,6 +480,26 @@ inline bool Intersect(const RotBox<dim>& r1, const RotBox<dim>& r2, bool proper)
 		   AxisBox<dim>(r2.m_corner0, r2.m_corner0 + r2.m_size), proper);
 }
 
+// These try the axis in the cache first. The axes are numbered 0 for
+// those of the bounding box of r, 1 for those of r itself, and in 3D,
+// 2 + 3 * i + j for the cross product of edge i of r with axis j.
+
+template<>
+bool Intersect<2>(const RotBox<2>& r, const AxisBox<2>& b, bool proper,
+                  SeparatingAxisCache& cache);
+template<>
+bool Intersect<3>(const RotBox<3>& r, const AxisBox<3>& b, bool proper,
+                  SeparatingAxisCache& cache);
+
+template<int dim>
+inline bool Intersect(const RotBox<dim>& r1, const RotBox<dim>& r2, bool proper,
+                      SeparatingAxisCache& cache)
+{
+  return Intersect(RotBox<dim>(r1).rotatePoint(r2.orientation().inverse(),
+					       r2.corner0()),
+		   AxisBox<dim>(r2.corner0(), r2.corner0() + r2.size()), proper, cache);
+}
+
 template<int dim>
 inline bool Contains(const RotBox<dim>& outer, const RotBox<dim>& inner, bool proper)
 {
@@ -52,6 +52,39 @@ inline bool _GreaterEq(CoordType x1, CoordType x2, bool proper)
   return !proper ? x1 >= x2 : x1 > x2;
 }
 
+/// Remembers which axis last separated a pair of shapes
+/**
+ * Intersect() for a RotBox and an AxisBox, for two RotBoxes, and for a
+ * convex Polygon<2> and a box or another convex polygon, is a separating
+ * axis test, which tries a fixed list of axes until one of them keeps
+ * the shapes apart. Shapes which stay near each other, like an entity
+ * standing by a building, tend to be separated by the same axis every
+ * time they are tested. Given a cache, those functions try the axis
+ * which worked last time first, and record the one which separates the
+ * shapes, so a repeated test usually takes a single projection.
+ *
+ * The answer is the same with or without a cache. Keep one cache for
+ * each pair of shapes, and use it with only one function, since each
+ * numbers its axes differently. A RotBox and its PreparedRotBox number
+ * them the same way.
+ **/
+class SeparatingAxisCache
+{
+ public:
+  /// Construct a cache which holds no axis
+  SeparatingAxisCache() : m_axis(-1) {}
+
+  /// The number of the axis which last separated the shapes, or -1 if none has
+  int axis() const {return m_axis;}
+  /// Record the axis which separated the shapes
+  void setAxis(int axis) {m_axis = axis;}
+  /// Forget the axis, so the next test tries them all in their usual order
+  void reset() {m_axis = -1;}
+
+ private:
+  int m_axis;
+};
+
 template<int dim>
 bool Intersect(const AxisBox<dim>& b, const Point<dim>& p, bool proper);
 template<int dim>
@@ -134,6 +167,13 @@ bool Intersect(const RotBox<dim>& r1, const RotBox<dim>& r2, bool proper);
 template<int dim>
 bool Contains(const RotBox<dim>& outer, const RotBox<dim>& inner, bool proper);
 
+template<int dim>
+bool Intersect(const RotBox<dim>& r, const AxisBox<dim>& b, bool proper,
+               SeparatingAxisCache& cache);
+template<int dim>
+bool Intersect(const RotBox<dim>& r1, const RotBox<dim>& r2, bool proper,
+               SeparatingAxisCache& cache);
+
 template<int dim>
 bool Intersect(const Polygon<dim>& r, const Point<dim>& p, bool proper);
 template<int dim>
@@ -172,6 +212,16 @@ bool Intersect(const Polygon<dim>& p1, const Polygon<dim>& p2, bool proper);
 template<int dim>
 bool Contains(const Polygon<dim>& outer, const Polygon<dim>& inner, bool proper);
 
+template<int dim>
+bool Intersect(const Polygon<dim>& p, const AxisBox<dim>& b, bool proper,
+               SeparatingAxisCache& cache);
+template<int dim>
+bool Intersect(const Polygon<dim>& p, const RotBox<dim>& r, bool proper,
+               SeparatingAxisCache& cache);
+template<int dim>
+bool Intersect(const Polygon<dim>& p1, const Polygon<dim>& p2, bool proper,
+               SeparatingAxisCache& cache);
+
 } // namespace WFMath
 
 #endif  // WFMATH_INTERSECT_DECLS_H
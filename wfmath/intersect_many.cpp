@@ -0,0 +1,222 @@
+// intersect_many.cpp (Intersect() for one box against many candidates)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-17
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "intersect_many.h"
+#include "intersect.h"
+#include "point_array_funcs.h"
+#include "simd.h"
+
+#include <algorithm>
+
+#include <cassert>
+
+// The vector loops below must give the same answers as the inline
+// Intersect() functions in intersect.h, so each lane makes the same
+// comparisons, with the epsilon of _Less() and _Greater(), and sums
+// the squared distance to a box in the same order. Where Intersect()
+// skips an axis on which a ball's center is inside the box, the lane
+// adds zero, which doesn't change the sum.
+
+namespace WFMath {
+
+// The loops handle the largest multiple of their width, and return the
+// number of candidates they processed. The mask must be cleared first,
+// and each group of lanes sets its bits in it.
+
+#ifdef WFMATH_AVX_DISPATCH
+WFMATH_TARGET_AVX
+static size_t _IntersectBoxesAVX(const CoordType* low, const CoordType* high,
+                                 const CoordType* const* lo, const CoordType* const* hi,
+                                 int dim, size_t n, bool proper, unsigned* mask)
+{
+  const __m256 eps = _mm256_set1_ps(numeric_constants<CoordType>::epsilon());
+  size_t i = 0;
+
+  for(; i + 8 <= n; i += 8) {
+    __m256 apart = _mm256_setzero_ps();
+    for(int j = 0; j < dim; ++j) {
+      __m256 bl = _mm256_set1_ps(low[j]), bh = _mm256_set1_ps(high[j]);
+      __m256 cl = _mm256_loadu_ps(lo[j] + i), ch = _mm256_loadu_ps(hi[j] + i);
+      if(proper)
+        apart = _mm256_or_ps(apart, _mm256_or_ps(_mm256_cmp_ps(bl, ch, _CMP_GE_OQ),
+                                                 _mm256_cmp_ps(bh, cl, _CMP_LE_OQ)));
+      else
+        apart = _mm256_or_ps(apart,
+            _mm256_or_ps(_mm256_cmp_ps(_mm256_sub_ps(bl, ch), eps, _CMP_GT_OQ),
+                         _mm256_cmp_ps(_mm256_sub_ps(cl, bh), eps, _CMP_GT_OQ)));
+    }
+    mask[i / 32] |= (unsigned) (~_mm256_movemask_ps(apart) & 0xff) << (i % 32);
+  }
+  return i;
+}
+
+WFMATH_TARGET_AVX
+static size_t _IntersectBallsAVX(const CoordType* low, const CoordType* high,
+                                 const CoordType* const* c, const CoordType* radii,
+                                 int dim, size_t n, bool proper, unsigned* mask)
+{
+  const __m256 zero = _mm256_setzero_ps();
+  size_t i = 0;
+
+  for(; i + 8 <= n; i += 8) {
+    __m256 dist = zero;
+    for(int j = 0; j < dim; ++j) {
+      __m256 bl = _mm256_set1_ps(low[j]), bh = _mm256_set1_ps(high[j]);
+      __m256 cj = _mm256_loadu_ps(c[j] + i);
+      __m256 above = _mm256_and_ps(_mm256_cmp_ps(cj, bh, _CMP_GT_OQ), _mm256_sub_ps(cj, bh));
+      __m256 d = _Select8(_mm256_cmp_ps(cj, bl, _CMP_LT_OQ), _mm256_sub_ps(cj, bl), above);
+      dist = _mm256_add_ps(dist, _mm256_mul_ps(d, d));
+    }
+    __m256 r = _mm256_loadu_ps(radii + i);
+    __m256 rr = _mm256_mul_ps(r, r);
+    __m256 hit = proper ? _mm256_cmp_ps(dist, rr, _CMP_LT_OQ)
+                        : _mm256_cmp_ps(dist, rr, _CMP_LE_OQ);
+    mask[i / 32] |= (unsigned) _mm256_movemask_ps(hit) << (i % 32);
+  }
+  return i;
+}
+#endif
+
+static size_t _IntersectBoxes(const CoordType* low, const CoordType* high,
+                              const CoordType* const* lo, const CoordType* const* hi,
+                              int dim, size_t n, bool proper, unsigned* mask)
+{
+  size_t i = 0;
+
+#ifdef WFMATH_AVX_DISPATCH
+  if(_CpuHasAVX())
+    i = _IntersectBoxesAVX(low, high, lo, hi, dim, n, proper, mask);
+#endif
+#if defined(__SSE2__)
+  const __m128 eps = _mm_set1_ps(numeric_constants<CoordType>::epsilon());
+
+  for(; i + 4 <= n; i += 4) {
+    __m128 apart = _mm_setzero_ps();
+    for(int j = 0; j < dim; ++j) {
+      __m128 bl = _mm_set1_ps(low[j]), bh = _mm_set1_ps(high[j]);
+      __m128 cl = _mm_loadu_ps(lo[j] + i), ch = _mm_loadu_ps(hi[j] + i);
+      if(proper)
+        apart = _mm_or_ps(apart, _mm_or_ps(_mm_cmpge_ps(bl, ch), _mm_cmple_ps(bh, cl)));
+      else
+        apart = _mm_or_ps(apart, _mm_or_ps(_mm_cmpgt_ps(_mm_sub_ps(bl, ch), eps),
+                                           _mm_cmpgt_ps(_mm_sub_ps(cl, bh), eps)));
+    }
+    mask[i / 32] |= (unsigned) (~_mm_movemask_ps(apart) & 0xf) << (i % 32);
+  }
+#endif
+
+  return i;
+}
+
+static size_t _IntersectBalls(const CoordType* low, const CoordType* high,
+                              const CoordType* const* c, const CoordType* radii,
+                              int dim, size_t n, bool proper, unsigned* mask)
+{
+  size_t i = 0;
+
+#ifdef WFMATH_AVX_DISPATCH
+  if(_CpuHasAVX())
+    i = _IntersectBallsAVX(low, high, c, radii, dim, n, proper, mask);
+#endif
+#if defined(__SSE2__)
+  const __m128 zero = _mm_setzero_ps();
+
+  for(; i + 4 <= n; i += 4) {
+    __m128 dist = zero;
+    for(int j = 0; j < dim; ++j) {
+      __m128 bl = _mm_set1_ps(low[j]), bh = _mm_set1_ps(high[j]);
+      __m128 cj = _mm_loadu_ps(c[j] + i);
+      __m128 above = _mm_and_ps(_mm_cmpgt_ps(cj, bh), _mm_sub_ps(cj, bh));
+      __m128 d = _Select4(_mm_cmplt_ps(cj, bl), _mm_sub_ps(cj, bl), above);
+      dist = _mm_add_ps(dist, _mm_mul_ps(d, d));
+    }
+    __m128 r = _mm_loadu_ps(radii + i);
+    __m128 rr = _mm_mul_ps(r, r);
+    __m128 hit = proper ? _mm_cmplt_ps(dist, rr) : _mm_cmple_ps(dist, rr);
+    mask[i / 32] |= (unsigned) _mm_movemask_ps(hit) << (i % 32);
+  }
+#endif
+
+  return i;
+}
+
+template<int dim>
+size_t IntersectMany(const AxisBox<dim>& b, const PointArray<dim>& lows,
+                     const PointArray<dim>& highs, bool proper, unsigned* mask)
+{
+  assert(lows.size() == highs.size());
+
+  const size_t n = lows.size();
+  std::fill(mask, mask + (n + 31) / 32, 0u);
+
+  const CoordType* lo[dim];
+  const CoordType* hi[dim];
+  for(int j = 0; j < dim; ++j) {
+    lo[j] = lows.elements(j);
+    hi[j] = highs.elements(j);
+  }
+
+  size_t done = _IntersectBoxes(b.lowCorner().elements(), b.highCorner().elements(),
+                                lo, hi, dim, n, proper, mask);
+  for(size_t i = done; i < n; ++i)
+    if(Intersect(b, AxisBox<dim>(lows.get(i), highs.get(i), true), proper))
+      mask[i / 32] |= 1u << (i % 32);
+
+  return _CountHits(mask, n);
+}
+
+template<int dim>
+size_t IntersectMany(const AxisBox<dim>& b, const PointArray<dim>& centers,
+                     const CoordType* radii, bool proper, unsigned* mask)
+{
+  const size_t n = centers.size();
+  std::fill(mask, mask + (n + 31) / 32, 0u);
+
+  const CoordType* c[dim];
+  for(int j = 0; j < dim; ++j)
+    c[j] = centers.elements(j);
+
+  size_t done = _IntersectBalls(b.lowCorner().elements(), b.highCorner().elements(),
+                                c, radii, dim, n, proper, mask);
+  for(size_t i = done; i < n; ++i)
+    if(Intersect(b, Ball<dim>(centers.get(i), radii[i]), proper))
+      mask[i / 32] |= 1u << (i % 32);
+
+  return _CountHits(mask, n);
+}
+
+template size_t IntersectMany<3>(const AxisBox<3>&, const PointArray<3>&,
+                                 const PointArray<3>&, bool, unsigned*);
+template size_t IntersectMany<2>(const AxisBox<2>&, const PointArray<2>&,
+                                 const PointArray<2>&, bool, unsigned*);
+template size_t IntersectMany<3>(const AxisBox<3>&, const PointArray<3>&,
+                                 const CoordType*, bool, unsigned*);
+template size_t IntersectMany<2>(const AxisBox<2>&, const PointArray<2>&,
+                                 const CoordType*, bool, unsigned*);
+
+} // namespace WFMath
@@ -0,0 +1,81 @@
+// intersect_many.h (Intersect() for one box against many candidates)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-17
+
+#ifndef WFMATH_INTERSECT_MANY_H
+#define WFMATH_INTERSECT_MANY_H
+
+#include <wfmath/const.h>
+#include <wfmath/point.h>
+#include <wfmath/axisbox.h>
+#include <wfmath/ball.h>
+#include <wfmath/point_array.h>
+
+#include <cstddef>
+
+namespace WFMath {
+
+// These finish a broadphase, where one box is tested against a list of
+// candidates. The candidates are held as structures of arrays, so that
+// the same axis of consecutive candidates can be loaded into one SIMD
+// register. The answer for each one is written to a bitmap in the same
+// layout as the validity flags of a PointArray<>: bit i % 32 of
+// mask[i / 32] is set if candidate i intersects the box. The mask must
+// hold (n + 31) / 32 words, all of which are overwritten, with the
+// unused bits of the last one cleared.
+//
+// Each bit is exactly what Intersect() gives for that candidate and the
+// box, for either value of proper. The candidates are tested eight at
+// a time with AVX where the processor supports it, four at a time with
+// SSE2 otherwise, and the remainder one at a time.
+
+/// Intersect() for an AxisBox and many AxisBoxes
+/**
+ * Candidate i is the box from lows.get(i) to highs.get(i), which must
+ * be ordered, as for AxisBox(lows.get(i), highs.get(i), true). The two
+ * arrays must have the same size. Returns the number of candidates
+ * which intersect b.
+ **/
+template<int dim>
+size_t IntersectMany(const AxisBox<dim>& b, const PointArray<dim>& lows,
+                     const PointArray<dim>& highs, bool proper, unsigned* mask);
+
+/// Intersect() for an AxisBox and many Balls
+/**
+ * Candidate i is the ball with center centers.get(i) and radius
+ * radii[i], and radii must hold centers.size() values. Returns the
+ * number of candidates which intersect b.
+ **/
+template<int dim>
+size_t IntersectMany(const AxisBox<dim>& b, const PointArray<dim>& centers,
+                     const CoordType* radii, bool proper, unsigned* mask);
+
+/// True if bit i of a mask written by IntersectMany() is set
+inline bool IntersectManyHit(const unsigned* mask, size_t i)
+{
+  return (mask[i / 32] & (1u << (i % 32))) != 0;
+}
+
+} // namespace WFMath
+
+#endif  // WFMATH_INTERSECT_MANY_H
@@ -0,0 +1,110 @@
+// intersect_many_bench.cpp (IntersectMany() benchmark)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-17
+
+// Compares IntersectMany() with calling Intersect() for each candidate,
+// for one AxisBox<3> tested against lists of AxisBoxes and Balls.
+
+#include "const.h"
+#include "point.h"
+#include "axisbox.h"
+#include "ball.h"
+#include "intersect.h"
+#include "intersect_many.h"
+#include "point_array.h"
+#include "randgen.h"
+#include "timestamp.h"
+
+#include <iostream>
+#include <vector>
+
+using namespace WFMath;
+
+static const int candidates = 1024;
+static const int repeats = 2000;
+
+static void report(const char* name, const TimeStamp& start, const TimeStamp& end)
+{
+  long ms = (end - start).milliseconds();
+  std::cout << name << ": " << ms << " ms, "
+            << (ms * 1e6 / ((double) candidates * repeats)) << " ns per candidate"
+            << std::endl;
+}
+
+static Point<3> random_point(MTRand& rand)
+{
+  return Point<3>((CoordType) (rand.rand() * 20 - 10), (CoordType) (rand.rand() * 20 - 10),
+                  (CoordType) (rand.rand() * 20 - 10));
+}
+
+int main()
+{
+  MTRand rand(1);
+
+  AxisBox<3> query(Point<3>(-4, -4, -4), Point<3>(4, 4, 4));
+
+  std::vector<AxisBox<3> > boxes;
+  std::vector<Ball<3> > balls;
+  PointArray<3> lows, highs, centers;
+  std::vector<CoordType> radii;
+  for(int n = 0; n < candidates; ++n) {
+    Point<3> p = random_point(rand);
+    boxes.push_back(AxisBox<3>(p, p + Vector<3>(1, 2, 1), true));
+    lows.push_back(boxes.back().lowCorner());
+    highs.push_back(boxes.back().highCorner());
+    balls.push_back(Ball<3>(random_point(rand), 1));
+    centers.push_back(balls.back().center());
+    radii.push_back(1);
+  }
+
+  std::vector<unsigned> mask((candidates + 31) / 32);
+
+  std::cout << "AxisBox<3> against " << candidates << " candidates, "
+            << repeats << " times" << std::endl;
+
+  size_t hits = 0, many_hits = 0;
+
+  TimeStamp start = TimeStamp::now();
+  for(int r = 0; r < repeats; ++r)
+    for(int n = 0; n < candidates; ++n)
+      hits += Intersect(query, boxes[n], false);
+  report("Intersect(AxisBox<3>, AxisBox<3>)", start, TimeStamp::now());
+
+  start = TimeStamp::now();
+  for(int r = 0; r < repeats; ++r)
+    many_hits += IntersectMany(query, lows, highs, false, &mask[0]);
+  report("IntersectMany(AxisBox<3>, AxisBox<3>)", start, TimeStamp::now());
+
+  start = TimeStamp::now();
+  for(int r = 0; r < repeats; ++r)
+    for(int n = 0; n < candidates; ++n)
+      hits += Intersect(query, balls[n], false);
+  report("Intersect(AxisBox<3>, Ball<3>)", start, TimeStamp::now());
+
+  start = TimeStamp::now();
+  for(int r = 0; r < repeats; ++r)
+    many_hits += IntersectMany(query, centers, &radii[0], false, &mask[0]);
+  report("IntersectMany(AxisBox<3>, Ball<3>)", start, TimeStamp::now());
+
+  return hits == many_hits ? 0 : 1;
+}
@@ -0,0 +1,231 @@
+// intersect_many_test.cpp (IntersectMany() test functions)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-17
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#ifndef DEBUG
+#define DEBUG
+#endif
+
+#include "const.h"
+#include "point.h"
+#include "axisbox.h"
+#include "ball.h"
+#include "intersect.h"
+#include "intersect_many.h"
+#include "point_array.h"
+#include "randgen.h"
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+#include <cassert>
+
+using namespace WFMath;
+
+// Coordinates on a grid of quarters, so that boxes and balls often
+// touch exactly, where proper makes a difference, and now and then
+// nudged by a little more or less than epsilon
+static CoordType random_coord(MTRand& rand, CoordType low, CoordType high)
+{
+  CoordType val = low + (high - low) * (CoordType) rand.rand();
+  val = (CoordType) (int) (val * 4) / 4;
+
+  switch(rand.randInt(7)) {
+    case 0:
+      return val + numeric_constants<CoordType>::epsilon() / 2;
+    case 1:
+      return val - numeric_constants<CoordType>::epsilon() * 2;
+    default:
+      return val;
+  }
+}
+
+template<int dim>
+static Point<dim> random_point(MTRand& rand)
+{
+  Point<dim> p;
+  p.setToOrigin();
+  for(int i = 0; i < dim; ++i)
+    p[i] = random_coord(rand, -3, 3);
+  return p;
+}
+
+template<int dim>
+static Vector<dim> random_size(MTRand& rand)
+{
+  Vector<dim> v;
+  for(int i = 0; i < dim; ++i)
+    v[i] = std::max(random_coord(rand, 0, 2), (CoordType) 0);
+  v.setValid();
+  return v;
+}
+
+// Each bit must match Intersect(), and the unused bits of the last
+// word must be clear
+static void check_mask(const std::vector<unsigned>& mask, const std::vector<bool>& expected,
+                       size_t hits)
+{
+  size_t n = expected.size(), count = 0;
+
+  for(size_t i = 0; i < n; ++i) {
+    assert(IntersectManyHit(&mask[0], i) == expected[i]);
+    if(expected[i])
+      ++count;
+  }
+  assert(hits == count);
+
+  if(n % 32 != 0)
+    assert((mask[n / 32] >> (n % 32)) == 0);
+}
+
+template<int dim>
+static void test_boxes(MTRand& rand, size_t n, int& hits, int& proper_misses)
+{
+  AxisBox<dim> b(random_point<dim>(rand), random_point<dim>(rand));
+  PointArray<dim> lows, highs;
+  std::vector<AxisBox<dim> > boxes;
+
+  for(size_t i = 0; i < n; ++i) {
+    Point<dim> low = random_point<dim>(rand);
+    AxisBox<dim> box(low, low + random_size<dim>(rand), true);
+    boxes.push_back(box);
+    lows.push_back(box.lowCorner());
+    highs.push_back(box.highCorner());
+  }
+
+  for(int j = 0; j < 2; ++j) {
+    bool proper = (j == 1);
+    std::vector<unsigned> mask((n + 31) / 32 + 1, ~0u);
+    std::vector<bool> expected(n);
+
+    for(size_t i = 0; i < n; ++i) {
+      expected[i] = Intersect(b, boxes[i], proper);
+      hits += expected[i];
+      proper_misses += proper && !expected[i] && Intersect(b, boxes[i], false);
+    }
+
+    check_mask(mask, expected, IntersectMany(b, lows, highs, proper, &mask[0]));
+    // Only the words it needs are written
+    assert(mask.back() == ~0u);
+  }
+}
+
+template<int dim>
+static void test_balls(MTRand& rand, size_t n, int& hits, int& proper_misses)
+{
+  AxisBox<dim> b(random_point<dim>(rand), random_point<dim>(rand));
+  PointArray<dim> centers;
+  std::vector<CoordType> radii;
+  std::vector<Ball<dim> > balls;
+
+  for(size_t i = 0; i < n; ++i) {
+    Ball<dim> ball(random_point<dim>(rand), std::max(random_coord(rand, 0, 2), (CoordType) 0));
+    balls.push_back(ball);
+    centers.push_back(ball.center());
+    radii.push_back(ball.radius());
+  }
+
+  for(int j = 0; j < 2; ++j) {
+    bool proper = (j == 1);
+    std::vector<unsigned> mask((n + 31) / 32 + 1, ~0u);
+    std::vector<bool> expected(n);
+
+    for(size_t i = 0; i < n; ++i) {
+      expected[i] = Intersect(b, balls[i], proper);
+      hits += expected[i];
+      proper_misses += proper && !expected[i] && Intersect(b, balls[i], false);
+    }
+
+    check_mask(mask, expected, IntersectMany(b, centers, radii.empty() ? 0 : &radii[0],
+                                             proper, &mask[0]));
+    assert(mask.back() == ~0u);
+  }
+}
+
+template<int dim>
+static void test_random(MTRand& rand)
+{
+  std::cout << "Testing " << dim << "D boxes against many candidates" << std::endl;
+
+  // Sizes on both sides of the SIMD widths and the mask words
+  const size_t sizes[] = {0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 200};
+
+  int box_hits = 0, box_proper_misses = 0, ball_hits = 0, ball_proper_misses = 0;
+
+  for(int k = 0; k < 20; ++k) {
+    for(size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+      test_boxes<dim>(rand, sizes[s], box_hits, box_proper_misses);
+      test_balls<dim>(rand, sizes[s], ball_hits, ball_proper_misses);
+    }
+  }
+
+  // Both answers, and shapes which only touch, must have come up
+  assert(box_hits > 1000 && box_proper_misses > 100);
+  assert(ball_hits > 1000 && ball_proper_misses > 10);
+}
+
+static void test_exact()
+{
+  std::cout << "Testing many candidates against fixed shapes" << std::endl;
+
+  AxisBox<2> b(Point<2>(0, 0), Point<2>(1, 1));
+  PointArray<2> lows, highs, centers;
+  std::vector<CoordType> radii;
+
+  // Nine boxes in a row along x, the first overlapping b, the second
+  // touching its right side, and the rest clear of it
+  for(int i = 0; i < 9; ++i) {
+    lows.push_back(Point<2>((CoordType) i * 0.5f + 0.5f, 0.5f));
+    highs.push_back(Point<2>((CoordType) i * 0.5f + 1, 2));
+    // Balls of radius 1 along the line through the top of b, the
+    // first centered on its corner and the second touching it there
+    centers.push_back(Point<2>(1 + (CoordType) i, 1));
+    radii.push_back(1);
+  }
+
+  unsigned mask;
+  assert(IntersectMany(b, lows, highs, false, &mask) == 2);
+  assert(mask == 0x3);
+  assert(IntersectMany(b, lows, highs, true, &mask) == 1);
+  assert(mask == 0x1);
+
+  assert(IntersectMany(b, centers, &radii[0], false, &mask) == 2);
+  assert(mask == 0x3);
+  assert(IntersectMany(b, centers, &radii[0], true, &mask) == 1);
+  assert(mask == 0x1);
+}
+
+int main()
+{
+  MTRand rand(19);
+
+  test_random<2>(rand);
+  test_random<3>(rand);
+  test_exact();
+
+  return 0;
+}
@@ -28,8 +28,7 @@
 
 #include <wfmath/const.h>
 #include <wfmath/point.h>
-
-#include <vector>
+#include <wfmath/small_vector.h>
 
 namespace WFMath {
 
@@ -81,7 +80,7 @@ class Line
   /// shape: return the position of the i'th corner, where 0 <= i < numCorners()
   Point<dim> getCorner(size_t i) const {return m_points[i];}
   /// shape: return the position of the center of the shape
-  Point<dim> getCenter() const {return Barycenter(m_points);}
+  Point<dim> getCenter() const {return Barycenter(m_points.data(), m_points.size());}
 
   // Add before i'th corner, zero is beginning, numCorners() is end
   bool addCorner(size_t i, const Point<dim>& p, CoordType = numeric_constants<CoordType>::epsilon())
@@ -132,15 +131,16 @@ class Line
    **/
   Line& rotatePoint(const RotMatrix<dim>& m, const Point<dim>& p);
 
-  AxisBox<dim> boundingBox() const {return BoundingBox(m_points);}
-  Ball<dim> boundingSphere() const {return BoundingSphere(m_points);}
-  Ball<dim> boundingSphereSloppy() const {return BoundingSphereSloppy(m_points);}
+  AxisBox<dim> boundingBox() const {return BoundingBox(m_points.data(), m_points.size());}
+  Ball<dim> boundingSphere() const {return BoundingSphere(m_points.data(), m_points.size());}
+  Ball<dim> boundingSphereSloppy() const {return BoundingSphereSloppy(m_points.data(), m_points.size());}
 
  private:
-  std::vector<Point<dim> > m_points;
-  typedef typename std::vector<Point<dim> >::iterator iterator;
-  typedef typename std::vector<Point<dim> >::const_iterator const_iterator;
-  typedef typename std::vector<Point<dim> >::size_type size_type;
+  typedef _SmallVector<Point<dim>, WFMATH_INLINE_CORNERS> Corners;
+  Corners m_points;
+  typedef typename Corners::iterator iterator;
+  typedef typename Corners::const_iterator const_iterator;
+  typedef typename Corners::size_type size_type;
 };
 
 template<int dim>
@@ -32,58 +32,80 @@
 // 2001-1-9: included in WFMath backend. Namespace wrapping added
 // and filename changed to follow WFMath conventions, but otherwise
 // unchanged.
+//
+// 2026-10-17: the std::list of points replaced by a contiguous array,
+// with move-to-front done on an array of indices, so that building a
+// ball allocates nothing per point. The points can also be used in
+// place, from any array of a type with operator[] for the
+// coordinates, instead of being checked in. With pivoting, the ball
+// is built up from a sample of the points, which saves most of the
+// passes over all of them.
 
 #ifndef WFMATH_MINIBALL_H
 #define WFMATH_MINIBALL_H
 
-#include <list>
+#include <vector>
 #include <wfmath/wrapped_array.h>
 
 namespace WFMath { namespace _miniball {
 
-    template <int d> class Miniball;
+    template <int d, class P> class Miniball;
     template <int d> class Basis;
 
     // Miniball
     // --------
     
-    template <int d>
+    // The points live in one array, either the ball's own, filled by
+    // check_in(), or the caller's, given to use_points(). Their order
+    // is kept as an array of indices into it, and positions in that
+    // order take the place of the list iterators of the original.
+    // With pivoting, build() only puts the points it needs into the
+    // order, see miniball_funcs.h.
+    template <int d, class P = Wrapped_array<d> >
     class Miniball {
         public:
             // types
-            typedef Wrapped_array<d>                            Point;
-            typedef typename std::list<Point>::iterator         It;
-            typedef typename std::list<Point>::const_iterator   Cit;
+            typedef P                                           Point;
     
         private:
             // data members
-            std::list<Point> L;         // STL list keeping the points
+            std::vector<Point> L;       // points checked in
+            const Point* pts;           // the points in use, L's or the caller's
+            int         n;              // number of points in use
+            std::vector<int> order;     // indices into pts, in move-to-front order
+            std::vector<int> cand;      // indices of points which may be outside
+            std::vector<double> ex;     // excess of each point, while finding cand
             Basis<d>    B;              // basis keeping the current ball
-            It          support_end;    // past-the-end iterator of support set
+            int         support_end;    // past-the-end position of support set
     
             // private methods
-            void        mtf_mb (It k);
-            void        pivot_mb (It k);
-            void        move_to_front (It j);
-            double      max_excess (It t, It i, It& pivot) const;
+            const Point& at (int k) const {return pts[order[k]];}
+            void        mtf_mb (int k);
+            void        pivot_mb (int k);
+            bool        add_outside_sample (int step);
+            bool        add_outside (bool first);
+            void        move_to_front (int j);
+            double      max_excess (int t, int i, int& pivot) const;
             double      abs (double r) const {return (r>0)? r: (-r);}
             double      sqr (double r) const {return r*r;}
     
         public:
             // construction
-            Miniball() : L(), B(), support_end() {}
+            Miniball() : L(), pts(0), n(0), order(), cand(), ex(), B(), support_end(0) {}
+            void        reserve (int size) {L.reserve(size);}
             void        check_in (const Point& p);
+            // use the size points at p, which must outlive the ball,
+            // instead of any checked in
+            void        use_points (const Point* p, int size);
             void        build (bool pivoting = true);
     
             // access
-            Point       center() const;
+            const double* center() const;
             double      squared_radius () const;
             int         nr_points () const;
-            Cit         points_begin () const;
-            Cit         points_end () const;
+            const Point& point (int i) const {return pts[i];}
             int         nr_support_points () const;
-            Cit         support_points_begin () const;
-            Cit         support_points_end () const;
+            const Point& support_point (int i) const {return at(i);}
     
             // checking
             double      accuracy (double& slack) const;
@@ -98,9 +120,6 @@ namespace WFMath { namespace _miniball {
     template <int d>
     class Basis {
         private:
-            // types
-            typedef Wrapped_array<d>            Point;
-    
             // data members
             int                 m, s;   // size and number of support points
             double              q0[d];
@@ -126,11 +145,13 @@ namespace WFMath { namespace _miniball {
             double              squared_radius() const;
             int                 size() const;
             int                 support_size() const;
-            double              excess (const Point& p) const;
+            template <class P>
+            double              excess (const P& p) const;
     
             // modification
             void                reset(); // generates empty sphere with m=s=0
-            bool                push (const Point& p);
+            template <class P>
+            bool                push (const P& p);
             void                pop ();
     
             // checking
@@ -32,10 +32,15 @@
 // 2001-1-9: included in WFMath backend. Namespace wrapping added
 // and filename changed to follow WFMath conventions, but otherwise
 // unchanged.
+//
+// 2026-10-17: Miniball rewritten over a contiguous array, see
+// miniball.h.
 
 #ifndef WFMATH_MINIBALL_FUNCS_H
 #define WFMATH_MINIBALL_FUNCS_H
 
+#include <algorithm>
+#include <cmath>
 #include <cassert>
 
 namespace WFMath { namespace _miniball {
@@ -43,34 +48,151 @@ namespace WFMath { namespace _miniball {
    // Miniball
    // --------
    
-   template <int d>
-   void Miniball<d>::check_in (const Point& p)
+   template <int d, class P>
+   void Miniball<d,P>::check_in (const Point& p)
    {
        L.push_back(p);
+       pts = &L[0];
+       n = L.size();
    }
    
    
-   template <int d>
-   void Miniball<d>::build (bool pivoting)
+   template <int d, class P>
+   void Miniball<d,P>::use_points (const Point* p, int size)
+   {
+       pts = p;
+       n = size;
+   }
+   
+   
+   // With pivoting, the ball is first built for an evenly spread
+   // sample of about 4 sqrt(n) of the points. The points outside it
+   // in samples four times as dense are added to the order, and the
+   // ball rebuilt, and then the same for all of the points, over and
+   // over, until none are left. By then the ball is usually close
+   // enough that the last passes only look at a few of the points.
+   template <int d, class P>
+   void Miniball<d,P>::build (bool pivoting)
    {
        B.reset();
-       support_end = L.begin();
-       if (pivoting)
-           pivot_mb (L.end());
-       else
-           mtf_mb (L.end());
+       support_end = 0;
+       if (!pivoting) {
+           order.resize(n);
+           for (int k=0; k<n; ++k)
+               order[k] = k;
+           mtf_mb (n);
+           return;
+       }
+   
+       int step = std::max(1, int(std::sqrt(double(n))) / 4);
+       order.clear();
+       for (int k=0; k<n; k+=step)
+           order.push_back(k);
+       pivot_mb (order.size());
+       if (step == 1)
+           return;
+   
+       for (step /= 4; step > 1; step /= 4) {
+           if (add_outside_sample (step)) {
+               B.reset();
+               pivot_mb (order.size());
+           }
+       }
+   
+       cand.clear();
+       double old_sqr_r = B.squared_radius();
+       for (bool first = true; add_outside (first); first = false) {
+           B.reset();
+           pivot_mb (order.size());
+           // as in pivot_mb(), stop when the ball has stopped growing
+           if (B.squared_radius() <= old_sqr_r)
+               break;
+           old_sqr_r = B.squared_radius();
+       }
    }
    
    
-   template <int d>
-   void Miniball<d>::mtf_mb (It i)
+   // Add every step'th point which is outside the ball to the end of
+   // the order, and return whether there were any
+   template <int d, class P>
+   bool Miniball<d,P>::add_outside_sample (int step)
+   {
+       const double *c = B.center(), sqr_r = B.squared_radius();
+       size_t old_size = order.size();
+   
+       for (int k=0; k<n; k+=step) {
+           const Point& p = pts[k];
+           double e = -sqr_r;
+           for (int j=0; j<d; ++j)
+               e += sqr(p[j]-c[j]);
+           if (e > 0)
+               order.push_back(k);
+       }
+       return order.size() > old_size;
+   }
+   
+   
+   // Add the points outside the ball to the end of the order, and
+   // return whether there were any. Every ball built after this one
+   // contains its support set, so if its radius is r and a later one's
+   // is r', their centers are at most sqrt(r'^2 - r^2) apart. That's
+   // no more than the radius R of the ball around the same center
+   // which holds every point, so a point closer to the center than
+   // R - sqrt(R^2 - r^2) is inside all of them. The first call looks
+   // at every point, and keeps the others as the candidates for the
+   // calls after it.
+   template <int d, class P>
+   bool Miniball<d,P>::add_outside (bool first)
+   {
+       const double *c = B.center(), sqr_r = B.squared_radius();
+       size_t old_size = order.size();
+   
+       if (!first) {
+           for (size_t m=0; m<cand.size(); ++m) {
+               const Point& p = pts[cand[m]];
+               double e = -sqr_r;
+               for (int j=0; j<d; ++j)
+                   e += sqr(p[j]-c[j]);
+               if (e > 0)
+                   order.push_back(cand[m]);
+           }
+           return order.size() > old_size;
+       }
+   
+       ex.resize(n);
+       double max_e = 0;
+       for (int k=0; k<n; ++k) {
+           const Point& p = pts[k];
+           double e = -sqr_r;
+           for (int j=0; j<d; ++j)
+               e += sqr(p[j]-c[j]);
+           ex[k] = e;
+           if (e > max_e)
+               max_e = e;
+       }
+   
+       // R^2 - r^2 is max_e, and the margin covers rounding
+       double safe = std::sqrt(sqr_r + max_e) - std::sqrt(max_e);
+       double limit = sqr(safe) * (1 - 1e-6) - sqr_r;
+       for (int k=0; k<n; ++k) {
+           if (ex[k] > limit)
+               cand.push_back(k);
+           if (ex[k] > 0)
+               order.push_back(k);
+       }
+       return order.size() > old_size;
+   }
+   
+   
+   template <int d, class P>
+   void Miniball<d,P>::mtf_mb (int i)
    {
-       support_end = L.begin();
+       support_end = 0;
        if ((B.size())==d+1) return;
-       for (It k=L.begin(); k!=i;) {
-           It j=k++;
-           if (B.excess(*j) > 0) {
-               if (B.push(*j)) {
+       for (int k=0; k!=i;) {
+           int j=k++;
+           if (B.excess(at(j)) > 0) {
+               if (B.push(at(j))) {
                    mtf_mb (j);
                    B.pop();
                    move_to_front(j);
@@ -79,44 +201,51 @@ namespace WFMath { namespace _miniball {
        }
    }
    
-   template <int d>
-   void Miniball<d>::move_to_front (It j)
+   // Moving position j to the front shifts every position before it
+   // up one, which leaves the positions after it alone
+   template <int d, class P>
+   void Miniball<d,P>::move_to_front (int j)
    {
-       if (support_end == j)
+       if (support_end <= j)
            support_end++;
-       L.splice (L.begin(), L, j);
+       int index = order[j];
+       std::copy_backward (order.begin(), order.begin()+j, order.begin()+j+1);
+       order[0] = index;
    }
    
    
-   template <int d>
-   void Miniball<d>::pivot_mb (It i)
+   template <int d, class P>
+   void Miniball<d,P>::pivot_mb (int i)
    {
-       It t = ++L.begin();
+       int t = std::min(1, i);
        mtf_mb (t);
        double max_e, old_sqr_r;
        do {
-           It pivot;
+           int pivot = t;
            max_e = max_excess (t, i, pivot);
            if (max_e <= 0)
                break;
+           // the pivot is outside the ball, so after the support set,
+           // and t is either before it or just after it
            t = support_end;
            if (t==pivot) ++t;
            old_sqr_r = B.squared_radius();
-           B.push (*pivot);
+           B.push (at(pivot));
            mtf_mb (support_end);
            B.pop();
            move_to_front (pivot);
+           if (t < pivot) ++t;
        } while (B.squared_radius() > old_sqr_r);
    }
    
    
-   template <int d>
-   double Miniball<d>::max_excess (It t, It i, It& pivot) const
+   template <int d, class P>
+   double Miniball<d,P>::max_excess (int t, int i, int& pivot) const
    {
        const double *c = B.center(), sqr_r = B.squared_radius();
        double e, max_e = 0;
-       for (It k=t; k!=i; ++k) {
-           const double *p = (*k).begin();
+       for (int k=t; k!=i; ++k) {
+           const Point& p = at(k);
            e = -sqr_r;
            for (int j=0; j<d; ++j)
                e += sqr(p[j]-c[j]);
@@ -130,73 +259,50 @@ namespace WFMath { namespace _miniball {
    
    
    
-   template <int d>
-   typename Miniball<d>::Point Miniball<d>::center () const
+   template <int d, class P>
+   const double* Miniball<d,P>::center () const
    {
-       return Point(B.center());
+       return B.center();
    }
    
-   template <int d>
-   double Miniball<d>::squared_radius () const
+   template <int d, class P>
+   double Miniball<d,P>::squared_radius () const
    {
        return B.squared_radius();
    }
    
    
-   template <int d>
-   int Miniball<d>::nr_points () const
-   {
-       return L.size();
-   }
-   
-   template <int d>
-   typename Miniball<d>::Cit Miniball<d>::points_begin () const
-   {
-       return L.begin();
-   }
-   
-   template <int d>
-   typename Miniball<d>::Cit Miniball<d>::points_end () const
+   template <int d, class P>
+   int Miniball<d,P>::nr_points () const
    {
-       return L.end();
+       return n;
    }
    
    
-   template <int d>
-   int Miniball<d>::nr_support_points () const
+   template <int d, class P>
+   int Miniball<d,P>::nr_support_points () const
    {
        return B.support_size();
    }
    
-   template <int d>
-   typename Miniball<d>::Cit Miniball<d>::support_points_begin () const
-   {
-       return L.begin();
-   }
-   
-   template <int d>
-   typename Miniball<d>::Cit Miniball<d>::support_points_end () const
-   {
-       return support_end;
-   }
-   
    
    
-   template <int d>
-   double Miniball<d>::accuracy (double& slack) const
+   template <int d, class P>
+   double Miniball<d,P>::accuracy (double& slack) const
    {
        double e, max_e = 0;
        int n_supp=0;
-       Cit i;
-       for (i=L.begin(); i!=support_end; ++i,++n_supp)
-           if ((e = abs (B.excess (*i))) > max_e)
+       int i;
+       for (i=0; i!=support_end; ++i,++n_supp)
+           if ((e = abs (B.excess (at(i)))) > max_e)
                max_e = e;
    
        // you've found a non-numerical problem if the following ever fails
        assert (n_supp == nr_support_points());
    
-       for (i=support_end; i!=L.end(); ++i)
-          if ((e = B.excess (*i)) > max_e)
+       // the order may not hold every point, so look at them all
+       for (i=0; i!=n; ++i)
+          if ((e = B.excess (pts[i])) > max_e)
                max_e = e;
    
        slack = B.slack();
@@ -204,8 +310,8 @@ namespace WFMath { namespace _miniball {
    }
    
    
-   template <int d>
-   bool Miniball<d>::is_valid (double tolerance) const
+   template <int d, class P>
+   bool Miniball<d,P>::is_valid (double tolerance) const
    {
        double slack;
        return ( (accuracy (slack) < tolerance) && (slack == 0) );
@@ -241,7 +347,8 @@ namespace WFMath { namespace _miniball {
    }
    
    template <int d>
-   double Basis<d>::excess (const Point& p) const
+   template <class P>
+   double Basis<d>::excess (const P& p) const
    {
        double e = -current_sqr_r;
        for (int k=0; k<d; ++k)
@@ -278,7 +385,8 @@ namespace WFMath { namespace _miniball {
    
    
    template <int d>
-   bool Basis<d>::push (const Point& p)
+   template <class P>
+   bool Basis<d>::push (const P& p)
    {
        int i, j;
        double eps = 1e-32;
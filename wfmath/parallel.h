@@ -0,0 +1,91 @@
+// parallel.h (Splitting a loop over an array between threads)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-17
+
+// Only included by the library's own source files, for the functions
+// which take a threads argument. A reduction runs a loop over each
+// slice into its own result, and combines the results afterwards.
+
+#ifndef WFMATH_PARALLEL_H
+#define WFMATH_PARALLEL_H
+
+#include <algorithm>
+#include <functional>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <cstddef>
+
+namespace WFMath {
+
+// The number of slices to split n elements into. If threads is zero,
+// that's as many as the hardware has threads, but no more than one
+// for each min_per_thread elements, below which starting a thread
+// costs more than it saves.
+inline unsigned _NumThreads(size_t n, unsigned threads, size_t min_per_thread)
+{
+  if(threads == 0) {
+    // Asking the hardware can mean a system call, so small sets don't
+    if(n < 2 * min_per_thread)
+      return 1;
+    static const unsigned hardware = std::thread::hardware_concurrency();
+    threads = hardware;
+    threads = (unsigned) std::min<size_t>(threads, n / min_per_thread);
+  }
+  return (unsigned) std::max<size_t>(1, std::min<size_t>(threads, n));
+}
+
+// Call f(begin, end, slice) for each of threads slices of [0, n), the
+// first on the calling thread. If a thread can't be started, its slice
+// is done on the calling thread instead.
+template<class F>
+void _ForSlices(size_t n, unsigned threads, const F& f)
+{
+  if(threads <= 1) {
+    f(0, n, 0);
+    return;
+  }
+
+  std::vector<std::thread> workers;
+  workers.reserve(threads);
+
+  for(unsigned t = 1; t < threads; ++t) {
+    size_t begin = n * t / threads, end = n * (t + 1) / threads;
+    try {
+      workers.push_back(std::thread(std::cref(f), begin, end, t));
+    }
+    catch(const std::system_error&) {
+      f(begin, end, t);
+    }
+  }
+
+  f(0, n / threads, 0);
+
+  for(size_t t = 0; t < workers.size(); ++t)
+    workers[t].join();
+}
+
+} // namespace WFMath
+
+#endif  // WFMATH_PARALLEL_H
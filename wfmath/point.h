@@ -28,8 +28,11 @@
 
 #include <wfmath/const.h>
 
+#include <iterator>
 #include <memory>
 #include <iosfwd>
+#include <type_traits>
+#include <vector>
 
 #include <cmath>
 
@@ -63,9 +66,32 @@ template<int dim>
 CoordType SloppyDistance(const Point<dim>& p1, const Point<dim>& p2)
   {return (p1 - p2).sloppyMag();}
 
+// The containers below may have any allocator; for points in an
+// array or a borrowed buffer, use the pointer overloads. Any other
+// range of points, such as part of a std::deque or a std::list, can be
+// passed as a pair of iterators.
+
+// For the iterator overloads of Barycenter(), BoundingBox() and
+// BoundingSphere(), the dim of the points an iterator refers to. Only
+// iterators to points have it, so the overloads take no others. The
+// points are contiguous, and are passed on to the pointer overloads,
+// for pointers and for std::vector iterators.
+template<class Iter, class T = typename std::iterator_traits<Iter>::value_type>
+struct _PointIterator {};
+
+template<class Iter, int dim>
+struct _PointIterator<Iter, Point<dim> >
+{
+  static const int value = dim;
+  typedef std::integral_constant<bool, std::is_pointer<Iter>::value
+    || std::is_same<Iter, typename std::vector<Point<dim> >::iterator>::value
+    || std::is_same<Iter, typename std::vector<Point<dim> >::const_iterator>::value>
+    contiguous;
+};
+
 /// Find the center of a set of points, all weighted equally
-template<int dim, template<class, class> class container>
-Point<dim> Barycenter(const container<Point<dim>, std::allocator<Point<dim> > >& c);
+template<int dim, template<class, class> class container, class A>
+Point<dim> Barycenter(const container<Point<dim>, A>& c);
 /// Find the center of a set of points with the given weights
 /**
  * If the number of points and the number of weights are not equal,
@@ -74,9 +100,28 @@ Point<dim> Barycenter(const container<Point<dim>, std::allocator<Point<dim> > >&
  * sum to zero.
  **/
 template<int dim, template<class, class> class container,
-      template<class, class> class container2>
-Point<dim> Barycenter(const container<Point<dim>, std::allocator<Point<dim> > >& c,
-          const container2<CoordType, std::allocator<CoordType> >& weights);
+      template<class, class> class container2, class A, class A2>
+Point<dim> Barycenter(const container<Point<dim>, A>& c,
+          const container2<CoordType, A2>& weights);
+/// Find the center of the n points at p, all weighted equally
+/**
+ * This sums in double, with SSE2 where it's available, and splits sets
+ * of more than a few hundred thousand points between threads, as many
+ * as the hardware has, unless threads is nonzero, when it's used
+ * instead.
+ **/
+template<int dim>
+Point<dim> Barycenter(const Point<dim>* p, size_t n, unsigned threads = 0);
+/// Find the center of the n points at p with the n weights at weights
+/**
+ * As for the container version, the weights must not sum to zero.
+ **/
+template<int dim>
+Point<dim> Barycenter(const Point<dim>* p, const CoordType* weights, size_t n,
+                      unsigned threads = 0);
+/// Find the center of the points in [begin, end), all weighted equally
+template<class Iter>
+Point<_PointIterator<Iter>::value> Barycenter(Iter begin, Iter end);
 
 // This is used a couple of places in the library
 template<int dim>
@@ -181,8 +226,11 @@ class Point
   Ball<dim> boundingSphereSloppy() const;
 
   Point toParentCoords(const Point& origin,
-      const RotMatrix<dim>& rotation = RotMatrix<dim>().identity()) const
+      const RotMatrix<dim>& rotation) const
   {return origin + (*this - Point().setToOrigin()) * rotation;}
+  // Same as passing the identity matrix above, without building one
+  Point toParentCoords(const Point& origin) const
+  {return origin + (*this - Point().setToOrigin());}
   Point toParentCoords(const AxisBox<dim>& coords) const;
   Point toParentCoords(const RotBox<dim>& coords) const;
 
@@ -191,8 +239,11 @@ class Point
   // matrix
 
   Point toLocalCoords(const Point& origin,
-      const RotMatrix<dim>& rotation = RotMatrix<dim>().identity()) const
+      const RotMatrix<dim>& rotation) const
   {return Point().setToOrigin() + rotation * (*this - origin);}
+  // Same as passing the identity matrix above, without building one
+  Point toLocalCoords(const Point& origin) const
+  {return Point().setToOrigin() + (*this - origin);}
   Point toLocalCoords(const AxisBox<dim>& coords) const;
   Point toLocalCoords(const RotBox<dim>& coords) const;
 
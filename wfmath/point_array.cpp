@@ -0,0 +1,591 @@
+// point_array.cpp (PointArray<> and VectorArray<> SIMD kernels)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "point_array_funcs.h"
+#include "simd.h"
+
+#include <cmath>
+
+// The vector loops below must give the same answers as the scalar
+// Point<> and Vector<> functions, so the order of the additions in
+// each lane matches theirs, and the epsilon used by Dot() and
+// SquaredDistance() is computed from the exponent bits directly,
+// the same way _ScaleEpsilon() does. For normal numbers, masking the
+// exponent bits of x gives 2^(e-1), where e is the exponent frexp()
+// returns, so ldexp(epsilon, e) == 2 * epsilon * (x & exponent mask).
+// Lanes where the smaller value is a nonzero denormal are redone with
+// the scalar code.
+
+namespace WFMath {
+
+static const int _FloatExponentMask = 0x7f800000;
+
+static inline CoordType _DotOne(const CoordType* const* a, const CoordType* v,
+                                int dim, size_t i, CoordType vmax)
+{
+  CoordType ans = 0, amax = 0;
+  for(int j = 0; j < dim; ++j) {
+    CoordType val = std::fabs(a[j][i]);
+    if(val > amax)
+      amax = val;
+    ans += a[j][i] * v[j];
+  }
+  return (std::fabs(ans) >= _ScaleEpsilon(amax, vmax,
+          numeric_constants<CoordType>::epsilon())) ? ans : 0;
+}
+
+static inline CoordType _SquaredDistanceOne(const CoordType* const* a,
+                                            const CoordType* p, int dim,
+                                            size_t i, CoordType pmax)
+{
+  CoordType ans = 0, amax = 0;
+  for(int j = 0; j < dim; ++j) {
+    CoordType val = std::fabs(a[j][i]);
+    if(val > amax)
+      amax = val;
+    CoordType diff = a[j][i] - p[j];
+    ans += diff * diff;
+  }
+  return (std::fabs(ans) >= _ScaleEpsilon(amax, pmax,
+          numeric_constants<CoordType>::epsilon())) ? ans : 0;
+}
+
+static inline CoordType _MaxAbs(const CoordType* v, int dim)
+{
+  CoordType max = 0;
+  for(int j = 0; j < dim; ++j) {
+    CoordType val = std::fabs(v[j]);
+    if(val > max)
+      max = val;
+  }
+  return max;
+}
+
+bool _CpuHasAVX()
+{
+#ifdef WFMATH_AVX_DISPATCH
+  static const bool has_avx = (__builtin_cpu_init(), __builtin_cpu_supports("avx"));
+  return has_avx;
+#else
+  return false;
+#endif
+}
+
+#ifdef WFMATH_AVX_DISPATCH
+// Each of these handles the largest multiple of 8 elements, and
+// returns the number of elements it processed.
+
+WFMATH_TARGET_AVX
+static size_t _ArrayAddConstAVX(CoordType* a, CoordType c, size_t n)
+{
+  size_t i = 0;
+  __m256 c8 = _mm256_set1_ps(c);
+  for(; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(a + i, _mm256_add_ps(_mm256_loadu_ps(a + i), c8));
+  }
+  return i;
+}
+
+WFMATH_TARGET_AVX
+static size_t _ArrayAddAVX(CoordType* a, const CoordType* b, size_t n)
+{
+  size_t i = 0;
+  for(; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(a + i, _mm256_add_ps(_mm256_loadu_ps(a + i),
+                                          _mm256_loadu_ps(b + i)));
+  }
+  return i;
+}
+
+WFMATH_TARGET_AVX
+static size_t _ArraySubAVX(CoordType* a, const CoordType* b, size_t n)
+{
+  size_t i = 0;
+  for(; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(a + i, _mm256_sub_ps(_mm256_loadu_ps(a + i),
+                                          _mm256_loadu_ps(b + i)));
+  }
+  return i;
+}
+
+WFMATH_TARGET_AVX
+static size_t _ArrayScaleAVX(CoordType* a, CoordType c, size_t n)
+{
+  size_t i = 0;
+  __m256 c8 = _mm256_set1_ps(c);
+  for(; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(a + i, _mm256_mul_ps(_mm256_loadu_ps(a + i), c8));
+  }
+  return i;
+}
+
+WFMATH_TARGET_AVX
+static inline __m256 _Fabs8(__m256 x)
+{
+  return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x);
+}
+
+// Sets *denormal if any lane of the smaller value needs the scalar code
+WFMATH_TARGET_AVX
+static inline __m256 _ScaleEpsilon8(__m256 max1, __m256 max2, bool* denormal)
+{
+  __m256 smaller = _mm256_min_ps(max1, max2);
+  __m256 pow2 = _mm256_and_ps(smaller,
+      _mm256_castsi256_ps(_mm256_set1_epi32(_FloatExponentMask)));
+  __m256 zero = _mm256_setzero_ps();
+  *denormal = _mm256_movemask_ps(_mm256_and_ps(
+      _mm256_cmp_ps(pow2, zero, _CMP_EQ_OQ),
+      _mm256_cmp_ps(smaller, zero, _CMP_NEQ_OQ))) != 0;
+  return _mm256_mul_ps(pow2, _mm256_set1_ps(2 * numeric_constants<CoordType>::epsilon()));
+}
+
+WFMATH_TARGET_AVX
+static size_t _ArrayDotAVX(const CoordType* const* a, const CoordType* v,
+                           int dim, size_t n, CoordType vmax, CoordType* out)
+{
+  size_t i = 0;
+  __m256 vmax8 = _mm256_set1_ps(vmax);
+  for(; i + 8 <= n; i += 8) {
+    __m256 ans = _mm256_setzero_ps(), amax = _mm256_setzero_ps();
+    for(int j = 0; j < dim; ++j) {
+      __m256 aj = _mm256_loadu_ps(a[j] + i);
+      amax = _mm256_max_ps(amax, _Fabs8(aj));
+      ans = _mm256_add_ps(ans, _mm256_mul_ps(aj, _mm256_set1_ps(v[j])));
+    }
+    bool denormal;
+    __m256 delta = _ScaleEpsilon8(amax, vmax8, &denormal);
+    __m256 keep = _mm256_cmp_ps(_Fabs8(ans), delta, _CMP_GE_OQ);
+    _mm256_storeu_ps(out + i, _mm256_and_ps(ans, keep));
+    if(denormal) {
+      for(size_t k = i; k < i + 8; ++k)
+        out[k] = _DotOne(a, v, dim, k, vmax);
+    }
+  }
+  return i;
+}
+
+WFMATH_TARGET_AVX
+static size_t _ArraySqrMagAVX(const CoordType* const* a, int dim, size_t n,
+                              CoordType* out)
+{
+  size_t i = 0;
+  for(; i + 8 <= n; i += 8) {
+    __m256 ans = _mm256_setzero_ps();
+    for(int j = 0; j < dim; ++j) {
+      __m256 aj = _mm256_loadu_ps(a[j] + i);
+      ans = _mm256_add_ps(ans, _mm256_mul_ps(aj, aj));
+    }
+    _mm256_storeu_ps(out + i, ans);
+  }
+  return i;
+}
+
+WFMATH_TARGET_AVX
+static size_t _ArraySquaredDistanceAVX(const CoordType* const* a,
+                                       const CoordType* p, int dim, size_t n,
+                                       CoordType pmax, CoordType* out)
+{
+  size_t i = 0;
+  __m256 pmax8 = _mm256_set1_ps(pmax);
+  for(; i + 8 <= n; i += 8) {
+    __m256 ans = _mm256_setzero_ps(), amax = _mm256_setzero_ps();
+    for(int j = 0; j < dim; ++j) {
+      __m256 aj = _mm256_loadu_ps(a[j] + i);
+      __m256 diff = _mm256_sub_ps(aj, _mm256_set1_ps(p[j]));
+      amax = _mm256_max_ps(amax, _Fabs8(aj));
+      ans = _mm256_add_ps(ans, _mm256_mul_ps(diff, diff));
+    }
+    bool denormal;
+    __m256 delta = _ScaleEpsilon8(amax, pmax8, &denormal);
+    __m256 keep = _mm256_cmp_ps(ans, delta, _CMP_GE_OQ);
+    _mm256_storeu_ps(out + i, _mm256_and_ps(ans, keep));
+    if(denormal) {
+      for(size_t k = i; k < i + 8; ++k)
+        out[k] = _SquaredDistanceOne(a, p, dim, k, pmax);
+    }
+  }
+  return i;
+}
+#endif
+
+#if defined(__SSE2__)
+static inline __m128 _Fabs4(__m128 x)
+{
+  return _mm_andnot_ps(_mm_set1_ps(-0.0f), x);
+}
+
+// Sets *denormal if any lane of the smaller value needs the scalar code
+static inline __m128 _ScaleEpsilon4(__m128 max1, __m128 max2, bool* denormal)
+{
+  __m128 smaller = _mm_min_ps(max1, max2);
+  __m128 pow2 = _mm_and_ps(smaller,
+      _mm_castsi128_ps(_mm_set1_epi32(_FloatExponentMask)));
+  __m128 zero = _mm_setzero_ps();
+  *denormal = _mm_movemask_ps(_mm_and_ps(_mm_cmpeq_ps(pow2, zero),
+                                         _mm_cmpneq_ps(smaller, zero))) != 0;
+  return _mm_mul_ps(pow2, _mm_set1_ps(2 * numeric_constants<CoordType>::epsilon()));
+}
+#endif
+
+void _ArrayAddConst(CoordType* a, CoordType c, size_t n)
+{
+  size_t i = 0;
+
+#ifdef WFMATH_AVX_DISPATCH
+  if(_CpuHasAVX())
+    i = _ArrayAddConstAVX(a, c, n);
+#endif
+#if defined(__SSE2__)
+  __m128 c4 = _mm_set1_ps(c);
+  for(; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(a + i, _mm_add_ps(_mm_loadu_ps(a + i), c4));
+  }
+#endif
+  for(; i < n; ++i) {
+    a[i] += c;
+  }
+}
+
+void _ArrayAdd(CoordType* a, const CoordType* b, size_t n)
+{
+  size_t i = 0;
+
+#ifdef WFMATH_AVX_DISPATCH
+  if(_CpuHasAVX())
+    i = _ArrayAddAVX(a, b, n);
+#endif
+#if defined(__SSE2__)
+  for(; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(a + i, _mm_add_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+  }
+#endif
+  for(; i < n; ++i) {
+    a[i] += b[i];
+  }
+}
+
+void _ArraySub(CoordType* a, const CoordType* b, size_t n)
+{
+  size_t i = 0;
+
+#ifdef WFMATH_AVX_DISPATCH
+  if(_CpuHasAVX())
+    i = _ArraySubAVX(a, b, n);
+#endif
+#if defined(__SSE2__)
+  for(; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(a + i, _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+  }
+#endif
+  for(; i < n; ++i) {
+    a[i] -= b[i];
+  }
+}
+
+void _ArrayScale(CoordType* a, CoordType c, size_t n)
+{
+  size_t i = 0;
+
+#ifdef WFMATH_AVX_DISPATCH
+  if(_CpuHasAVX())
+    i = _ArrayScaleAVX(a, c, n);
+#endif
+#if defined(__SSE2__)
+  __m128 c4 = _mm_set1_ps(c);
+  for(; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(a + i, _mm_mul_ps(_mm_loadu_ps(a + i), c4));
+  }
+#endif
+  for(; i < n; ++i) {
+    a[i] *= c;
+  }
+}
+
+void _ArrayDot(const CoordType* const* a, const CoordType* v, int dim,
+               size_t n, CoordType* out)
+{
+  CoordType vmax = _MaxAbs(v, dim);
+  size_t i = 0;
+
+#ifdef WFMATH_AVX_DISPATCH
+  if(_CpuHasAVX())
+    i = _ArrayDotAVX(a, v, dim, n, vmax, out);
+#endif
+#if defined(__SSE2__)
+  __m128 vmax4 = _mm_set1_ps(vmax);
+  for(; i + 4 <= n; i += 4) {
+    __m128 ans = _mm_setzero_ps(), amax = _mm_setzero_ps();
+    for(int j = 0; j < dim; ++j) {
+      __m128 aj = _mm_loadu_ps(a[j] + i);
+      amax = _mm_max_ps(amax, _Fabs4(aj));
+      ans = _mm_add_ps(ans, _mm_mul_ps(aj, _mm_set1_ps(v[j])));
+    }
+    bool denormal;
+    __m128 delta = _ScaleEpsilon4(amax, vmax4, &denormal);
+    __m128 keep = _mm_cmpge_ps(_Fabs4(ans), delta);
+    _mm_storeu_ps(out + i, _mm_and_ps(ans, keep));
+    if(denormal) {
+      for(size_t k = i; k < i + 4; ++k)
+        out[k] = _DotOne(a, v, dim, k, vmax);
+    }
+  }
+#endif
+  for(; i < n; ++i) {
+    out[i] = _DotOne(a, v, dim, i, vmax);
+  }
+}
+
+void _ArraySqrMag(const CoordType* const* a, int dim, size_t n, CoordType* out)
+{
+  size_t i = 0;
+
+#ifdef WFMATH_AVX_DISPATCH
+  if(_CpuHasAVX())
+    i = _ArraySqrMagAVX(a, dim, n, out);
+#endif
+#if defined(__SSE2__)
+  for(; i + 4 <= n; i += 4) {
+    __m128 ans = _mm_setzero_ps();
+    for(int j = 0; j < dim; ++j) {
+      __m128 aj = _mm_loadu_ps(a[j] + i);
+      ans = _mm_add_ps(ans, _mm_mul_ps(aj, aj));
+    }
+    _mm_storeu_ps(out + i, ans);
+  }
+#endif
+  for(; i < n; ++i) {
+    CoordType ans = 0;
+    for(int j = 0; j < dim; ++j) {
+      ans += a[j][i] * a[j][i];
+    }
+    out[i] = ans;
+  }
+}
+
+void _ArraySquaredDistance(const CoordType* const* a, const CoordType* p,
+                           int dim, size_t n, CoordType* out)
+{
+  CoordType pmax = _MaxAbs(p, dim);
+  size_t i = 0;
+
+#ifdef WFMATH_AVX_DISPATCH
+  if(_CpuHasAVX())
+    i = _ArraySquaredDistanceAVX(a, p, dim, n, pmax, out);
+#endif
+#if defined(__SSE2__)
+  __m128 pmax4 = _mm_set1_ps(pmax);
+  for(; i + 4 <= n; i += 4) {
+    __m128 ans = _mm_setzero_ps(), amax = _mm_setzero_ps();
+    for(int j = 0; j < dim; ++j) {
+      __m128 aj = _mm_loadu_ps(a[j] + i);
+      __m128 diff = _mm_sub_ps(aj, _mm_set1_ps(p[j]));
+      amax = _mm_max_ps(amax, _Fabs4(aj));
+      ans = _mm_add_ps(ans, _mm_mul_ps(diff, diff));
+    }
+    bool denormal;
+    __m128 delta = _ScaleEpsilon4(amax, pmax4, &denormal);
+    __m128 keep = _mm_cmpge_ps(ans, delta);
+    _mm_storeu_ps(out + i, _mm_and_ps(ans, keep));
+    if(denormal) {
+      for(size_t k = i; k < i + 4; ++k)
+        out[k] = _SquaredDistanceOne(a, p, dim, k, pmax);
+    }
+  }
+#endif
+  for(; i < n; ++i) {
+    out[i] = _SquaredDistanceOne(a, p, dim, i, pmax);
+  }
+}
+
+#ifdef WFMATH_AVX_DISPATCH
+template<int dim>
+WFMATH_TARGET_AVX
+static size_t _ArrayAffineAVX(const CoordType* const* in, CoordType* const* out,
+                              size_t n, const _AffineCoeffs<dim>& c)
+{
+  size_t i = 0;
+  for(; i + 8 <= n; i += 8) {
+    __m256 diff[dim];
+    for(int j = 0; j < dim; ++j) {
+      diff[j] = _mm256_sub_ps(_mm256_loadu_ps(in[j] + i), _mm256_set1_ps(c.pre[j]));
+    }
+    for(int k = 0; k < dim; ++k) {
+      __m256 ans = _mm256_setzero_ps();
+      for(int j = 0; j < dim; ++j) {
+        ans = _mm256_add_ps(ans, _mm256_mul_ps(_mm256_set1_ps(c.a[k][j]), diff[j]));
+      }
+      if(c.has_post) {
+        ans = _mm256_add_ps(_mm256_set1_ps(c.post[k]), ans);
+      }
+      _mm256_storeu_ps(out[k] + i, ans);
+    }
+  }
+  return i;
+}
+#endif
+
+template<int dim>
+void _ArrayAffine(const CoordType* const* in, CoordType* const* out, size_t n,
+                  const _AffineCoeffs<dim>& c)
+{
+  size_t i = 0;
+
+#ifdef WFMATH_AVX_DISPATCH
+  if(_CpuHasAVX())
+    i = _ArrayAffineAVX<dim>(in, out, n, c);
+#endif
+#if defined(__SSE2__)
+  for(; i + 4 <= n; i += 4) {
+    __m128 diff[dim];
+    for(int j = 0; j < dim; ++j) {
+      diff[j] = _mm_sub_ps(_mm_loadu_ps(in[j] + i), _mm_set1_ps(c.pre[j]));
+    }
+    for(int k = 0; k < dim; ++k) {
+      __m128 ans = _mm_setzero_ps();
+      for(int j = 0; j < dim; ++j) {
+        ans = _mm_add_ps(ans, _mm_mul_ps(_mm_set1_ps(c.a[k][j]), diff[j]));
+      }
+      if(c.has_post) {
+        ans = _mm_add_ps(_mm_set1_ps(c.post[k]), ans);
+      }
+      _mm_storeu_ps(out[k] + i, ans);
+    }
+  }
+#endif
+  for(; i < n; ++i) {
+    CoordType vals[dim];
+    for(int j = 0; j < dim; ++j) {
+      vals[j] = in[j][i];
+    }
+    c.apply(vals, vals);
+    for(int j = 0; j < dim; ++j) {
+      out[j][i] = vals[j];
+    }
+  }
+}
+
+void Rotate(const Point<3>* in, size_t n, Point<3>* out,
+            const Quaternion& q, const Point<3>& p)
+{
+  _AffineCoeffs<3> c(RotMatrix<3>(q), p);
+  c.valid = q.isValid() && p.isValid();
+  _AffineRange(in, n, out, c);
+}
+
+void Rotate(const Vector<3>* in, size_t n, Vector<3>* out, const Quaternion& q)
+{
+  _AffineCoeffs<3> c((RotMatrix<3>(q)));
+  c.valid = q.isValid();
+  _AffineRange(in, n, out, c);
+}
+
+void ToParentCoords(const Point<3>* in, size_t n, Point<3>* out,
+                    const Point<3>& origin, const Quaternion& rotation)
+{
+  _AffineCoeffs<3> c = _AffineCoeffs<3>::toParent(origin, RotMatrix<3>(rotation));
+  c.valid = rotation.isValid() && origin.isValid();
+  _AffineRange(in, n, out, c);
+}
+
+void ToLocalCoords(const Point<3>* in, size_t n, Point<3>* out,
+                   const Point<3>& origin, const Quaternion& rotation)
+{
+  _AffineCoeffs<3> c = _AffineCoeffs<3>::toLocal(origin, RotMatrix<3>(rotation));
+  c.valid = rotation.isValid() && origin.isValid();
+  _AffineRange(in, n, out, c);
+}
+
+template<>
+PointArray<3>& PointArray<3>::rotate(const Quaternion& q, const Point<3>& p)
+{
+  _AffineCoeffs<3> c(RotMatrix<3>(q), p);
+  c.valid = q.isValid() && p.isValid();
+  affine(c);
+  return *this;
+}
+
+template<>
+PointArray<3>& PointArray<3>::toParentCoords(const Point<3>& origin,
+                                             const Quaternion& rotation)
+{
+  _AffineCoeffs<3> c = _AffineCoeffs<3>::toParent(origin, RotMatrix<3>(rotation));
+  c.valid = rotation.isValid() && origin.isValid();
+  affine(c);
+  return *this;
+}
+
+template<>
+PointArray<3>& PointArray<3>::toLocalCoords(const Point<3>& origin,
+                                            const Quaternion& rotation)
+{
+  _AffineCoeffs<3> c = _AffineCoeffs<3>::toLocal(origin, RotMatrix<3>(rotation));
+  c.valid = rotation.isValid() && origin.isValid();
+  affine(c);
+  return *this;
+}
+
+template<>
+VectorArray<3>& VectorArray<3>::rotate(const Quaternion& q)
+{
+  _AffineCoeffs<3> c((RotMatrix<3>(q)));
+  c.valid = q.isValid();
+  affine(c);
+  return *this;
+}
+
+template class _CoordArray<3>;
+template class _CoordArray<2>;
+
+template class PointArray<3>;
+template class PointArray<2>;
+
+template class VectorArray<3>;
+template class VectorArray<2>;
+
+template void Dot<3>(const VectorArray<3>&, const Vector<3>&, CoordType*);
+template void Dot<2>(const VectorArray<2>&, const Vector<2>&, CoordType*);
+
+template void SquaredDistance<3>(const PointArray<3>&, const Point<3>&, CoordType*);
+template void SquaredDistance<2>(const PointArray<2>&, const Point<2>&, CoordType*);
+
+template void _ArrayAffine<3>(const CoordType* const*, CoordType* const*, size_t, const _AffineCoeffs<3>&);
+template void _ArrayAffine<2>(const CoordType* const*, CoordType* const*, size_t, const _AffineCoeffs<2>&);
+
+template void Rotate<3>(const Point<3>*, size_t, Point<3>*, const RotMatrix<3>&, const Point<3>&);
+template void Rotate<2>(const Point<2>*, size_t, Point<2>*, const RotMatrix<2>&, const Point<2>&);
+
+template void Rotate<3>(const Vector<3>*, size_t, Vector<3>*, const RotMatrix<3>&);
+template void Rotate<2>(const Vector<2>*, size_t, Vector<2>*, const RotMatrix<2>&);
+
+template void ToParentCoords<3>(const Point<3>*, size_t, Point<3>*, const Point<3>&, const RotMatrix<3>&);
+template void ToParentCoords<2>(const Point<2>*, size_t, Point<2>*, const Point<2>&, const RotMatrix<2>&);
+
+template void ToLocalCoords<3>(const Point<3>*, size_t, Point<3>*, const Point<3>&, const RotMatrix<3>&);
+template void ToLocalCoords<2>(const Point<2>*, size_t, Point<2>*, const Point<2>&, const RotMatrix<2>&);
+
+} // namespace WFMath
@@ -0,0 +1,279 @@
+// point_array.h (Structure-of-arrays containers for Point<> and Vector<>)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifndef WFMATH_POINT_ARRAY_H
+#define WFMATH_POINT_ARRAY_H
+
+#include <wfmath/const.h>
+#include <wfmath/point.h>
+#include <wfmath/vector.h>
+
+#include <vector>
+
+#include <cstddef>
+
+namespace WFMath {
+
+template<int dim> class PointArray;
+template<int dim> class VectorArray;
+template<int dim> struct _AffineCoeffs;
+
+// Batch coordinate transforms over contiguous ranges of Point<> and
+// Vector<>. The matrix is set up once per call instead of once per
+// element, and the results are identical to calling the matching member
+// function on each element. The Quaternion versions convert the
+// rotation to a RotMatrix<3> first, so they agree with the per-point
+// Quaternion functions to within the library precision. In all of
+// these, out may be the same as in.
+
+/// Write in[i].rotate(m, p) to out[i] for n points
+template<int dim>
+void Rotate(const Point<dim>* in, size_t n, Point<dim>* out,
+            const RotMatrix<dim>& m, const Point<dim>& p);
+/// Write in[i].rotate(q, p) to out[i] for n points
+void Rotate(const Point<3>* in, size_t n, Point<3>* out,
+            const Quaternion& q, const Point<3>& p);
+/// Write in[i].rotate(m) to out[i] for n vectors
+template<int dim>
+void Rotate(const Vector<dim>* in, size_t n, Vector<dim>* out,
+            const RotMatrix<dim>& m);
+/// Write in[i].rotate(q) to out[i] for n vectors
+void Rotate(const Vector<3>* in, size_t n, Vector<3>* out, const Quaternion& q);
+/// Write in[i].toParentCoords(origin, rotation) to out[i] for n points
+template<int dim>
+void ToParentCoords(const Point<dim>* in, size_t n, Point<dim>* out,
+                    const Point<dim>& origin, const RotMatrix<dim>& rotation);
+/// Write in[i].toParentCoords(origin, rotation) to out[i] for n points
+void ToParentCoords(const Point<3>* in, size_t n, Point<3>* out,
+                    const Point<3>& origin, const Quaternion& rotation);
+/// Write in[i].toLocalCoords(origin, rotation) to out[i] for n points
+template<int dim>
+void ToLocalCoords(const Point<dim>* in, size_t n, Point<dim>* out,
+                   const Point<dim>& origin, const RotMatrix<dim>& rotation);
+/// Write in[i].toLocalCoords(origin, rotation) to out[i] for n points
+void ToLocalCoords(const Point<3>* in, size_t n, Point<3>* out,
+                   const Point<3>& origin, const Quaternion& rotation);
+
+/// Write Dot(va[i], v) to out[i] for each element of va
+template<int dim>
+void Dot(const VectorArray<dim>& va, const Vector<dim>& v, CoordType* out);
+/// Write SquaredDistance(pa[i], p) to out[i] for each element of pa
+template<int dim>
+void SquaredDistance(const PointArray<dim>& pa, const Point<dim>& p, CoordType* out);
+
+/// Storage shared by PointArray<> and VectorArray<>
+/**
+ * Each axis is kept in its own contiguous array of CoordType, so that
+ * the same axis of consecutive elements can be loaded into one SIMD
+ * register. The per-element m_valid flags of Point<> and Vector<>
+ * are packed into a bitmap.
+ **/
+template<int dim>
+class _CoordArray
+{
+ public:
+  _CoordArray() : m_size(0) {}
+
+  /// The number of elements in the array
+  size_t size() const {return m_size;}
+  /// True if the array has no elements
+  bool empty() const {return m_size == 0;}
+
+  /// Remove all elements
+  void clear();
+  /// Preallocate storage for n elements
+  void reserve(size_t n);
+  /// Change the number of elements, new elements are invalid
+  void resize(size_t n);
+
+  /// Return true if the i'th element is valid
+  bool isValid(size_t i) const
+  {return (m_valid[i / 32] & (1u << (i % 32))) != 0;}
+  /// Set the validity of the i'th element
+  void setValid(size_t i, bool valid = true)
+  {
+    if(valid)
+      m_valid[i / 32] |= (1u << (i % 32));
+    else
+      m_valid[i / 32] &= ~(1u << (i % 32));
+  }
+  /// Return true if every element is valid
+  bool allValid() const;
+
+  /// The contiguous coordinates of the given axis
+  const CoordType* elements(int axis) const {return m_elem[axis].data();}
+  /// The contiguous coordinates of the given axis
+  CoordType* elements(int axis) {return m_elem[axis].data();}
+
+ protected:
+  void pushBack(const CoordType* vals, bool valid);
+  void setElem(size_t i, const CoordType* vals, bool valid);
+  void getElem(size_t i, CoordType* vals) const;
+  // Clear the validity of every element
+  void invalidate();
+  // And the validity of every element with that of another array
+  void andValid(const _CoordArray& other);
+  // Fill pointers to the start of each axis
+  void axes(const CoordType** ptrs) const;
+  void axes(CoordType** ptrs);
+  // Apply a batch transform to every element
+  void affine(const _AffineCoeffs<dim>& c);
+
+  std::vector<CoordType> m_elem[dim];
+  std::vector<unsigned> m_valid;
+  size_t m_size;
+};
+
+/// A structure-of-arrays container of Point<dim>
+/**
+ * This holds the same data as a std::vector<Point<dim> >, but with
+ * each axis stored contiguously, so operations applied to all the
+ * points at once can use SIMD instructions.
+ **/
+template<int dim = 3>
+class PointArray : public _CoordArray<dim>
+{
+ public:
+  /// Construct an empty array
+  PointArray() {}
+  /// Construct an array from a range of Point<dim>
+  template<class Iter>
+  PointArray(Iter begin, Iter end) {assign(begin, end);}
+
+  /// Replace the contents of the array with a range of Point<dim>
+  template<class Iter>
+  void assign(Iter begin, Iter end)
+  {
+    this->clear();
+    for(; begin != end; ++begin)
+      push_back(*begin);
+  }
+  /// Copy the contents of the array into an output range of Point<dim>
+  template<class OutIter>
+  OutIter copyTo(OutIter out) const
+  {
+    for(size_t i = 0; i < this->m_size; ++i)
+      *out++ = get(i);
+    return out;
+  }
+
+  /// Append a point
+  void push_back(const Point<dim>& p) {this->pushBack(p.elements(), p.isValid());}
+  /// Get the i'th point
+  Point<dim> get(size_t i) const;
+  /// Set the i'th point
+  void set(size_t i, const Point<dim>& p) {this->setElem(i, p.elements(), p.isValid());}
+
+  /// Shift every point by v
+  PointArray& operator+=(const Vector<dim>& v);
+  /// Shift every point by -v
+  PointArray& operator-=(const Vector<dim>& v);
+  /// Shift each point by the matching element of va, which must have the same size
+  PointArray& operator+=(const VectorArray<dim>& va);
+  /// Shift each point by minus the matching element of va, which must have the same size
+  PointArray& operator-=(const VectorArray<dim>& va);
+
+  /// Rotate every point about p
+  PointArray& rotate(const RotMatrix<dim>& m, const Point<dim>& p);
+  /// 3D only: rotate every point about p
+  PointArray& rotate(const Quaternion& q, const Point<dim>& p);
+
+  /// Convert every point from the frame at origin to the parent frame
+  PointArray& toParentCoords(const Point<dim>& origin, const RotMatrix<dim>& rotation);
+  /// 3D only: convert every point from the frame at origin to the parent frame
+  PointArray& toParentCoords(const Point<dim>& origin, const Quaternion& rotation);
+  /// Convert every point from the parent frame to the frame at origin
+  PointArray& toLocalCoords(const Point<dim>& origin, const RotMatrix<dim>& rotation);
+  /// 3D only: convert every point from the parent frame to the frame at origin
+  PointArray& toLocalCoords(const Point<dim>& origin, const Quaternion& rotation);
+
+  friend void SquaredDistance<dim>(const PointArray& pa, const Point<dim>& p, CoordType* out);
+};
+
+/// A structure-of-arrays container of Vector<dim>
+/**
+ * This holds the same data as a std::vector<Vector<dim> >, but with
+ * each axis stored contiguously, so operations applied to all the
+ * vectors at once can use SIMD instructions.
+ **/
+template<int dim = 3>
+class VectorArray : public _CoordArray<dim>
+{
+ public:
+  /// Construct an empty array
+  VectorArray() {}
+  /// Construct an array from a range of Vector<dim>
+  template<class Iter>
+  VectorArray(Iter begin, Iter end) {assign(begin, end);}
+
+  /// Replace the contents of the array with a range of Vector<dim>
+  template<class Iter>
+  void assign(Iter begin, Iter end)
+  {
+    this->clear();
+    for(; begin != end; ++begin)
+      push_back(*begin);
+  }
+  /// Copy the contents of the array into an output range of Vector<dim>
+  template<class OutIter>
+  OutIter copyTo(OutIter out) const
+  {
+    for(size_t i = 0; i < this->m_size; ++i)
+      *out++ = get(i);
+    return out;
+  }
+
+  /// Append a vector
+  void push_back(const Vector<dim>& v) {this->pushBack(v.elements(), v.isValid());}
+  /// Get the i'th vector
+  Vector<dim> get(size_t i) const;
+  /// Set the i'th vector
+  void set(size_t i, const Vector<dim>& v) {this->setElem(i, v.elements(), v.isValid());}
+
+  /// Add v to every vector
+  VectorArray& operator+=(const Vector<dim>& v);
+  /// Subtract v from every vector
+  VectorArray& operator-=(const Vector<dim>& v);
+  /// Add the matching element of va, which must have the same size
+  VectorArray& operator+=(const VectorArray& va);
+  /// Subtract the matching element of va, which must have the same size
+  VectorArray& operator-=(const VectorArray& va);
+  /// Scale every vector by d
+  VectorArray& operator*=(CoordType d);
+
+  /// Rotate every vector, as Vector<dim>::rotate(m)
+  VectorArray& rotate(const RotMatrix<dim>& m);
+  /// 3D only: rotate every vector, as Vector<3>::rotate(q)
+  VectorArray& rotate(const Quaternion& q);
+
+  /// Write the squared magnitude of each vector to out[i]
+  void sqrMag(CoordType* out) const;
+
+  friend class PointArray<dim>;
+  friend void Dot<dim>(const VectorArray& va, const Vector<dim>& v, CoordType* out);
+};
+
+} // namespace WFMath
+
+#endif  // WFMATH_POINT_ARRAY_H
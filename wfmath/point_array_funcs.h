@@ -0,0 +1,526 @@
+// point_array_funcs.h (PointArray<> and VectorArray<> implementation)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifndef WFMATH_POINT_ARRAY_FUNCS_H
+#define WFMATH_POINT_ARRAY_FUNCS_H
+
+#include <wfmath/point_array.h>
+
+#include <wfmath/point.h>
+#include <wfmath/vector.h>
+#include <wfmath/rotmatrix.h>
+#include <wfmath/quaternion.h>
+
+#include <cassert>
+
+namespace WFMath {
+
+// The SIMD kernels, implemented in point_array.cpp. Each axis of the
+// array is passed as a separate pointer to n contiguous values.
+
+// a[i] += c
+void _ArrayAddConst(CoordType* a, CoordType c, size_t n);
+// a[i] += b[i]
+void _ArrayAdd(CoordType* a, const CoordType* b, size_t n);
+// a[i] -= b[i]
+void _ArraySub(CoordType* a, const CoordType* b, size_t n);
+// a[i] *= c
+void _ArrayScale(CoordType* a, CoordType c, size_t n);
+// out[i] = Dot(a[i], v), with the same epsilon handling as Dot()
+void _ArrayDot(const CoordType* const* a, const CoordType* v, int dim,
+               size_t n, CoordType* out);
+// out[i] = a[i].sqrMag()
+void _ArraySqrMag(const CoordType* const* a, int dim, size_t n, CoordType* out);
+// out[i] = SquaredDistance(a[i], p), with the same epsilon handling
+// as SquaredDistance()
+void _ArraySquaredDistance(const CoordType* const* a, const CoordType* p,
+                           int dim, size_t n, CoordType* out);
+
+// The coefficients of out = post + a * (in - pre), which covers all
+// the batch transforms. The arithmetic is done in the same order as
+// the Point<> and Vector<> member functions, so the answers match.
+template<int dim>
+struct _AffineCoeffs
+{
+  CoordType a[dim][dim];
+  CoordType pre[dim];
+  CoordType post[dim];
+  // Vector rotations have no post translation, and adding a zero
+  // one would turn -0 into 0
+  bool has_post;
+  bool valid;
+
+  // in.rotate(m, p), which is p + Prod(in - p, m)
+  _AffineCoeffs(const RotMatrix<dim>& m, const Point<dim>& p)
+    : has_post(true), valid(m.isValid() && p.isValid())
+  {
+    setTranspose(m);
+    for(int i = 0; i < dim; ++i) {
+      pre[i] = post[i] = p[i];
+    }
+  }
+  // in.rotate(m), which is Prod(in, m)
+  explicit _AffineCoeffs(const RotMatrix<dim>& m)
+    : has_post(false), valid(m.isValid())
+  {
+    setTranspose(m);
+    for(int i = 0; i < dim; ++i) {
+      pre[i] = post[i] = 0;
+    }
+  }
+
+  // in.toParentCoords(origin, m), which is origin + Prod(in - 0, m)
+  static _AffineCoeffs toParent(const Point<dim>& origin, const RotMatrix<dim>& m)
+  {
+    _AffineCoeffs c(m);
+    for(int i = 0; i < dim; ++i) {
+      c.post[i] = origin[i];
+    }
+    c.has_post = true;
+    c.valid = c.valid && origin.isValid();
+    return c;
+  }
+  // in.toLocalCoords(origin, m), which is 0 + Prod(m, in - origin)
+  static _AffineCoeffs toLocal(const Point<dim>& origin, const RotMatrix<dim>& m)
+  {
+    _AffineCoeffs c(m);
+    for(int i = 0; i < dim; ++i) {
+      for(int j = 0; j < dim; ++j) {
+        c.a[i][j] = m.elem(i, j);
+      }
+      c.pre[i] = origin[i];
+    }
+    c.has_post = true;
+    c.valid = c.valid && origin.isValid();
+    return c;
+  }
+
+  void setTranspose(const RotMatrix<dim>& m)
+  {
+    for(int i = 0; i < dim; ++i) {
+      for(int j = 0; j < dim; ++j) {
+        a[i][j] = m.elem(j, i);
+      }
+    }
+  }
+
+  // Transform one set of coordinates, in and out may be the same
+  void apply(const CoordType* in, CoordType* out) const
+  {
+    CoordType diff[dim];
+    for(int j = 0; j < dim; ++j) {
+      diff[j] = in[j] - pre[j];
+    }
+    for(int i = 0; i < dim; ++i) {
+      CoordType ans = 0;
+      for(int j = 0; j < dim; ++j) {
+        ans += a[i][j] * diff[j];
+      }
+      out[i] = has_post ? post[i] + ans : ans;
+    }
+  }
+};
+
+// The SoA version of _AffineCoeffs::apply(), in point_array.cpp
+template<int dim>
+void _ArrayAffine(const CoordType* const* in, CoordType* const* out, size_t n,
+                  const _AffineCoeffs<dim>& c);
+
+template<int dim, class Elem>
+void _AffineRange(const Elem* in, size_t n, Elem* out, const _AffineCoeffs<dim>& c)
+{
+  for(size_t i = 0; i < n; ++i) {
+    bool valid = c.valid && in[i].isValid();
+    c.apply(in[i].elements(), &out[i][0]);
+    out[i].setValid(valid);
+  }
+}
+
+template<int dim>
+void Rotate(const Point<dim>* in, size_t n, Point<dim>* out,
+            const RotMatrix<dim>& m, const Point<dim>& p)
+{
+  _AffineRange(in, n, out, _AffineCoeffs<dim>(m, p));
+}
+
+template<int dim>
+void Rotate(const Vector<dim>* in, size_t n, Vector<dim>* out,
+            const RotMatrix<dim>& m)
+{
+  _AffineRange(in, n, out, _AffineCoeffs<dim>(m));
+}
+
+template<int dim>
+void ToParentCoords(const Point<dim>* in, size_t n, Point<dim>* out,
+                    const Point<dim>& origin, const RotMatrix<dim>& rotation)
+{
+  _AffineRange(in, n, out, _AffineCoeffs<dim>::toParent(origin, rotation));
+}
+
+template<int dim>
+void ToLocalCoords(const Point<dim>* in, size_t n, Point<dim>* out,
+                   const Point<dim>& origin, const RotMatrix<dim>& rotation)
+{
+  _AffineRange(in, n, out, _AffineCoeffs<dim>::toLocal(origin, rotation));
+}
+
+template<int dim>
+void _CoordArray<dim>::clear()
+{
+  for(int i = 0; i < dim; ++i) {
+    m_elem[i].clear();
+  }
+  m_valid.clear();
+  m_size = 0;
+}
+
+template<int dim>
+void _CoordArray<dim>::reserve(size_t n)
+{
+  for(int i = 0; i < dim; ++i) {
+    m_elem[i].reserve(n);
+  }
+  m_valid.reserve((n + 31) / 32);
+}
+
+template<int dim>
+void _CoordArray<dim>::resize(size_t n)
+{
+  for(int i = 0; i < dim; ++i) {
+    m_elem[i].resize(n);
+  }
+  m_valid.resize((n + 31) / 32, 0);
+
+  // Bits past the end of the array are kept clear, so growing
+  // leaves the new elements invalid
+  if(n < m_size && n % 32 != 0) {
+    m_valid[n / 32] &= (1u << (n % 32)) - 1;
+  }
+
+  m_size = n;
+}
+
+template<int dim>
+bool _CoordArray<dim>::allValid() const
+{
+  size_t full = m_size / 32;
+
+  for(size_t i = 0; i < full; ++i) {
+    if(m_valid[i] != ~0u) {
+      return false;
+    }
+  }
+
+  if(m_size % 32 != 0) {
+    unsigned mask = (1u << (m_size % 32)) - 1;
+    if((m_valid[full] & mask) != mask) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+template<int dim>
+void _CoordArray<dim>::pushBack(const CoordType* vals, bool valid)
+{
+  for(int i = 0; i < dim; ++i) {
+    m_elem[i].push_back(vals[i]);
+  }
+  if(m_size % 32 == 0) {
+    m_valid.push_back(0);
+  }
+  setValid(m_size++, valid);
+}
+
+template<int dim>
+void _CoordArray<dim>::setElem(size_t n, const CoordType* vals, bool valid)
+{
+  assert(n < m_size);
+
+  for(int i = 0; i < dim; ++i) {
+    m_elem[i][n] = vals[i];
+  }
+  setValid(n, valid);
+}
+
+template<int dim>
+void _CoordArray<dim>::getElem(size_t n, CoordType* vals) const
+{
+  assert(n < m_size);
+
+  for(int i = 0; i < dim; ++i) {
+    vals[i] = m_elem[i][n];
+  }
+}
+
+template<int dim>
+void _CoordArray<dim>::invalidate()
+{
+  for(size_t i = 0; i < m_valid.size(); ++i) {
+    m_valid[i] = 0;
+  }
+}
+
+template<int dim>
+void _CoordArray<dim>::andValid(const _CoordArray<dim>& other)
+{
+  assert(m_size == other.m_size);
+
+  for(size_t i = 0; i < m_valid.size(); ++i) {
+    m_valid[i] &= other.m_valid[i];
+  }
+}
+
+template<int dim>
+void _CoordArray<dim>::axes(const CoordType** ptrs) const
+{
+  for(int i = 0; i < dim; ++i) {
+    ptrs[i] = m_elem[i].data();
+  }
+}
+
+template<int dim>
+void _CoordArray<dim>::axes(CoordType** ptrs)
+{
+  for(int i = 0; i < dim; ++i) {
+    ptrs[i] = m_elem[i].data();
+  }
+}
+
+template<int dim>
+Point<dim> PointArray<dim>::get(size_t i) const
+{
+  Point<dim> out;
+
+  this->getElem(i, &out[0]);
+  out.setValid(this->isValid(i));
+
+  return out;
+}
+
+template<int dim>
+PointArray<dim>& PointArray<dim>::operator+=(const Vector<dim>& v)
+{
+  for(int i = 0; i < dim; ++i) {
+    _ArrayAddConst(this->m_elem[i].data(), v[i], this->m_size);
+  }
+  if(!v.isValid()) {
+    this->invalidate();
+  }
+
+  return *this;
+}
+
+template<int dim>
+PointArray<dim>& PointArray<dim>::operator-=(const Vector<dim>& v)
+{
+  for(int i = 0; i < dim; ++i) {
+    _ArrayAddConst(this->m_elem[i].data(), -v[i], this->m_size);
+  }
+  if(!v.isValid()) {
+    this->invalidate();
+  }
+
+  return *this;
+}
+
+template<int dim>
+PointArray<dim>& PointArray<dim>::operator+=(const VectorArray<dim>& va)
+{
+  assert(this->m_size == va.size());
+
+  for(int i = 0; i < dim; ++i) {
+    _ArrayAdd(this->m_elem[i].data(), va.elements(i), this->m_size);
+  }
+  this->andValid(va);
+
+  return *this;
+}
+
+template<int dim>
+PointArray<dim>& PointArray<dim>::operator-=(const VectorArray<dim>& va)
+{
+  assert(this->m_size == va.size());
+
+  for(int i = 0; i < dim; ++i) {
+    _ArraySub(this->m_elem[i].data(), va.elements(i), this->m_size);
+  }
+  this->andValid(va);
+
+  return *this;
+}
+
+template<int dim>
+void _CoordArray<dim>::affine(const _AffineCoeffs<dim>& c)
+{
+  CoordType* a[dim];
+
+  axes(a);
+  _ArrayAffine<dim>(a, a, m_size, c);
+  if(!c.valid) {
+    invalidate();
+  }
+}
+
+template<int dim>
+PointArray<dim>& PointArray<dim>::rotate(const RotMatrix<dim>& m, const Point<dim>& p)
+{
+  this->affine(_AffineCoeffs<dim>(m, p));
+  return *this;
+}
+
+template<int dim>
+PointArray<dim>& PointArray<dim>::toParentCoords(const Point<dim>& origin,
+                                                 const RotMatrix<dim>& rotation)
+{
+  this->affine(_AffineCoeffs<dim>::toParent(origin, rotation));
+  return *this;
+}
+
+template<int dim>
+PointArray<dim>& PointArray<dim>::toLocalCoords(const Point<dim>& origin,
+                                                const RotMatrix<dim>& rotation)
+{
+  this->affine(_AffineCoeffs<dim>::toLocal(origin, rotation));
+  return *this;
+}
+
+template<int dim>
+Vector<dim> VectorArray<dim>::get(size_t i) const
+{
+  Vector<dim> out;
+
+  this->getElem(i, &out[0]);
+  out.setValid(this->isValid(i));
+
+  return out;
+}
+
+template<int dim>
+VectorArray<dim>& VectorArray<dim>::operator+=(const Vector<dim>& v)
+{
+  for(int i = 0; i < dim; ++i) {
+    _ArrayAddConst(this->m_elem[i].data(), v[i], this->m_size);
+  }
+  if(!v.isValid()) {
+    this->invalidate();
+  }
+
+  return *this;
+}
+
+template<int dim>
+VectorArray<dim>& VectorArray<dim>::operator-=(const Vector<dim>& v)
+{
+  for(int i = 0; i < dim; ++i) {
+    _ArrayAddConst(this->m_elem[i].data(), -v[i], this->m_size);
+  }
+  if(!v.isValid()) {
+    this->invalidate();
+  }
+
+  return *this;
+}
+
+template<int dim>
+VectorArray<dim>& VectorArray<dim>::operator+=(const VectorArray<dim>& va)
+{
+  assert(this->m_size == va.m_size);
+
+  for(int i = 0; i < dim; ++i) {
+    _ArrayAdd(this->m_elem[i].data(), va.m_elem[i].data(), this->m_size);
+  }
+  this->andValid(va);
+
+  return *this;
+}
+
+template<int dim>
+VectorArray<dim>& VectorArray<dim>::operator-=(const VectorArray<dim>& va)
+{
+  assert(this->m_size == va.m_size);
+
+  for(int i = 0; i < dim; ++i) {
+    _ArraySub(this->m_elem[i].data(), va.m_elem[i].data(), this->m_size);
+  }
+  this->andValid(va);
+
+  return *this;
+}
+
+template<int dim>
+VectorArray<dim>& VectorArray<dim>::operator*=(CoordType d)
+{
+  for(int i = 0; i < dim; ++i) {
+    _ArrayScale(this->m_elem[i].data(), d, this->m_size);
+  }
+
+  return *this;
+}
+
+template<int dim>
+VectorArray<dim>& VectorArray<dim>::rotate(const RotMatrix<dim>& m)
+{
+  this->affine(_AffineCoeffs<dim>(m));
+  return *this;
+}
+
+template<int dim>
+void VectorArray<dim>::sqrMag(CoordType* out) const
+{
+  const CoordType* a[dim];
+
+  this->axes(a);
+  _ArraySqrMag(a, dim, this->m_size, out);
+}
+
+template<int dim>
+void Dot(const VectorArray<dim>& va, const Vector<dim>& v, CoordType* out)
+{
+  const CoordType* a[dim];
+
+  va.axes(a);
+  _ArrayDot(a, v.elements(), dim, va.m_size, out);
+}
+
+template<int dim>
+void SquaredDistance(const PointArray<dim>& pa, const Point<dim>& p, CoordType* out)
+{
+  const CoordType* a[dim];
+
+  pa.axes(a);
+  _ArraySquaredDistance(a, p.elements(), dim, pa.m_size, out);
+}
+
+template<> PointArray<3>& PointArray<3>::rotate(const Quaternion& q, const Point<3>& p);
+template<> PointArray<3>& PointArray<3>::toParentCoords(const Point<3>& origin,
+                                                       const Quaternion& rotation);
+template<> PointArray<3>& PointArray<3>::toLocalCoords(const Point<3>& origin,
+                                                      const Quaternion& rotation);
+template<> VectorArray<3>& VectorArray<3>::rotate(const Quaternion& q);
+
+} // namespace WFMath
+
+#endif  // WFMATH_POINT_ARRAY_FUNCS_H
@@ -0,0 +1,348 @@
+// point_array_test.cpp (PointArray<> and VectorArray<> test functions)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#ifndef DEBUG
+#define DEBUG
+#endif
+
+#include "const.h"
+#include "vector.h"
+#include "point.h"
+#include "point_array.h"
+#include "rotmatrix.h"
+#include "quaternion.h"
+#include "randgen.h"
+
+#include <vector>
+#include <limits>
+#include <iostream>
+
+#include <cassert>
+
+using namespace WFMath;
+
+// Some of the coordinates are zero, tiny or denormal, to exercise the epsilon
+// handling in Dot() and SquaredDistance()
+static CoordType random_coord(MTRand& rand)
+{
+  switch(rand.randInt(8)) {
+    case 0:
+      return 0;
+    case 1:
+      return (CoordType) (rand.rand() * 1e-6);
+    case 2:
+      return std::numeric_limits<CoordType>::denorm_min() * (CoordType) rand.randInt(1000);
+    default:
+      return (CoordType) (rand.rand() * 200 - 100);
+  }
+}
+
+template<int dim>
+void test_point_array(MTRand& rand)
+{
+  std::cout << "Testing PointArray<" << dim << "> and VectorArray<" << dim << ">" << std::endl;
+
+  // Not a multiple of 8, so the scalar tail is used as well
+  const size_t num = 77;
+
+  std::vector<Point<dim> > points;
+  std::vector<Vector<dim> > vectors;
+
+  for(size_t i = 0; i < num; ++i) {
+    Point<dim> p;
+    Vector<dim> v;
+    for(int j = 0; j < dim; ++j) {
+      p[j] = random_coord(rand);
+      v[j] = random_coord(rand);
+    }
+    p.setValid(i % 5 != 0);
+    v.setValid(i % 7 != 0);
+    points.push_back(p);
+    vectors.push_back(v);
+  }
+
+  PointArray<dim> pa(points.begin(), points.end());
+  VectorArray<dim> va(vectors.begin(), vectors.end());
+
+  assert(pa.size() == num);
+  assert(va.size() == num);
+  assert(!pa.allValid());
+
+  for(size_t i = 0; i < num; ++i) {
+    assert(pa.get(i) == points[i] || !points[i].isValid());
+    assert(pa.isValid(i) == points[i].isValid());
+    assert(va.isValid(i) == vectors[i].isValid());
+    for(int j = 0; j < dim; ++j) {
+      assert(pa.elements(j)[i] == points[i][j]);
+      assert(va.elements(j)[i] == vectors[i][j]);
+    }
+  }
+
+  Vector<dim> shift;
+  Point<dim> ref;
+  for(int j = 0; j < dim; ++j) {
+    shift[j] = random_coord(rand);
+    ref[j] = random_coord(rand);
+  }
+  shift.setValid();
+  ref.setValid();
+
+  // The array kernels must agree exactly with the scalar functions
+
+  std::vector<CoordType> out(num);
+
+  Dot(va, shift, &out[0]);
+  for(size_t i = 0; i < num; ++i) {
+    assert(out[i] == Dot(vectors[i], shift));
+  }
+
+  va.sqrMag(&out[0]);
+  for(size_t i = 0; i < num; ++i) {
+    assert(out[i] == vectors[i].sqrMag());
+  }
+
+  SquaredDistance(pa, ref, &out[0]);
+  for(size_t i = 0; i < num; ++i) {
+    assert(out[i] == SquaredDistance(points[i], ref));
+  }
+
+  SquaredDistance(pa, points[3], &out[0]);
+  assert(out[3] == 0);
+
+  pa += shift;
+  pa -= va;
+  va *= 0.5f;
+  va += shift;
+  for(size_t i = 0; i < num; ++i) {
+    Point<dim> p = points[i];
+    p += shift;
+    p -= vectors[i];
+    Vector<dim> v = vectors[i];
+    v *= 0.5f;
+    v += shift;
+    for(int j = 0; j < dim; ++j) {
+      assert(pa.get(i)[j] == p[j]);
+      assert(va.get(i)[j] == v[j]);
+    }
+    assert(pa.isValid(i) == p.isValid());
+    assert(va.isValid(i) == v.isValid());
+  }
+
+  // Conversion back to the AoS types
+  std::vector<Point<dim> > copied(num);
+  pa.copyTo(copied.begin());
+  for(size_t i = 0; i < num; ++i) {
+    assert(copied[i].isValid() == pa.isValid(i));
+    for(int j = 0; j < dim; ++j) {
+      assert(copied[i][j] == pa.elements(j)[i]);
+    }
+  }
+
+  // Validity bitmap bookkeeping
+  pa.resize(40);
+  assert(pa.size() == 40);
+  pa.resize(70);
+  for(size_t i = 40; i < 70; ++i) {
+    assert(!pa.isValid(i));
+  }
+  for(size_t i = 0; i < 70; ++i) {
+    pa.setValid(i);
+  }
+  assert(pa.allValid());
+  Vector<dim> invalid;
+  invalid.zero();
+  invalid.setValid(false);
+  pa -= invalid;
+  for(size_t i = 0; i < 70; ++i) {
+    assert(!pa.isValid(i));
+  }
+
+  pa.clear();
+  assert(pa.empty());
+  assert(pa.allValid());
+}
+
+template<int dim>
+void test_batch_transform(const RotMatrix<dim>& m, MTRand& rand)
+{
+  std::cout << "Testing batch transforms by " << dim << "D RotMatrix" << std::endl;
+
+  const size_t num = 29;
+
+  std::vector<Point<dim> > points(num);
+  std::vector<Vector<dim> > vectors(num);
+  Point<dim> origin;
+
+  for(size_t i = 0; i < num; ++i) {
+    for(int j = 0; j < dim; ++j) {
+      points[i][j] = (CoordType) (rand.rand() * 20 - 10);
+      vectors[i][j] = (CoordType) (rand.rand() * 20 - 10);
+      origin[j] = (CoordType) (rand.rand() * 20 - 10);
+    }
+    points[i].setValid(i != 4);
+    vectors[i].setValid(i != 5);
+  }
+  origin.setValid();
+
+  // The batch functions must agree exactly with the per-point ones
+
+  std::vector<Point<dim> > out(num);
+  std::vector<Vector<dim> > vout(vectors);
+  PointArray<dim> pa(points.begin(), points.end());
+  VectorArray<dim> va(vectors.begin(), vectors.end());
+
+  ToParentCoords(&points[0], num, &out[0], origin, m);
+  pa.toParentCoords(origin, m);
+  for(size_t i = 0; i < num; ++i) {
+    Point<dim> p = points[i].toParentCoords(origin, m);
+    assert(out[i].isValid() == p.isValid() && pa.isValid(i) == p.isValid());
+    for(int j = 0; j < dim; ++j) {
+      assert(out[i][j] == p[j]);
+      assert(pa.elements(j)[i] == p[j]);
+    }
+  }
+
+  ToLocalCoords(&points[0], num, &out[0], origin, m);
+  pa.assign(points.begin(), points.end());
+  pa.toLocalCoords(origin, m);
+  for(size_t i = 0; i < num; ++i) {
+    Point<dim> p = points[i].toLocalCoords(origin, m);
+    assert(out[i].isValid() == p.isValid() && pa.isValid(i) == p.isValid());
+    for(int j = 0; j < dim; ++j) {
+      assert(out[i][j] == p[j]);
+      assert(pa.elements(j)[i] == p[j]);
+    }
+  }
+
+  out = points;
+  Rotate(&out[0], num, &out[0], m, origin);
+  pa.assign(points.begin(), points.end());
+  pa.rotate(m, origin);
+  for(size_t i = 0; i < num; ++i) {
+    Point<dim> p = points[i];
+    p.rotate(m, origin);
+    assert(out[i].isValid() == p.isValid() && pa.isValid(i) == p.isValid());
+    for(int j = 0; j < dim; ++j) {
+      assert(out[i][j] == p[j]);
+      assert(pa.elements(j)[i] == p[j]);
+    }
+  }
+
+  Rotate(&vout[0], num, &vout[0], m);
+  va.rotate(m);
+  for(size_t i = 0; i < num; ++i) {
+    Vector<dim> v = vectors[i];
+    v.rotate(m);
+    assert(vout[i].isValid() == v.isValid() && va.isValid(i) == v.isValid());
+    for(int j = 0; j < dim; ++j) {
+      assert(vout[i][j] == v[j]);
+      assert(va.elements(j)[i] == v[j]);
+    }
+  }
+
+  // The rotation-less overloads skip the identity matrix
+  RotMatrix<dim> ident;
+  ident.identity();
+  assert(points[0].toParentCoords(origin) == points[0].toParentCoords(origin, ident));
+  assert(points[0].toLocalCoords(origin) == points[0].toLocalCoords(origin, ident));
+}
+
+void test_batch_quaternion(const Quaternion& q, MTRand& rand)
+{
+  std::cout << "Testing batch transforms by Quaternion" << std::endl;
+
+  const size_t num = 13;
+
+  std::vector<Point<3> > points(num), out(num);
+  std::vector<Vector<3> > vectors(num), vout(num);
+  Point<3> origin(1, -2, 3);
+
+  for(size_t i = 0; i < num; ++i) {
+    for(int j = 0; j < 3; ++j) {
+      points[i][j] = (CoordType) (rand.rand() * 20 - 10);
+      vectors[i][j] = (CoordType) (rand.rand() * 20 - 10);
+    }
+    points[i].setValid();
+    vectors[i].setValid();
+  }
+
+  PointArray<3> pa(points.begin(), points.end());
+
+  // The quaternion is converted to a matrix once, so these only agree
+  // to within the library precision
+  const CoordType eps = 100 * numeric_constants<CoordType>::epsilon();
+
+  ToParentCoords(&points[0], num, &out[0], origin, q);
+  pa.toParentCoords(origin, q);
+  for(size_t i = 0; i < num; ++i) {
+    Point<3> p = points[i].toParentCoords(origin, q);
+    assert(Equal(out[i], p, eps));
+    assert(Equal(pa.get(i), p, eps));
+  }
+
+  ToLocalCoords(&points[0], num, &out[0], origin, q);
+  for(size_t i = 0; i < num; ++i) {
+    assert(Equal(out[i], points[i].toLocalCoords(origin, q), eps));
+  }
+
+  Rotate(&points[0], num, &out[0], q, origin);
+  for(size_t i = 0; i < num; ++i) {
+    Point<3> p = points[i];
+    assert(Equal(out[i], p.rotate(q, origin), eps));
+  }
+
+  Rotate(&vectors[0], num, &vout[0], q);
+  VectorArray<3> va(vectors.begin(), vectors.end());
+  va.rotate(q);
+  for(size_t i = 0; i < num; ++i) {
+    Vector<3> v = vectors[i];
+    v.rotate(q);
+    assert(Equal(vout[i], v, eps));
+    assert(Equal(va.get(i), v, eps));
+  }
+}
+
+int main()
+{
+  MTRand rand(4711);
+
+  test_point_array<2>(rand);
+  test_point_array<3>(rand);
+
+  RotMatrix<2> m2;
+  RotMatrix<3> m3;
+
+  m2.rotation(numeric_constants<CoordType>::pi() / 7);
+  m3.rotation(Vector<3>(1, 2, -1), numeric_constants<CoordType>::pi() / 5);
+
+  test_batch_transform(m2, rand);
+  test_batch_transform(m3, rand);
+
+  test_batch_quaternion(Quaternion(Vector<3>(0, 1, 1), 1.2f), rand);
+
+  return 0;
+}
@@ -160,14 +160,14 @@ inline CoordType SquaredDistance(const Point<dim>& p1, const Point<dim>& p2)
 }
 
 template<int dim, template<class, class> class container,
-			template<class, class> class container2>
-Point<dim> Barycenter(const container<Point<dim>, std::allocator<Point<dim> > >& c,
-		      const container2<CoordType, std::allocator<CoordType> >& weights)
+			template<class, class> class container2, class A, class A2>
+Point<dim> Barycenter(const container<Point<dim>, A>& c,
+		      const container2<CoordType, A2>& weights)
 {
   // FIXME become friend
 
-  typename container<Point<dim>, std::allocator<Point<dim> > >::const_iterator c_i = c.begin(), c_end = c.end();
-  typename container2<CoordType, std::allocator<CoordType> >::const_iterator w_i = weights.begin(),
+  typename container<Point<dim>, A>::const_iterator c_i = c.begin(), c_end = c.end();
+  typename container2<CoordType, A2>::const_iterator w_i = weights.begin(),
 						 w_end = weights.end();
 
   Point<dim> out;
@@ -208,13 +208,10 @@ Point<dim> Barycenter(const container<Point<dim>, std::allocator<Point<dim> > >&
   return out;
 }
 
-template<int dim, template<class, class> class container>
-Point<dim> Barycenter(const container<Point<dim>, std::allocator<Point<dim> > >& c)
+// The center of the points in [begin, end), for any iterator
+template<int dim, class Iter>
+Point<dim> _Barycenter(Iter i, Iter end)
 {
-  // FIXME become friend
-
-  typename container<Point<dim>, std::allocator<Point<dim> > >::const_iterator i = c.begin(), end = c.end();
-
   if (i == end) {
     return Point<dim>();
   }
@@ -241,6 +238,34 @@ Point<dim> Barycenter(const container<Point<dim>, std::allocator<Point<dim> > >&
   return out;
 }
 
+template<int dim, class Iter>
+inline Point<dim> _Barycenter(Iter begin, Iter end, std::true_type)
+{
+  size_t n = end - begin;
+  return Barycenter(n ? &*begin : (const Point<dim>*) 0, n);
+}
+
+template<int dim, class Iter>
+inline Point<dim> _Barycenter(Iter begin, Iter end, std::false_type)
+{
+  return _Barycenter<dim>(begin, end);
+}
+
+template<int dim, template<class, class> class container, class A>
+Point<dim> Barycenter(const container<Point<dim>, A>& c)
+{
+  // FIXME become friend
+
+  return _Barycenter<dim>(c.begin(), c.end());
+}
+
+template<class Iter>
+Point<_PointIterator<Iter>::value> Barycenter(Iter begin, Iter end)
+{
+  return _Barycenter<_PointIterator<Iter>::value>(begin, end,
+                                                  typename _PointIterator<Iter>::contiguous());
+}
+
 template<int dim>
 inline Point<dim> Midpoint(const Point<dim>& p1, const Point<dim>& p2, CoordType dist)
 {
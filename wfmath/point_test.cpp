@@ -38,12 +38,14 @@
 #include "axisbox.h"
 #include "ball.h"
 #include "stream.h"
+#include "randgen.h"
 
 #include "general_test.h"
 #include "shape_test.h"
 
 #include <vector>
 #include <list>
+#include <cmath>
 
 using namespace WFMath;
 
@@ -90,6 +92,82 @@ void test_point(const Point<dim>& p)
   // FIXME more tests
 }
 
+// The array versions of BoundingBox() and Barycenter() against the
+// container ones, with sizes on both sides of the SSE2 widths and the
+// blocks, and split between different numbers of threads
+template<int dim>
+void test_arrays(MTRand& rand)
+{
+  std::cout << "Testing " << dim << "D BoundingBox() and Barycenter() on arrays" << std::endl;
+
+  const size_t sizes[] = {0, 1, 2, 3, 5, 1023, 1024, 1025, 3001, 300000};
+  const unsigned threads[] = {1, 0, 3, 7};
+
+  assert(!BoundingBox((const Point<dim>*) 0, 0).isValid());
+  assert(!BoundingBox((const AxisBox<dim>*) 0, 0).isValid());
+  assert(!Barycenter((const Point<dim>*) 0, 0).isValid());
+
+  for(size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+    size_t n = sizes[s];
+    std::vector<Point<dim> > points(n);
+    std::vector<AxisBox<dim> > boxes(n);
+    std::vector<CoordType> weights(n);
+    std::list<CoordType> weight_list;
+    for(size_t i = 0; i < n; ++i) {
+      for(int j = 0; j < dim; ++j)
+        points[i][j] = (CoordType) (rand.rand() * 200 - 100);
+      points[i].setValid();
+      Point<dim> corner = points[i];
+      for(int j = 0; j < dim; ++j)
+        corner[j] += (CoordType) (rand.rand() * 5);
+      boxes[i] = AxisBox<dim>(points[i], corner, true);
+      weights[i] = (CoordType) (rand.rand() + 0.5);
+      weight_list.push_back(weights[i]);
+    }
+    if(n == 0)
+      continue;
+
+    AxisBox<dim> point_box = BoundingBox(points), box_box = BoundingBox(boxes);
+    Point<dim> center = Barycenter(points), weighted = Barycenter(points, weight_list);
+    // The container versions sum in CoordType, which drifts over many points
+    CoordType tolerance = (CoordType) (n > 1000 ? 1e-2 : 1e-4);
+
+    for(size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); ++t) {
+      AxisBox<dim> b = BoundingBox(&points[0], n, threads[t]);
+      assert(b == point_box && b.isValid());
+      b = BoundingBox(&boxes[0], n, threads[t]);
+      assert(b == box_box && b.isValid());
+
+      Point<dim> c = Barycenter(&points[0], n, threads[t]);
+      assert(c.isValid());
+      for(int j = 0; j < dim; ++j)
+        assert(std::fabs(c[j] - center[j]) < tolerance);
+      c = Barycenter(&points[0], &weights[0], n, threads[t]);
+      assert(c.isValid());
+      for(int j = 0; j < dim; ++j)
+        assert(std::fabs(c[j] - weighted[j]) < tolerance);
+    }
+
+    // An invalid point, or box corner, anywhere makes the answer invalid
+    size_t bad = rand.randInt((unsigned long) n - 1);
+    points[bad].setValid(false);
+    boxes[bad].highCorner().setValid(false);
+    for(size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); ++t) {
+      assert(!BoundingBox(&points[0], n, threads[t]).isValid());
+      assert(!Barycenter(&points[0], n, threads[t]).isValid());
+      AxisBox<dim> b = BoundingBox(&boxes[0], n, threads[t]);
+      assert(b.lowCorner().isValid() && !b.highCorner().isValid());
+    }
+  }
+
+  // Weights which sum to zero
+  Point<dim> p[2];
+  p[0].setToOrigin();
+  p[1].setToOrigin();
+  CoordType w[2] = {5, -5};
+  assert(!Barycenter(p, w, 2).isValid());
+}
+
 int main()
 {
   test_point(Point<2>(1, -1));
@@ -100,5 +178,10 @@ int main()
   Point<3> zero3 = Point<3>::ZERO();
   assert(zero3.x() == 0 && zero3.y() == 0 && zero3.z() == 0);
 
+  MTRand rand(23);
+
+  test_arrays<2>(rand);
+  test_arrays<3>(rand);
+
   return 0;
 }
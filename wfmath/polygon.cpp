@@ -39,31 +39,39 @@ void _Poly2Reorient::reorient(Polygon<2>& poly, size_t skip) const
       for(size_t i = 0; i != end; ++i) {
         if(i == skip)
           continue;
-        (poly[i])[1] = 0;
+        Point<2> p = poly[i];
+        p[1] = 0;
+        poly.moveCorner(i, p);
       }
       return;
     case _WFMATH_POLY2REORIENT_CLEAR_BOTH_AXES:
       for(size_t i = 0; i != end; ++i) {
         if(i == skip)
           continue;
-        (poly[i])[0] = 0;
-        (poly[i])[1] = 0;
+        Point<2> p = poly[i];
+        p[0] = 0;
+        p[1] = 0;
+        poly.moveCorner(i, p);
       }
       return;
     case _WFMATH_POLY2REORIENT_MOVE_AXIS2_TO_AXIS1:
       for(size_t i = 0; i != end; ++i) {
         if(i == skip)
            continue;
-        (poly[i])[0] = (poly[i])[1];
-        (poly[i])[1] = 0;
+        Point<2> p = poly[i];
+        p[0] = p[1];
+        p[1] = 0;
+        poly.moveCorner(i, p);
       }
       return;
     case _WFMATH_POLY2REORIENT_SCALE1_CLEAR2:
       for(size_t i = 0; i != end; ++i) {
         if(i == skip)
           continue;
-        (poly[i])[0] *= m_scale;
-        (poly[i])[1] = 0;
+        Point<2> p = poly[i];
+        p[0] *= m_scale;
+        p[1] = 0;
+        poly.moveCorner(i, p);
       }
       return;
     default:
@@ -91,6 +99,59 @@ bool Polygon<2>::isEqualTo(const Polygon<2>& p, CoordType epsilon) const
   return true;
 }
 
+int Polygon<2>::convexity() const
+{
+  int c = m_convexity.load(std::memory_order_relaxed);
+  if(c != convexityUnknown)
+    return c;
+
+  const size_t n = m_points.size();
+  int turn = 0, x_sign_changes = 0;
+  CoordType last_dx = 0;
+
+  c = (n >= 3) ? convexityUnknown : notConvex;
+
+  for(size_t i = 0; i < n && c == convexityUnknown; ++i) {
+    const Point<2>& prev = m_points[(i == 0) ? n - 1 : i - 1];
+    const Point<2>& next = m_points[(i + 1 == n) ? 0 : i + 1];
+    const Point<2>& corner = m_points[i];
+    CoordType cross = Cross(corner - prev, next - corner);
+
+    if(!(cross != 0) || (turn != 0 && (cross > 0) != (turn > 0))) {
+      c = notConvex;
+      break;
+    }
+    turn = (cross > 0) ? 1 : -1;
+
+    // Turning the same way at every corner, a polygon going round more
+    // than once, like a pentagram, reverses its direction in x more
+    // than twice
+    CoordType dx = next[0] - corner[0];
+    if(dx != 0) {
+      if(last_dx != 0 && (dx > 0) != (last_dx > 0))
+        ++x_sign_changes;
+      last_dx = dx;
+    }
+  }
+
+  if(c == convexityUnknown) {
+    // The change from the last edge back to the first
+    for(size_t i = 0; i < n; ++i) {
+      CoordType dx = m_points[(i + 1 == n) ? 0 : i + 1][0] - m_points[i][0];
+      if(dx != 0) {
+        if((dx > 0) != (last_dx > 0))
+          ++x_sign_changes;
+        break;
+      }
+    }
+    c = (x_sign_changes > 2) ? notConvex
+      : (turn > 0) ? convexCounterClockwise : convexClockwise;
+  }
+
+  m_convexity.store(c, std::memory_order_relaxed);
+  return c;
+}
+
 bool Polygon<2>::isValid() const
 {
   for(theConstIter i = m_points.begin(); i != m_points.end(); ++i)
@@ -115,6 +176,9 @@ Polygon<2>& Polygon<2>::rotatePoint(const RotMatrix<2>& m, const Point<2>& p)
   for(theIter i = m_points.begin(); i != m_points.end(); ++i)
     i->rotate(m, p);
 
+  // A matrix with parity reverses the orientation
+  cornersChanged();
+
   return *this;
 }
 
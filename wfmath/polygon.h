@@ -30,8 +30,9 @@
 #include <wfmath/axisbox.h>
 #include <wfmath/ball.h>
 #include <wfmath/quaternion.h>
+#include <wfmath/small_vector.h>
 
-#include <vector>
+#include <atomic>
 
 namespace WFMath {
 
@@ -47,10 +48,10 @@ template<>
 class Polygon<2>
 {
  public:
-  Polygon() : m_points() {}
-  Polygon(const Polygon& p) : m_points(p.m_points) {}
+  Polygon() : m_points(), m_convexity(convexityUnknown) {}
+  Polygon(const Polygon& p) : m_points(p.m_points), m_convexity(p.m_convexity.load(std::memory_order_relaxed)) {}
   /// Construct a polygon from an object passed by Atlas
-  explicit Polygon(const AtlasInType& a) : m_points() {fromAtlas(a);}
+  explicit Polygon(const AtlasInType& a) : m_points(), m_convexity(convexityUnknown) {fromAtlas(a);}
 
   ~Polygon() {}
 
@@ -64,7 +65,11 @@ class Polygon<2>
   void fromAtlas(const AtlasInType& a);
   
   Polygon& operator=(const Polygon& p)
-  {m_points = p.m_points; return *this;}
+  {
+    m_points = p.m_points;
+    m_convexity.store(p.m_convexity.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
+  }
 
   bool isEqualTo(const Polygon& p, CoordType epsilon = numeric_constants<CoordType>::epsilon()) const;
 
@@ -77,7 +82,22 @@ class Polygon<2>
 
   size_t numCorners() const {return m_points.size();}
   Point<2> getCorner(size_t i) const {return m_points[i];}
-  Point<2> getCenter() const {return Barycenter(m_points);}
+  Point<2> getCenter() const {return Barycenter(m_points.data(), m_points.size());}
+
+  /// True if the polygon is strictly convex
+  /**
+   * That is, it has at least three corners, and turns the same way, by
+   * less than a half turn, at every one of them, going once around.
+   * Polygons with repeated corners, or with three corners in a row on
+   * a line, are not strictly convex.
+   *
+   * This is worked out the first time it's needed, and kept until the
+   * corners change. The intersection functions use it to pick faster
+   * tests for convex polygons. Any non-const member function counts as
+   * changing the corners, which is why there is no non-const operator[]:
+   * a reference to a corner could change it after the check was cached.
+   **/
+  bool isConvex() const {return convexity() != notConvex;}
 
   // For a Polygon<2>, addCorner() and moveCorner() always succeed.
   // The return values are present for the sake of a unified template
@@ -85,22 +105,22 @@ class Polygon<2>
 
   // Add before i'th corner, zero is beginning, numCorners() is end
   bool addCorner(size_t i, const Point<2>& p, CoordType = numeric_constants<CoordType>::epsilon())
-  {m_points.insert(m_points.begin() + i, p); return true;}
+  {m_points.insert(m_points.begin() + i, p); cornersChanged(); return true;}
 
   // Remove the i'th corner
-  void removeCorner(size_t i) {m_points.erase(m_points.begin() + i);}
+  void removeCorner(size_t i) {m_points.erase(m_points.begin() + i); cornersChanged();}
 
   // Move the i'th corner to p
   bool moveCorner(size_t i, const Point<2>& p, CoordType = numeric_constants<CoordType>::epsilon())
-  {m_points[i] = p; return true;}
+  {m_points[i] = p; cornersChanged(); return true;}
 
   // Remove all points
-  void clear()	{m_points.clear();}
+  void clear()	{m_points.clear(); cornersChanged();}
 
+  // Corners are changed with moveCorner(), see isConvex()
   const Point<2>& operator[](size_t i) const {return m_points[i];}
-  Point<2>& operator[](size_t i)		  {return m_points[i];}
 
-  void resize(std::vector<Point<2> >::size_type size) {m_points.resize(size);}
+  void resize(size_t size) {m_points.resize(size); cornersChanged();}
 
   // Movement functions
 
@@ -118,9 +138,9 @@ class Polygon<2>
 
   // Intersection functions
 
-  AxisBox<2> boundingBox() const {return BoundingBox(m_points);}
-  Ball<2> boundingSphere() const {return BoundingSphere(m_points);}
-  Ball<2> boundingSphereSloppy() const {return BoundingSphereSloppy(m_points);}
+  AxisBox<2> boundingBox() const {return BoundingBox(m_points.data(), m_points.size());}
+  Ball<2> boundingSphere() const {return BoundingSphere(m_points.data(), m_points.size());}
+  Ball<2> boundingSphereSloppy() const {return BoundingSphereSloppy(m_points.data(), m_points.size());}
 
   Polygon toParentCoords(const Point<2>& origin,
       const RotMatrix<2>& rotation = RotMatrix<2>().identity()) const;
@@ -140,6 +160,8 @@ class Polygon<2>
   friend bool Contains<2>(const Point<2>& p, const Polygon& r, bool proper);
 
   friend bool Intersect<2>(const Polygon& p, const AxisBox<2>& b, bool proper);
+  friend bool Intersect<2>(const Polygon& p, const AxisBox<2>& b, bool proper,
+                           SeparatingAxisCache& cache);
   friend bool Contains<2>(const Polygon& p, const AxisBox<2>& b, bool proper);
   friend bool Contains<2>(const AxisBox<2>& b, const Polygon& p, bool proper);
 
@@ -152,17 +174,49 @@ class Polygon<2>
   friend bool Contains<2>(const Segment<2>& s, const Polygon& p, bool proper);
 
   friend bool Intersect<2>(const Polygon& p, const RotBox<2>& r, bool proper);
+  friend bool Intersect<2>(const Polygon& p, const RotBox<2>& r, bool proper,
+                           SeparatingAxisCache& cache);
   friend bool Contains<2>(const Polygon& p, const RotBox<2>& r, bool proper);
   friend bool Contains<2>(const RotBox<2>& r, const Polygon& p, bool proper);
 
   friend bool Intersect<2>(const Polygon& p1, const Polygon& p2, bool proper);
+  friend bool Intersect<2>(const Polygon& p1, const Polygon& p2, bool proper,
+                           SeparatingAxisCache& cache);
   friend bool Contains<2>(const Polygon& outer, const Polygon& inner, bool proper);
 
 private:
-  std::vector<Point<2> > m_points;
-  typedef std::vector<Point<2> >::iterator theIter;
-  typedef std::vector<Point<2> >::const_iterator theConstIter;
-
+  // The values of m_convexity. The orientation of a convex polygon is
+  // the sign of the area it encloses.
+  enum {
+    convexityUnknown,
+    notConvex,
+    convexCounterClockwise,
+    convexClockwise
+  };
+
+  // One of the values above other than convexityUnknown, from the
+  // cache if it's there
+  int convexity() const;
+  // +1 for a convex polygon with positive area, -1 for negative area,
+  // and 0 for any other polygon
+  int convexOrientation() const
+  {
+    int c = convexity();
+    return (c == convexCounterClockwise) ? 1 : (c == convexClockwise) ? -1 : 0;
+  }
+  void cornersChanged() {m_convexity.store(convexityUnknown, std::memory_order_relaxed);}
+
+  // Up to WFMATH_INLINE_CORNERS corners are kept in the polygon
+  // itself, so small polygons can be built and copied without
+  // allocating
+  typedef _SmallVector<Point<2>, WFMATH_INLINE_CORNERS> Corners;
+  Corners m_points;
+  typedef Corners::iterator theIter;
+  typedef Corners::const_iterator theConstIter;
+
+  // Const queries may fill this in from several threads at once, all
+  // of them storing the same value, so it only needs to be atomic
+  mutable std::atomic<int> m_convexity;
 };
 
 // Helper classes, to keep track of the orientation of
@@ -273,11 +327,11 @@ public:
   // 3D only
   _Poly2Orient<3> toParentCoords(const Point<3>& origin, const Quaternion& rotation) const
   {_Poly2Orient p(*this); p.m_origin = m_origin.toParentCoords(origin, rotation);
-    p.m_axes[0].rotate(rotation); p.m_axes[0].rotate(rotation); return p;}
+    p.m_axes[0].rotate(rotation); p.m_axes[1].rotate(rotation); return p;}
   _Poly2Orient<3> toLocalCoords(const Point<3>& origin, const Quaternion& rotation) const
   {_Poly2Orient p(*this); p.m_origin = m_origin.toLocalCoords(origin, rotation);
     p.m_axes[0].rotate(rotation.inverse());
-    p.m_axes[0].rotate(rotation.inverse()); return p;}
+    p.m_axes[1].rotate(rotation.inverse()); return p;}
 
   // Gives the offset from pd to the space spanned by
   // the basis, and puts the nearest point in p2.
@@ -329,6 +383,8 @@ public:
   size_t numCorners() const {return m_poly.numCorners();}
   Point<dim> getCorner(size_t i) const {return m_orient.convert(m_poly[i]);}
   Point<dim> getCenter() const {return m_orient.convert(m_poly.getCenter());}
+  /// True if the polygon is strictly convex, see Polygon<2>::isConvex()
+  bool isConvex() const {return m_poly.isConvex();}
 
   // The failure of the following functions does not invalidate the
   // polygon, but merely leaves it unchaged.
@@ -466,7 +522,7 @@ inline bool Polygon<dim>::moveCorner(size_t i, const Point<dim>& p, CoordType ep
     return false;
 
   r.reorient(m_poly, i);
-  m_poly[i] = p2;
+  m_poly.moveCorner(i, p2);
   m_orient = try_orient;
 
   return true;
@@ -0,0 +1,246 @@
+// polygon_alloc_test.cpp (Checks that the polygon intersection functions don't allocate)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+// Created: 2026-10-16
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#ifndef DEBUG
+#define DEBUG
+#endif
+
+#include "const.h"
+#include "vector.h"
+#include "rotmatrix.h"
+#include "point.h"
+#include "axisbox.h"
+#include "ball.h"
+#include "segment.h"
+#include "rotbox.h"
+#include "polygon.h"
+#include "polygon_intersect.h"
+#include "line.h"
+
+#include <iostream>
+#include <new>
+
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+
+using namespace WFMath;
+
+// Count every allocation in the program, including those made inside
+// the library
+static size_t allocations = 0;
+
+void* operator new(std::size_t size)
+{
+  ++allocations;
+  void* p = std::malloc(size ? size : 1);
+  if(!p)
+    throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+static Polygon<3> make_polygon(const Point<3>* corners, size_t num)
+{
+  Polygon<3> p;
+  for(size_t i = 0; i < num; ++i) {
+    bool succ = p.addCorner(i, corners[i]);
+    assert(succ);
+  }
+  return p;
+}
+
+// A regular polygon in the plane spanned by u and w, with its first
+// corner at the origin
+static Polygon<3> make_round_polygon(const Vector<3>& u, const Vector<3>& w,
+                                     size_t num, CoordType radius)
+{
+  Polygon<3> p;
+  for(size_t i = 0; i < num; ++i) {
+    CoordType angle = (CoordType) (2 * numeric_constants<CoordType>::pi() * i / num);
+    Point<3> corner = Point<3>().setToOrigin()
+                    + u * (radius * (std::cos(angle) - 1))
+                    + w * (radius * std::sin(angle));
+    bool succ = p.addCorner(i, corner);
+    assert(succ);
+  }
+  return p;
+}
+
+static Polygon<2> make_polygon_2d(size_t num, CoordType radius)
+{
+  Polygon<2> p;
+  for(size_t i = 0; i < num; ++i) {
+    CoordType angle = (CoordType) (2 * numeric_constants<CoordType>::pi() * i / num);
+    // Alternate the radius, to make it concave
+    CoordType r = (i % 2) ? radius / 2 : radius;
+    p.addCorner(i, Point<2>(r * std::cos(angle), r * std::sin(angle)));
+  }
+  return p;
+}
+
+// Run every polygon intersection function the shapes support, returning
+// a checksum of the answers
+static unsigned run_queries(const Polygon<3>* polys, size_t num_polys,
+                       const Polygon<2>& poly2)
+{
+  unsigned answers = 0;
+
+  for(int proper = 0; proper < 2; ++proper) {
+    for(size_t i = 0; i < num_polys; ++i) {
+      for(size_t j = 0; j < num_polys; ++j) {
+        answers = answers * 3 + Intersect(polys[i], polys[j], proper != 0);
+        answers = answers * 3 + Contains(polys[i], polys[j], proper != 0);
+      }
+
+      const Polygon<3>& p = polys[i];
+      AxisBox<3> box(Point<3>(-1, -1, -1), Point<3>(1, 1, 1));
+      RotMatrix<3> m;
+      m.rotation(Vector<3>(1, 2, 3), 0.5f);
+      RotBox<3> rbox(Point<3>(-1, -1, -1), Vector<3>(2, 2, 2), m);
+      Segment<3> s(Point<3>(-1, -1, -1), Point<3>(1, 1, 1));
+      Ball<3> ball(Point<3>(0.5f, 0.5f, 0), 0.7f);
+
+      answers = answers * 3 + Intersect(p, box, proper != 0);
+      answers = answers * 3 + Contains(p, box, proper != 0);
+      answers = answers * 3 + Contains(box, p, proper != 0);
+      answers = answers * 3 + Intersect(p, rbox, proper != 0);
+      answers = answers * 3 + Contains(p, rbox, proper != 0);
+      answers = answers * 3 + Contains(rbox, p, proper != 0);
+      answers = answers * 3 + Intersect(p, s, proper != 0);
+      answers = answers * 3 + Contains(p, s, proper != 0);
+      answers = answers * 3 + Contains(s, p, proper != 0);
+      answers = answers * 3 + Intersect(p, ball, proper != 0);
+      answers = answers * 3 + Contains(p, ball, proper != 0);
+      answers = answers * 3 + Contains(ball, p, proper != 0);
+    }
+
+    AxisBox<2> box(Point<2>(-0.5f, -0.5f), Point<2>(0.5f, 0.5f));
+    RotMatrix<2> m;
+    m.rotation(0.3f);
+    RotBox<2> rbox(Point<2>(-0.5f, -0.5f), Vector<2>(3, 1), m);
+    Segment<2> s(Point<2>(-2, 0.1f), Point<2>(2, 0.2f));
+    Ball<2> ball(Point<2>(1, 0), 0.3f);
+
+    answers = answers * 3 + Intersect(poly2, Point<2>(0.1f, 0.2f), proper != 0);
+    answers = answers * 3 + Intersect(poly2, box, proper != 0);
+    answers = answers * 3 + Contains(poly2, box, proper != 0);
+    answers = answers * 3 + Intersect(poly2, rbox, proper != 0);
+    answers = answers * 3 + Contains(poly2, rbox, proper != 0);
+    answers = answers * 3 + Intersect(poly2, s, proper != 0);
+    answers = answers * 3 + Contains(poly2, s, proper != 0);
+    answers = answers * 3 + Intersect(poly2, ball, proper != 0);
+    answers = answers * 3 + Contains(poly2, ball, proper != 0);
+    answers = answers * 3 + Intersect(poly2, poly2, proper != 0);
+    answers = answers * 3 + Contains(poly2, poly2, proper != 0);
+  }
+
+  return answers;
+}
+
+int main()
+{
+  std::cout << "Testing allocation in the polygon intersection functions" << std::endl;
+
+  // Polygons sharing a corner at the origin, so that those in
+  // different planes meet along a line, and those in the same plane
+  // overlap. This covers all of the cases in _PolyPolyIntersect()
+  // and _PolyPolyContains(). No two neighboring corners lie on the
+  // line where two planes meet, as _GetCrossings() doesn't handle
+  // that reliably.
+  const Point<3> square[] = {Point<3>(0, 0, 0), Point<3>(2, 0, 0),
+                             Point<3>(2, 2, 0), Point<3>(0, 2, 0)};
+  const Point<3> crossing[] = {Point<3>(0, 0, 0), Point<3>(1, 1, -1),
+                               Point<3>(1, 1, 1)};
+  const Point<3> touching[] = {Point<3>(0, 0, 0), Point<3>(-1, -1, -1),
+                               Point<3>(-1, -1, 1)};
+  const Point<3> inside[] = {Point<3>(0, 0, 0), Point<3>(1, 0, 0),
+                             Point<3>(1, 0.5f, 0)};
+  const Point<3> line[] = {Point<3>(0, 0, 0), Point<3>(1, 1, 0)};
+
+  Vector<3> diagonal(1, 1, 0);
+  diagonal /= diagonal.mag();
+
+  const Polygon<3> polys[] = {
+    make_polygon(square, 4),
+    make_polygon(crossing, 3),
+    make_polygon(touching, 3),
+    make_polygon(inside, 3),
+    make_polygon(line, 2),
+    make_round_polygon(diagonal, Vector<3>(0, 0, 1), 64, 1),
+    make_round_polygon(Vector<3>(1, 0, 0), Vector<3>(0, 1, 0), 64, 1),
+  };
+  const size_t num_polys = sizeof(polys) / sizeof(polys[0]);
+
+  const Polygon<2> poly2 = make_polygon_2d(64, 2);
+
+  // The first run may grow the scratch storage
+  unsigned answers = run_queries(polys, num_polys, poly2);
+
+  allocations = 0;
+  for(int n = 0; n < 10; ++n)
+    assert(run_queries(polys, num_polys, poly2) == answers);
+  assert(allocations == 0);
+
+  // Shapes with no more than WFMATH_INLINE_CORNERS corners don't
+  // allocate to be built, copied or moved
+  allocations = 0;
+  for(int n = 0; n < 10; ++n) {
+    Polygon<3> square3 = make_polygon(square, 4);
+    Polygon<3> copy = square3;
+    Polygon<3> moved = copy.toParentCoords(Point<3>(1, 2, 3));
+    assert(moved.numCorners() == 4 && copy == square3);
+
+    Polygon<2> square2 = make_polygon_2d(WFMATH_INLINE_CORNERS, 1);
+    Polygon<2> local = square2.toLocalCoords(Point<2>(1, 1));
+    square2 = local;
+    assert(square2.numCorners() == WFMATH_INLINE_CORNERS);
+
+    Line<3> path;
+    for(size_t i = 0; i < WFMATH_INLINE_CORNERS; ++i)
+      path.addCorner(i, square[i % 4]);
+    Line<3> path_copy = path;
+    assert(path_copy == path && path.boundingBox().isValid());
+  }
+  assert(allocations == 0);
+
+  // More than that falls back to the heap
+  Polygon<2> big = make_polygon_2d(WFMATH_INLINE_CORNERS + 1, 1);
+  allocations = 0;
+  Polygon<2> big_copy = big;
+  assert(allocations == 1 && big_copy == big);
+
+  return 0;
+}
@@ -0,0 +1,162 @@
+// polygon_bench.cpp (Polygon<2> intersection benchmark)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+// Compares Intersect() and Contains() for two Polygon<2> with the
+// nested loops over every pair of edges they used to be, for
+// polygons of increasing size. Then compares the tests for convex
+// polygons with the general ones.
+
+#include "const.h"
+#include "point.h"
+#include "segment.h"
+#include "polygon.h"
+#include "polygon_intersect.h"
+#include "randgen.h"
+#include "timestamp.h"
+
+#include <iostream>
+
+#include <cmath>
+
+using namespace WFMath;
+
+static bool brute_intersect(const Polygon<2>& p1, const Polygon<2>& p2, bool proper)
+{
+  for(size_t i1 = 0, j1 = p1.numCorners() - 1; i1 < p1.numCorners(); j1 = i1++)
+    for(size_t i2 = 0, j2 = p2.numCorners() - 1; i2 < p2.numCorners(); j2 = i2++)
+      if(Intersect(Segment<2>(p1[j1], p1[i1]), Segment<2>(p2[j2], p2[i2]), proper))
+        return true;
+
+  return Contains(p1, p2[0], proper) || Contains(p2, p1[0], proper);
+}
+
+static bool brute_contains(const Polygon<2>& outer, const Polygon<2>& inner)
+{
+  for(size_t i = 0, j = inner.numCorners() - 1; i < inner.numCorners(); j = i++)
+    if(!Contains(outer, Segment<2>(inner[j], inner[i]), false))
+      return false;
+
+  return true;
+}
+
+// A star shaped polygon around (x, 0) with radii between low and high
+static Polygon<2> star(MTRand& rand, int corners, CoordType x, CoordType low, CoordType high)
+{
+  Polygon<2> poly;
+  for(int i = 0; i < corners; ++i) {
+    CoordType angle = (CoordType) (2 * numeric_constants<CoordType>::pi() * i / corners);
+    CoordType r = low + (high - low) * (CoordType) rand.rand();
+    poly.addCorner(i, Point<2>(x + r * std::cos(angle), r * std::sin(angle)));
+  }
+  return poly;
+}
+
+static void report(const char* name, int iterations, const TimeStamp& start, const TimeStamp& end)
+{
+  double us = (end - start).milliseconds() * 1e3 / iterations;
+  std::cout << "  " << name << ": " << us << " us per call" << std::endl;
+}
+
+int main()
+{
+  MTRand rand(1);
+  bool same = true;
+
+  // Stars which are near each other but don't touch, for Intersect(),
+  // and one star inside the other, for Contains(), so that neither
+  // function can stop early
+  for(int corners = 16; corners <= 4096; corners *= 4) {
+    Polygon<2> outer = star(rand, corners, 0, 600, 1000);
+    Polygon<2> inner = star(rand, corners, 0, 100, 500);
+    Polygon<2> beside = star(rand, corners, 1700, 100, 690);
+    int iterations = 20000000 / (corners * corners) + 5;
+
+    std::cout << "Polygon<2> pairs with " << corners << " corners, "
+              << iterations << " iterations" << std::endl;
+
+    int hits = 0;
+    TimeStamp start = TimeStamp::now();
+    for(int n = 0; n < iterations; ++n)
+      hits += brute_intersect(outer, beside, false);
+    report("Intersect(), every pair", iterations, start, TimeStamp::now());
+
+    int swept_hits = 0;
+    start = TimeStamp::now();
+    for(int n = 0; n < iterations; ++n)
+      swept_hits += Intersect(outer, beside, false);
+    report("Intersect()", iterations, start, TimeStamp::now());
+
+    start = TimeStamp::now();
+    for(int n = 0; n < iterations; ++n)
+      hits += brute_contains(outer, inner);
+    report("Contains(), every pair", iterations, start, TimeStamp::now());
+
+    start = TimeStamp::now();
+    for(int n = 0; n < iterations; ++n)
+      swept_hits += Contains(outer, inner, false);
+    report("Contains()", iterations, start, TimeStamp::now());
+
+    same = same && (hits == swept_hits);
+  }
+
+  // Regular polygons, and copies with a repeated corner, which are not
+  // strictly convex and so use the general tests
+  for(int corners = 16; corners <= 4096; corners *= 4) {
+    Polygon<2> convex = star(rand, corners, 0, 1000, 1000);
+    Polygon<2> beside = star(rand, corners, 2100, 1000, 1000);
+    Polygon<2> general = convex, general_beside = beside;
+    general.addCorner(0, convex[0]);
+    general_beside.addCorner(0, beside[0]);
+    int iterations = 2000000 / corners + 5, point_iterations = 2000000;
+
+    std::cout << "Convex Polygon<2> with " << corners << " corners, "
+              << point_iterations << " and " << iterations << " iterations" << std::endl;
+
+    int hits = 0;
+    TimeStamp start = TimeStamp::now();
+    for(int n = 0; n < point_iterations; ++n)
+      hits += Intersect(general, Point<2>((CoordType) (n % 2000 - 1000), 10), false);
+    report("Intersect() with a point, general", point_iterations, start, TimeStamp::now());
+
+    int convex_hits = 0;
+    start = TimeStamp::now();
+    for(int n = 0; n < point_iterations; ++n)
+      convex_hits += Intersect(convex, Point<2>((CoordType) (n % 2000 - 1000), 10), false);
+    report("Intersect() with a point, convex", point_iterations, start, TimeStamp::now());
+
+    start = TimeStamp::now();
+    for(int n = 0; n < iterations; ++n)
+      hits += Intersect(general, general_beside, false);
+    report("Intersect() with a polygon, general", iterations, start, TimeStamp::now());
+
+    start = TimeStamp::now();
+    for(int n = 0; n < iterations; ++n)
+      convex_hits += Intersect(convex, beside, false);
+    report("Intersect() with a polygon, convex", iterations, start, TimeStamp::now());
+
+    same = same && (hits == convex_hits);
+  }
+
+  return same ? 0 : 1;
+}
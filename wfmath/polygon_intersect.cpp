@@ -27,9 +27,12 @@
 
 #include "segment.h"
 #include "rotbox.h"
+#include "prepared_polygon.h"
 
 #include <algorithm>
-#include <list>
+#include <vector>
+
+#include <cmath>
 
 namespace WFMath {
 
@@ -149,24 +152,59 @@ struct LinePointData {
   bool cross;
 };
 
+// For use in _PolyEdgePairs()
+struct _EdgeBox {
+  CoordType low[2], high[2];
+  size_t edge;
+  int poly;
+
+  bool operator<(const _EdgeBox& b) const {return low[0] < b.low[0];}
+};
+
+// Working storage for _PolyPolyIntersect(), _PolyPolyContains() and
+// the Polygon<2>/Polygon<2> functions. Each thread keeps its own, and
+// the vectors keep their capacity between calls, so once they have
+// grown to fit the largest polygons seen, these functions stop
+// allocating.
+struct _PolyPolyScratch {
+  std::vector<CoordType> cross1, cross2;
+  // Stuff for when multiple sequential corners lie on the line
+  std::vector<LinePointData> line_point_data;
+  Polygon<2> poly;
+  // For _PolyEdgePairs()
+  std::vector<_EdgeBox> boxes;
+  std::vector<size_t> active[2];
+  // For Contains(Polygon<2>, Polygon<2>)
+  PreparedPolygon<2> prepared;
+  std::vector<char> near_crossings;
+};
+
+static _PolyPolyScratch& _GetPolyPolyScratch()
+{
+  static thread_local _PolyPolyScratch scratch;
+  return scratch;
+}
+
 // This finds the intervals where the polygon intersects the line
 // through p parallel to v, and puts the endpoints of those
 // intervals in the vector "cross"
 static bool _GetCrossings(const Polygon<2> &poly, const Point<2> &p,
 			  const Vector<2> &v, std::vector<CoordType> &cross,
+			  std::vector<LinePointData> &line_point_data,
 			  bool proper)
 {
-  assert(poly.numCorners() == cross.size()); // Already allocated
   assert(Equal(v.sqrMag(), 1));
 
+  // A corner which touches the line adds two crossings. resize()
+  // and clear() keep the capacity.
+  cross.resize(2 * poly.numCorners());
+  line_point_data.clear();
+
   // The sign of the cross product changes when you cross the line
   Point<2> old_p = poly.getCorner(poly.numCorners() - 1);
   bool old_below = (Cross(v, old_p - p) < 0);
   int next_cross = 0;
 
-  // Stuff for when multiple sequential corners lie on the line
-  std::list<LinePointData> line_point_data;
-
   for(size_t i = 0; i < poly.numCorners(); ++i) {
     Point<2> p_i =  poly.getCorner(i);
     Vector<2> v_i = p_i - p;
@@ -177,8 +215,9 @@ static bool _GetCrossings(const Polygon<2> &poly, const Point<2> &p,
       Point<2> p_j;
       Vector<2> v_j;
       CoordType proj_j, low_proj = proj, high_proj = proj;
+      const size_t after_i = (i + 1 == poly.numCorners()) ? 0 : i + 1;
       size_t j;
-      for(j = i + 1; j != i; j == poly.numCorners() - 1 ? j = 0 : ++j) {
+      for(j = after_i; j != i; j == poly.numCorners() - 1 ? j = 0 : ++j) {
         p_j = poly.getCorner(j);
 	v_j = p_j - p;
         proj_j = Dot(v_j, v);
@@ -201,7 +240,7 @@ static bool _GetCrossings(const Polygon<2> &poly, const Point<2> &p,
         continue;
       }
 
-      if(j == i + 1) { // just one point on the line
+      if(j == after_i) { // just one point on the line
 
         if(below != old_below) {
           old_below = below;
@@ -220,14 +259,14 @@ static bool _GetCrossings(const Polygon<2> &poly, const Point<2> &p,
 
       LinePointData data = {low_proj, high_proj, below != old_below};
 
-      std::list<LinePointData>::iterator I;
+      std::vector<LinePointData>::iterator I;
 
       for(I = line_point_data.begin(); I != line_point_data.end(); ++I) {
         if(data.low > I->high)
           continue;
 
         if(data.high < I->low) {
-          line_point_data.insert(I, data);
+          I = line_point_data.insert(I, data);
           break;
         }
 
@@ -237,11 +276,11 @@ static bool _GetCrossings(const Polygon<2> &poly, const Point<2> &p,
         I->high = (I->high > data.high) ? I->high : data.high;
         I->cross = (I->cross != data.cross);
 
-        std::list<LinePointData>::iterator J = I;
+        std::vector<LinePointData>::iterator J = I;
 
         ++J;
 
-        if(J->low < I->high) {
+        if(J != line_point_data.end() && J->low < I->high) {
           I->high = J->high;
           I->cross = (I->cross != J->cross);
 	  line_point_data.erase(J);
@@ -262,7 +301,7 @@ static bool _GetCrossings(const Polygon<2> &poly, const Point<2> &p,
 
     if(below != old_below) {
       old_below = below;
-      Vector<2> dist = p - old_p;
+      Vector<2> dist = p_i - old_p; // the edge
       CoordType dist_sqr_mag = dist.sqrMag();
       CoordType dist_proj = Dot(dist, v);
 
@@ -270,19 +309,19 @@ static bool _GetCrossings(const Polygon<2> &poly, const Point<2> &p,
 
       assert(denom != 0); // We got a crossing, the vectors can't be parallel
 
-      CoordType line_pos = (dist_proj * Dot(v_i, dist) + dist_sqr_mag * proj) / denom;
+      CoordType line_pos = (dist_proj * Dot(v_i, dist) - dist_sqr_mag * proj) / denom;
 
       cross[next_cross++] = line_pos;
     }
 
-    old_p = p;
+    old_p = p_i;
   }
 
   cross.resize(next_cross);
   std::sort(cross.begin(), cross.end());
 
   if(!line_point_data.empty()) {
-    std::list<LinePointData>::iterator I = line_point_data.begin();
+    std::vector<LinePointData>::iterator I = line_point_data.begin();
     std::vector<CoordType>::iterator cross_num = cross.begin();
     bool hit = false;
 
@@ -302,7 +341,7 @@ static bool _GetCrossings(const Polygon<2> &poly, const Point<2> &p,
 
         do {
           ++high_cross_num;
-        } while(*high_cross_num < I->high);
+        } while(high_cross_num != cross.end() && *high_cross_num < I->high);
 
         hit_between = (((high_cross_num - cross_num) % 2) != 0) != I->cross;
 
@@ -423,12 +462,15 @@ bool _PolyPolyIntersect(const Polygon<2> &poly1, const Polygon<2> &poly2,
       }
 
       {
-	std::vector<CoordType> cross1(poly1.numCorners());
-	if(!_GetCrossings(poly1, data.p1, data.v1, cross1, proper))
+	_PolyPolyScratch& scratch = _GetPolyPolyScratch();
+	std::vector<CoordType> &cross1 = scratch.cross1, &cross2 = scratch.cross2;
+
+	if(!_GetCrossings(poly1, data.p1, data.v1, cross1,
+			  scratch.line_point_data, proper))
 	  return false; // line misses polygon
 
-	std::vector<CoordType> cross2(poly2.numCorners());
-	if(!_GetCrossings(poly2, data.p2, data.v2, cross2, proper))
+	if(!_GetCrossings(poly2, data.p2, data.v2, cross2,
+			  scratch.line_point_data, proper))
 	  return false; // line misses polygon
 
 	std::vector<CoordType>::iterator i1 = cross1.begin(), i2 = cross2.begin();
@@ -465,14 +507,17 @@ bool _PolyPolyIntersect(const Polygon<2> &poly1, const Polygon<2> &poly2,
       // Perhaps not the most efficient, but this is a
       // rare special case.
       {
-        Polygon<2> tmp_poly(poly2);
+        // Assignment reuses the scratch polygon's storage
+        Polygon<2>& tmp_poly = _GetPolyPolyScratch().poly;
+        tmp_poly = poly2;
 
         for(size_t i = 0; i < tmp_poly.numCorners(); ++i) {
-          Point<2> &p = tmp_poly[i];
+          Point<2> p = tmp_poly[i];
           Point<2> shift_p = p + data.off;
 
           p[0] = shift_p[0] * data.v1[0] + shift_p[1] * data.v2[0];
           p[1] = shift_p[0] * data.v1[1] + shift_p[1] * data.v2[1];
+          tmp_poly.moveCorner(i, p);
         }
 
       return Intersect(poly1, tmp_poly, proper);
@@ -520,14 +565,16 @@ bool _PolyPolyContains(const Polygon<2> &outer, const Polygon<2> &inner,
       // Perhaps not the most efficient, but this is a
       // rare special case.
       {
-        Polygon<2> tmp_poly(inner);
+        Polygon<2>& tmp_poly = _GetPolyPolyScratch().poly;
+        tmp_poly = inner;
 
         for(size_t i = 0; i < tmp_poly.numCorners(); ++i) {
-          Point<2> &p = tmp_poly[i];
+          Point<2> p = tmp_poly[i];
           Point<2> shift_p = p + data.off;
 
           p[0] = shift_p[0] * data.v1[0] + shift_p[1] * data.v2[0];
           p[1] = shift_p[0] * data.v1[1] + shift_p[1] * data.v2[1];
+          tmp_poly.moveCorner(i, p);
         }
 
         return Contains(outer, tmp_poly, proper);
@@ -545,9 +592,190 @@ bool _PolyPolyContains(const Polygon<2> &outer, const Polygon<2> &inner,
 // The Polygon<2>/Point<2> intersection function was stolen directly
 // from shape.cpp in libCoal
 
+// Fast paths for convex polygons. These take the corners of the
+// polygon as an array, so that boxes can use them too, and the
+// orientation o from Polygon<2>::convexOrientation().
+
+// Positive when q is on the inner side of the edge from a to b, and
+// proportional to its distance from the line through the edge. This
+// is the cross product of b - a and q - a, without the rounding to
+// zero Cross() does, since _EdgeTolerance() allows for that.
+static CoordType _EdgeDepth(const Point<2>& a, const Point<2>& b, int o, const Point<2>& q)
+{
+  return o * ((b[0] - a[0]) * (q[1] - a[1]) - (b[1] - a[1]) * (q[0] - a[0]));
+}
+
+// The rounding error allowed in _EdgeDepth(), about epsilon times the
+// size of the coordinates, in distance from the edge
+static CoordType _EdgeTolerance(const Point<2>& a, const Point<2>& b, const Point<2>& q)
+{
+  CoordType scale = 1;
+  for(int i = 0; i < 2; ++i)
+    scale = FloatMax(scale, FloatMax(std::fabs(a[i]), std::fabs(q[i])));
+
+  return numeric_constants<CoordType>::epsilon() * scale
+         * (std::fabs(b[0] - a[0]) + std::fabs(b[1] - a[1]));
+}
+
+static bool _InsideEdge(const Point<2>& a, const Point<2>& b, int o,
+                        const Point<2>& q, bool proper)
+{
+  CoordType depth = _EdgeDepth(a, b, o, q), tolerance = _EdgeTolerance(a, b, q);
+
+  return proper ? depth > tolerance : depth >= -tolerance;
+}
+
+// Point containment in O(log n). Seen from corner 0, the other corners
+// go round in order, so a binary search finds the triangle of the fan
+// from corner 0 which q is in, if any, and only the outer edge of that
+// triangle needs testing.
+static bool _ConvexContains(const Point<2>* corners, size_t n, int o,
+                            const Point<2>& q, bool proper)
+{
+  const Point<2>& first = corners[0];
+
+  if(!_InsideEdge(first, corners[1], o, q, proper)
+     || !_InsideEdge(corners[n - 1], first, o, q, proper))
+    return false;
+
+  size_t low = 1, high = n - 1;
+  while(high - low > 1) {
+    size_t mid = low + (high - low) / 2;
+    if(_EdgeDepth(first, corners[mid], o, q) >= 0)
+      low = mid;
+    else
+      high = mid;
+  }
+
+  return _InsideEdge(corners[low], corners[low + 1], o, q, proper);
+}
+
+// True if the line through edge i of a, which ends at corner i,
+// separates a from b. This finds the deepest corner of b with a full
+// search, so it's O(nb).
+static bool _ConvexEdgeSeparates(const Point<2>* a, size_t na, int oa, size_t i,
+                                 const Point<2>* b, size_t nb, bool proper)
+{
+  const Point<2>& a0 = a[(i == 0) ? na - 1 : i - 1];
+  const Point<2>& a1 = a[i];
+
+  size_t j = 0;
+  CoordType depth = _EdgeDepth(a0, a1, oa, b[0]);
+  for(size_t k = 1; k < nb; ++k) {
+    CoordType d = _EdgeDepth(a0, a1, oa, b[k]);
+    if(d > depth) {
+      depth = d;
+      j = k;
+    }
+  }
+
+  CoordType tolerance = _EdgeTolerance(a0, a1, b[j]);
+  return proper ? depth <= tolerance : depth < -tolerance;
+}
+
+// The first edge of a whose line separates a from b, or, for proper,
+// at least keeps their interiors apart, or -1 if there is none. The
+// edges of a turn steadily, so the corner of b furthest inside each
+// edge moves steadily round b, and only needs a full search for the
+// first edge. This makes it O(na + nb).
+static long _ConvexSeparatingEdge(const Point<2>* a, size_t na, int oa,
+                                  const Point<2>* b, size_t nb, int ob, bool proper)
+{
+  // Going round b the same way the edges of a go round
+  const size_t step = (oa == ob) ? 1 : nb - 1;
+  size_t j = 0;
+
+  CoordType depth = _EdgeDepth(a[na - 1], a[0], oa, b[0]);
+  for(size_t k = 1; k < nb; ++k) {
+    CoordType d = _EdgeDepth(a[na - 1], a[0], oa, b[k]);
+    if(d > depth) {
+      depth = d;
+      j = k;
+    }
+  }
+
+  for(size_t i = 0; i < na; ++i) {
+    const Point<2>& a0 = a[(i == 0) ? na - 1 : i - 1];
+    const Point<2>& a1 = a[i];
+
+    depth = _EdgeDepth(a0, a1, oa, b[j]);
+    for(size_t k = 0; k < nb; ++k) {
+      size_t next = (j + step) % nb;
+      CoordType d = _EdgeDepth(a0, a1, oa, b[next]);
+      if(!(d > depth))
+        break;
+      depth = d;
+      j = next;
+    }
+
+    CoordType tolerance = _EdgeTolerance(a0, a1, b[j]);
+    if(proper ? depth <= tolerance : depth < -tolerance)
+      return (long) i;
+  }
+
+  return -1;
+}
+
+// The separating axis test for two convex polygons. The axes are the
+// edges of a, numbered from 0, then the edges of b, numbered from na.
+// If there is a cache, the edge in it is tried first, and the edge
+// which separates the polygons is stored in it.
+static bool _ConvexIntersect(const Point<2>* a, size_t na, int oa,
+                             const Point<2>* b, size_t nb, int ob, bool proper,
+                             SeparatingAxisCache* cache = 0)
+{
+  if(cache && cache->axis() >= 0) {
+    size_t axis = (size_t) cache->axis();
+    if(axis < na ? _ConvexEdgeSeparates(a, na, oa, axis, b, nb, proper)
+       : axis < na + nb && _ConvexEdgeSeparates(b, nb, ob, axis - na, a, na, proper))
+      return false;
+  }
+
+  long edge = _ConvexSeparatingEdge(a, na, oa, b, nb, ob, proper);
+  if(edge < 0) {
+    edge = _ConvexSeparatingEdge(b, nb, ob, a, na, oa, proper);
+    if(edge < 0)
+      return true;
+    edge += (long) na;
+  }
+
+  if(cache)
+    cache->setAxis((int) edge);
+  return false;
+}
+
+// The corners of a box, in order round it. Returns its orientation,
+// or 0 if it has no area.
+template<class Box>
+static int _BoxCorners(const Box& box, Point<2> corners[4])
+{
+  corners[0] = box.getCorner(0);
+  corners[1] = box.getCorner(1);
+  corners[2] = box.getCorner(3);
+  corners[3] = box.getCorner(2);
+
+  CoordType area = Cross(corners[1] - corners[0], corners[2] - corners[1]);
+
+  return (area > 0) ? 1 : (area < 0) ? -1 : 0;
+}
+
+// A convex polygon contains any shape whose corners it contains
+static bool _ConvexContainsCorners(const Point<2>* corners, size_t n, int o,
+                                   const Point<2>* inner, size_t inner_n, bool proper)
+{
+  for(size_t i = 0; i < inner_n; ++i)
+    if(!_ConvexContains(corners, n, o, inner[i], proper))
+      return false;
+
+  return true;
+}
+
 template<>
 bool Intersect<2>(const Polygon<2>& r, const Point<2>& p, bool proper)
 {
+  if(int o = r.convexOrientation())
+    return _ConvexContains(&r.m_points[0], r.m_points.size(), o, p, proper);
+
   const Polygon<2>::theConstIter begin = r.m_points.begin(), end = r.m_points.end();
   bool hit = false;
 
@@ -588,6 +816,12 @@ bool Contains<2>(const Point<2>& p, const Polygon<2>& r, bool proper)
 template<>
 bool Intersect<2>(const Polygon<2>& p, const AxisBox<2>& b, bool proper)
 {
+  if(int o = p.convexOrientation()) {
+    Point<2> corners[4];
+    if(int ob = _BoxCorners(b, corners))
+      return _ConvexIntersect(&p.m_points[0], p.m_points.size(), o, corners, 4, ob, proper);
+  }
+
   const Polygon<2>::theConstIter begin = p.m_points.begin(), end = p.m_points.end();
   bool hit = false;
 
@@ -653,12 +887,42 @@ bool Intersect<2>(const Polygon<2>& p, const AxisBox<2>& b, bool proper)
     }
   }
 
-  return hit;
+  if(hit)
+    return true;
+
+  // No edge crosses the box, and the box isn't inside the polygon, but
+  // the polygon may still be inside the box, as _ConvexIntersect()
+  // finds for convex polygons
+  for(Polygon<2>::theConstIter i = begin; i != end; ++i)
+    if(Intersect(b, *i, proper))
+      return true;
+
+  return false;
+}
+
+template<>
+bool Intersect<2>(const Polygon<2>& p, const AxisBox<2>& b, bool proper,
+                  SeparatingAxisCache& cache)
+{
+  if(int o = p.convexOrientation()) {
+    Point<2> corners[4];
+    if(int ob = _BoxCorners(b, corners))
+      return _ConvexIntersect(&p.m_points[0], p.m_points.size(), o, corners, 4, ob,
+                              proper, &cache);
+  }
+
+  return Intersect(p, b, proper);
 }
 
 template<>
 bool Contains<2>(const Polygon<2>& p, const AxisBox<2>& b, bool proper)
 {
+  if(int o = p.convexOrientation()) {
+    Point<2> corners[4];
+    _BoxCorners(b, corners);
+    return _ConvexContainsCorners(&p.m_points[0], p.m_points.size(), o, corners, 4, proper);
+  }
+
   const Polygon<2>::theConstIter begin = p.m_points.begin(), end = p.m_points.end();
   bool hit = false;
 
@@ -828,6 +1092,74 @@ bool Intersect<2>(const Polygon<2>& p, const Segment<2>& s, bool proper)
   return false;
 }
 
+// The part of Contains(Polygon<2>, Segment<2>, false) for one corner
+// of the polygon and the edge leading to it. s2 is that edge, with the
+// corner at s2.endpoint(this_point), and next is the corner after it.
+// Returns false if s leaves the polygon here, and otherwise toggles
+// hit if the edge crosses the ray from s.m_p1.
+static bool _SegmentCornerCheck(const Segment<2>& s, const Segment<2>& s2,
+                                int this_point, const Point<2>& next, bool& hit)
+{
+  if(Intersect(s2, s, true))
+    return false;
+
+  // The segment, and the polygon edge
+  const Point<2> &p1 = s.endpoint(0), &p2 = s.endpoint(1);
+  const Point<2> &e1 = s2.endpoint(0), &e2 = s2.endpoint(1);
+  const Point<2> &corner = s2.endpoint(this_point), &prev = s2.endpoint(this_point ? 0 : 1);
+
+  // Check for crossing at an endpoint
+  if(Contains(s, corner, false) && (corner != p2)) {
+    Vector<2> segment = p2 - p1;
+    Vector<2> edge1 = corner - prev;
+    Vector<2> edge2 = corner - next;
+
+    CoordType c1 = Cross(segment, edge1), c2 = Cross(segment, edge2);
+
+    if(c1 * c2 < 0) { // opposite sides
+      if(corner == p1) { // really a containment issue
+        if(edge1[1] * edge2[1] > 0 // Edges either both up or both down
+          || ((edge1[1] > 0) ? c1 : c2) < 0) // segment lies to the left
+          hit = !hit;
+        return true; // Already checked containment for this point
+      }
+      else
+        return false;
+    }
+  }
+
+  // Check containment of one endpoint
+
+  bool vertically_between =
+      ((corner[1] <= p1[1] && p1[1] < prev[1]) ||
+       (prev[1] <= p1[1] && p1[1] < corner[1]));
+
+  if (!vertically_between)
+    return true;
+
+  CoordType x_intersect = e1[0] + (e2[0] - e1[0]) * (p1[1] - e1[1]) / (e2[1] - e1[1]);
+
+  if(Equal(p1[0], x_intersect)) { // Figure out which side the segment's on
+
+    // Equal points are handled in the crossing routine above, if the
+    // segment crosses there. If it doesn't, and p1 is this corner, the
+    // side of this edge the segment is on decides it, as for any other
+    // point of the edge.
+    if(prev == p1)
+      return true;
+
+    Vector<2> poly_edge = (e1[1] < e2[1]) ? (e2 - e1) : (e1 - e2);
+    Vector<2> segment = p2 - p1;
+
+    if(Cross(segment, poly_edge) < 0)
+      hit = !hit;
+  }
+  else if(p1[0] < x_intersect)
+    hit = !hit;
+
+  return true;
+}
+
 template<>
 bool Contains<2>(const Polygon<2>& p, const Segment<2>& s, bool proper)
 {
@@ -844,65 +1176,17 @@ bool Contains<2>(const Polygon<2>& p, const Segment<2>& s, bool proper)
 
   for(Polygon<2>::theConstIter i = begin; i != end; ++i) {
     s2.endpoint(next_point) = *i;
-    if(Intersect(s2, s, !proper))
-      return false;
-    bool this_point = next_point;
+    int this_point = next_point;
     next_point = next_point ? 0 : 1;
-    if(proper)
-      continue;
-
-    // Check for crossing at an endpoint
-    if(Contains(s, *i, false) && (*i != s.m_p2)) {
-      Vector<2> segment = s.m_p2 - s.m_p1;
-      Vector<2> edge1 = *i - s2.endpoint(next_point); // Gives prev point in this case
-      Vector<2> edge2 = *i - *(i + 1);
-
-      CoordType c1 = Cross(segment, edge1), c2 = Cross(segment, edge2);
-
-      if(c1 * c2 < 0) { // opposite sides
-        if(*i == s.m_p1) { // really a containment issue
-          if(edge1[1] * edge2[1] > 0 // Edges either both up or both down
-            || ((edge1[1] > 0) ? c1 : c2) < 0) // segment lies to the left
-            hit = !hit;
-          continue; // Already checked containment for this point
-        }
-        else
-          return false;
-      }
-    }
 
-    // Check containment of one endpoint
-
-    // next_point also gives prev_point
-    bool vertically_between =
-        ((s2.endpoint(this_point)[1] <= s.m_p1[1]
-       && s.m_p1[1] < s2.endpoint(next_point)[1]) ||
-         (s2.endpoint(next_point)[1] <= s.m_p1[1]
-       && s.m_p1[1] < s2.endpoint(this_point)[1]));
-
-    if (!vertically_between)
+    if(proper) {
+      if(Intersect(s2, s, false))
+        return false;
       continue;
-
-    CoordType x_intersect = s2.m_p1[0] + (s2.m_p2[0] - s2.m_p1[0])
-			    * (s.m_p1[1] - s2.m_p1[1])
-			    / (s2.m_p2[1] - s2.m_p1[1]);
-
-    if(Equal(s.m_p1[0], x_intersect)) { // Figure out which side the segment's on
-
-      // Equal points are handled in the crossing routine above
-      if(s2.endpoint(next_point) == s.m_p1)
-        continue;
-      assert(s2.endpoint(this_point) != s.m_p1);
-
-      Vector<2> poly_edge = (s2.m_p1[1] < s2.m_p2[1]) ? (s2.m_p2 - s2.m_p1)
-						      : (s2.m_p1 - s2.m_p2);
-      Vector<2> segment = s.m_p2 - s.m_p1;
-
-      if(Cross(segment, poly_edge) < 0)
-        hit = !hit;
     }
-    else if(s.m_p1[0] < x_intersect)
-      hit = !hit;
+
+    if(!_SegmentCornerCheck(s, s2, this_point, (i + 1 == end) ? *begin : *(i + 1), hit))
+      return false;
   }
 
   return proper || hit;
@@ -921,6 +1205,12 @@ bool Contains<2>(const Segment<2>& s, const Polygon<2>& p, bool proper)
 template<>
 bool Intersect<2>(const Polygon<2>& p, const RotBox<2>& r, bool proper)
 {
+  if(int o = p.convexOrientation()) {
+    Point<2> corners[4];
+    if(int orot = _BoxCorners(r, corners))
+      return _ConvexIntersect(&p.m_points[0], p.m_points.size(), o, corners, 4, orot, proper);
+  }
+
   CoordType m_low[2], m_high[2];
 
   for(int j = 0; j < 2; ++j) {
@@ -1013,9 +1303,29 @@ bool Intersect<2>(const Polygon<2>& p, const RotBox<2>& r, bool proper)
   return hit;
 }
 
+template<>
+bool Intersect<2>(const Polygon<2>& p, const RotBox<2>& r, bool proper,
+                  SeparatingAxisCache& cache)
+{
+  if(int o = p.convexOrientation()) {
+    Point<2> corners[4];
+    if(int orot = _BoxCorners(r, corners))
+      return _ConvexIntersect(&p.m_points[0], p.m_points.size(), o, corners, 4, orot,
+                              proper, &cache);
+  }
+
+  return Intersect(p, r, proper);
+}
+
 template<>
 bool Contains<2>(const Polygon<2>& p, const RotBox<2>& r, bool proper)
 {
+  if(int o = p.convexOrientation()) {
+    Point<2> corners[4];
+    _BoxCorners(r, corners);
+    return _ConvexContainsCorners(&p.m_points[0], p.m_points.size(), o, corners, 4, proper);
+  }
+
   CoordType m_low[2], m_high[2];
 
   for(int j = 0; j < 2; ++j) {
@@ -1134,66 +1444,209 @@ bool Contains<2>(const RotBox<2>& r, const Polygon<2>& p, bool proper)
   return true;
 }
 
-template<>
-bool Intersect<2>(const Polygon<2>& p1, const Polygon<2>& p2, bool proper)
+// The edge of poly leading to corner k, with its ends in the order the
+// loops above leave them in s2 after count steps
+static Segment<2> _PolyEdge(const Polygon<2>& poly, size_t k, size_t count)
 {
-  Polygon<2>::theConstIter begin1 = p1.m_points.begin(), end1 = p1.m_points.end();
-  Polygon<2>::theConstIter begin2 = p2.m_points.begin(), end2 = p2.m_points.end();
-  Segment<2> s1, s2;
-  int next_end1, next_end2;
-
-  s1.endpoint(0) = p1.m_points.back();
-  s2.endpoint(0) = p2.m_points.back();
-  next_end1 = next_end2 = 1;
-  for(Polygon<2>::theConstIter i1 = begin1; i1 != end1; ++i1) {
-    s1.endpoint(next_end1) = *i1;
-    next_end1 = next_end1 ? 0 : 1;
-
-    for(Polygon<2>::theConstIter i2 = begin2; i2 != end2; ++i2) {
-      s2.endpoint(next_end2) = *i2;
-      next_end2 = next_end2 ? 0 : 1;
-
-      if(Intersect(s1, s2, proper))
-        return true;
+  const Point<2>& cur = poly[k];
+  const Point<2>& prev = poly[(k == 0) ? poly.numCorners() - 1 : k - 1];
+
+  return (count % 2 == 0) ? Segment<2>(prev, cur) : Segment<2>(cur, prev);
+}
+
+// Add a box around each edge of poly to boxes. The box is grown by
+// more than the distance at which the non-proper Segment<2> tests, and
+// the Equal() test in the ray crossing count, can still accept a point
+// of the other polygon as on the edge.
+static void _FillEdgeBoxes(const Polygon<2>& poly, int index, std::vector<_EdgeBox>& boxes)
+{
+  const CoordType epsilon = numeric_constants<CoordType>::epsilon();
+  const CoordType root_epsilon = std::sqrt(epsilon);
+  const size_t n = poly.numCorners();
+
+  for(size_t k = 0; k < n; ++k) {
+    const Point<2>& cur = poly[k];
+    const Point<2>& prev = poly[(k == 0) ? n - 1 : k - 1];
+    _EdgeBox b;
+    CoordType size = 0, max_abs = 0;
+
+    for(int i = 0; i < 2; ++i) {
+      b.low[i] = FloatMin(cur[i], prev[i]);
+      b.high[i] = FloatMax(cur[i], prev[i]);
+      size = FloatMax(size, b.high[i] - b.low[i]);
+      max_abs = FloatMax(max_abs, FloatMax(std::fabs(b.low[i]), std::fabs(b.high[i])));
     }
+
+    // Contains(Segment<>, Point<>) allows about 7e-4 times the length
+    // of the segment to the side, and sqrt(epsilon) past the ends
+    CoordType grow = 2e-3f * size + 4 * epsilon * max_abs + 4 * epsilon + 2 * root_epsilon;
+    for(int i = 0; i < 2; ++i) {
+      b.low[i] -= grow;
+      b.high[i] += grow;
+    }
+    b.edge = k;
+    b.poly = index;
+    boxes.push_back(b);
   }
+}
+
+// Call visit(edge of a, edge of b) for each pair of edges whose boxes
+// from _FillEdgeBoxes() overlap, until it returns false. This sorts
+// the boxes by their low x coordinate and sweeps across them, keeping
+// a list of the boxes of each polygon which the sweep is still inside,
+// so it takes O((n + m) log(n + m)) time plus the number of pairs.
+template<class Visitor>
+static void _PolyEdgePairs(const Polygon<2>& a, const Polygon<2>& b, Visitor visit)
+{
+  _PolyPolyScratch& scratch = _GetPolyPolyScratch();
+  std::vector<_EdgeBox>& boxes = scratch.boxes;
+
+  boxes.clear();
+  _FillEdgeBoxes(a, 0, boxes);
+  _FillEdgeBoxes(b, 1, boxes);
+  std::sort(boxes.begin(), boxes.end());
+
+  scratch.active[0].clear();
+  scratch.active[1].clear();
 
-  return Contains(p1, p2.m_points.front(), proper)
+  for(size_t i = 0; i < boxes.size(); ++i) {
+    const _EdgeBox& box = boxes[i];
+    std::vector<size_t>& others = scratch.active[box.poly ? 0 : 1];
+
+    for(size_t j = 0; j < others.size();) {
+      const _EdgeBox& other = boxes[others[j]];
+
+      // The sweep has passed this one, drop it
+      if(other.high[0] < box.low[0]) {
+        others[j] = others.back();
+        others.pop_back();
+        continue;
+      }
+      ++j;
+
+      if(other.high[1] < box.low[1] || box.high[1] < other.low[1])
+        continue;
+
+      bool keep_going = box.poly ? visit(other.edge, box.edge)
+                                 : visit(box.edge, other.edge);
+      if(!keep_going)
+        return;
+    }
+
+    scratch.active[box.poly].push_back(i);
+  }
+}
+
+// Edge pairs which are further apart than the boxes in _PolyEdgePairs()
+// allow can't intersect, so only the pairs it finds are tested. The
+// ends of each Segment<2> are in the same order as the old nested
+// loops over every pair put them in, so the answers are the same.
+
+template<>
+bool Intersect<2>(const Polygon<2>& p1, const Polygon<2>& p2, bool proper)
+{
+  if(p1.numCorners() == 0 || p2.numCorners() == 0)
+    return false;
+
+  int o1 = p1.convexOrientation(), o2 = p2.convexOrientation();
+  if(o1 && o2)
+    return _ConvexIntersect(&p1.m_points[0], p1.m_points.size(), o1,
+                            &p2.m_points[0], p2.m_points.size(), o2, proper);
+
+  const size_t m = p2.numCorners();
+  bool hit = false;
+
+  _PolyEdgePairs(p1, p2, [&](size_t i1, size_t i2) {
+    hit = Intersect(_PolyEdge(p1, i1, i1), _PolyEdge(p2, i2, i1 * m + i2), proper);
+    return !hit;
+  });
+
+  return hit || Contains(p1, p2.m_points.front(), proper)
       || Contains(p2, p1.m_points.front(), proper);
 }
 
 template<>
-bool Contains<2>(const Polygon<2>& outer, const Polygon<2>& inner, bool proper)
+bool Intersect<2>(const Polygon<2>& p1, const Polygon<2>& p2, bool proper,
+                  SeparatingAxisCache& cache)
 {
-  if(proper && !Contains(outer, inner.m_points.front(), true))
+  if(p1.numCorners() == 0 || p2.numCorners() == 0)
     return false;
 
-  Polygon<2>::theConstIter begin = inner.m_points.begin(), end = inner.m_points.end();
-  Segment<2> s;
-  s.endpoint(0) = inner.m_points.back();
-  int next_end = 1;
+  int o1 = p1.convexOrientation(), o2 = p2.convexOrientation();
+  if(o1 && o2)
+    return _ConvexIntersect(&p1.m_points[0], p1.m_points.size(), o1,
+                            &p2.m_points[0], p2.m_points.size(), o2, proper, &cache);
 
-  for(Polygon<2>::theConstIter i = begin; i != end; ++i) {
-    s.endpoint(next_end) = *i;
-    next_end = next_end ? 0 : 1;
-    if(!proper) {
-      if(!Contains(outer, s, false))
-        return false;
-    }
-    else {
-      Polygon<2>::theConstIter begin2 = outer.m_points.begin(),
-				end2 = outer.m_points.end();
-      Segment<2> s2;
-      s2.endpoint(0) = outer.m_points.back();
-      int next_end2 = 1;
-      for(Polygon<2>::theConstIter i2 = begin2; i2 != end2; ++i2) {
-        s2.endpoint(next_end2) = *i2;
-        next_end2 = next_end2 ? 0 : 1;
-  
-        if(Intersect(s, s2, false))
-          return false;
-      }
+  return Intersect(p1, p2, proper);
+}
+
+template<>
+bool Contains<2>(const Polygon<2>& outer, const Polygon<2>& inner, bool proper)
+{
+  if(inner.numCorners() == 0)
+    return true;
+
+  if(int o = outer.convexOrientation())
+    return _ConvexContainsCorners(&outer.m_points[0], outer.m_points.size(), o,
+                                  &inner.m_points[0], inner.m_points.size(), proper);
+
+  if(proper) {
+    if(!Contains(outer, inner.m_points.front(), true))
+      return false;
+
+    bool hit = false;
+    _PolyEdgePairs(inner, outer, [&](size_t ii, size_t io) {
+      hit = Intersect(_PolyEdge(inner, ii, ii), _PolyEdge(outer, io, io), false);
+      return !hit;
+    });
+
+    return !hit;
+  }
+
+  // Contains(outer, s, false) for each edge s of inner is a test of the
+  // edges of outer near s, and a count of the edges of outer crossing
+  // the ray from the start of s. The prepared polygon counts all the
+  // crossings. For the edges near s, flip that count back out and
+  // use the toggles from _SegmentCornerCheck() instead.
+  _PolyPolyScratch& scratch = _GetPolyPolyScratch();
+  std::vector<char>& near_crossings = scratch.near_crossings;
+  const size_t n = outer.numCorners();
+
+  scratch.prepared.build(outer);
+  near_crossings.assign(inner.numCorners(), 0);
+
+  bool inside = true;
+  _PolyEdgePairs(inner, outer, [&](size_t ii, size_t io) {
+    const Segment<2> s = _PolyEdge(inner, ii, ii), s2 = _PolyEdge(outer, io, io);
+    const Point<2>& next = outer[(io + 1 == n) ? 0 : io + 1];
+
+    bool toggle = false;
+    if(!_SegmentCornerCheck(s, s2, (io % 2 == 0) ? 1 : 0, next, toggle)) {
+      inside = false;
+      return false;
     }
+
+    // The crossing the prepared polygon counted for this edge
+    const Point<2>& p = s.endpoint(0);
+    const Point<2>& cur = outer[io];
+    const Point<2>& prev = outer[(io == 0) ? n - 1 : io - 1];
+    if(FloatMin(cur[1], prev[1]) <= p[1] && p[1] < FloatMax(cur[1], prev[1])
+       && p[0] < cur[0] + (prev[0] - cur[0]) * (p[1] - cur[1]) / (prev[1] - cur[1]))
+      toggle = !toggle;
+
+    if(toggle)
+      near_crossings[ii] ^= 1;
+    return true;
+  });
+
+  if(!inside)
+    return false;
+
+  for(size_t ii = 0; ii < inner.numCorners(); ++ii) {
+    // The start of _PolyEdge(inner, ii, ii)
+    const Point<2>& p = inner[(ii % 2 != 0) ? ii : (ii == 0) ? inner.numCorners() - 1 : ii - 1];
+    if(scratch.prepared.oddCrossings(p) == (near_crossings[ii] != 0))
+      return false;
   }
 
   return true;
@@ -317,7 +317,7 @@ int  _Intersect(const _Poly2Orient<dim> &o1, const _Poly2Orient<dim> &o2,
       assert(o1.m_axes[1].isValid() && o2.m_axes[1].isValid());
 
       // The planes are parallel, check if they are the same plane
-      CoordType off_sqr_mag = data.off.sqrMag();
+      CoordType off_sqr_mag = off.sqrMag();
 
       // Find the offset between the origins in o2's coordnates
 
@@ -400,7 +400,7 @@ bool Intersect(const Polygon<dim>& p, const AxisBox<dim>& b, bool proper)
     next_end = next_end ? 0 : 1;
   }
 
-  return Contains(p, p2, proper);
+  return Intersect(p.m_poly, p2, proper);
 }
 
 template<int dim>
@@ -625,7 +625,7 @@ bool Intersect(const Polygon<dim>& p, const RotBox<dim>& r, bool proper)
     next_end = next_end ? 0 : 1;
   }
 
-  return Contains(p, p2, proper);
+  return Intersect(p.m_poly, p2, proper);
 }
 
 template<int dim>
@@ -689,6 +689,29 @@ bool Contains(const Polygon<dim>& outer, const Polygon<dim>& inner, bool proper)
   return _PolyPolyContains(outer.m_poly, inner.m_poly, intersect_dim, data, proper);
 }
 
+// Only the convex Polygon<2> tests use the cache, these ignore it
+
+template<int dim>
+inline bool Intersect(const Polygon<dim>& p, const AxisBox<dim>& b, bool proper,
+                      SeparatingAxisCache&)
+{
+  return Intersect(p, b, proper);
+}
+
+template<int dim>
+inline bool Intersect(const Polygon<dim>& p, const RotBox<dim>& r, bool proper,
+                      SeparatingAxisCache&)
+{
+  return Intersect(p, r, proper);
+}
+
+template<int dim>
+inline bool Intersect(const Polygon<dim>& p1, const Polygon<dim>& p2, bool proper,
+                      SeparatingAxisCache&)
+{
+  return Intersect(p1, p2, proper);
+}
+
 template<>
 bool Intersect(const Polygon<2>& r, const Point<2>& p, bool proper);
 template<>
@@ -727,6 +750,21 @@ bool Intersect(const Polygon<2>& p1, const Polygon<2>& p2, bool proper);
 template<>
 bool Contains(const Polygon<2>& outer, const Polygon<2>& inner, bool proper);
 
+// For two convex polygons, the axes are the edges of the first, then
+// those of the second, with edge i ending at corner i. A box counts
+// as a polygon with its corners 0, 1, 3 and 2, as getCorner() numbers
+// them.
+
+template<>
+bool Intersect(const Polygon<2>& p, const AxisBox<2>& b, bool proper,
+               SeparatingAxisCache& cache);
+template<>
+bool Intersect(const Polygon<2>& p, const RotBox<2>& r, bool proper,
+               SeparatingAxisCache& cache);
+template<>
+bool Intersect(const Polygon<2>& p1, const Polygon<2>& p2, bool proper,
+               SeparatingAxisCache& cache);
+
 } // namespace WFMath
 
 #endif  // WFMATH_POLYGON_INTERSECT_H
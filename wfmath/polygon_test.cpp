@@ -37,7 +37,9 @@
 #include "polygon.h"
 #include "polygon_intersect.h"
 #include "stream.h"
+#include "randgen.h"
 #include <vector>
+#include <algorithm>
 
 #include "general_test.h"
 #include "shape_test.h"
@@ -167,6 +169,364 @@ void test_contains()
 
 }
 
+// The nested loops over every pair of edges, as Intersect() and
+// Contains() for two Polygon<2> were before they swept over the edges.
+static bool brute_intersect(const Polygon<2>& p1, const Polygon<2>& p2, bool proper)
+{
+  Segment<2> s1, s2;
+  int next_end1 = 1, next_end2 = 1;
+
+  s1.endpoint(0) = p1[p1.numCorners() - 1];
+  s2.endpoint(0) = p2[p2.numCorners() - 1];
+  for(size_t i1 = 0; i1 < p1.numCorners(); ++i1) {
+    s1.endpoint(next_end1) = p1[i1];
+    next_end1 = next_end1 ? 0 : 1;
+
+    for(size_t i2 = 0; i2 < p2.numCorners(); ++i2) {
+      s2.endpoint(next_end2) = p2[i2];
+      next_end2 = next_end2 ? 0 : 1;
+
+      if(Intersect(s1, s2, proper))
+        return true;
+    }
+  }
+
+  return Contains(p1, p2[0], proper) || Contains(p2, p1[0], proper);
+}
+
+static bool brute_contains(const Polygon<2>& outer, const Polygon<2>& inner, bool proper)
+{
+  if(proper && !Contains(outer, inner[0], true))
+    return false;
+
+  Segment<2> s;
+  s.endpoint(0) = inner[inner.numCorners() - 1];
+  int next_end = 1;
+
+  for(size_t i = 0; i < inner.numCorners(); ++i) {
+    s.endpoint(next_end) = inner[i];
+    next_end = next_end ? 0 : 1;
+    if(!proper) {
+      if(!Contains(outer, s, false))
+        return false;
+      continue;
+    }
+
+    Segment<2> s2;
+    s2.endpoint(0) = outer[outer.numCorners() - 1];
+    int next_end2 = 1;
+    for(size_t i2 = 0; i2 < outer.numCorners(); ++i2) {
+      s2.endpoint(next_end2) = outer[i2];
+      next_end2 = next_end2 ? 0 : 1;
+      if(Intersect(s, s2, false))
+        return false;
+    }
+  }
+
+  return true;
+}
+
+// Convex polygons take other paths, which only agree with the loops
+// away from shared corners and edges, where the loops are unreliable.
+// Those are checked against the loops only when convex_too is set.
+static void check_polygon_pair(const Polygon<2>& p1, const Polygon<2>& p2, bool convex_too)
+{
+  bool both_convex = p1.isConvex() && p2.isConvex();
+
+  for(int proper = 0; proper < 2; ++proper) {
+    if(convex_too || !both_convex) {
+      assert(Intersect(p1, p2, proper != 0) == brute_intersect(p1, p2, proper != 0));
+      assert(Intersect(p2, p1, proper != 0) == brute_intersect(p2, p1, proper != 0));
+    }
+    if(convex_too || !p1.isConvex())
+      assert(Contains(p1, p2, proper != 0) == brute_contains(p1, p2, proper != 0));
+    if(convex_too || !p2.isConvex())
+      assert(Contains(p2, p1, proper != 0) == brute_contains(p2, p1, proper != 0));
+  }
+}
+
+// A star shaped polygon, concave for most choices of radii. With snap,
+// the corners are rounded to whole numbers, which gives shared
+// corners, collinear edges and corners lying on edges.
+static Polygon<2> random_star(MTRand& rand, size_t corners, const Point<2>& center,
+                              CoordType radius, bool snap)
+{
+  Polygon<2> poly;
+  for(size_t i = 0; i < corners; ++i) {
+    CoordType angle = (CoordType) (2 * numeric_constants<CoordType>::pi() * i / corners);
+    CoordType r = radius * (CoordType) (0.2 + 0.8 * rand.rand());
+    Point<2> p(center[0] + r * std::cos(angle), center[1] + r * std::sin(angle));
+    if(snap)
+      p = Point<2>(std::floor(p[0] + 0.5f), std::floor(p[1] + 0.5f));
+    poly.addCorner(i, p);
+  }
+  return poly;
+}
+
+/**
+ * Compare polygon/polygon intersection and containment against a test of every pair of edges.
+ */
+void test_polygon_polygon()
+{
+  std::cout << "Testing Polygon<2>/Polygon<2> against every pair of edges" << std::endl;
+
+  MTRand rand(11);
+
+  for(int n = 0; n < 400; ++n) {
+    bool snap = (n % 2) != 0;
+    CoordType radius = snap ? 8 : 10;
+    Polygon<2> p1 = random_star(rand, 3 + rand.randInt(40), Point<2>(0, 0), radius, snap);
+    Point<2> center((CoordType) (rand.rand() * 24 - 12), (CoordType) (rand.rand() * 24 - 12));
+    if(snap)
+      center = Point<2>(std::floor(center[0]), std::floor(center[1]));
+    Polygon<2> p2 = random_star(rand, 3 + rand.randInt(40), center,
+                                radius * (CoordType) (0.1 + rand.rand()), snap);
+
+    check_polygon_pair(p1, p2, !snap);
+    check_polygon_pair(p1, p1, false);
+
+    // Shrunk copies, inside or touching
+    Polygon<2> shrunk = p1;
+    for(size_t i = 0; i < shrunk.numCorners(); ++i)
+      if(i % 3 != 0)
+        shrunk.moveCorner(i, Point<2>(p1[i][0] / 2, p1[i][1] / 2));
+    check_polygon_pair(p1, shrunk, false);
+  }
+}
+
+// The same polygon with its first corner repeated, which is not
+// strictly convex, so the intersection functions use the general tests
+static Polygon<2> general_copy(const Polygon<2>& p)
+{
+  Polygon<2> copy = p;
+  copy.addCorner(0, p[0]);
+  assert(!copy.isConvex());
+  return copy;
+}
+
+// A convex polygon with corners at random angles on a circle
+static Polygon<2> random_convex(MTRand& rand, size_t corners, const Point<2>& center,
+                                CoordType radius, bool clockwise)
+{
+  std::vector<CoordType> angles;
+  for(size_t i = 0; i < corners; ++i)
+    angles.push_back((CoordType) (2 * numeric_constants<CoordType>::pi() * rand.rand()));
+  std::sort(angles.begin(), angles.end());
+  if(clockwise)
+    std::reverse(angles.begin(), angles.end());
+
+  Polygon<2> poly;
+  for(size_t i = 0; i < corners; ++i)
+    poly.addCorner(i, Point<2>(center[0] + radius * std::cos(angles[i]),
+                               center[1] + radius * std::sin(angles[i])));
+  return poly;
+}
+
+static Polygon<2> square(CoordType x, CoordType y, CoordType size)
+{
+  Polygon<2> p;
+  p.addCorner(0, Point<2>(x, y));
+  p.addCorner(1, Point<2>(x + size, y));
+  p.addCorner(2, Point<2>(x + size, y + size));
+  p.addCorner(3, Point<2>(x, y + size));
+  return p;
+}
+
+/**
+ * Test the convexity check, and the tests used for convex polygons.
+ */
+void test_convex()
+{
+  std::cout << "Testing convex Polygon<2>" << std::endl;
+
+  Polygon<2> p = square(0, 0, 4);
+  assert(p.isConvex());
+
+  // Clockwise
+  Polygon<2> cw;
+  for(size_t i = 0; i < 4; ++i)
+    cw.addCorner(0, p[i]);
+  assert(cw.isConvex());
+
+  // Changing a corner drops the cached answer
+  Polygon<2> dent = p;
+  dent.moveCorner(2, Point<2>(1, 1));
+  assert(!dent.isConvex());
+  dent.moveCorner(2, Point<2>(4, 4));
+  assert(dent.isConvex());
+  dent.addCorner(2, Point<2>(4, 2));
+  assert(!dent.isConvex()); // Three corners in a row
+  dent.removeCorner(2);
+  assert(dent.isConvex());
+
+  Polygon<2> pentagram;
+  for(int i = 0; i < 5; ++i) {
+    CoordType angle = (CoordType) (4 * numeric_constants<CoordType>::pi() * i / 5);
+    pentagram.addCorner(i, Point<2>(std::cos(angle), std::sin(angle)));
+  }
+  assert(!pentagram.isConvex());
+
+  Polygon<2> line;
+  line.addCorner(0, Point<2>(0, 0));
+  line.addCorner(1, Point<2>(1, 1));
+  assert(!line.isConvex());
+
+  // Polygons which aren't convex, strictly inside a box
+  Polygon<2> notch;
+  notch.addCorner(0, Point<2>(0, 0));
+  notch.addCorner(1, Point<2>(4, 0));
+  notch.addCorner(2, Point<2>(4, 4));
+  notch.addCorner(3, Point<2>(2, 1));
+  notch.addCorner(4, Point<2>(0, 4));
+  assert(!notch.isConvex());
+  AxisBox<2> around_notch(Point<2>(-1, -1), Point<2>(5, 5));
+  assert(Intersect(notch, around_notch, true));
+  assert(Intersect(notch, around_notch, false));
+  assert(Intersect(pentagram, AxisBox<2>(Point<2>(-2, -2), Point<2>(2, 2)), true));
+  // In the notch, so not touching it
+  assert(!Intersect(notch, AxisBox<2>(Point<2>(1.5f, 3), Point<2>(2.5f, 4)), false));
+
+  const Polygon<2>* squares[] = {&p, &cw};
+  for(int n = 0; n < 2; ++n) {
+    const Polygon<2>& s = *squares[n];
+
+    assert(Intersect(s, Point<2>(1, 3), true));
+    assert(!Intersect(s, Point<2>(5, 3), false));
+    assert(!Intersect(s, Point<2>(-1, -1), false));
+    assert(Intersect(s, Point<2>(4, 2), false));
+    assert(!Intersect(s, Point<2>(4, 2), true));
+    assert(Intersect(s, Point<2>(0, 0), false));
+    assert(!Intersect(s, Point<2>(0, 0), true));
+
+    // Sharing an edge
+    assert(Intersect(s, square(4, 1, 2), false));
+    assert(!Intersect(s, square(4, 1, 2), true));
+    assert(Intersect(s, square(3, 1, 2), true));
+    assert(!Intersect(s, square(5, 1, 2), false));
+    assert(Contains(s, square(1, 1, 2), true));
+    assert(Contains(s, square(2, 2, 2), false));
+    assert(!Contains(s, square(2, 2, 2), true));
+    assert(Contains(s, s, false));
+    assert(!Contains(s, s, true));
+    assert(Intersect(s, s, true));
+
+    // A box around the whole polygon
+    AxisBox<2> around(Point<2>(-1, -1), Point<2>(5, 5));
+    assert(Intersect(s, around, true));
+    assert(!Contains(s, around, false));
+    assert(Intersect(s, AxisBox<2>(Point<2>(4, 4), Point<2>(5, 5)), false));
+    assert(!Intersect(s, AxisBox<2>(Point<2>(4, 4), Point<2>(5, 5)), true));
+    assert(Contains(s, AxisBox<2>(Point<2>(1, 1), Point<2>(3, 3)), true));
+    // The same for the general test
+    assert(Intersect(general_copy(s), around, true));
+
+    // A diamond, with its corners one past the edges
+    RotMatrix<2> quarter;
+    quarter.rotation(numeric_constants<CoordType>::pi() / 4);
+    RotBox<2> diamond(Point<2>(2, -1), Vector<2>(std::sqrt(4.5f), std::sqrt(4.5f)), quarter);
+    assert(Intersect(s, diamond, false));
+    assert(!Contains(s, diamond, false));
+    RotBox<2> outside(Point<2>(7, 0), Vector<2>(2, 2), quarter);
+    assert(!Intersect(s, outside, false));
+  }
+
+  // Against the general tests, for random convex polygons
+  MTRand rand(13);
+  int i_box = 0;
+
+  for(int n = 0; n < 200; ++n) {
+    Polygon<2> c1 = random_convex(rand, 3 + rand.randInt(30), Point<2>(0, 0), 10, n % 2 != 0);
+    Point<2> center((CoordType) (rand.rand() * 30 - 15), (CoordType) (rand.rand() * 30 - 15));
+    Polygon<2> c2 = random_convex(rand, 3 + rand.randInt(30), center,
+                                  (CoordType) (1 + 10 * rand.rand()), n % 3 != 0);
+    if(!c1.isConvex() || !c2.isConvex())
+      continue; // Random corners too close together
+
+    Polygon<2> g1 = general_copy(c1), g2 = general_copy(c2);
+
+    for(int proper = 0; proper < 2; ++proper) {
+      assert(Intersect(c1, c2, proper != 0) == Intersect(g1, g2, proper != 0));
+      assert(Contains(c1, c2, proper != 0) == Contains(g1, c2, proper != 0));
+      assert(Contains(c2, c1, proper != 0) == Contains(g2, c1, proper != 0));
+
+      for(int i = 0; i < 20; ++i) {
+        Point<2> q((CoordType) (rand.rand() * 24 - 12), (CoordType) (rand.rand() * 24 - 12));
+        assert(Intersect(c1, q, proper != 0) == Intersect(g1, q, proper != 0));
+      }
+
+      // Boxes of all sizes, some holding the whole polygon
+      Point<2> low((CoordType) (rand.rand() * 24 - 12), (CoordType) (rand.rand() * 24 - 12));
+      CoordType size = (CoordType) ((i_box++ % 2) ? 1 : 30);
+      AxisBox<2> box(low, low + Vector<2>((CoordType) rand.rand() * size,
+                                          (CoordType) rand.rand() * size));
+      assert(Intersect(c1, box, proper != 0) == Intersect(g1, box, proper != 0));
+      assert(Contains(c1, box, proper != 0) == Contains(g1, box, proper != 0));
+
+      RotMatrix<2> m;
+      m.rotation((CoordType) (rand.rand() * 6));
+      RotBox<2> r(low, Vector<2>((CoordType) rand.rand(), (CoordType) rand.rand()), m);
+      assert(Intersect(c1, r, proper != 0) == Intersect(g1, r, proper != 0));
+      assert(Contains(c1, r, proper != 0) == Contains(g1, r, proper != 0));
+    }
+  }
+}
+
+/**
+ * Add and remove corners on either side of the number kept inline,
+ * against a std::vector doing the same.
+ */
+void test_corner_storage()
+{
+  std::cout << "Testing Polygon<2> corner storage" << std::endl;
+
+  MTRand rand(13);
+  const size_t max_corners = 3 * WFMATH_INLINE_CORNERS;
+
+  for(int n = 0; n < 200; ++n) {
+    Polygon<2> p;
+    std::vector<Point<2> > expected;
+
+    for(int step = 0; step < 100; ++step) {
+      size_t size = expected.size();
+      bool add = size == 0 || (size < max_corners && rand.randInt(2) != 0);
+      if(add) {
+        size_t i = rand.randInt((unsigned long) size);
+        Point<2> corner((CoordType) rand.rand(), (CoordType) rand.rand());
+        p.addCorner(i, corner);
+        expected.insert(expected.begin() + i, corner);
+      }
+      else if(rand.randInt(4) == 0) {
+        // Insert a copy of one of its own corners
+        size_t i = rand.randInt((unsigned long) size - 1);
+        size_t j = rand.randInt((unsigned long) size);
+        p.addCorner(j, p[i]);
+        expected.insert(expected.begin() + j, expected[i]);
+      }
+      else {
+        size_t i = rand.randInt((unsigned long) size - 1);
+        p.removeCorner(i);
+        expected.erase(expected.begin() + i);
+      }
+
+      assert(p.numCorners() == expected.size());
+      for(size_t i = 0; i < expected.size(); ++i)
+        assert(p[i] == expected[i]);
+
+      Polygon<2> copy = p, assigned;
+      assigned = copy;
+      assert(copy == p && assigned == p);
+      if(!expected.empty())
+        assert(p.boundingBox() == BoundingBox(expected));
+    }
+
+    p.resize(2);
+    expected.resize(2);
+    assert(p.numCorners() == 2 && p[0] == expected[0] && p[1] == expected[1]);
+    p.clear();
+    assert(p.numCorners() == 0);
+  }
+}
+
 int main()
 {
   bool succ;
@@ -197,5 +557,11 @@ int main()
 
   test_contains();
 
+  test_polygon_polygon();
+
+  test_convex();
+
+  test_corner_storage();
+
   return 0;
 }
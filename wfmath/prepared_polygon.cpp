@@ -0,0 +1,236 @@
+// prepared_polygon.cpp (PreparedPolygon<> implementation)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "prepared_polygon.h"
+#include "polygon_intersect.h"
+
+#include <algorithm>
+
+#include <cmath>
+
+namespace WFMath {
+
+// The x coordinate of an edge at height y, in double precision, for
+// sorting the edges of a slab
+static double _EdgeX(CoordType ax, CoordType ay, CoordType bx, CoordType by, double y)
+{
+  return ax + ((double) bx - ax) * (y - ay) / ((double) by - ay);
+}
+
+void PreparedPolygon<2>::build(const Polygon<2>& p)
+{
+  m_poly = p;
+  m_y.clear();
+  m_slabs.clear();
+  m_edges.clear();
+
+  const size_t n = p.numCorners();
+
+  for(size_t i = 0; i < n; ++i)
+    m_y.push_back(p[i][1]);
+  std::sort(m_y.begin(), m_y.end());
+  m_y.erase(std::unique(m_y.begin(), m_y.end()), m_y.end());
+
+  if(m_y.size() < 2)
+    return;
+
+  const size_t num_slabs = m_y.size() - 1;
+  const Slab empty = {0, 0, true};
+  m_slabs.assign(num_slabs + 1, empty);
+
+  // Count the edges crossing each slab into the start of the next
+  // one, so that the running sum gives the start of each slab. This
+  // needs no storage besides the index itself, so rebuilding an index
+  // for a polygon no larger than before doesn't allocate.
+  for(size_t i = 0, j = n - 1; i < n; j = i++) {
+    size_t begin, end;
+    slabRange(p[i][1], p[j][1], begin, end);
+    for(size_t k = begin; k < end; ++k)
+      ++m_slabs[k + 1].first;
+  }
+
+  for(size_t k = 1; k <= num_slabs; ++k)
+    m_slabs[k].first += m_slabs[k - 1].first;
+
+  m_edges.resize(m_slabs[num_slabs].first);
+
+  // Use the start of each slab as its fill position, which leaves it
+  // at the start of the next slab
+  for(size_t i = 0, j = n - 1; i < n; j = i++) {
+    Edge e = {p[i][0], p[i][1], p[j][0], p[j][1]};
+    // A bound on the rounding error of Edge::xAt(), see below
+    CoordType error = 16 * std::numeric_limits<CoordType>::epsilon()
+                      * (std::fabs(e.ax) + std::fabs(e.bx))
+                      + std::numeric_limits<CoordType>::min();
+    size_t begin, end;
+    slabRange(e.ay, e.by, begin, end);
+    for(size_t k = begin; k < end; ++k) {
+      m_edges[m_slabs[k].first++] = e;
+      m_slabs[k].window = FloatMax(m_slabs[k].window, error);
+    }
+  }
+
+  for(size_t k = num_slabs; k > 0; --k)
+    m_slabs[k].first = m_slabs[k - 1].first;
+  m_slabs[0].first = 0;
+
+  // Edge::xAt() rounds five times, and the terms it adds are no larger
+  // than |ax| + |bx|, so its error is well under the bound above. The
+  // edges are sorted by their exact position, to within the double
+  // precision tolerance below, so an edge's computed position can only
+  // be out of order with edges within 2 * error of it. The window adds
+  // a margin on top of that.
+  for(size_t k = 0; k < num_slabs; ++k) {
+    Slab& slab = m_slabs[k];
+    const double bottom = m_y[k], top = m_y[k + 1], middle = (bottom + top) / 2;
+    const double tolerance = slab.window / 4;
+    Edge* begin = &m_edges[0] + slab.first;
+    Edge* end = &m_edges[0] + m_slabs[k + 1].first;
+
+    std::sort(begin, end, [middle](const Edge& e1, const Edge& e2) {
+      return _EdgeX(e1.ax, e1.ay, e1.bx, e1.by, middle)
+           < _EdgeX(e2.ax, e2.ay, e2.bx, e2.by, middle);
+    });
+
+    // Line segments which are in the same order at the top and bottom
+    // of the slab don't cross in between
+    for(Edge* e = begin; e + 1 < end && slab.sorted; ++e) {
+      slab.sorted = _EdgeX(e[0].ax, e[0].ay, e[0].bx, e[0].by, bottom)
+                 <= _EdgeX(e[1].ax, e[1].ay, e[1].bx, e[1].by, bottom) + tolerance
+                 && _EdgeX(e[0].ax, e[0].ay, e[0].bx, e[0].by, top)
+                 <= _EdgeX(e[1].ax, e[1].ay, e[1].bx, e[1].by, top) + tolerance;
+    }
+
+    slab.window *= 3;
+  }
+}
+
+void PreparedPolygon<2>::slabRange(CoordType y1, CoordType y2,
+                                   size_t& begin, size_t& end) const
+{
+  // An edge crosses the slabs between the heights of its ends, and
+  // horizontal edges cross none
+  begin = std::lower_bound(m_y.begin(), m_y.end(), FloatMin(y1, y2)) - m_y.begin();
+  end = std::lower_bound(m_y.begin(), m_y.end(), FloatMax(y1, y2)) - m_y.begin();
+}
+
+bool PreparedPolygon<2>::contains(const Point<2>& p, bool proper) const
+{
+  // Intersect(Polygon<2>, Point<2>) has its own O(log n) test for
+  // convex polygons, which doesn't count crossings
+  if(m_poly.isConvex())
+    return Intersect(m_poly, p, proper);
+
+  // Intersect(Polygon<2>, Point<2>) only looks at edges with
+  // ay <= p[1] < by or by <= p[1] < ay, so points outside
+  // [m_y.front(), m_y.back()) are never inside. This is also
+  // false for a NaN, as it is there.
+  if(m_y.size() < 2 || !(m_y.front() <= p[1] && p[1] < m_y.back()))
+    return false;
+
+  size_t slab = std::upper_bound(m_y.begin(), m_y.end(), p[1]) - m_y.begin() - 1;
+
+  return slabContains(slab, p, true, proper);
+}
+
+bool PreparedPolygon<2>::oddCrossings(const Point<2>& p) const
+{
+  if(m_y.size() < 2 || !(m_y.front() <= p[1] && p[1] < m_y.back()))
+    return false;
+
+  size_t slab = std::upper_bound(m_y.begin(), m_y.end(), p[1]) - m_y.begin() - 1;
+
+  return slabContains(slab, p, false, false);
+}
+
+bool PreparedPolygon<2>::slabContains(size_t slab, const Point<2>& p,
+                                      bool boundary, bool proper) const
+{
+  const Slab& s = m_slabs[slab];
+  const size_t begin = s.first, end = m_slabs[slab + 1].first;
+  const CoordType x = p[0], y = p[1];
+
+  // Every edge in the slab is vertically between, so any edge at
+  // all which is Equal() to p decides the answer, whatever the order
+  // the edges are tested in, and the rest are counted
+  if(!s.sorted) {
+    bool hit = false;
+    for(size_t i = begin; i < end; ++i) {
+      CoordType x_intersect = m_edges[i].xAt(y);
+      if(boundary && Equal(x, x_intersect))
+        return !proper;
+      if(x < x_intersect)
+        hit = !hit;
+    }
+    return hit;
+  }
+
+  // Find the first edge to the right of p
+  size_t lo = begin, hi = end;
+  while(lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if(m_edges[mid].xAt(y) > x)
+      hi = mid;
+    else
+      lo = mid + 1;
+  }
+
+  // Edges further than reach from p can't be Equal() to it, which
+  // allows at most 2 * epsilon * |x|, or epsilon for x == 0, and are
+  // on the side of p their order puts them on. Test the rest one by one.
+  const CoordType epsilon = numeric_constants<CoordType>::epsilon();
+  const CoordType reach = s.window
+                        + (boundary ? FloatMax(2 * epsilon * std::fabs(x), epsilon) : 0);
+  size_t crossings = 0;
+
+  size_t right = lo;
+  for(; right < end; ++right) {
+    CoordType x_intersect = m_edges[right].xAt(y);
+    if(x_intersect > x + reach)
+      break;
+    if(boundary && Equal(x, x_intersect))
+      return !proper;
+    if(x < x_intersect)
+      ++crossings;
+  }
+  crossings += end - right;
+
+  for(size_t left = lo; left-- > begin;) {
+    CoordType x_intersect = m_edges[left].xAt(y);
+    if(x_intersect < x - reach)
+      break;
+    if(boundary && Equal(x, x_intersect))
+      return !proper;
+    if(x < x_intersect)
+      ++crossings;
+  }
+
+  return (crossings % 2) != 0;
+}
+
+}
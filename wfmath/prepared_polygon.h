@@ -0,0 +1,148 @@
+// prepared_polygon.h (A Polygon<2> indexed for fast point containment tests)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifndef WFMATH_PREPARED_POLYGON_H
+#define WFMATH_PREPARED_POLYGON_H
+
+#include <wfmath/const.h>
+#include <wfmath/point.h>
+#include <wfmath/axisbox.h>
+#include <wfmath/polygon.h>
+
+#include <vector>
+
+#include <cstddef>
+
+namespace WFMath {
+
+template<int dim> class PreparedPolygon;
+
+/// A Polygon<2> indexed for testing many points against it
+/**
+ * The polygon is cut into horizontal slabs at the y coordinates of its
+ * corners. No corner lies inside a slab, so the edges crossing a slab
+ * cross all of it, and for a simple polygon they can be stored in left
+ * to right order. A point is tested by a binary search for its slab,
+ * followed by a binary search among that slab's edges, so a test is
+ * O(log n) and never allocates.
+ *
+ * The answer is exactly the one Intersect(Polygon<2>, Point<2>, proper)
+ * gives for the same polygon, including for points on the boundary:
+ * each edge near the point is tested with the same arithmetic and the
+ * same Equal() check, and the rest are counted from their position in
+ * the slab. Edges which cross each other inside a slab, in polygons
+ * which are not simple, can't be ordered, so those slabs fall back to
+ * testing each of their edges.
+ *
+ * Each edge is stored once for every slab it crosses. For typical
+ * outlines this is a few times the number of corners, but a polygon
+ * with many long edges stacked above each other needs more.
+ *
+ * The index is a snapshot, so rebuild it after changing the polygon.
+ * Rebuilding reuses the index's storage, and only allocates if the
+ * new polygon needs more.
+ **/
+template<>
+class PreparedPolygon<2>
+{
+ public:
+  /// Construct an empty index
+  PreparedPolygon() {}
+  /// Construct an index of a polygon
+  explicit PreparedPolygon(const Polygon<2>& p) {build(p);}
+
+  /// Replace the contents of the index with a polygon
+  void build(const Polygon<2>& p);
+
+  /// The polygon the index was built from
+  const Polygon<2>& polygon() const {return m_poly;}
+  /// The number of corners of the polygon
+  size_t numCorners() const {return m_poly.numCorners();}
+  /// The number of stored edges, summed over all the slabs
+  size_t numSlabEdges() const {return m_edges.size();}
+
+  /// The bounding box of the polygon
+  AxisBox<2> boundingBox() const {return m_poly.boundingBox();}
+
+  /// True if p is inside the polygon, the same as Intersect(polygon(), p, proper)
+  bool contains(const Point<2>& p, bool proper) const;
+  /// True if an odd number of edges cross the ray from p in the +x direction
+  /**
+   * This is the crossing count contains() is based on, without its
+   * Equal() test for points on the boundary.
+   **/
+  bool oddCrossings(const Point<2>& p) const;
+
+ private:
+  // An edge from corner a to the corner b before it, the same order
+  // the loop in Intersect(Polygon<2>, Point<2>) uses
+  struct Edge
+  {
+    CoordType ax, ay, bx, by;
+
+    // Must be the same expression as in Intersect(Polygon<2>, Point<2>),
+    // so that it rounds the same way
+    CoordType xAt(CoordType y) const
+    {return ax + (bx - ax) * (y - ay) / (by - ay);}
+  };
+
+  struct Slab
+  {
+    // The edges crossing the slab are m_edges[first, m_slabs[k + 1].first)
+    size_t first;
+    // The largest error in Edge::xAt() for the slab's edges, times a
+    // safety factor. Edges further than this from a point can be counted
+    // from their order alone.
+    CoordType window;
+    // False if the edges crossed inside the slab, so have no order
+    bool sorted;
+  };
+
+  void slabRange(CoordType y1, CoordType y2, size_t& begin, size_t& end) const;
+  bool slabContains(size_t slab, const Point<2>& p, bool boundary, bool proper) const;
+
+  Polygon<2> m_poly;
+  // The y coordinates of the corners, sorted, without duplicates. Slab
+  // k is [m_y[k], m_y[k + 1]).
+  std::vector<CoordType> m_y;
+  // One more than there are slabs, to mark the end of the last one
+  std::vector<Slab> m_slabs;
+  std::vector<Edge> m_edges;
+};
+
+/// True if p is inside the prepared polygon, the same as for the Polygon<2> itself
+inline bool Intersect(const PreparedPolygon<2>& r, const Point<2>& p, bool proper)
+{
+  return r.contains(p, proper);
+}
+
+/// True if p is inside the prepared polygon, the same as for the Polygon<2> itself
+inline bool Contains(const PreparedPolygon<2>& r, const Point<2>& p, bool proper)
+{
+  return r.contains(p, proper);
+}
+
+} // namespace WFMath
+
+#endif  // WFMATH_PREPARED_POLYGON_H
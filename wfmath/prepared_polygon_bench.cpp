@@ -0,0 +1,90 @@
+// prepared_polygon_bench.cpp (PreparedPolygon<> benchmark)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+// Created: 2026-10-16
+
+// Compares Intersect(PreparedPolygon<2>, Point<2>) with
+// Intersect(Polygon<2>, Point<2>) for a large concave polygon.
+
+#include "const.h"
+#include "point.h"
+#include "polygon.h"
+#include "polygon_intersect.h"
+#include "prepared_polygon.h"
+#include "randgen.h"
+#include "timestamp.h"
+
+#include <iostream>
+#include <vector>
+
+#include <cmath>
+
+using namespace WFMath;
+
+static const int corners = 5000;
+static const int iterations = 200000;
+
+static void report(const char* name, const TimeStamp& start, const TimeStamp& end)
+{
+  long ms = (end - start).milliseconds();
+  std::cout << name << ": " << ms << " ms, "
+            << (ms * 1e6 / iterations) << " ns per call" << std::endl;
+}
+
+int main()
+{
+  MTRand rand(1);
+
+  // A star shaped outline, like a zone boundary
+  Polygon<2> poly;
+  for(int i = 0; i < corners; ++i) {
+    CoordType angle = (CoordType) (2 * numeric_constants<CoordType>::pi() * i / corners);
+    CoordType r = (CoordType) (500 + 500 * rand.rand());
+    poly.addCorner(i, Point<2>(r * std::cos(angle), r * std::sin(angle)));
+  }
+
+  std::vector<Point<2> > points;
+  for(int n = 0; n < 1024; ++n)
+    points.push_back(Point<2>((CoordType) (rand.rand() * 2000 - 1000),
+                              (CoordType) (rand.rand() * 2000 - 1000)));
+
+  std::cout << "Polygon<2> with " << corners << " corners, "
+            << iterations << " iterations" << std::endl;
+
+  TimeStamp start = TimeStamp::now();
+  PreparedPolygon<2> prep(poly);
+  std::cout << "build: " << (TimeStamp::now() - start).milliseconds() << " ms, "
+            << prep.numSlabEdges() << " slab edges" << std::endl;
+
+  int hits = 0;
+  start = TimeStamp::now();
+  for(int n = 0; n < iterations; ++n)
+    hits += Intersect(poly, points[n % 1024], false);
+  report("Polygon<2>", start, TimeStamp::now());
+
+  int prepared_hits = 0;
+  start = TimeStamp::now();
+  for(int n = 0; n < iterations; ++n)
+    prepared_hits += Intersect(prep, points[n % 1024], false);
+  report("PreparedPolygon<2>", start, TimeStamp::now());
+
+  return hits == prepared_hits ? 0 : 1;
+}
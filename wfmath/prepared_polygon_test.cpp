@@ -0,0 +1,163 @@
+// prepared_polygon_test.cpp (PreparedPolygon<> test functions)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+// Created: 2026-10-16
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#ifndef DEBUG
+#define DEBUG
+#endif
+
+#include "const.h"
+#include "point.h"
+#include "polygon.h"
+#include "polygon_intersect.h"
+#include "prepared_polygon.h"
+#include "randgen.h"
+
+#include <iostream>
+
+#include <cassert>
+#include <cmath>
+
+using namespace WFMath;
+
+static void check_point(const Polygon<2>& poly, const PreparedPolygon<2>& prep,
+                        const Point<2>& p)
+{
+  assert(Intersect(prep, p, false) == Intersect(poly, p, false));
+  assert(Intersect(prep, p, true) == Intersect(poly, p, true));
+  assert(Contains(prep, p, false) == Contains(poly, p, false));
+}
+
+// Compare against Intersect(Polygon<2>, Point<2>) at random points, at
+// the corners, on the edges and on the horizontal lines through the corners
+static void check_polygon(const Polygon<2>& poly, MTRand& rand)
+{
+  PreparedPolygon<2> prep(poly);
+  assert(prep.numCorners() == poly.numCorners());
+
+  AxisBox<2> box = poly.boundingBox();
+  CoordType width = box.highCorner()[0] - box.lowCorner()[0];
+  CoordType height = box.highCorner()[1] - box.lowCorner()[1];
+
+  for(int n = 0; n < 2000; ++n) {
+    Point<2> p(box.lowCorner()[0] + (CoordType) ((rand.rand() * 1.2 - 0.1) * width),
+               box.lowCorner()[1] + (CoordType) ((rand.rand() * 1.2 - 0.1) * height));
+    check_point(poly, prep, p);
+  }
+
+  for(size_t i = 0, j = poly.numCorners() - 1; i < poly.numCorners(); j = i++) {
+    const Point<2>& a = poly[i], & b = poly[j];
+    check_point(poly, prep, a);
+    for(int n = 0; n < 10; ++n) {
+      CoordType t = (CoordType) rand.rand();
+      check_point(poly, prep, Point<2>(a[0] + (b[0] - a[0]) * t, a[1] + (b[1] - a[1]) * t));
+      check_point(poly, prep, Point<2>(box.lowCorner()[0] + (CoordType) rand.rand() * width, a[1]));
+    }
+    // Just either side of the corner
+    check_point(poly, prep, Point<2>(std::nextafter(a[0], -1e30f), a[1]));
+    check_point(poly, prep, Point<2>(std::nextafter(a[0], 1e30f), a[1]));
+    check_point(poly, prep, Point<2>(a[0], std::nextafter(a[1], -1e30f)));
+    check_point(poly, prep, Point<2>(a[0], std::nextafter(a[1], 1e30f)));
+  }
+}
+
+// A star shaped polygon, concave for most choices of radii
+static Polygon<2> random_star(MTRand& rand, size_t corners, const Point<2>& center,
+                              CoordType radius)
+{
+  Polygon<2> poly;
+  for(size_t i = 0; i < corners; ++i) {
+    CoordType angle = (CoordType) (2 * numeric_constants<CoordType>::pi() * i / corners);
+    CoordType r = radius * (CoordType) (0.2 + 0.8 * rand.rand());
+    poly.addCorner(i, Point<2>(center[0] + r * std::cos(angle),
+                               center[1] + r * std::sin(angle)));
+  }
+  return poly;
+}
+
+int main()
+{
+  MTRand rand(7);
+
+  // Empty and degenerate polygons
+  Polygon<2> poly;
+  PreparedPolygon<2> prep(poly);
+  check_point(poly, prep, Point<2>(0, 0));
+  poly.addCorner(0, Point<2>(1, 1));
+  prep.build(poly);
+  check_point(poly, prep, Point<2>(1, 1));
+  check_point(poly, prep, Point<2>(0, 0));
+  poly.addCorner(1, Point<2>(3, 1));
+  prep.build(poly);
+  check_point(poly, prep, Point<2>(2, 1));
+
+  // Convex, and star shaped with a few and many corners
+  for(int n = 0; n < 10; ++n) {
+    check_polygon(random_star(rand, 3 + rand.randInt(10), Point<2>(0, 0), 10), rand);
+    check_polygon(random_star(rand, 500, Point<2>(0, 0), 1000), rand);
+    // Far from the origin, where rounding is coarser
+    check_polygon(random_star(rand, 100, Point<2>(30000, -20000), 50), rand);
+  }
+  poly.clear();
+  for(int i = 0; i < 8; ++i) {
+    CoordType angle = (CoordType) (2 * numeric_constants<CoordType>::pi() * i / 8);
+    poly.addCorner(i, Point<2>(std::cos(angle), std::sin(angle)));
+  }
+  check_polygon(poly, rand);
+
+  // A comb, with many corners and horizontal edges at the same heights
+  poly.clear();
+  for(int i = 0; i < 20; ++i) {
+    poly.addCorner(poly.numCorners(), Point<2>(2 * i, 0));
+    poly.addCorner(poly.numCorners(), Point<2>(2 * i, 10));
+    poly.addCorner(poly.numCorners(), Point<2>(2 * i + 1, 10));
+    poly.addCorner(poly.numCorners(), Point<2>(2 * i + 1, 1));
+  }
+  poly.addCorner(poly.numCorners(), Point<2>(40, 1));
+  poly.addCorner(poly.numCorners(), Point<2>(40, 0));
+  prep.build(poly);
+  check_polygon(poly, rand);
+  for(int x = -1; x <= 41; ++x)
+    for(int y = -1; y <= 11; ++y)
+      check_point(poly, prep, Point<2>(x, y));
+  // 40 edges cross each of the two slabs, [0, 1) and [1, 10)
+  assert(prep.numSlabEdges() == 80);
+
+  // Self-intersecting polygons, whose slabs can't all be sorted
+  poly.clear();
+  for(int i = 0; i < 5; ++i) {
+    CoordType angle = (CoordType) (4 * numeric_constants<CoordType>::pi() * i / 5);
+    poly.addCorner(i, Point<2>(std::cos(angle), std::sin(angle)));
+  }
+  check_polygon(poly, rand);
+  for(int n = 0; n < 10; ++n) {
+    poly.clear();
+    for(int i = 0; i < 30; ++i)
+      poly.addCorner(i, Point<2>((CoordType) rand.rand(), (CoordType) rand.rand()));
+    check_polygon(poly, rand);
+  }
+
+  return 0;
+}
@@ -0,0 +1,270 @@
+// prepared_rotbox.cpp (PreparedRotBox<> implementation)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-17
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "prepared_rotbox.h"
+#include "rotbox_funcs.h"
+
+#include <cmath>
+
+#include <cassert>
+
+namespace WFMath {
+
+template<int dim>
+void PreparedRotBox<dim>::build(const RotBox<dim>& r)
+{
+  m_box = r;
+  m_center = r.getCenter();
+
+  for(int i = 0; i < dim; ++i) {
+    m_half[i] = std::fabs(r.size()[i]) / 2;
+    m_axes[i] = r.orientation().row(i);
+  }
+  m_half.setValid(r.size().isValid());
+
+  m_inv = r.orientation().inverse();
+  m_bbox = r.boundingBox();
+  m_local = AxisBox<dim>(r.corner0(), r.corner0() + r.size());
+
+  buildSeparatingAxes();
+}
+
+template<int dim>
+AxisBox<dim> PreparedRotBox<dim>::localBoundingBox(const AxisBox<dim>& b) const
+{
+  return RotBox<dim>(Point<dim>(b.lowCorner()).rotate(m_inv, m_box.corner0()),
+                     b.highCorner() - b.lowCorner(), m_inv).boundingBox();
+}
+
+template<>
+void PreparedRotBox<2>::buildSeparatingAxes()
+{
+  // The bounding boxes in each frame are enough in 2D
+  m_num_sep = 0;
+}
+
+// These are the edge-edge axes of Intersect<3>(RotBox<3>, AxisBox<3>),
+// with the part of each projection which depends only on the RotBox
+
+template<>
+void PreparedRotBox<3>::buildSeparatingAxes()
+{
+  const RotMatrix<3>& m = m_box.orientation();
+  const Vector<3>& size = m_box.size();
+  const int next[] = {1, 2, 0};
+
+  m_num_sep = 0;
+
+  for(int i = 0; i < 3; ++i) {
+    for(int j = 0; j < 3; ++j) {
+      Vector<3>& axis = m_sep_axis[m_num_sep];
+
+      switch(j) {
+        case 0:
+          axis[0] = 0;
+          axis[1] = -m.elem(i, 2);
+          axis[2] =  m.elem(i, 1);
+          break;
+        case 1:
+          axis[0] =  m.elem(i, 2);
+          axis[1] = 0;
+          axis[2] = -m.elem(i, 0);
+          break;
+        case 2:
+          axis[0] = -m.elem(i, 1);
+          axis[1] =  m.elem(i, 0);
+          axis[2] = 0;
+          break;
+        default:
+          assert(false);
+      }
+      axis.setValid();
+
+      // Intersect() stops at the first pair of parallel edges, so the
+      // axes after it are never tried
+      if(axis.sqrMag() < numeric_constants<CoordType>::epsilon() * numeric_constants<CoordType>::epsilon())
+        return;
+
+      int k = next[i];
+      CoordType val = Dot(m.row(k), axis) * size[k];
+      CoordType low, high;
+
+      if(val > 0) {
+        high = val;
+        low = 0;
+      }
+      else {
+        low = val;
+        high = 0;
+      }
+
+      k = next[k];
+      val = Dot(m.row(k), axis) * size[k];
+
+      if(val > 0)
+        high += val;
+      else
+        low += val;
+
+      m_sep_low[m_num_sep] = low;
+      m_sep_high[m_num_sep] = high;
+      ++m_num_sep;
+    }
+  }
+}
+
+// The axes are numbered as for Intersect(RotBox, AxisBox, proper, cache),
+// so that a SeparatingAxisCache works the same for both
+
+template<int dim>
+static bool _BoxAxesSeparate(const PreparedRotBox<dim>& r, const AxisBox<dim>& b,
+                             int axis, bool proper)
+{
+  if(axis == 0)
+    return !Intersect(r.boundingBox(), b, proper);
+
+  return !Intersect(r.localBoundingBox(b), r.localBox(), proper);
+}
+
+// Edge-edge axis n, with the same arithmetic as
+// Intersect<3>(RotBox<3>, AxisBox<3>)
+static bool _CrossAxisSeparates(const PreparedRotBox<3>& r, const AxisBox<3>& b, int n,
+                                bool proper)
+{
+  const Vector<3>& axis = r.separatingAxis(n);
+  Vector<3> sep = b.lowCorner() - r.rotBox().corner0();
+  Vector<3> b_size = b.highCorner() - b.lowCorner();
+  const int next[] = {1, 2, 0};
+
+  // AxisBox projection, along the two coordinate axes which
+  // aren't crossed into this one
+
+  int k = next[n % 3];
+  CoordType val = axis[k] * b_size[k];
+  CoordType b_low, b_high;
+
+  if(val > 0) {
+    b_high = val;
+    b_low = 0;
+  }
+  else {
+    b_low = val;
+    b_high = 0;
+  }
+
+  k = next[k];
+  val = axis[k] * b_size[k];
+
+  if(val > 0)
+    b_high += val;
+  else
+    b_low += val;
+
+  CoordType dist = Dot(sep, axis);
+
+  return _Greater(r.separatingLow(n) - dist, b_high, proper)
+      || _Less(r.separatingHigh(n) - dist, b_low, proper);
+}
+
+// There are no edge-edge axes in 2D, so this is never called
+static bool _CrossAxisSeparates(const PreparedRotBox<2>&, const AxisBox<2>&, int, bool)
+{
+  assert(false);
+  return false;
+}
+
+// Returns the number of the first axis which separates the boxes, or -1
+template<int dim>
+static int _SeparatingAxis(const PreparedRotBox<dim>& r, const AxisBox<dim>& b, bool proper)
+{
+  for(int axis = 0; axis < 2; ++axis)
+    if(_BoxAxesSeparate(r, b, axis, proper))
+      return axis;
+
+  for(int n = 0; n < r.numSeparatingAxes(); ++n)
+    if(_CrossAxisSeparates(r, b, n, proper))
+      return 2 + n;
+
+  return -1;
+}
+
+template<int dim>
+static bool _AxisSeparates(const PreparedRotBox<dim>& r, const AxisBox<dim>& b, int axis,
+                           bool proper)
+{
+  if(axis < 2)
+    return _BoxAxesSeparate(r, b, axis, proper);
+
+  return axis - 2 < r.numSeparatingAxes() && _CrossAxisSeparates(r, b, axis - 2, proper);
+}
+
+template<int dim>
+static bool _CachedIntersect(const PreparedRotBox<dim>& r, const AxisBox<dim>& b,
+                             bool proper, SeparatingAxisCache& cache)
+{
+  if(cache.axis() >= 0 && _AxisSeparates(r, b, cache.axis(), proper))
+    return false;
+
+  int axis = _SeparatingAxis(r, b, proper);
+  if(axis < 0)
+    return true;
+
+  cache.setAxis(axis);
+  return false;
+}
+
+template<>
+bool Intersect<2>(const PreparedRotBox<2>& r, const AxisBox<2>& b, bool proper)
+{
+  return _SeparatingAxis(r, b, proper) < 0;
+}
+
+template<>
+bool Intersect<3>(const PreparedRotBox<3>& r, const AxisBox<3>& b, bool proper)
+{
+  return _SeparatingAxis(r, b, proper) < 0;
+}
+
+template<>
+bool Intersect<2>(const PreparedRotBox<2>& r, const AxisBox<2>& b, bool proper,
+                  SeparatingAxisCache& cache)
+{
+  return _CachedIntersect(r, b, proper, cache);
+}
+
+template<>
+bool Intersect<3>(const PreparedRotBox<3>& r, const AxisBox<3>& b, bool proper,
+                  SeparatingAxisCache& cache)
+{
+  return _CachedIntersect(r, b, proper, cache);
+}
+
+template class PreparedRotBox<3>;
+template class PreparedRotBox<2>;
+
+}
@@ -0,0 +1,292 @@
+// prepared_rotbox.h (A RotBox with its derived quantities cached)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-17
+
+#ifndef WFMATH_PREPARED_ROTBOX_H
+#define WFMATH_PREPARED_ROTBOX_H
+
+#include <wfmath/const.h>
+#include <wfmath/vector.h>
+#include <wfmath/point.h>
+#include <wfmath/rotmatrix.h>
+#include <wfmath/axisbox.h>
+#include <wfmath/ball.h>
+#include <wfmath/segment.h>
+#include <wfmath/rotbox.h>
+#include <wfmath/intersect.h>
+
+namespace WFMath {
+
+/// A RotBox with the quantities its intersection tests need worked out once
+/**
+ * Intersect() and Contains() for a RotBox invert its orientation, build
+ * temporary boxes and find its bounding box on every call. For a box
+ * which is tested many times without moving, such as a static obstacle,
+ * a PreparedRotBox does that work once, when it is built. In 3D it also
+ * keeps the nine edge-edge separating axes, and the extent of the box
+ * along each of them.
+ *
+ * All the Intersect() and Contains() functions which take a RotBox also
+ * take a PreparedRotBox, and give exactly the same answers as they do
+ * for the box it was built from. Intersect() for two boxes works in the
+ * frame of its second argument, and like any Intersect() with its
+ * arguments the other way around, Intersect(PreparedRotBox, RotBox) is
+ * Intersect(RotBox, PreparedRotBox).
+ *
+ * The cache is a snapshot, so rebuild it after changing the box.
+ **/
+template<int dim = 3>
+class PreparedRotBox
+{
+ public:
+  /// Construct an uninitialized box
+  PreparedRotBox() : m_num_sep(0) {}
+  /// Construct a prepared copy of a box
+  explicit PreparedRotBox(const RotBox<dim>& r) {build(r);}
+
+  /// Replace the box, and work out its cached values
+  void build(const RotBox<dim>& r);
+
+  /// The box the cache was built from
+  const RotBox<dim>& rotBox() const		{return m_box;}
+  /// The center of the box
+  const Point<dim>& center() const		{return m_center;}
+  /// Half the size of the box along each of its axes, all nonnegative
+  const Vector<dim>& halfExtents() const	{return m_half;}
+  /// The unit direction of axis i of the box, the same as orientation().row(i)
+  const Vector<dim>& faceAxis(int i) const	{return m_axes[i];}
+  /// The inverse of the orientation of the box
+  const RotMatrix<dim>& inverseOrientation() const {return m_inv;}
+  /// The bounding box of the box, the same as rotBox().boundingBox()
+  const AxisBox<dim>& boundingBox() const	{return m_bbox;}
+  /// The box in its own frame, with corner0() fixed, as an AxisBox
+  const AxisBox<dim>& localBox() const		{return m_local;}
+  Ball<dim> boundingSphere() const		{return m_box.boundingSphere();}
+
+  /// Rotate a point into the frame of localBox()
+  Point<dim> toLocal(const Point<dim>& p) const
+  {return m_box.corner0() + ProdInv(p - m_box.corner0(), m_box.orientation());}
+  /// The bounding box of b, rotated into the frame of localBox()
+  AxisBox<dim> localBoundingBox(const AxisBox<dim>& b) const;
+
+  /// The number of cached separating axes, nine in 3D and none in 2D
+  /**
+   * In 3D, fewer are kept if an edge of the box is parallel to a
+   * coordinate axis, since the test ends at the first such pair.
+   **/
+  int numSeparatingAxes() const {return m_num_sep;}
+  /// The cross product of an edge of the box with a coordinate axis
+  const Vector<dim>& separatingAxis(int i) const {return m_sep_axis[i];}
+  /// The lowest projection of the box onto separatingAxis(i), relative to corner0()
+  CoordType separatingLow(int i) const {return m_sep_low[i];}
+  /// The highest projection of the box onto separatingAxis(i), relative to corner0()
+  CoordType separatingHigh(int i) const {return m_sep_high[i];}
+
+ private:
+  void buildSeparatingAxes();
+
+  RotBox<dim> m_box;
+  Point<dim> m_center;
+  Vector<dim> m_half;
+  Vector<dim> m_axes[dim];
+  RotMatrix<dim> m_inv;
+  AxisBox<dim> m_bbox, m_local;
+
+  // In 3D, the axes are the cross products of box axis i with
+  // coordinate axis j, at i * 3 + j, in the order Intersect() tries them
+  int m_num_sep;
+  Vector<dim> m_sep_axis[dim * dim];
+  CoordType m_sep_low[dim * dim], m_sep_high[dim * dim];
+};
+
+template<>
+void PreparedRotBox<2>::buildSeparatingAxes();
+template<>
+void PreparedRotBox<3>::buildSeparatingAxes();
+
+template<int dim>
+inline bool Intersect(const PreparedRotBox<dim>& r, const Point<dim>& p, bool proper)
+{
+  return Intersect(r.rotBox(), p, proper);
+}
+
+template<int dim>
+inline bool Contains(const Point<dim>& p, const PreparedRotBox<dim>& r, bool proper)
+{
+  return Contains(p, r.rotBox(), proper);
+}
+
+template<int dim>
+bool Intersect(const PreparedRotBox<dim>& r, const AxisBox<dim>& b, bool proper);
+
+template<>
+bool Intersect<2>(const PreparedRotBox<2>& r, const AxisBox<2>& b, bool proper);
+template<>
+bool Intersect<3>(const PreparedRotBox<3>& r, const AxisBox<3>& b, bool proper);
+
+/// Intersect(), trying the axis in the cache first
+/**
+ * This numbers the axes the same way Intersect(RotBox, AxisBox, proper,
+ * cache) does, so the same cache works with the box before and after it
+ * is prepared.
+ **/
+template<int dim>
+bool Intersect(const PreparedRotBox<dim>& r, const AxisBox<dim>& b, bool proper,
+               SeparatingAxisCache& cache);
+
+template<>
+bool Intersect<2>(const PreparedRotBox<2>& r, const AxisBox<2>& b, bool proper,
+                  SeparatingAxisCache& cache);
+template<>
+bool Intersect<3>(const PreparedRotBox<3>& r, const AxisBox<3>& b, bool proper,
+                  SeparatingAxisCache& cache);
+
+template<int dim>
+inline bool Contains(const PreparedRotBox<dim>& r, const AxisBox<dim>& b, bool proper)
+{
+  return Contains(r.localBox(), r.localBoundingBox(b), proper);
+}
+
+template<int dim>
+inline bool Contains(const AxisBox<dim>& b, const PreparedRotBox<dim>& r, bool proper)
+{
+  return Contains(b, r.boundingBox(), proper);
+}
+
+template<int dim>
+inline bool Intersect(const PreparedRotBox<dim>& r, const Ball<dim>& b, bool proper)
+{
+  return Intersect(r.localBox(), Ball<dim>(r.toLocal(b.center()), b.radius()), proper);
+}
+
+template<int dim>
+inline bool Contains(const PreparedRotBox<dim>& r, const Ball<dim>& b, bool proper)
+{
+  return Contains(r.localBox(), Ball<dim>(r.toLocal(b.center()), b.radius()), proper);
+}
+
+template<int dim>
+inline bool Contains(const Ball<dim>& b, const PreparedRotBox<dim>& r, bool proper)
+{
+  return Contains(Ball<dim>(r.toLocal(b.center()), b.radius()), r.localBox(), proper);
+}
+
+template<int dim>
+inline bool Intersect(const PreparedRotBox<dim>& r, const Segment<dim>& s, bool proper)
+{
+  return Intersect(r.localBox(), Segment<dim>(r.toLocal(s.endpoint(0)),
+                                              r.toLocal(s.endpoint(1))), proper);
+}
+
+template<int dim>
+inline bool Contains(const PreparedRotBox<dim>& r, const Segment<dim>& s, bool proper)
+{
+  return Contains(r.localBox(), Segment<dim>(r.toLocal(s.endpoint(0)),
+                                             r.toLocal(s.endpoint(1))), proper);
+}
+
+template<int dim>
+inline bool Contains(const Segment<dim>& s, const PreparedRotBox<dim>& r, bool proper)
+{
+  return Contains(Segment<dim>(r.toLocal(s.endpoint(0)), r.toLocal(s.endpoint(1))),
+                  r.localBox(), proper);
+}
+
+// The first box is rotated into the frame of the second, as for two
+// RotBoxes, so it's the second one whose inverse orientation is kept
+
+template<int dim>
+inline bool Intersect(const RotBox<dim>& r1, const PreparedRotBox<dim>& r2, bool proper)
+{
+  return Intersect(RotBox<dim>(r1).rotatePoint(r2.inverseOrientation(),
+                                               r2.rotBox().corner0()),
+                   r2.localBox(), proper);
+}
+
+template<int dim>
+inline bool Intersect(const PreparedRotBox<dim>& r1, const PreparedRotBox<dim>& r2,
+                      bool proper)
+{
+  return Intersect(r1.rotBox(), r2, proper);
+}
+
+template<int dim>
+inline bool Intersect(const RotBox<dim>& r1, const PreparedRotBox<dim>& r2, bool proper,
+                      SeparatingAxisCache& cache)
+{
+  return Intersect(RotBox<dim>(r1).rotatePoint(r2.inverseOrientation(),
+                                               r2.rotBox().corner0()),
+                   r2.localBox(), proper, cache);
+}
+
+template<int dim>
+inline bool Intersect(const PreparedRotBox<dim>& r1, const PreparedRotBox<dim>& r2,
+                      bool proper, SeparatingAxisCache& cache)
+{
+  return Intersect(r1.rotBox(), r2, proper, cache);
+}
+
+template<int dim>
+inline bool Contains(const PreparedRotBox<dim>& outer, const RotBox<dim>& inner, bool proper)
+{
+  return Contains(outer.localBox(),
+                  RotBox<dim>(inner).rotatePoint(outer.inverseOrientation(),
+                                                 outer.rotBox().corner0()), proper);
+}
+
+template<int dim>
+inline bool Contains(const RotBox<dim>& outer, const PreparedRotBox<dim>& inner, bool proper)
+{
+  return Contains(outer, inner.rotBox(), proper);
+}
+
+template<int dim>
+inline bool Contains(const PreparedRotBox<dim>& outer, const PreparedRotBox<dim>& inner,
+                     bool proper)
+{
+  return Contains(outer, inner.rotBox(), proper);
+}
+
+// The Polygon<> functions don't use anything the cache holds
+
+template<int dim>
+inline bool Intersect(const Polygon<dim>& p, const PreparedRotBox<dim>& r, bool proper)
+{
+  return Intersect(p, r.rotBox(), proper);
+}
+
+template<int dim>
+inline bool Contains(const Polygon<dim>& p, const PreparedRotBox<dim>& r, bool proper)
+{
+  return Contains(p, r.rotBox(), proper);
+}
+
+template<int dim>
+inline bool Contains(const PreparedRotBox<dim>& r, const Polygon<dim>& p, bool proper)
+{
+  return Contains(r.rotBox(), p, proper);
+}
+
+} // namespace WFMath
+
+#endif  // WFMATH_PREPARED_ROTBOX_H
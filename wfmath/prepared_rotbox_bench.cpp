@@ -0,0 +1,117 @@
+// prepared_rotbox_bench.cpp (PreparedRotBox<> benchmark)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-17
+
+// Compares Intersect(PreparedRotBox<3>, X) with Intersect(RotBox<3>, X)
+// for a static box tested against many AxisBoxes, Balls and RotBoxes.
+
+#include "const.h"
+#include "vector.h"
+#include "point.h"
+#include "rotmatrix.h"
+#include "axisbox.h"
+#include "ball.h"
+#include "rotbox.h"
+#include "intersect.h"
+#include "prepared_rotbox.h"
+#include "randgen.h"
+#include "timestamp.h"
+
+#include <iostream>
+#include <vector>
+
+using namespace WFMath;
+
+static const int iterations = 1000000;
+
+static void report(const char* name, const TimeStamp& start, const TimeStamp& end)
+{
+  long ms = (end - start).milliseconds();
+  std::cout << name << ": " << ms << " ms, "
+            << (ms * 1e6 / iterations) << " ns per call" << std::endl;
+}
+
+static Point<3> random_point(MTRand& rand)
+{
+  return Point<3>((CoordType) (rand.rand() * 20 - 10), (CoordType) (rand.rand() * 20 - 10),
+                  (CoordType) (rand.rand() * 20 - 10));
+}
+
+int main()
+{
+  MTRand rand(1);
+
+  // A building, turned a little off the axes
+  RotMatrix<3> m;
+  m.rotation(Vector<3>(0.1f, 1, 0.2f), 0.6f);
+  RotBox<3> box(Point<3>(-3, -2, -4), Vector<3>(6, 4, 8), m);
+  PreparedRotBox<3> prep(box);
+
+  std::vector<AxisBox<3> > boxes;
+  std::vector<Ball<3> > balls;
+  std::vector<RotBox<3> > rboxes;
+  for(int n = 0; n < 1024; ++n) {
+    Point<3> p = random_point(rand);
+    boxes.push_back(AxisBox<3>(p, p + Vector<3>(1, 2, 1)));
+    balls.push_back(Ball<3>(random_point(rand), 1));
+    rboxes.push_back(RotBox<3>(random_point(rand), Vector<3>(1, 2, 1),
+                               RotMatrix<3>().rotation(Vector<3>(1, 1, 0),
+                                                       (CoordType) rand.rand())));
+  }
+
+  std::cout << "RotBox<3> against " << iterations << " shapes" << std::endl;
+
+  int hits = 0, prepared_hits = 0;
+
+  TimeStamp start = TimeStamp::now();
+  for(int n = 0; n < iterations; ++n)
+    hits += Intersect(box, boxes[n % 1024], false);
+  report("RotBox<3>/AxisBox<3>", start, TimeStamp::now());
+
+  start = TimeStamp::now();
+  for(int n = 0; n < iterations; ++n)
+    prepared_hits += Intersect(prep, boxes[n % 1024], false);
+  report("PreparedRotBox<3>/AxisBox<3>", start, TimeStamp::now());
+
+  start = TimeStamp::now();
+  for(int n = 0; n < iterations; ++n)
+    hits += Intersect(box, balls[n % 1024], false);
+  report("RotBox<3>/Ball<3>", start, TimeStamp::now());
+
+  start = TimeStamp::now();
+  for(int n = 0; n < iterations; ++n)
+    prepared_hits += Intersect(prep, balls[n % 1024], false);
+  report("PreparedRotBox<3>/Ball<3>", start, TimeStamp::now());
+
+  start = TimeStamp::now();
+  for(int n = 0; n < iterations; ++n)
+    hits += Intersect(rboxes[n % 1024], box, false);
+  report("RotBox<3>/RotBox<3>", start, TimeStamp::now());
+
+  start = TimeStamp::now();
+  for(int n = 0; n < iterations; ++n)
+    prepared_hits += Intersect(rboxes[n % 1024], prep, false);
+  report("RotBox<3>/PreparedRotBox<3>", start, TimeStamp::now());
+
+  return hits == prepared_hits ? 0 : 1;
+}
@@ -0,0 +1,268 @@
+// prepared_rotbox_test.cpp (PreparedRotBox<> test functions)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-17
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#ifndef DEBUG
+#define DEBUG
+#endif
+
+#include "const.h"
+#include "vector.h"
+#include "point.h"
+#include "rotmatrix.h"
+#include "axisbox.h"
+#include "ball.h"
+#include "segment.h"
+#include "rotbox.h"
+#include "polygon.h"
+#include "intersect.h"
+#include "polygon_intersect.h"
+#include "prepared_rotbox.h"
+#include "randgen.h"
+
+#include <iostream>
+
+#include <cassert>
+#include <cmath>
+
+using namespace WFMath;
+
+static CoordType random_coord(MTRand& rand, CoordType low, CoordType high)
+{
+  return low + (high - low) * (CoordType) rand.rand();
+}
+
+template<int dim>
+static Point<dim> random_point(MTRand& rand)
+{
+  Point<dim> p;
+  p.setToOrigin();
+  for(int i = 0; i < dim; ++i)
+    p[i] = random_coord(rand, -3, 3);
+  return p;
+}
+
+template<int dim>
+static Vector<dim> random_size(MTRand& rand)
+{
+  Vector<dim> v;
+  for(int i = 0; i < dim; ++i)
+    v[i] = random_coord(rand, 0.2f, 2);
+  v.setValid();
+  return v;
+}
+
+static RotMatrix<2> random_rotation(MTRand& rand, const RotMatrix<2>&)
+{
+  RotMatrix<2> m;
+  return m.rotation(random_coord(rand, -3, 3));
+}
+
+static RotMatrix<3> random_rotation(MTRand& rand, const RotMatrix<3>&)
+{
+  RotMatrix<3> m;
+  Vector<3> axis(random_coord(rand, -1, 1), random_coord(rand, -1, 1),
+                 random_coord(rand, -1, 1));
+  return m.rotation(axis, random_coord(rand, -3, 3));
+}
+
+// Every overload must agree with the RotBox it was built from
+template<int dim>
+static int check_box(const RotBox<dim>& box, MTRand& rand)
+{
+  PreparedRotBox<dim> prep(box);
+
+  assert(prep.boundingBox() == box.boundingBox());
+  assert(prep.center() == box.getCenter());
+  for(int i = 0; i < dim; ++i) {
+    assert(Equal(prep.halfExtents()[i], std::fabs(box.size()[i]) / 2));
+    assert(prep.faceAxis(i) == box.orientation().row(i));
+  }
+  assert(prep.inverseOrientation() == box.orientation().inverse());
+
+  int hits = 0;
+
+  for(int n = 0; n < 20; ++n) {
+    Point<dim> p = random_point<dim>(rand);
+    Point<dim> low = random_point<dim>(rand);
+    AxisBox<dim> abox(low, low + random_size<dim>(rand));
+    // Small enough to fit inside the box now and then
+    AxisBox<dim> small(box.getCenter(), box.getCenter() + random_size<dim>(rand) / 8);
+    Ball<dim> ball(random_point<dim>(rand), random_coord(rand, 0.1f, 1.5f));
+    Ball<dim> inner(box.getCenter(), random_coord(rand, 0.01f, 0.2f));
+    Segment<dim> seg(random_point<dim>(rand), random_point<dim>(rand));
+    Segment<dim> short_seg(box.getCenter(), box.getCenter() + random_size<dim>(rand) / 8);
+    RotBox<dim> other(random_point<dim>(rand), random_size<dim>(rand),
+                      random_rotation(rand, RotMatrix<dim>()));
+    RotBox<dim> inside(box.getCenter(), random_size<dim>(rand) / 8,
+                       random_rotation(rand, RotMatrix<dim>()));
+    PreparedRotBox<dim> prep_other(other);
+
+    for(int j = 0; j < 2; ++j) {
+      bool proper = (j == 1);
+
+      assert(Intersect(prep, p, proper) == Intersect(box, p, proper));
+      assert(Intersect(p, prep, proper) == Intersect(p, box, proper));
+      assert(Contains(prep, p, proper) == Contains(box, p, proper));
+      assert(Contains(p, prep, proper) == Contains(p, box, proper));
+
+      hits += Intersect(prep, abox, proper);
+      assert(Intersect(prep, abox, proper) == Intersect(box, abox, proper));
+      assert(Intersect(abox, prep, proper) == Intersect(abox, box, proper));
+      assert(Intersect(prep, small, proper) == Intersect(box, small, proper));
+      assert(Contains(prep, abox, proper) == Contains(box, abox, proper));
+      assert(Contains(prep, small, proper) == Contains(box, small, proper));
+      assert(Contains(abox, prep, proper) == Contains(abox, box, proper));
+
+      hits += Intersect(prep, ball, proper);
+      assert(Intersect(prep, ball, proper) == Intersect(box, ball, proper));
+      assert(Intersect(ball, prep, proper) == Intersect(ball, box, proper));
+      assert(Contains(prep, ball, proper) == Contains(box, ball, proper));
+      assert(Contains(prep, inner, proper) == Contains(box, inner, proper));
+      assert(Contains(ball, prep, proper) == Contains(ball, box, proper));
+
+      hits += Intersect(prep, seg, proper);
+      assert(Intersect(prep, seg, proper) == Intersect(box, seg, proper));
+      assert(Intersect(seg, prep, proper) == Intersect(seg, box, proper));
+      assert(Contains(prep, seg, proper) == Contains(box, seg, proper));
+      assert(Contains(prep, short_seg, proper) == Contains(box, short_seg, proper));
+      assert(Contains(seg, prep, proper) == Contains(seg, box, proper));
+
+      hits += Intersect(other, prep, proper);
+      assert(Intersect(other, prep, proper) == Intersect(other, box, proper));
+      assert(Intersect(prep, other, proper) == Intersect(other, box, proper));
+      assert(Intersect(prep_other, prep, proper) == Intersect(other, box, proper));
+      assert(Contains(prep, other, proper) == Contains(box, other, proper));
+      assert(Contains(prep, inside, proper) == Contains(box, inside, proper));
+      assert(Contains(other, prep, proper) == Contains(other, box, proper));
+      assert(Contains(prep_other, prep, proper) == Contains(other, box, proper));
+    }
+  }
+
+  return hits;
+}
+
+template<int dim>
+static void test_random(MTRand& rand)
+{
+  std::cout << "Testing " << dim << "D prepared boxes" << std::endl;
+
+  int hits = 0;
+  for(int i = 0; i < 100; ++i) {
+    hits += check_box(RotBox<dim>(random_point<dim>(rand), random_size<dim>(rand),
+                                  random_rotation(rand, RotMatrix<dim>())), rand);
+  }
+  assert(hits > 500);
+
+  // Axis aligned, where the 3D test stops at the first pair of
+  // parallel edges
+  RotMatrix<dim> identity;
+  identity.identity();
+  for(int i = 0; i < 10; ++i)
+    check_box(RotBox<dim>(random_point<dim>(rand), random_size<dim>(rand), identity), rand);
+
+  PreparedRotBox<dim> prep(RotBox<dim>(random_point<dim>(rand), random_size<dim>(rand),
+                                       identity));
+  assert(prep.numSeparatingAxes() == 0);
+}
+
+static void test_exact()
+{
+  std::cout << "Testing prepared boxes against fixed shapes" << std::endl;
+
+  // A unit cube turned 45 degrees about z, which reaches out to
+  // sqrt(1/2) along x and y
+  RotMatrix<3> m;
+  m.rotation(0, 1, numeric_constants<CoordType>::pi() / 4);
+  RotBox<3> box(Point<3>(0, 0, 0), Vector<3>(1, 1, 1), m);
+  box.moveCenterTo(Point<3>(0, 0, 0));
+  PreparedRotBox<3> prep(box);
+
+  // Its z edge is parallel to the z axis, which is the last pair tried
+  assert(prep.numSeparatingAxes() == 8);
+  assert(Equal(prep.boundingBox().highCorner()[0], std::sqrt(0.5f)));
+  assert(Equal(prep.boundingBox().highCorner()[2], 0.5f));
+
+  // Inside the bounding box, but off the corner of the turned cube
+  AxisBox<3> corner(Point<3>(0.6f, 0.6f, -0.1f), Point<3>(0.7f, 0.7f, 0.1f));
+  assert(Intersect(prep.boundingBox(), corner, false));
+  assert(!Intersect(prep, corner, false));
+  assert(!Intersect(box, corner, false));
+
+  AxisBox<3> center(Point<3>(-0.1f, -0.1f, -0.1f), Point<3>(0.1f, 0.1f, 0.1f));
+  assert(Intersect(prep, center, true));
+  assert(Contains(prep, center, true));
+  assert(!Contains(center, prep, false));
+
+  assert(Intersect(prep, Ball<3>(Point<3>(1, 0, 0), 0.3f), false));
+  assert(!Intersect(prep, Ball<3>(Point<3>(1, 1, 0), 0.3f), false));
+  assert(Intersect(prep, Segment<3>(Point<3>(-1, 0, 0), Point<3>(1, 0, 0)), true));
+
+  // Rebuilding replaces the cached values
+  box.shift(Vector<3>(10, 0, 0));
+  prep.build(box);
+  assert(!Intersect(prep, center, false));
+  assert(prep.center() == Point<3>(10, 0, 0));
+}
+
+static void test_polygon(MTRand& rand)
+{
+  std::cout << "Testing prepared boxes against polygons" << std::endl;
+
+  for(int i = 0; i < 50; ++i) {
+    RotBox<2> box(random_point<2>(rand), random_size<2>(rand),
+                  random_rotation(rand, RotMatrix<2>()));
+    PreparedRotBox<2> prep(box);
+
+    Polygon<2> poly;
+    Point<2> center = random_point<2>(rand);
+    for(int j = 0; j < 5; ++j) {
+      CoordType angle = j * 2 * numeric_constants<CoordType>::pi() / 5;
+      CoordType r = random_coord(rand, 0.3f, 2);
+      poly.addCorner(j, center + Vector<2>(r * std::cos(angle), r * std::sin(angle)));
+    }
+
+    for(int j = 0; j < 2; ++j) {
+      bool proper = (j == 1);
+      assert(Intersect(poly, prep, proper) == Intersect(poly, box, proper));
+      assert(Intersect(prep, poly, proper) == Intersect(box, poly, proper));
+      assert(Contains(poly, prep, proper) == Contains(poly, box, proper));
+      assert(Contains(prep, poly, proper) == Contains(box, poly, proper));
+    }
+  }
+}
+
+int main()
+{
+  MTRand rand(17);
+
+  test_random<2>(rand);
+  test_random<3>(rand);
+  test_exact();
+  test_polygon(rand);
+
+  return 0;
+}
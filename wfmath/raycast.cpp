@@ -0,0 +1,568 @@
+// raycast.cpp (Ray and segment casts against shapes)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "raycast.h"
+#include "intersect.h"
+#include "point_array_funcs.h"
+#include "simd.h"
+
+#include <vector>
+
+#include <cassert>
+#include <cmath>
+
+// The packet loops below must give the same answers as the scalar
+// _Raycast() functions in raycast.h, so each lane does the same
+// operations in the same order.
+
+namespace WFMath {
+
+// Dot() rounds small answers to zero, which would move the hit
+template<int dim>
+static CoordType _RayDot(const Vector<dim>& v1, const Vector<dim>& v2)
+{
+  CoordType ans = 0;
+  for(int i = 0; i < dim; ++i)
+    ans += v1[i] * v2[i];
+  return ans;
+}
+
+template<int dim>
+bool _Raycast(const Point<dim>& origin, const Vector<dim>& dir, CoordType max_t,
+              const Segment<dim>& s, CoordType& t, Point<dim>& hit,
+              Vector<dim>& normal)
+{
+  const Point<dim> &p1 = s.endpoint(0), &p2 = s.endpoint(1);
+  CoordType dd = dir.sqrMag();
+  CoordType t1 = 0, t2 = 0;
+  if(dd > 0) {
+    t1 = _RayDot(p1 - origin, dir) / dd;
+    t2 = _RayDot(p2 - origin, dir) / dd;
+  }
+
+  // The ray can't hit the segment past the furthest projection of an
+  // endpoint, so test against a finite piece of it
+  CoordType len = std::min(std::max(std::max(t1, t2), (CoordType) 0), max_t);
+  if(!Intersect(Segment<dim>(origin, origin + dir * len), s, false))
+    return false;
+
+  Vector<dim> e = p2 - p1, offset = p1 - origin;
+  CoordType ee = e.sqrMag(), de = _RayDot(dir, e),
+            denom = dd * ee - de * de;
+
+  if(denom > numeric_constants<CoordType>::epsilon() * dd * ee)
+    // The lines cross at a single point
+    t = (ee * _RayDot(dir, offset) - de * _RayDot(e, offset)) / denom;
+  else
+    // Parallel, the ray first meets the nearer endpoint
+    t = std::min(t1, t2);
+  t = std::min(std::max(t, (CoordType) 0), len);
+
+  hit = origin + dir * t;
+  normal.zero();
+  if(t == 0)
+    return true;
+
+  // The part of -dir perpendicular to the segment
+  normal = -dir;
+  if(ee > 0)
+    normal += e * (de / ee);
+  if(!(normal.sqrMag() > numeric_constants<CoordType>::epsilon() * dd))
+    normal = -dir;
+  normal /= normal.mag();
+  return true;
+}
+
+// True if (px, py) is in the polygon with the given corners, by the
+// even-odd rule, like Intersect(Polygon<2>, Point<2>)
+static bool _PlanarContains(const CoordType* x, const CoordType* y, size_t n,
+                            CoordType px, CoordType py)
+{
+  bool hit = false;
+
+  for(size_t i = 0, j = n - 1; i < n; j = i++) {
+    if(!((y[i] <= py && py < y[j]) || (y[j] <= py && py < y[i])))
+      continue;
+
+    CoordType x_intersect = x[i] + (x[j] - x[i]) * (py - y[i]) / (y[j] - y[i]);
+
+    if(Equal(px, x_intersect))
+      return true;
+    if(px < x_intersect)
+      hit = !hit;
+  }
+
+  return hit;
+}
+
+// Cast a ray which starts outside a polygon in the plane, and set
+// edge to the corner which starts the edge it enters through
+static bool _PlanarRaycast(const CoordType* x, const CoordType* y, size_t n,
+                           CoordType ox, CoordType oy, CoordType dx, CoordType dy,
+                           CoordType max_t, CoordType& t, size_t& edge)
+{
+  bool found = false;
+
+  for(size_t i = 0, j = n - 1; i < n; j = i++) {
+    // Solve origin + s * dir = corner j + u * (corner i - corner j)
+    CoordType ex = x[i] - x[j], ey = y[i] - y[j];
+    CoordType denom = dx * ey - dy * ex;
+    if(denom == 0)
+      continue; // Parallel, the ray meets the neighbouring edges first
+
+    CoordType ax = x[j] - ox, ay = y[j] - oy;
+    CoordType s = (ax * ey - ay * ex) / denom, u = (ax * dy - ay * dx) / denom;
+    if(u < 0 || u > 1 || s < 0 || s > max_t)
+      continue;
+
+    if(!found || s < t) {
+      t = s;
+      edge = j;
+      found = true;
+    }
+  }
+
+  return found;
+}
+
+template<>
+bool _Raycast<2>(const Point<2>& origin, const Vector<2>& dir, CoordType max_t,
+                 const Polygon<2>& p, CoordType& t, Point<2>& hit,
+                 Vector<2>& normal)
+{
+  const size_t n = p.numCorners();
+  if(n == 0)
+    return false;
+
+  std::vector<CoordType> x(n), y(n);
+  for(size_t i = 0; i < n; ++i) {
+    x[i] = p[i][0];
+    y[i] = p[i][1];
+  }
+
+  normal.zero();
+  if(_PlanarContains(&x[0], &y[0], n, origin[0], origin[1])) {
+    t = 0;
+    hit = origin;
+    return true;
+  }
+
+  size_t edge;
+  if(!_PlanarRaycast(&x[0], &y[0], n, origin[0], origin[1], dir[0], dir[1],
+                     max_t, t, edge))
+    return false;
+
+  hit = origin + dir * t;
+  Vector<2> e = p[(edge + 1) % n] - p[edge];
+  normal = Vector<2>(e[1], -e[0]);
+  if(_RayDot(normal, dir) > 0)
+    normal = -normal;
+  normal /= normal.mag();
+  return true;
+}
+
+template<>
+bool _Raycast<3>(const Point<3>& origin, const Vector<3>& dir, CoordType max_t,
+                 const Polygon<3>& p, CoordType& t, Point<3>& hit,
+                 Vector<3>& normal)
+{
+  const size_t n = p.numCorners();
+  if(n == 0)
+    return false;
+
+  std::vector<Point<3> > corners(n);
+  for(size_t i = 0; i < n; ++i)
+    corners[i] = p.getCorner(i);
+
+  // Newell's normal of the plane, and the axis it's closest to, which
+  // is dropped to work in the plane
+  Vector<3> plane_normal;
+  plane_normal.zero();
+  for(size_t i = 0; i < n; ++i) {
+    const Point<3> &a = corners[i], &b = corners[(i + 1) % n];
+    for(int j = 0; j < 3; ++j)
+      plane_normal[j] += (a[(j + 1) % 3] - b[(j + 1) % 3]) * (a[(j + 2) % 3] + b[(j + 2) % 3]);
+  }
+  int drop = 0;
+  for(int j = 1; j < 3; ++j)
+    if(std::fabs(plane_normal[j]) > std::fabs(plane_normal[drop]))
+      drop = j;
+  const int ax = (drop + 1) % 3, ay = (drop + 2) % 3;
+
+  std::vector<CoordType> x(n), y(n);
+  for(size_t i = 0; i < n; ++i) {
+    x[i] = corners[i][ax];
+    y[i] = corners[i][ay];
+  }
+
+  CoordType nn = plane_normal.sqrMag(), eps = numeric_constants<CoordType>::epsilon();
+  Vector<3> offset = corners[0] - origin;
+  CoordType denom = _RayDot(plane_normal, dir), height = _RayDot(plane_normal, offset);
+
+  normal.zero();
+
+  if(!(denom * denom > eps * nn * dir.sqrMag())) {
+    // The ray is parallel to the plane, and misses unless it's in it
+    if(!(height * height <= eps * nn * offset.sqrMag()))
+      return false;
+
+    if(_PlanarContains(&x[0], &y[0], n, origin[ax], origin[ay])) {
+      t = 0;
+      hit = origin;
+      return true;
+    }
+
+    size_t edge;
+    if(!_PlanarRaycast(&x[0], &y[0], n, origin[ax], origin[ay], dir[ax], dir[ay],
+                       max_t, t, edge))
+      return false;
+
+    hit = origin + dir * t;
+    normal = Cross(plane_normal, corners[(edge + 1) % n] - corners[edge]);
+  }
+  else {
+    t = height / denom;
+    if(t < 0 || t > max_t)
+      return false;
+
+    hit = origin + dir * t;
+    if(!_PlanarContains(&x[0], &y[0], n, hit[ax], hit[ay]))
+      return false;
+    if(t == 0)
+      return true;
+
+    normal = plane_normal;
+  }
+
+  if(_RayDot(normal, dir) > 0)
+    normal = -normal;
+  normal /= normal.mag();
+  return true;
+}
+
+// The packet loops handle the largest multiple of their width, and
+// return the number of elements they processed. Misses get t = -1,
+// and if normal is not null, each lane of it is filled in as the
+// scalar code would for a hit.
+
+#ifdef WFMATH_AVX_DISPATCH
+WFMATH_TARGET_AVX
+static size_t _RaycastBoxesAVX(const CoordType* const* o, const CoordType* const* d,
+                               const CoordType* low, const CoordType* high, int dim,
+                               size_t n, CoordType* t, CoordType* const* normal)
+{
+  const __m256 zero = _mm256_setzero_ps(), one = _mm256_set1_ps(1),
+               big = _mm256_set1_ps(std::numeric_limits<CoordType>::max()),
+               minus_big = _mm256_set1_ps(-std::numeric_limits<CoordType>::max());
+  size_t i = 0;
+
+  for(; i + 8 <= n; i += 8) {
+    __m256 enter = minus_big, exit = one, axis = _mm256_set1_ps(-1);
+    __m256 ok = _mm256_cmp_ps(zero, zero, _CMP_EQ_OQ);
+    for(int j = 0; j < dim; ++j) {
+      __m256 oj = _mm256_loadu_ps(o[j] + i), dj = _mm256_loadu_ps(d[j] + i);
+      __m256 lo = _mm256_set1_ps(low[j]), hi = _mm256_set1_ps(high[j]);
+      __m256 flat = _mm256_cmp_ps(dj, zero, _CMP_EQ_OQ);
+      __m256 outside = _mm256_or_ps(_mm256_cmp_ps(oj, lo, _CMP_LT_OQ),
+                                    _mm256_cmp_ps(oj, hi, _CMP_GT_OQ));
+      ok = _mm256_andnot_ps(_mm256_and_ps(flat, outside), ok);
+      __m256 t1 = _mm256_div_ps(_mm256_sub_ps(lo, oj), dj),
+             t2 = _mm256_div_ps(_mm256_sub_ps(hi, oj), dj);
+      __m256 tl = _Select8(flat, minus_big, _mm256_min_ps(t1, t2)),
+             th = _Select8(flat, big, _mm256_max_ps(t1, t2));
+      __m256 later = _mm256_cmp_ps(tl, enter, _CMP_GT_OQ);
+      enter = _Select8(later, tl, enter);
+      axis = _Select8(later, _mm256_set1_ps((CoordType) j), axis);
+      exit = _mm256_min_ps(exit, th);
+    }
+    __m256 hit = _mm256_and_ps(ok, _mm256_and_ps(_mm256_cmp_ps(enter, exit, _CMP_LE_OQ),
+                                                 _mm256_cmp_ps(exit, zero, _CMP_GE_OQ)));
+    __m256 inside = _mm256_cmp_ps(enter, zero, _CMP_LT_OQ);
+    __m256 ans = _mm256_andnot_ps(inside, enter);
+    _mm256_storeu_ps(t + i, _Select8(hit, ans, _mm256_set1_ps(-1)));
+    if(normal) {
+      axis = _Select8(inside, _mm256_set1_ps(-1), axis);
+      for(int j = 0; j < dim; ++j) {
+        __m256 dj = _mm256_loadu_ps(d[j] + i);
+        __m256 on_axis = _mm256_cmp_ps(axis, _mm256_set1_ps((CoordType) j), _CMP_EQ_OQ);
+        __m256 face = _Select8(_mm256_cmp_ps(dj, zero, _CMP_GT_OQ), _mm256_set1_ps(-1), one);
+        _mm256_storeu_ps(normal[j] + i, _mm256_and_ps(on_axis, face));
+      }
+    }
+  }
+  return i;
+}
+
+WFMATH_TARGET_AVX
+static size_t _RaycastBallsAVX(const CoordType* const* o, const CoordType* const* d,
+                               const CoordType* center, CoordType radius, int dim,
+                               size_t n, CoordType* t, CoordType* const* normal)
+{
+  const __m256 zero = _mm256_setzero_ps(), one = _mm256_set1_ps(1),
+               minus_zero = _mm256_set1_ps(-0.0f), rr = _mm256_set1_ps(radius * radius);
+  size_t i = 0;
+
+  for(; i + 8 <= n; i += 8) {
+    __m256 a = zero, half_b = zero, c = zero;
+    for(int j = 0; j < dim; ++j) {
+      __m256 dj = _mm256_loadu_ps(d[j] + i);
+      __m256 oc = _mm256_sub_ps(_mm256_loadu_ps(o[j] + i), _mm256_set1_ps(center[j]));
+      a = _mm256_add_ps(a, _mm256_mul_ps(dj, dj));
+      c = _mm256_add_ps(c, _mm256_mul_ps(oc, oc));
+      half_b = _mm256_add_ps(half_b, _mm256_mul_ps(oc, dj));
+    }
+    c = _mm256_sub_ps(c, rr);
+    __m256 disc = _mm256_sub_ps(_mm256_mul_ps(half_b, half_b), _mm256_mul_ps(a, c));
+    __m256 root = _mm256_div_ps(_mm256_sub_ps(_mm256_xor_ps(half_b, minus_zero),
+                                              _mm256_sqrt_ps(disc)), a);
+    __m256 inside = _mm256_cmp_ps(c, zero, _CMP_LE_OQ);
+    __m256 hit = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(a, zero, _CMP_GT_OQ),
+                                             _mm256_cmp_ps(disc, zero, _CMP_GE_OQ)),
+                               _mm256_and_ps(_mm256_cmp_ps(root, zero, _CMP_GE_OQ),
+                                             _mm256_cmp_ps(root, one, _CMP_LE_OQ)));
+    __m256 ans = _Select8(inside, zero, _Select8(hit, root, _mm256_set1_ps(-1)));
+    _mm256_storeu_ps(t + i, ans);
+    if(normal) {
+      // As in the scalar code, the offset of the hit from the center,
+      // or the reverse of the ray where that has no length
+      __m256 ll = zero;
+      for(int j = 0; j < dim; ++j) {
+        __m256 pj = _mm256_add_ps(_mm256_loadu_ps(o[j] + i),
+                                  _mm256_mul_ps(_mm256_loadu_ps(d[j] + i), ans));
+        __m256 nj = _mm256_sub_ps(pj, _mm256_set1_ps(center[j]));
+        ll = _mm256_add_ps(ll, _mm256_mul_ps(nj, nj));
+        _mm256_storeu_ps(normal[j] + i, nj);
+      }
+      __m256 len = _mm256_sqrt_ps(ll), dir_len = _mm256_sqrt_ps(a);
+      __m256 has_len = _mm256_cmp_ps(len, zero, _CMP_GT_OQ);
+      for(int j = 0; j < dim; ++j) {
+        __m256 nj = _Select8(has_len, _mm256_div_ps(_mm256_loadu_ps(normal[j] + i), len),
+                             _mm256_div_ps(_mm256_xor_ps(_mm256_loadu_ps(d[j] + i), minus_zero),
+                                           dir_len));
+        _mm256_storeu_ps(normal[j] + i, _mm256_andnot_ps(inside, nj));
+      }
+    }
+  }
+  return i;
+}
+#endif
+
+static size_t _RaycastBoxes(const CoordType* const* o, const CoordType* const* d,
+                            const CoordType* low, const CoordType* high, int dim,
+                            size_t n, CoordType* t, CoordType* const* normal)
+{
+  size_t i = 0;
+
+#ifdef WFMATH_AVX_DISPATCH
+  if(_CpuHasAVX())
+    i = _RaycastBoxesAVX(o, d, low, high, dim, n, t, normal);
+#endif
+#if defined(__SSE2__)
+  const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1),
+               big = _mm_set1_ps(std::numeric_limits<CoordType>::max()),
+               minus_big = _mm_set1_ps(-std::numeric_limits<CoordType>::max());
+
+  for(; i + 4 <= n; i += 4) {
+    __m128 enter = minus_big, exit = one, axis = _mm_set1_ps(-1);
+    __m128 ok = _mm_cmpeq_ps(zero, zero);
+    for(int j = 0; j < dim; ++j) {
+      __m128 oj = _mm_loadu_ps(o[j] + i), dj = _mm_loadu_ps(d[j] + i);
+      __m128 lo = _mm_set1_ps(low[j]), hi = _mm_set1_ps(high[j]);
+      __m128 flat = _mm_cmpeq_ps(dj, zero);
+      __m128 outside = _mm_or_ps(_mm_cmplt_ps(oj, lo), _mm_cmpgt_ps(oj, hi));
+      ok = _mm_andnot_ps(_mm_and_ps(flat, outside), ok);
+      __m128 t1 = _mm_div_ps(_mm_sub_ps(lo, oj), dj),
+             t2 = _mm_div_ps(_mm_sub_ps(hi, oj), dj);
+      __m128 tl = _Select4(flat, minus_big, _mm_min_ps(t1, t2)),
+             th = _Select4(flat, big, _mm_max_ps(t1, t2));
+      __m128 later = _mm_cmpgt_ps(tl, enter);
+      enter = _Select4(later, tl, enter);
+      axis = _Select4(later, _mm_set1_ps((CoordType) j), axis);
+      exit = _mm_min_ps(exit, th);
+    }
+    __m128 hit = _mm_and_ps(ok, _mm_and_ps(_mm_cmple_ps(enter, exit),
+                                           _mm_cmpge_ps(exit, zero)));
+    __m128 inside = _mm_cmplt_ps(enter, zero);
+    __m128 ans = _mm_andnot_ps(inside, enter);
+    _mm_storeu_ps(t + i, _Select4(hit, ans, _mm_set1_ps(-1)));
+    if(normal) {
+      axis = _Select4(inside, _mm_set1_ps(-1), axis);
+      for(int j = 0; j < dim; ++j) {
+        __m128 dj = _mm_loadu_ps(d[j] + i);
+        __m128 on_axis = _mm_cmpeq_ps(axis, _mm_set1_ps((CoordType) j));
+        __m128 face = _Select4(_mm_cmpgt_ps(dj, zero), _mm_set1_ps(-1), one);
+        _mm_storeu_ps(normal[j] + i, _mm_and_ps(on_axis, face));
+      }
+    }
+  }
+#endif
+
+  return i;
+}
+
+static size_t _RaycastBalls(const CoordType* const* o, const CoordType* const* d,
+                            const CoordType* center, CoordType radius, int dim,
+                            size_t n, CoordType* t, CoordType* const* normal)
+{
+  size_t i = 0;
+
+#ifdef WFMATH_AVX_DISPATCH
+  if(_CpuHasAVX())
+    i = _RaycastBallsAVX(o, d, center, radius, dim, n, t, normal);
+#endif
+#if defined(__SSE2__)
+  const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1),
+               minus_zero = _mm_set1_ps(-0.0f), rr = _mm_set1_ps(radius * radius);
+
+  for(; i + 4 <= n; i += 4) {
+    __m128 a = zero, half_b = zero, c = zero;
+    for(int j = 0; j < dim; ++j) {
+      __m128 dj = _mm_loadu_ps(d[j] + i);
+      __m128 oc = _mm_sub_ps(_mm_loadu_ps(o[j] + i), _mm_set1_ps(center[j]));
+      a = _mm_add_ps(a, _mm_mul_ps(dj, dj));
+      c = _mm_add_ps(c, _mm_mul_ps(oc, oc));
+      half_b = _mm_add_ps(half_b, _mm_mul_ps(oc, dj));
+    }
+    c = _mm_sub_ps(c, rr);
+    __m128 disc = _mm_sub_ps(_mm_mul_ps(half_b, half_b), _mm_mul_ps(a, c));
+    __m128 root = _mm_div_ps(_mm_sub_ps(_mm_xor_ps(half_b, minus_zero), _mm_sqrt_ps(disc)), a);
+    __m128 inside = _mm_cmple_ps(c, zero);
+    __m128 hit = _mm_and_ps(_mm_and_ps(_mm_cmpgt_ps(a, zero), _mm_cmpge_ps(disc, zero)),
+                            _mm_and_ps(_mm_cmpge_ps(root, zero), _mm_cmple_ps(root, one)));
+    __m128 ans = _Select4(inside, zero, _Select4(hit, root, _mm_set1_ps(-1)));
+    _mm_storeu_ps(t + i, ans);
+    if(normal) {
+      __m128 ll = zero;
+      for(int j = 0; j < dim; ++j) {
+        __m128 pj = _mm_add_ps(_mm_loadu_ps(o[j] + i),
+                               _mm_mul_ps(_mm_loadu_ps(d[j] + i), ans));
+        __m128 nj = _mm_sub_ps(pj, _mm_set1_ps(center[j]));
+        ll = _mm_add_ps(ll, _mm_mul_ps(nj, nj));
+        _mm_storeu_ps(normal[j] + i, nj);
+      }
+      __m128 len = _mm_sqrt_ps(ll), dir_len = _mm_sqrt_ps(a);
+      __m128 has_len = _mm_cmpgt_ps(len, zero);
+      for(int j = 0; j < dim; ++j) {
+        __m128 nj = _Select4(has_len, _mm_div_ps(_mm_loadu_ps(normal[j] + i), len),
+                             _mm_div_ps(_mm_xor_ps(_mm_loadu_ps(d[j] + i), minus_zero),
+                                        dir_len));
+        _mm_storeu_ps(normal[j] + i, _mm_andnot_ps(inside, nj));
+      }
+    }
+  }
+#endif
+
+  return i;
+}
+
+// Finish a packet cast with the scalar code, and fill in the
+// validity of the normals
+template<int dim, class Shape>
+static size_t _RaycastRemainder(const PointArray<dim>& origins,
+                                const VectorArray<dim>& dirs, const Shape& shape,
+                                size_t start, CoordType* t, VectorArray<dim>* normals)
+{
+  for(size_t i = start; i < origins.size(); ++i) {
+    Point<dim> hit;
+    Vector<dim> normal;
+    if(!_Raycast(origins.get(i), dirs.get(i), 1, shape, t[i], hit, normal))
+      t[i] = -1;
+    else if(normals)
+      normals->set(i, normal);
+  }
+
+  size_t hits = 0;
+  for(size_t i = 0; i < origins.size(); ++i) {
+    bool got = t[i] >= 0;
+    if(got)
+      ++hits;
+    if(normals)
+      normals->setValid(i, got);
+  }
+  return hits;
+}
+
+template<int dim>
+size_t Raycast(const PointArray<dim>& origins, const VectorArray<dim>& dirs,
+               const AxisBox<dim>& b, CoordType* t, VectorArray<dim>* normals)
+{
+  assert(origins.size() == dirs.size());
+
+  const CoordType* o[dim];
+  const CoordType* d[dim];
+  CoordType* n[dim];
+  if(normals)
+    normals->resize(origins.size());
+  for(int j = 0; j < dim; ++j) {
+    o[j] = origins.elements(j);
+    d[j] = dirs.elements(j);
+    n[j] = normals ? normals->elements(j) : 0;
+  }
+
+  size_t done = _RaycastBoxes(o, d, b.lowCorner().elements(), b.highCorner().elements(),
+                              dim, origins.size(), t, normals ? n : 0);
+  return _RaycastRemainder(origins, dirs, b, done, t, normals);
+}
+
+template<int dim>
+size_t Raycast(const PointArray<dim>& origins, const VectorArray<dim>& dirs,
+               const Ball<dim>& b, CoordType* t, VectorArray<dim>* normals)
+{
+  assert(origins.size() == dirs.size());
+
+  const CoordType* o[dim];
+  const CoordType* d[dim];
+  CoordType* n[dim];
+  if(normals)
+    normals->resize(origins.size());
+  for(int j = 0; j < dim; ++j) {
+    o[j] = origins.elements(j);
+    d[j] = dirs.elements(j);
+    n[j] = normals ? normals->elements(j) : 0;
+  }
+
+  size_t done = _RaycastBalls(o, d, b.center().elements(), b.radius(), dim,
+                              origins.size(), t, normals ? n : 0);
+  return _RaycastRemainder(origins, dirs, b, done, t, normals);
+}
+
+template bool _Raycast<3>(const Point<3>&, const Vector<3>&, CoordType,
+                          const Segment<3>&, CoordType&, Point<3>&, Vector<3>&);
+template bool _Raycast<2>(const Point<2>&, const Vector<2>&, CoordType,
+                          const Segment<2>&, CoordType&, Point<2>&, Vector<2>&);
+
+template size_t Raycast<3>(const PointArray<3>&, const VectorArray<3>&,
+                           const AxisBox<3>&, CoordType*, VectorArray<3>*);
+template size_t Raycast<2>(const PointArray<2>&, const VectorArray<2>&,
+                           const AxisBox<2>&, CoordType*, VectorArray<2>*);
+template size_t Raycast<3>(const PointArray<3>&, const VectorArray<3>&,
+                           const Ball<3>&, CoordType*, VectorArray<3>*);
+template size_t Raycast<2>(const PointArray<2>&, const VectorArray<2>&,
+                           const Ball<2>&, CoordType*, VectorArray<2>*);
+
+} // namespace WFMath
@@ -0,0 +1,250 @@
+// raycast.h (Ray and segment casts against shapes)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifndef WFMATH_RAYCAST_H
+#define WFMATH_RAYCAST_H
+
+#include <wfmath/const.h>
+#include <wfmath/vector.h>
+#include <wfmath/point.h>
+#include <wfmath/rotmatrix.h>
+#include <wfmath/axisbox.h>
+#include <wfmath/ball.h>
+#include <wfmath/segment.h>
+#include <wfmath/rotbox.h>
+#include <wfmath/polygon.h>
+#include <wfmath/point_array.h>
+
+#include <limits>
+#include <algorithm>
+
+#include <cmath>
+
+namespace WFMath {
+
+// The functions below cast the ray origin + t * dir, for t from 0 to
+// max_t, and return true if it hits the shape. On a hit, t is the
+// first parameter in the shape, hit is the point there and normal is
+// the unit outward normal of the surface. A ray which starts inside
+// the shape hits it at t = 0, with a zero normal.
+
+template<int dim>
+bool _Raycast(const Point<dim>& origin, const Vector<dim>& dir, CoordType max_t,
+              const AxisBox<dim>& b, CoordType& t, Point<dim>& hit,
+              Vector<dim>& normal)
+{
+  // Clip the parameter range against the slab of each axis, and
+  // remember which slab was entered last
+  CoordType enter = -std::numeric_limits<CoordType>::max(), exit = max_t;
+  int axis = -1;
+
+  for(int i = 0; i < dim; ++i) {
+    if(dir[i] == 0) {
+      if(origin[i] < b.lowCorner()[i] || origin[i] > b.highCorner()[i])
+        return false;
+      continue;
+    }
+    CoordType low = (b.lowCorner()[i] - origin[i]) / dir[i],
+              high = (b.highCorner()[i] - origin[i]) / dir[i];
+    if(low > high)
+      std::swap(low, high);
+    if(low > enter) {
+      enter = low;
+      axis = i;
+    }
+    if(high < exit)
+      exit = high;
+  }
+
+  if(enter > exit || exit < 0)
+    return false;
+
+  normal.zero();
+  if(enter < 0 || axis < 0)
+    t = 0;
+  else {
+    t = enter;
+    normal[axis] = (dir[axis] > 0) ? -1 : 1;
+  }
+  hit = origin + dir * t;
+  return true;
+}
+
+template<int dim>
+bool _Raycast(const Point<dim>& origin, const Vector<dim>& dir, CoordType max_t,
+              const Ball<dim>& b, CoordType& t, Point<dim>& hit,
+              Vector<dim>& normal)
+{
+  // Solve |origin + t * dir - center|^2 = radius^2 for the smaller root
+  Vector<dim> offset = origin - b.center();
+  CoordType a = dir.sqrMag(), c = offset.sqrMag() - b.radius() * b.radius();
+
+  if(c <= 0) {
+    t = 0;
+    hit = origin;
+    normal.zero();
+    return true;
+  }
+  if(!(a > 0))
+    return false;
+
+  CoordType half_b = 0;
+  for(int i = 0; i < dim; ++i)
+    half_b += offset[i] * dir[i];
+  CoordType disc = half_b * half_b - a * c;
+  if(disc < 0)
+    return false;
+
+  // Both roots have the sign of -half_b, since c > 0
+  t = (-half_b - std::sqrt(disc)) / a;
+  if(t < 0 || t > max_t)
+    return false;
+
+  hit = origin + dir * t;
+  // A ray can only hit a ball of zero radius at its center, where there
+  // is no direction to go out along, so face the ray instead
+  normal = hit - b.center();
+  CoordType len = normal.mag();
+  if(len > 0)
+    normal /= len;
+  else
+    normal = -dir / std::sqrt(a);
+  return true;
+}
+
+template<int dim>
+bool _Raycast(const Point<dim>& origin, const Vector<dim>& dir, CoordType max_t,
+              const RotBox<dim>& r, CoordType& t, Point<dim>& hit,
+              Vector<dim>& normal)
+{
+  // Cast in the frame of the box, where it is an AxisBox
+  Point<dim> zero;
+  zero.setToOrigin();
+  Point<dim> local_origin = zero + Prod(r.orientation(), origin - r.corner0());
+  Vector<dim> local_dir = Prod(r.orientation(), dir), local_normal;
+  Point<dim> local_hit;
+
+  if(!_Raycast(local_origin, local_dir, max_t, AxisBox<dim>(zero, zero + r.size()),
+               t, local_hit, local_normal))
+    return false;
+
+  hit = origin + dir * t;
+  normal = Prod(local_normal, r.orientation());
+  return true;
+}
+
+/// Cast a ray against a segment, which in 3D must pass through it
+/**
+ * The normal is perpendicular to the segment, facing the ray. If the
+ * ray runs along the segment, it faces back along the ray instead.
+ **/
+template<int dim>
+bool _Raycast(const Point<dim>& origin, const Vector<dim>& dir, CoordType max_t,
+              const Segment<dim>& s, CoordType& t, Point<dim>& hit,
+              Vector<dim>& normal);
+
+/// Cast a ray against a polygon
+/**
+ * In 2D the polygon is filled, and the normal is that of the edge the
+ * ray enters through. In 3D the normal is that of the plane of the
+ * polygon, facing the ray. The inside is found with the even-odd
+ * rule, like Intersect().
+ **/
+template<int dim>
+bool _Raycast(const Point<dim>& origin, const Vector<dim>& dir, CoordType max_t,
+              const Polygon<dim>& p, CoordType& t, Point<dim>& hit,
+              Vector<dim>& normal);
+
+template<>
+bool _Raycast<2>(const Point<2>& origin, const Vector<2>& dir, CoordType max_t,
+                 const Polygon<2>& p, CoordType& t, Point<2>& hit,
+                 Vector<2>& normal);
+template<>
+bool _Raycast<3>(const Point<3>& origin, const Vector<3>& dir, CoordType max_t,
+                 const Polygon<3>& p, CoordType& t, Point<3>& hit,
+                 Vector<3>& normal);
+
+/// Cast a segment against a shape
+/**
+ * This returns true if the segment hits the shape. In that case, t is
+ * set to the first point of the segment in the shape, as a parameter
+ * which is 0 at s.endpoint(0) and 1 at s.endpoint(1), hit is set to
+ * that point, and normal is set to the unit outward normal of the
+ * surface there. A segment which starts inside the shape hits it at
+ * t = 0, with a zero normal.
+ *
+ * The shape may be an AxisBox, Ball, RotBox, Segment or Polygon.
+ * Boundaries count as part of the shape, as for Intersect() with
+ * proper set to false.
+ **/
+template<int dim, template<int> class Shape>
+inline bool Raycast(const Segment<dim>& s, const Shape<dim>& shape, CoordType& t,
+                    Point<dim>& hit, Vector<dim>& normal)
+{
+  return _Raycast(s.endpoint(0), s.endpoint(1) - s.endpoint(0), 1, shape,
+                  t, hit, normal);
+}
+
+/// Cast an unbounded ray against a shape
+/**
+ * This is the same as Raycast() for a segment, for the points
+ * origin + t * dir with t >= 0.
+ **/
+template<int dim, template<int> class Shape>
+inline bool Raycast(const Point<dim>& origin, const Vector<dim>& dir,
+                    const Shape<dim>& shape, CoordType& t, Point<dim>& hit,
+                    Vector<dim>& normal)
+{
+  return _Raycast(origin, dir, std::numeric_limits<CoordType>::max(), shape,
+                  t, hit, normal);
+}
+
+/// Cast many segments against an AxisBox at once
+/**
+ * Segment i runs from origins[i] to origins[i] + dirs[i], and the two
+ * arrays must have the same size. For each segment which hits the box,
+ * t[i] is set to the same parameter Raycast() would give, and for
+ * each which misses it is set to -1. If normals is not null, it is
+ * resized to match, and holds the normal of each hit, or an invalid
+ * vector for a miss. Returns the number of hits.
+ *
+ * The segments are cast eight at a time with AVX where the processor
+ * supports it, four at a time with SSE2 otherwise, and the remainder
+ * one at a time.
+ **/
+template<int dim>
+size_t Raycast(const PointArray<dim>& origins, const VectorArray<dim>& dirs,
+               const AxisBox<dim>& b, CoordType* t, VectorArray<dim>* normals = 0);
+
+/// Cast many segments against a Ball at once
+/**
+ * This works like Raycast() for an AxisBox and many segments.
+ **/
+template<int dim>
+size_t Raycast(const PointArray<dim>& origins, const VectorArray<dim>& dirs,
+               const Ball<dim>& b, CoordType* t, VectorArray<dim>* normals = 0);
+
+} // namespace WFMath
+
+#endif  // WFMATH_RAYCAST_H
@@ -0,0 +1,420 @@
+// raycast_test.cpp (Ray and segment cast test functions)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#ifndef DEBUG
+#define DEBUG
+#endif
+
+#include "const.h"
+#include "vector.h"
+#include "point.h"
+#include "rotmatrix.h"
+#include "axisbox.h"
+#include "ball.h"
+#include "segment.h"
+#include "rotbox.h"
+#include "polygon.h"
+#include "intersect.h"
+#include "polygon_intersect.h"
+#include "point_array.h"
+#include "raycast.h"
+#include "randgen.h"
+
+#include <iostream>
+#include <vector>
+
+#include <cassert>
+#include <cmath>
+
+using namespace WFMath;
+
+static const CoordType tolerance = 1e-3f;
+
+static CoordType random_coord(MTRand& rand, CoordType low, CoordType high)
+{
+  return low + (high - low) * (CoordType) rand.rand();
+}
+
+template<int dim>
+static Point<dim> random_point(MTRand& rand)
+{
+  Point<dim> p;
+  p.setToOrigin();
+  for(int i = 0; i < dim; ++i)
+    p[i] = random_coord(rand, -3, 3);
+  return p;
+}
+
+template<int dim>
+static Vector<dim> random_size(MTRand& rand)
+{
+  Vector<dim> v;
+  for(int i = 0; i < dim; ++i)
+    v[i] = random_coord(rand, 0.2f, 2);
+  v.setValid();
+  return v;
+}
+
+static RotMatrix<2> random_rotation(MTRand& rand, const RotMatrix<2>&)
+{
+  RotMatrix<2> m;
+  return m.rotation(random_coord(rand, -3, 3));
+}
+
+static RotMatrix<3> random_rotation(MTRand& rand, const RotMatrix<3>&)
+{
+  RotMatrix<3> m;
+  Vector<3> axis(random_coord(rand, -1, 1), 1, random_coord(rand, -1, 1));
+  return m.rotation(axis, random_coord(rand, -3, 3));
+}
+
+template<int dim>
+static Polygon<dim> random_polygon(MTRand& rand);
+
+template<>
+Polygon<2> random_polygon<2>(MTRand& rand)
+{
+  // A star shape, which is usually not convex
+  Point<2> center = random_point<2>(rand);
+  Polygon<2> p;
+  for(int i = 0; i < 7; ++i) {
+    CoordType angle = i * 2 * numeric_constants<CoordType>::pi() / 7,
+              r = random_coord(rand, 0.3f, 2);
+    p.addCorner(i, center + Vector<2>(r * std::cos(angle), r * std::sin(angle)));
+  }
+  return p;
+}
+
+template<>
+Polygon<3> random_polygon<3>(MTRand& rand)
+{
+  Polygon<2> flat = random_polygon<2>(rand);
+  RotMatrix<3> m = random_rotation(rand, RotMatrix<3>());
+  Point<3> origin = random_point<3>(rand);
+  Polygon<3> p;
+  for(size_t i = 0; i < flat.numCorners(); ++i) {
+    bool added = p.addCorner(i, origin + Prod(Vector<3>(flat[i][0], flat[i][1], 0), m),
+                             tolerance);
+    assert(added);
+  }
+  return p;
+}
+
+// Check a cast against Intersect()
+template<int dim, template<int> class Shape>
+static bool check_cast(const Segment<dim>& s, const Shape<dim>& shape)
+{
+  CoordType t;
+  Point<dim> hit;
+  Vector<dim> normal;
+  Vector<dim> dir = s.endpoint(1) - s.endpoint(0);
+
+  if(!Raycast(s, shape, t, hit, normal)) {
+    assert(!Intersect(s, shape, true));
+    return false;
+  }
+
+  assert(t >= 0 && t <= 1);
+  assert(hit == s.endpoint(0) + dir * t);
+  assert(Intersect(Ball<dim>(hit, tolerance), shape, false));
+
+  if(t == 0) {
+    assert(normal.sqrMag() == 0);
+    return true;
+  }
+
+  assert(std::fabs(normal.mag() - 1) < tolerance);
+  assert(Dot(normal, dir) <= tolerance);
+
+  // Nothing is hit before t
+  if(t > 0.01f)
+    assert(!Intersect(Segment<dim>(s.endpoint(0), s.endpoint(0) + dir * (t - 0.01f)),
+                      shape, false));
+
+  // The unbounded ray gives the same answer
+  CoordType ray_t;
+  Point<dim> ray_hit;
+  Vector<dim> ray_normal;
+  assert(Raycast(s.endpoint(0), dir, shape, ray_t, ray_hit, ray_normal));
+  assert(std::fabs(ray_t - t) < tolerance);
+
+  return true;
+}
+
+template<int dim>
+static void test_exact()
+{
+  std::cout << "Testing " << dim << "D casts" << std::endl;
+
+  Point<dim> origin;
+  origin.setToOrigin();
+  Vector<dim> x, y, ones;
+  x.zero();
+  y.zero();
+  x[0] = 1;
+  y[1] = 1;
+  ones.zero();
+  for(int i = 0; i < dim; ++i)
+    ones[i] = 1;
+
+  CoordType t;
+  Point<dim> hit;
+  Vector<dim> normal;
+
+  // Through the middle of a unit box, along x
+  AxisBox<dim> box(origin, origin + ones);
+  Point<dim> start = origin + ones * 0.5f;
+  start[0] = -1.5f;
+  assert(Raycast(Segment<dim>(start, start + x * 3), box, t, hit, normal));
+  assert(Equal(t, 0.5f));
+  assert(normal == -x);
+  assert(!Raycast(Segment<dim>(start, start + x * 0.5f), box, t, hit, normal));
+  assert(Raycast(start, x, box, t, hit, normal));
+  assert(Equal(t, 1.5f));
+  assert(!Raycast(start, -x, box, t, hit, normal));
+
+  // From inside
+  assert(Raycast(Segment<dim>(origin + ones * 0.5f, origin + x * 5), box, t, hit, normal));
+  assert(t == 0 && normal.sqrMag() == 0);
+
+  // A ball at the origin
+  Ball<dim> ball(origin, 1);
+  start = origin - x * 2;
+  assert(Raycast(Segment<dim>(start, origin + x * 2), ball, t, hit, normal));
+  assert(Equal(t, 0.25f));
+  assert(normal == -x);
+  assert(!Raycast(Segment<dim>(start + y * 1.5f, origin + x * 2 + y * 1.5f),
+                  ball, t, hit, normal));
+  assert(!Raycast(start, -x, ball, t, hit, normal));
+
+  // A ball of zero radius is only hit through its center, and faces the
+  // ray. Comparing vectors lets NaN through, so check the length too.
+  Ball<dim> dot(origin, 0);
+  assert(Raycast(Segment<dim>(start, origin + x * 2), dot, t, hit, normal));
+  assert(t == 0.5f && hit == origin && normal.sqrMag() == 1 && normal == -x);
+  assert(!Raycast(Segment<dim>(start + y, origin + x * 2 + y), dot, t, hit, normal));
+
+  // And the same in a packet, long enough to use every loop
+  PointArray<dim> origins;
+  VectorArray<dim> dirs;
+  for(size_t i = 0; i < 13; ++i) {
+    const Vector<dim>& axis = (i % 2) ? x : y;
+    origins.push_back(origin - axis * (CoordType) (i + 1));
+    dirs.push_back(axis * (CoordType) (2 * (i + 1)));
+  }
+  std::vector<CoordType> ts(origins.size());
+  VectorArray<dim> normals;
+  assert(Raycast(origins, dirs, dot, &ts[0], &normals) == origins.size());
+  for(size_t i = 0; i < origins.size(); ++i)
+    assert(ts[i] == 0.5f && normals.isValid(i) && normals.get(i).sqrMag() == 1
+           && normals.get(i) == ((i % 2) ? -x : -y));
+
+  // A rotated box, the same unit box turned about the origin
+  RotMatrix<dim> m;
+  m.identity();
+  RotBox<dim> rbox(origin, ones, m);
+  start = origin + ones * 0.5f;
+  start[0] = -1.5f;
+  assert(Raycast(Segment<dim>(start, start + x * 3), rbox, t, hit, normal));
+  assert(Equal(t, 0.5f));
+  assert(normal == -x);
+  m.rotation(0, 1, numeric_constants<CoordType>::pi() / 2);
+  rbox = RotBox<dim>(origin, ones, m);
+  start = rbox.getCenter() - x * 2;
+  assert(Raycast(Segment<dim>(start, start + x * 4), rbox, t, hit, normal));
+  assert(Equal(t, 0.375f));
+  assert(normal == -x);
+
+  // A segment across the path
+  Segment<dim> wall(origin - y, origin + y);
+  assert(Raycast(Segment<dim>(origin - x, origin + x), wall, t, hit, normal));
+  assert(Equal(t, 0.5f));
+  assert(normal == -x);
+  // Along the segment
+  assert(Raycast(Segment<dim>(origin - y * 3, origin + y * 3), wall, t, hit, normal));
+  assert(Equal(t, 1 / (CoordType) 3));
+  assert(normal == -y);
+  assert(!Raycast(Segment<dim>(origin + x - y, origin + x + y), wall, t, hit, normal));
+}
+
+static void test_polygons()
+{
+  std::cout << "Testing polygon casts" << std::endl;
+
+  // An L shape
+  Polygon<2> l;
+  l.addCorner(0, Point<2>(0, 0));
+  l.addCorner(1, Point<2>(3, 0));
+  l.addCorner(2, Point<2>(3, 1));
+  l.addCorner(3, Point<2>(1, 1));
+  l.addCorner(4, Point<2>(1, 3));
+  l.addCorner(5, Point<2>(0, 3));
+
+  CoordType t;
+  Point<2> hit;
+  Vector<2> normal;
+
+  // Across the notch
+  assert(Raycast(Segment<2>(Point<2>(2, 2), Point<2>(-1, 2)), l, t, hit, normal));
+  assert(Equal(t, 1 / (CoordType) 3));
+  assert(normal == Vector<2>(1, 0));
+  assert(Raycast(Segment<2>(Point<2>(2, 2), Point<2>(2, -1)), l, t, hit, normal));
+  assert(Equal(t, 1 / (CoordType) 3));
+  assert(normal == Vector<2>(0, 1));
+  assert(!Raycast(Segment<2>(Point<2>(2, 2), Point<2>(4, 4)), l, t, hit, normal));
+  assert(Raycast(Segment<2>(Point<2>(0.5f, 0.5f), Point<2>(9, 9)), l, t, hit, normal));
+  assert(t == 0);
+
+  // A square in the plane z = 1
+  Polygon<3> square;
+  square.addCorner(0, Point<3>(0, 0, 1));
+  square.addCorner(1, Point<3>(1, 0, 1));
+  square.addCorner(2, Point<3>(1, 1, 1));
+  square.addCorner(3, Point<3>(0, 1, 1));
+
+  Point<3> hit3;
+  Vector<3> normal3;
+  assert(Raycast(Segment<3>(Point<3>(0.5f, 0.5f, 0), Point<3>(0.5f, 0.5f, 2)),
+                 square, t, hit3, normal3));
+  assert(Equal(t, 0.5f));
+  assert(normal3 == Vector<3>(0, 0, -1));
+  assert(Raycast(Segment<3>(Point<3>(0.5f, 0.5f, 3), Point<3>(0.5f, 0.5f, -1)),
+                 square, t, hit3, normal3));
+  assert(Equal(t, 0.5f));
+  assert(normal3 == Vector<3>(0, 0, 1));
+  assert(!Raycast(Segment<3>(Point<3>(1.5f, 0.5f, 0), Point<3>(1.5f, 0.5f, 2)),
+                  square, t, hit3, normal3));
+  // In the plane
+  assert(Raycast(Segment<3>(Point<3>(-1, 0.5f, 1), Point<3>(3, 0.5f, 1)),
+                 square, t, hit3, normal3));
+  assert(Equal(t, 0.25f));
+  assert(normal3 == Vector<3>(-1, 0, 0));
+}
+
+template<int dim>
+static void test_random(MTRand& rand)
+{
+  std::cout << "Testing random " << dim << "D casts" << std::endl;
+
+  int hits = 0;
+  for(int i = 0; i < 500; ++i) {
+    Point<dim> p = random_point<dim>(rand);
+    Segment<dim> s(p, p + (random_point<dim>(rand) - p) * 2);
+
+    Point<dim> low = random_point<dim>(rand);
+    hits += check_cast(s, AxisBox<dim>(low, low + random_size<dim>(rand)));
+    hits += check_cast(s, Ball<dim>(random_point<dim>(rand), random_coord(rand, 0.1f, 1.5f)));
+    hits += check_cast(s, RotBox<dim>(random_point<dim>(rand), random_size<dim>(rand),
+                                      random_rotation(rand, RotMatrix<dim>())));
+    // In 3D, random segments only touch within the tolerance of Intersect()
+    if(dim == 2)
+      hits += check_cast(s, Segment<dim>(random_point<dim>(rand), random_point<dim>(rand)));
+    hits += check_cast(s, random_polygon<dim>(rand));
+  }
+  assert(hits > 50);
+}
+
+// The packet casts give the same answers as casting each segment alone
+template<int dim, template<int> class Shape>
+static void check_packet(MTRand& rand, const Shape<dim>& shape, size_t n)
+{
+  PointArray<dim> origins;
+  VectorArray<dim> dirs;
+  for(size_t i = 0; i < n; ++i) {
+    origins.push_back(random_point<dim>(rand));
+    Vector<dim> dir = random_point<dim>(rand) - origins.get(i);
+    // Some axis aligned segments, which only cross some of the slabs
+    if(rand.rand() < 0.2)
+      dir[rand.randInt(dim - 1)] = 0;
+    dirs.push_back(dir * 2);
+  }
+
+  std::vector<CoordType> t(n + 1);
+  VectorArray<dim> normals;
+  size_t hits = Raycast(origins, dirs, shape, &t[0], &normals);
+  assert(normals.size() == n);
+
+  size_t expected = 0;
+  for(size_t i = 0; i < n; ++i) {
+    CoordType ti;
+    Point<dim> hit;
+    Vector<dim> normal;
+    bool got = Raycast(Segment<dim>(origins.get(i), origins.get(i) + dirs.get(i)),
+                       shape, ti, hit, normal);
+    assert(got == (t[i] >= 0));
+    assert(got == normals.isValid(i));
+    if(!got) {
+      assert(t[i] == -1);
+      continue;
+    }
+    ++expected;
+    assert(std::fabs(ti - t[i]) < tolerance);
+    Vector<dim> packet_normal = normals.get(i);
+    for(int j = 0; j < dim; ++j)
+      assert(std::fabs(normal[j] - packet_normal[j]) < tolerance);
+  }
+  assert(hits == expected);
+
+  // The normals are optional
+  std::vector<CoordType> t2(n + 1);
+  assert(Raycast(origins, dirs, shape, &t2[0]) == hits);
+  for(size_t i = 0; i < n; ++i)
+    assert(t[i] == t2[i]);
+}
+
+template<int dim>
+static void test_packets(MTRand& rand)
+{
+  std::cout << "Testing " << dim << "D packet casts" << std::endl;
+
+  // Sizes which leave each possible remainder after 8 and 4 wide loops
+  for(size_t n = 0; n < 20; ++n) {
+    Point<dim> low = random_point<dim>(rand);
+    check_packet(rand, AxisBox<dim>(low, low + random_size<dim>(rand) * 2), n);
+    check_packet(rand, Ball<dim>(random_point<dim>(rand), random_coord(rand, 0.5f, 2)), n);
+  }
+  for(int i = 0; i < 20; ++i) {
+    Point<dim> low = random_point<dim>(rand);
+    check_packet(rand, AxisBox<dim>(low, low + random_size<dim>(rand) * 2), 101);
+    check_packet(rand, Ball<dim>(random_point<dim>(rand), random_coord(rand, 0.5f, 2)), 101);
+  }
+}
+
+int main()
+{
+  MTRand rand(15);
+
+  test_exact<2>();
+  test_exact<3>();
+  test_polygons();
+  test_random<2>(rand);
+  test_random<3>(rand);
+  test_packets<2>(rand);
+  test_packets<3>(rand);
+
+  return 0;
+}
@@ -0,0 +1,431 @@
+// reduce.cpp (BoundingBox() and Barycenter() over arrays)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-17
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "vector.h"
+#include "point.h"
+#include "axisbox.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <vector>
+#include <cmath>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// The loops here read the coordinates of each Point straight from
+// memory, at p.elements(), so that the same loops work for the corners
+// of AxisBoxes, stride Points apart. A Point<3> is four CoordTypes
+// long, the last holding its validity flag, so the SSE2 loops load a
+// whole point at a time. They AND the last lanes together as integers,
+// and the lowest byte of the result is a bool which is true if all the
+// flags were. A Point<2> is three long, so they load two points into
+// one register, two CoordTypes from each, and check the flags one at a
+// time.
+
+namespace WFMath {
+
+// Below this many points a slice costs more to start than it saves
+static const size_t _min_points_per_thread = 1 << 18;
+
+// The low and high corners of the bounding box of some elements, and
+// whether they're all valid. For points, the corners are the same.
+template<int dim>
+struct _Bounds
+{
+  CoordType low[dim], high[dim];
+  bool low_valid, high_valid;
+};
+
+// The sums of some points, each times its weight if there are any, and
+// of the weights, and the largest absolute weight, and whether all the
+// points are valid
+template<int dim>
+struct _Sums
+{
+  double sum[dim];
+  double weight, max_weight;
+  bool valid;
+};
+
+// Fold the n elements with corners at lo and hi into b. Returns the
+// number of elements handled, the rest being left to the scalar loop.
+template<int dim>
+static size_t _MinMaxSSE2(const Point<dim>*, const Point<dim>*, size_t, size_t, _Bounds<dim>&)
+{
+  return 0;
+}
+
+// Add the n points at p, each times the weight at w if w isn't null,
+// to s. Returns the number of points handled.
+template<int dim>
+static size_t _SumSSE2(const Point<dim>*, const CoordType*, size_t, _Sums<dim>&)
+{
+  return 0;
+}
+
+#if defined(__SSE2__)
+static_assert(sizeof(Point<3>) == 4 * sizeof(CoordType) && sizeof(CoordType) == sizeof(float),
+              "A Point<3> is four floats long");
+static_assert(sizeof(Point<2>) == 3 * sizeof(CoordType), "A Point<2> is three floats long");
+
+static inline bool _ValidLane(__m128i flags)
+{
+  return (_mm_cvtsi128_si32(_mm_shuffle_epi32(flags, 3)) & 0xff) != 0;
+}
+
+template<>
+size_t _MinMaxSSE2<3>(const Point<3>* lo_p, const Point<3>* hi_p, size_t stride, size_t n,
+                      _Bounds<3>& b)
+{
+  const CoordType* lo = lo_p->elements();
+  const CoordType* hi = hi_p->elements();
+  stride *= 4;
+
+  // Two sets of accumulators, so the loads don't wait on each other
+  __m128 l0 = _mm_loadu_ps(lo), h0 = _mm_loadu_ps(hi), l1 = l0, h1 = h0;
+  __m128i lv = _mm_set1_epi32(-1), hv = lv;
+  size_t i = 0;
+
+  for(; i + 2 <= n; i += 2) {
+    __m128 a0 = _mm_loadu_ps(lo + i * stride), a1 = _mm_loadu_ps(lo + (i + 1) * stride);
+    __m128 b0 = _mm_loadu_ps(hi + i * stride), b1 = _mm_loadu_ps(hi + (i + 1) * stride);
+    l0 = _mm_min_ps(l0, a0);
+    l1 = _mm_min_ps(l1, a1);
+    h0 = _mm_max_ps(h0, b0);
+    h1 = _mm_max_ps(h1, b1);
+    lv = _mm_and_si128(lv, _mm_and_si128(_mm_castps_si128(a0), _mm_castps_si128(a1)));
+    hv = _mm_and_si128(hv, _mm_and_si128(_mm_castps_si128(b0), _mm_castps_si128(b1)));
+  }
+
+  CoordType l[4], h[4];
+  _mm_storeu_ps(l, _mm_min_ps(l0, l1));
+  _mm_storeu_ps(h, _mm_max_ps(h0, h1));
+  for(int j = 0; j < 3; ++j) {
+    b.low[j] = FloatMin(b.low[j], l[j]);
+    b.high[j] = FloatMax(b.high[j], h[j]);
+  }
+  b.low_valid = b.low_valid && _ValidLane(lv);
+  b.high_valid = b.high_valid && _ValidLane(hv);
+
+  return i;
+}
+
+template<>
+size_t _MinMaxSSE2<2>(const Point<2>* lo_p, const Point<2>* hi_p, size_t stride, size_t n,
+                      _Bounds<2>& b)
+{
+  const CoordType* lo = lo_p->elements();
+  const CoordType* hi = hi_p->elements();
+  size_t c_stride = stride * 3;
+
+  __m128 zero = _mm_setzero_ps();
+  __m128 l = _mm_loadl_pi(zero, (const __m64*) lo), h = _mm_loadl_pi(zero, (const __m64*) hi);
+  l = _mm_movelh_ps(l, l);
+  h = _mm_movelh_ps(h, h);
+  bool low_valid = true, high_valid = true;
+  size_t i = 0;
+
+  for(; i + 2 <= n; i += 2) {
+    __m128 a = _mm_loadh_pi(_mm_loadl_pi(zero, (const __m64*) (lo + i * c_stride)),
+                            (const __m64*) (lo + (i + 1) * c_stride));
+    __m128 c = _mm_loadh_pi(_mm_loadl_pi(zero, (const __m64*) (hi + i * c_stride)),
+                            (const __m64*) (hi + (i + 1) * c_stride));
+    l = _mm_min_ps(l, a);
+    h = _mm_max_ps(h, c);
+    low_valid &= lo_p[i * stride].isValid() & lo_p[(i + 1) * stride].isValid();
+    high_valid &= hi_p[i * stride].isValid() & hi_p[(i + 1) * stride].isValid();
+  }
+
+  CoordType lv[4], hv[4];
+  _mm_storeu_ps(lv, l);
+  _mm_storeu_ps(hv, h);
+  for(int j = 0; j < 2; ++j) {
+    b.low[j] = FloatMin(b.low[j], FloatMin(lv[j], lv[j + 2]));
+    b.high[j] = FloatMax(b.high[j], FloatMax(hv[j], hv[j + 2]));
+  }
+  b.low_valid = b.low_valid && low_valid;
+  b.high_valid = b.high_valid && high_valid;
+
+  return i;
+}
+
+template<>
+size_t _SumSSE2<3>(const Point<3>* p_p, const CoordType* w, size_t n, _Sums<3>& s)
+{
+  const CoordType* p = p_p->elements();
+
+  // Clear the lane holding the validity flag before converting, since
+  // its bits may be a denormal or a NaN
+  const __m128 mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+  __m128d xy0 = _mm_setzero_pd(), z0 = xy0, xy1 = xy0, z1 = xy0, tot = xy0;
+  __m128i valid = _mm_set1_epi32(-1);
+  size_t i = 0;
+
+  for(; i + 2 <= n; i += 2) {
+    __m128 v0 = _mm_loadu_ps(p + i * 4), v1 = _mm_loadu_ps(p + (i + 1) * 4);
+    valid = _mm_and_si128(valid, _mm_and_si128(_mm_castps_si128(v0), _mm_castps_si128(v1)));
+    v0 = _mm_and_ps(v0, mask);
+    v1 = _mm_and_ps(v1, mask);
+    __m128d a0 = _mm_cvtps_pd(v0), b0 = _mm_cvtps_pd(_mm_movehl_ps(v0, v0));
+    __m128d a1 = _mm_cvtps_pd(v1), b1 = _mm_cvtps_pd(_mm_movehl_ps(v1, v1));
+    if(w) {
+      __m128d w0 = _mm_set1_pd(w[i]), w1 = _mm_set1_pd(w[i + 1]);
+      a0 = _mm_mul_pd(a0, w0);
+      b0 = _mm_mul_pd(b0, w0);
+      a1 = _mm_mul_pd(a1, w1);
+      b1 = _mm_mul_pd(b1, w1);
+      tot = _mm_add_sd(tot, _mm_add_sd(w0, w1));
+    }
+    xy0 = _mm_add_pd(xy0, a0);
+    z0 = _mm_add_pd(z0, b0);
+    xy1 = _mm_add_pd(xy1, a1);
+    z1 = _mm_add_pd(z1, b1);
+  }
+
+  double sum[4];
+  _mm_storeu_pd(sum, _mm_add_pd(xy0, xy1));
+  _mm_storeu_pd(sum + 2, _mm_add_pd(z0, z1));
+  for(int j = 0; j < 3; ++j)
+    s.sum[j] += sum[j];
+  s.weight += _mm_cvtsd_f64(tot);
+  s.valid = s.valid && _ValidLane(valid);
+
+  return i;
+}
+
+template<>
+size_t _SumSSE2<2>(const Point<2>* p_p, const CoordType* w, size_t n, _Sums<2>& s)
+{
+  const CoordType* p = p_p->elements();
+
+  __m128 zero = _mm_setzero_ps();
+  __m128d xy0 = _mm_setzero_pd(), xy1 = xy0, tot = xy0;
+  bool valid = true;
+  size_t i = 0;
+
+  for(; i + 2 <= n; i += 2) {
+    __m128 v = _mm_loadh_pi(_mm_loadl_pi(zero, (const __m64*) (p + i * 3)),
+                            (const __m64*) (p + (i + 1) * 3));
+    __m128d a0 = _mm_cvtps_pd(v), a1 = _mm_cvtps_pd(_mm_movehl_ps(v, v));
+    if(w) {
+      __m128d w0 = _mm_set1_pd(w[i]), w1 = _mm_set1_pd(w[i + 1]);
+      a0 = _mm_mul_pd(a0, w0);
+      a1 = _mm_mul_pd(a1, w1);
+      tot = _mm_add_sd(tot, _mm_add_sd(w0, w1));
+    }
+    xy0 = _mm_add_pd(xy0, a0);
+    xy1 = _mm_add_pd(xy1, a1);
+    valid &= p_p[i].isValid() & p_p[i + 1].isValid();
+  }
+
+  double sum[2];
+  _mm_storeu_pd(sum, _mm_add_pd(xy0, xy1));
+  s.sum[0] += sum[0];
+  s.sum[1] += sum[1];
+  s.weight += _mm_cvtsd_f64(tot);
+  s.valid = s.valid && valid;
+
+  return i;
+}
+#endif
+
+template<int dim>
+static void _MinMax(const Point<dim>* lo, const Point<dim>* hi, size_t stride, size_t begin,
+                    size_t end, _Bounds<dim>& b)
+{
+  for(int j = 0; j < dim; ++j) {
+    b.low[j] = lo[begin * stride][j];
+    b.high[j] = hi[begin * stride][j];
+  }
+  b.low_valid = b.high_valid = true;
+
+  size_t i = begin + _MinMaxSSE2<dim>(lo + begin * stride, hi + begin * stride, stride,
+                                      end - begin, b);
+
+  for(; i < end; ++i) {
+    const Point<dim> &l = lo[i * stride], &h = hi[i * stride];
+    for(int j = 0; j < dim; ++j) {
+      b.low[j] = FloatMin(b.low[j], l[j]);
+      b.high[j] = FloatMax(b.high[j], h[j]);
+    }
+    b.low_valid = b.low_valid && l.isValid();
+    b.high_valid = b.high_valid && h.isValid();
+  }
+}
+
+// The bounding box of the n elements, the low corner of each at
+// lo[i * stride] and the high one at hi[i * stride]
+template<int dim>
+static AxisBox<dim> _BoundingBox(const Point<dim>* lo, const Point<dim>* hi, size_t stride,
+                                 size_t n, unsigned threads)
+{
+  if(n == 0)
+    return AxisBox<dim>();
+
+  threads = _NumThreads(n, threads, _min_points_per_thread);
+  // A single slice, as for any small set, doesn't allocate
+  _Bounds<dim> one;
+  std::vector<_Bounds<dim> > many(threads > 1 ? threads : 0);
+  _Bounds<dim>* slices = (threads > 1) ? &many[0] : &one;
+
+  _ForSlices(n, threads, [&](size_t begin, size_t end, unsigned t) {
+    _MinMax(lo, hi, stride, begin, end, slices[t]);
+  });
+
+  Point<dim> low, high;
+  for(int j = 0; j < dim; ++j) {
+    low[j] = slices[0].low[j];
+    high[j] = slices[0].high[j];
+  }
+  bool low_valid = slices[0].low_valid, high_valid = slices[0].high_valid;
+
+  for(unsigned t = 1; t < threads; ++t) {
+    for(int j = 0; j < dim; ++j) {
+      low[j] = FloatMin(low[j], slices[t].low[j]);
+      high[j] = FloatMax(high[j], slices[t].high[j]);
+    }
+    low_valid = low_valid && slices[t].low_valid;
+    high_valid = high_valid && slices[t].high_valid;
+  }
+
+  low.setValid(low_valid);
+  high.setValid(high_valid);
+
+  return AxisBox<dim>(low, high, true);
+}
+
+template<int dim>
+AxisBox<dim> BoundingBox(const Point<dim>* p, size_t n, unsigned threads)
+{
+  return _BoundingBox(p, p, 1, n, threads);
+}
+
+template<int dim>
+AxisBox<dim> BoundingBox(const AxisBox<dim>* b, size_t n, unsigned threads)
+{
+  if(n == 0)
+    return AxisBox<dim>();
+
+  // An AxisBox is just its two corners, so the corners of the next box
+  // are two Points on
+  static_assert(sizeof(AxisBox<dim>) == 2 * sizeof(Point<dim>), "AxisBox is its two corners");
+
+  return _BoundingBox(&b[0].lowCorner(), &b[0].highCorner(), 2, n, threads);
+}
+
+template<int dim>
+static void _Sum(const Point<dim>* p, const CoordType* w, size_t begin, size_t end,
+                 _Sums<dim>& s)
+{
+  for(int j = 0; j < dim; ++j)
+    s.sum[j] = 0;
+  s.weight = s.max_weight = 0;
+  s.valid = true;
+
+  size_t i = begin + _SumSSE2<dim>(p + begin, w ? w + begin : 0, end - begin, s);
+
+  for(; i < end; ++i) {
+    double wi = w ? w[i] : 1;
+    for(int j = 0; j < dim; ++j)
+      s.sum[j] += p[i][j] * wi;
+    if(w)
+      s.weight += wi;
+    s.valid = s.valid && p[i].isValid();
+  }
+
+  if(w) {
+    for(i = begin; i < end; ++i)
+      s.max_weight = std::max(s.max_weight, (double) std::fabs(w[i]));
+  }
+}
+
+template<int dim>
+static Point<dim> _Barycenter(const Point<dim>* p, const CoordType* w, size_t n,
+                              unsigned threads)
+{
+  if(n == 0)
+    return Point<dim>();
+
+  threads = _NumThreads(n, threads, _min_points_per_thread);
+  _Sums<dim> one;
+  std::vector<_Sums<dim> > many(threads > 1 ? threads : 0);
+  _Sums<dim>* slices = (threads > 1) ? &many[0] : &one;
+
+  _ForSlices(n, threads, [&](size_t begin, size_t end, unsigned t) {
+    _Sum(p, w, begin, end, slices[t]);
+  });
+
+  _Sums<dim> s = slices[0];
+  for(unsigned t = 1; t < threads; ++t) {
+    for(int j = 0; j < dim; ++j)
+      s.sum[j] += slices[t].sum[j];
+    s.weight += slices[t].weight;
+    s.max_weight = std::max(s.max_weight, slices[t].max_weight);
+    s.valid = s.valid && slices[t].valid;
+  }
+
+  if(!w)
+    s.weight = (double) n;
+  // Make sure the weights don't add up to zero
+  else if(s.max_weight <= 0
+          || std::fabs(s.weight) <= s.max_weight * numeric_constants<CoordType>::epsilon())
+    return Point<dim>();
+
+  Point<dim> out;
+  for(int j = 0; j < dim; ++j)
+    out[j] = (CoordType) (s.sum[j] / s.weight);
+  out.setValid(s.valid);
+
+  return out;
+}
+
+template<int dim>
+Point<dim> Barycenter(const Point<dim>* p, size_t n, unsigned threads)
+{
+  return _Barycenter(p, (const CoordType*) 0, n, threads);
+}
+
+template<int dim>
+Point<dim> Barycenter(const Point<dim>* p, const CoordType* weights, size_t n,
+                      unsigned threads)
+{
+  return _Barycenter(p, weights, n, threads);
+}
+
+template AxisBox<2> BoundingBox<2>(const Point<2>*, size_t, unsigned);
+template AxisBox<3> BoundingBox<3>(const Point<3>*, size_t, unsigned);
+template AxisBox<2> BoundingBox<2>(const AxisBox<2>*, size_t, unsigned);
+template AxisBox<3> BoundingBox<3>(const AxisBox<3>*, size_t, unsigned);
+template Point<2> Barycenter<2>(const Point<2>*, size_t, unsigned);
+template Point<3> Barycenter<3>(const Point<3>*, size_t, unsigned);
+template Point<2> Barycenter<2>(const Point<2>*, const CoordType*, size_t, unsigned);
+template Point<3> Barycenter<3>(const Point<3>*, const CoordType*, size_t, unsigned);
+
+} // namespace WFMath
@@ -148,12 +148,12 @@ class RotBox
   RotBox toLocalCoords(const Point<dim>& origin,
       const RotMatrix<dim>& rotation = RotMatrix<dim>().identity()) const
         {return RotBox(m_corner0.toLocalCoords(origin, rotation), m_size,
-    rotation * m_orient);}
+    ProdInv(m_orient, rotation));}
   RotBox toLocalCoords(const AxisBox<dim>& coords) const
         {return RotBox(m_corner0.toLocalCoords(coords), m_size, m_orient);}
   RotBox toLocalCoords(const RotBox<dim>& coords) const
         {return RotBox(m_corner0.toLocalCoords(coords), m_size,
-    coords.m_orient * m_orient);}
+    ProdInv(m_orient, coords.m_orient));}
 
   // 3D only
   RotBox toParentCoords(const Point<dim>& origin, const Quaternion& rotation) const;
@@ -362,6 +362,185 @@ bool _MatrixInverseImpl(const int size, CoordType* in, CoordType* out)
   return true;
 }
 
+// Closed-form versions of the backends above, for RotMatrix<2> and
+// RotMatrix<3>. They take the same steps as _MatrixSetValsImpl() and
+// the generic normalize(), but compute the inverse transpose from the
+// cofactors instead of by row reduction.
+
+// Writes the inverse transpose of the matrix to out, and returns its
+// determinant. If the determinant is zero, out is not usable.
+template<int size>
+static CoordType _MatrixInverseTranspose(const CoordType* m, CoordType* out);
+
+template<>
+CoordType _MatrixInverseTranspose<2>(const CoordType* m, CoordType* out)
+{
+  CoordType det = m[0] * m[3] - m[1] * m[2];
+
+  if(det == 0)
+    return 0;
+
+  CoordType inv = 1 / det;
+
+  out[0] = m[3] * inv;
+  out[1] = -m[2] * inv;
+  out[2] = -m[1] * inv;
+  out[3] = m[0] * inv;
+
+  return det;
+}
+
+template<>
+CoordType _MatrixInverseTranspose<3>(const CoordType* m, CoordType* out)
+{
+  // The rows of the cofactor matrix are the cross products of the
+  // other two rows
+
+  out[0] = m[4] * m[8] - m[5] * m[7];
+  out[1] = m[5] * m[6] - m[3] * m[8];
+  out[2] = m[3] * m[7] - m[4] * m[6];
+  out[3] = m[7] * m[2] - m[8] * m[1];
+  out[4] = m[8] * m[0] - m[6] * m[2];
+  out[5] = m[6] * m[1] - m[7] * m[0];
+  out[6] = m[1] * m[5] - m[2] * m[4];
+  out[7] = m[2] * m[3] - m[0] * m[5];
+  out[8] = m[0] * m[4] - m[1] * m[3];
+
+  CoordType det = m[0] * out[0] + m[1] * out[1] + m[2] * out[2];
+
+  if(det == 0)
+    return 0;
+
+  CoordType inv = 1 / det;
+
+  for(int i = 0; i < 9; ++i)
+    out[i] *= inv;
+
+  return det;
+}
+
+template<int size>
+static bool _MatrixSetValsFixed(CoordType* vals, bool& flip, CoordType precision)
+{
+  precision = std::fabs(precision);
+
+  if(precision >= .9) // Can get an infinite loop for precision == 1
+    return false;
+
+  CoordType buf[size*size];
+
+  while(true) {
+    CoordType try_prec = 0;
+
+    for(int i = 0; i < size; ++i) {
+      for(int j = i; j < size; ++j) {
+        CoordType ans = 0;
+        for(int k = 0; k < size; ++k)
+          ans += vals[i*size+k] * vals[j*size+k];
+
+        if(i == j) // Subtract identity matrix
+          --ans;
+        ans = std::fabs(ans);
+        if(ans >= try_prec)
+          try_prec = ans;
+      }
+    }
+
+    if(try_prec > precision)
+      return false;
+
+    CoordType det = _MatrixInverseTranspose<size>(vals, buf);
+
+    if(det == 0) // Degenerate matrix, something badly wrong
+      return false;
+
+    if(try_prec <= numeric_constants<CoordType>::epsilon()) {
+      flip = det < 0;
+      return true;
+    }
+
+    // The same linear approximation scheme as _MatrixSetValsImpl()
+    for(int i = 0; i < size*size; ++i)
+      vals[i] = (vals[i] + buf[i]) / 2;
+  }
+}
+
+template<>
+bool RotMatrix<2>::_setVals(CoordType *vals, CoordType precision)
+{
+  bool flip;
+
+  if(!_MatrixSetValsFixed<2>(vals, flip, precision))
+    return false;
+
+  for(int i = 0; i < 2; ++i)
+    for(int j = 0; j < 2; ++j)
+      m_elem[i][j] = vals[i*2+j];
+
+  m_flip = flip;
+  m_valid = true;
+  m_age = 1;
+
+  return true;
+}
+
+template<>
+bool RotMatrix<3>::_setVals(CoordType *vals, CoordType precision)
+{
+  bool flip;
+
+  if(!_MatrixSetValsFixed<3>(vals, flip, precision))
+    return false;
+
+  for(int i = 0; i < 3; ++i)
+    for(int j = 0; j < 3; ++j)
+      m_elem[i][j] = vals[i*3+j];
+
+  m_flip = flip;
+  m_valid = true;
+  m_age = 1;
+
+  return true;
+}
+
+template<>
+void RotMatrix<2>::normalize()
+{
+  // average the matrix with its inverse transpose, as in the generic version
+
+  CoordType buf[4];
+
+  CoordType det = _MatrixInverseTranspose<2>(&m_elem[0][0], buf);
+  assert(det != 0); // matrix can't be degenerate
+  if(det == 0)
+    return;
+
+  for(int i = 0; i < 2; ++i)
+    for(int j = 0; j < 2; ++j)
+      m_elem[i][j] = (m_elem[i][j] + buf[i*2+j]) / 2;
+
+  m_age = 1;
+}
+
+template<>
+void RotMatrix<3>::normalize()
+{
+  // average the matrix with its inverse transpose, as in the generic version
+
+  CoordType buf[9];
+
+  CoordType det = _MatrixInverseTranspose<3>(&m_elem[0][0], buf);
+  assert(det != 0); // matrix can't be degenerate
+  if(det == 0)
+    return;
+
+  for(int i = 0; i < 3; ++i)
+    for(int j = 0; j < 3; ++j)
+      m_elem[i][j] = (m_elem[i][j] + buf[i*3+j]) / 2;
+
+  m_age = 1;
+}
+
 template <>
 RotMatrix<3>::RotMatrix(const Quaternion& q,
                         const bool not_flip) : m_flip(false), m_valid(false),
@@ -391,6 +570,12 @@ template Vector<3> ProdInv<3>(Vector<3> const&, RotMatrix<3> const&);
 template Vector<3> Prod<3>(Vector<3> const&, RotMatrix<3> const&);
 template Vector<2> Prod<2>(Vector<2> const&, RotMatrix<2> const&);
 
+template Vector<3> Prod<3>(RotMatrix<3> const&, Vector<3> const&);
+template Vector<2> Prod<2>(RotMatrix<2> const&, Vector<2> const&);
+
+template Vector<3> InvProd<3>(RotMatrix<3> const&, Vector<3> const&);
+template Vector<2> InvProd<2>(RotMatrix<2> const&, Vector<2> const&);
+
 template RotMatrix<3> Prod<3>(RotMatrix<3> const&, RotMatrix<3> const&);
 template RotMatrix<2> Prod<2>(RotMatrix<2> const&, RotMatrix<2> const&);
 
@@ -0,0 +1,119 @@
+// rotmatrix_bench.cpp (RotMatrix<> benchmarks)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+// Compares the closed-form RotMatrix<3>::setVals() and normalize()
+// with the generic size-N backends they replace.
+
+#include "const.h"
+#include "vector.h"
+#include "rotmatrix_funcs.h"
+#include "timestamp.h"
+
+#include <iostream>
+
+using namespace WFMath;
+
+static const int iterations = 200000;
+
+// Keep the compiler from optimizing away the work
+static CoordType sink = 0;
+
+static void report(const char* name, const TimeStamp& start, const TimeStamp& end)
+{
+  long ms = (end - start).milliseconds();
+  std::cout << name << ": " << ms << " ms, "
+            << (ms * 1e6 / iterations) << " ns per call" << std::endl;
+}
+
+// The previous RotMatrix<3>::normalize(), in terms of the generic backend
+static void generic_normalize(CoordType vals[9])
+{
+  CoordType buf1[9], buf2[9];
+
+  for(int i = 0; i < 3; ++i) {
+    for(int j = 0; j < 3; ++j) {
+      buf1[j*3 + i] = vals[i*3 + j];
+      buf2[j*3 + i] = ((i == j) ? 1.f : 0.f);
+    }
+  }
+
+  _MatrixInverseImpl(3, buf1, buf2);
+
+  for(int i = 0; i < 9; ++i)
+    vals[i] = (vals[i] + buf2[i]) / 2;
+}
+
+int main()
+{
+  RotMatrix<3> m;
+  m.rotation(Vector<3>(1, 2, -1), numeric_constants<CoordType>::pi() / 5);
+
+  // Slightly off orthogonal, the way a matrix is after
+  // WFMATH_MAX_NORM_AGE products, so setVals() has to clean it up
+  CoordType input[9];
+  for(int i = 0; i < 3; ++i)
+    for(int j = 0; j < 3; ++j)
+      input[i*3+j] = m.elem(i, j) * (((i + j) % 2) ? 1.00001f : 0.99999f);
+
+  std::cout << "RotMatrix<3>, " << iterations << " iterations" << std::endl;
+
+  TimeStamp start = TimeStamp::now();
+  for(int n = 0; n < iterations; ++n) {
+    CoordType vals[9], buf1[9], buf2[9];
+    bool flip;
+    for(int i = 0; i < 9; ++i)
+      vals[i] = input[i];
+    _MatrixSetValsImpl(3, vals, flip, buf1, buf2, 1e-3f);
+    sink += vals[n % 9];
+  }
+  report("generic setVals", start, TimeStamp::now());
+
+  start = TimeStamp::now();
+  for(int n = 0; n < iterations; ++n) {
+    RotMatrix<3> out;
+    out.setVals(input, 1e-3f);
+    sink += out.elem(0, n % 3);
+  }
+  report("closed-form setVals", start, TimeStamp::now());
+
+  start = TimeStamp::now();
+  for(int n = 0; n < iterations; ++n) {
+    CoordType vals[9];
+    for(int i = 0; i < 9; ++i)
+      vals[i] = input[i];
+    generic_normalize(vals);
+    sink += vals[n % 9];
+  }
+  report("generic normalize", start, TimeStamp::now());
+
+  start = TimeStamp::now();
+  for(int n = 0; n < iterations; ++n) {
+    RotMatrix<3> out(m);
+    out.normalize();
+    sink += out.elem(0, n % 3);
+  }
+  report("closed-form normalize", start, TimeStamp::now());
+
+  return sink == 12345 ? 1 : 0;
+}
@@ -243,6 +243,13 @@ inline Vector<dim> operator*(const Vector<dim>& v, const RotMatrix<dim>& m)
   return InvProd(m, v); // Since transpose() and inverse() are the same
 }
 
+// The dimensions we actually use get closed-form versions of _setVals()
+// and normalize(), defined in rotmatrix.cpp
+template<> bool RotMatrix<2>::_setVals(CoordType *vals, CoordType precision);
+template<> bool RotMatrix<3>::_setVals(CoordType *vals, CoordType precision);
+template<> void RotMatrix<2>::normalize();
+template<> void RotMatrix<3>::normalize();
+
 template<int dim>
 inline bool RotMatrix<dim>::setVals(const CoordType vals[dim][dim], CoordType precision)
 {
@@ -103,6 +103,41 @@ void test_rotmatrix(const RotMatrix<dim>& m)
     for(int j = 0; j < dim; ++j)
       assert(Equal(conv_ident.elem(i, j), (i == j) ? 1 : 0));
 
+  // setVals() cleans up small errors in the input, and rejects input
+  // which is too far from orthogonal. Check both parities.
+
+  RotMatrix<dim> mirrored = Prod(m, RotMatrix<dim>().mirror(0));
+
+  for(int parity = 0; parity < 2; ++parity) {
+    const RotMatrix<dim>& orig = parity ? mirrored : m;
+    CoordType vals[dim][dim];
+
+    for(int i = 0; i < dim; ++i)
+      for(int j = 0; j < dim; ++j)
+        vals[i][j] = orig.elem(i, j) * (((i + j) % 2) ? 1.0001f : 0.9999f);
+
+    RotMatrix<dim> fixed;
+    assert(fixed.setVals(vals, 1e-2f));
+    assert(fixed.isEqualTo(orig, 1e-3f));
+    assert(fixed.determinant() == orig.determinant());
+
+    for(int i = 0; i < dim; ++i) {
+      for(int j = 0; j < dim; ++j) {
+        CoordType dot = 0;
+        for(int k = 0; k < dim; ++k)
+          dot += fixed.elem(i, k) * fixed.elem(j, k);
+        assert(std::fabs(dot - ((i == j) ? 1 : 0)) <= 2 * numeric_constants<CoordType>::epsilon());
+      }
+    }
+
+    RotMatrix<dim> renormed = fixed;
+    renormed.normalize();
+    assert(renormed.isEqualTo(fixed));
+
+    vals[0][0] += 0.5f;
+    assert(!fixed.setVals(vals));
+  }
+
   // FIXME much more
 }
 
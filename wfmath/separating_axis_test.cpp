@@ -0,0 +1,306 @@
+// separating_axis_test.cpp (SeparatingAxisCache test functions)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-17
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#ifndef DEBUG
+#define DEBUG
+#endif
+
+#include "const.h"
+#include "vector.h"
+#include "point.h"
+#include "rotmatrix.h"
+#include "axisbox.h"
+#include "rotbox.h"
+#include "polygon.h"
+#include "intersect.h"
+#include "polygon_intersect.h"
+#include "prepared_rotbox.h"
+#include "randgen.h"
+
+#include <iostream>
+
+#include <cassert>
+#include <cmath>
+
+using namespace WFMath;
+
+static CoordType random_coord(MTRand& rand, CoordType low, CoordType high)
+{
+  return low + (high - low) * (CoordType) rand.rand();
+}
+
+template<int dim>
+static Point<dim> random_point(MTRand& rand)
+{
+  Point<dim> p;
+  p.setToOrigin();
+  for(int i = 0; i < dim; ++i)
+    p[i] = random_coord(rand, -3, 3);
+  return p;
+}
+
+template<int dim>
+static Vector<dim> random_size(MTRand& rand)
+{
+  Vector<dim> v;
+  for(int i = 0; i < dim; ++i)
+    v[i] = random_coord(rand, 0.2f, 2);
+  v.setValid();
+  return v;
+}
+
+static RotMatrix<2> random_rotation(MTRand& rand, const RotMatrix<2>&)
+{
+  RotMatrix<2> m;
+  return m.rotation(random_coord(rand, -3, 3));
+}
+
+static RotMatrix<3> random_rotation(MTRand& rand, const RotMatrix<3>&)
+{
+  RotMatrix<3> m;
+  Vector<3> axis(random_coord(rand, -1, 1), random_coord(rand, -1, 1),
+                 random_coord(rand, -1, 1));
+  return m.rotation(axis, random_coord(rand, -3, 3));
+}
+
+static Polygon<2> random_convex(MTRand& rand, const Point<2>& center)
+{
+  // A regular polygon, which is always convex
+  Polygon<2> poly;
+  int n = 3 + (int) rand.randInt(5);
+  CoordType r = random_coord(rand, 0.5f, 1.5f), start = random_coord(rand, -3, 3);
+  for(int j = 0; j < n; ++j) {
+    CoordType angle = start + j * 2 * numeric_constants<CoordType>::pi() / n;
+    poly.addCorner(j, center + Vector<2>(r * std::cos(angle), r * std::sin(angle)));
+  }
+  assert(poly.isConvex());
+  return poly;
+}
+
+// A stale cache, holding an axis left over from some other pair, or
+// one which is out of range
+static void stale(MTRand& rand, SeparatingAxisCache& cache)
+{
+  cache.setAxis((int) rand.randInt(20));
+}
+
+// The cached test must give the same answer as the plain one, and
+// leave an axis in the cache exactly when the shapes are apart
+template<class S1, class S2>
+static bool check(const S1& s1, const S2& s2, bool proper, SeparatingAxisCache& cache)
+{
+  bool hit = Intersect(s1, s2, proper);
+  assert(Intersect(s1, s2, proper, cache) == hit);
+  if(!hit)
+    assert(cache.axis() >= 0);
+  return hit;
+}
+
+// The first shape moves past the second in small steps, with one cache
+// kept for the whole pass, as it would be from frame to frame
+template<int dim>
+static void test_boxes(MTRand& rand)
+{
+  std::cout << "Testing " << dim << "D boxes with a separating axis cache" << std::endl;
+
+  int hits = 0;
+
+  for(int i = 0; i < 100; ++i) {
+    RotBox<dim> r(random_point<dim>(rand), random_size<dim>(rand),
+                  random_rotation(rand, RotMatrix<dim>()));
+    RotBox<dim> other(random_point<dim>(rand), random_size<dim>(rand),
+                      random_rotation(rand, RotMatrix<dim>()));
+    Point<dim> low = random_point<dim>(rand);
+    AxisBox<dim> b(low, low + random_size<dim>(rand));
+    PreparedRotBox<dim> prep(r), prep_other(other);
+
+    Vector<dim> step;
+    for(int j = 0; j < dim; ++j)
+      step[j] = random_coord(rand, -0.1f, 0.1f);
+    step.setValid();
+
+    for(int j = 0; j < 2; ++j) {
+      bool proper = (j == 1);
+      SeparatingAxisCache box_cache, prep_cache, pair_cache, prep_pair_cache;
+
+      for(int n = 0; n < 40; ++n) {
+        RotBox<dim> moved(r);
+        moved.shift(step * (CoordType) n);
+        prep.build(moved);
+
+        hits += check(moved, b, proper, box_cache);
+        check(prep, b, proper, prep_cache);
+        hits += check(moved, other, proper, pair_cache);
+        assert(Intersect(moved, prep_other, proper, prep_pair_cache)
+               == Intersect(moved, other, proper));
+        assert(Intersect(prep, prep_other, proper, prep_pair_cache)
+               == Intersect(moved, other, proper));
+
+        // A RotBox and its PreparedRotBox find the same axis
+        assert(box_cache.axis() == prep_cache.axis() || Intersect(moved, b, proper));
+      }
+
+      SeparatingAxisCache cache;
+      for(int n = 0; n < 10; ++n) {
+        stale(rand, cache);
+        check(r, b, proper, cache);
+        stale(rand, cache);
+        check(r, other, proper, cache);
+        stale(rand, cache);
+        check(PreparedRotBox<dim>(r), b, proper, cache);
+      }
+    }
+  }
+
+  assert(hits > 200);
+}
+
+static void test_polygons(MTRand& rand)
+{
+  std::cout << "Testing polygons with a separating axis cache" << std::endl;
+
+  int hits = 0;
+
+  for(int i = 0; i < 100; ++i) {
+    Polygon<2> p1 = random_convex(rand, random_point<2>(rand));
+    Polygon<2> p2 = random_convex(rand, random_point<2>(rand));
+    RotBox<2> r(random_point<2>(rand), random_size<2>(rand),
+                random_rotation(rand, RotMatrix<2>()));
+    Point<2> low = random_point<2>(rand);
+    AxisBox<2> b(low, low + random_size<2>(rand));
+    Vector<2> step(random_coord(rand, -0.1f, 0.1f), random_coord(rand, -0.1f, 0.1f));
+
+    for(int j = 0; j < 2; ++j) {
+      bool proper = (j == 1);
+      SeparatingAxisCache poly_cache, box_cache, rot_cache, cache;
+
+      for(int n = 0; n < 40; ++n) {
+        Polygon<2> moved(p1);
+        moved.shift(step * (CoordType) n);
+
+        hits += check(moved, p2, proper, poly_cache);
+        assert(poly_cache.axis() < (int) (p1.numCorners() + p2.numCorners()));
+        hits += check(moved, b, proper, box_cache);
+        hits += check(moved, r, proper, rot_cache);
+        assert(box_cache.axis() < (int) p1.numCorners() + 4);
+
+        stale(rand, cache);
+        check(moved, p2, proper, cache);
+        stale(rand, cache);
+        check(moved, r, proper, cache);
+      }
+    }
+  }
+
+  assert(hits > 500);
+
+  // A polygon which isn't convex ignores the cache
+  Polygon<2> notch;
+  notch.addCorner(0, Point<2>(0, 0));
+  notch.addCorner(1, Point<2>(2, 0));
+  notch.addCorner(2, Point<2>(1, 1));
+  notch.addCorner(3, Point<2>(2, 2));
+  notch.addCorner(4, Point<2>(0, 2));
+  AxisBox<2> inside_notch(Point<2>(1.6f, 0.9f), Point<2>(1.9f, 1.1f));
+
+  SeparatingAxisCache cache;
+  assert(!Intersect(notch, inside_notch, false, cache));
+  assert(cache.axis() == -1);
+}
+
+static void test_exact()
+{
+  std::cout << "Testing the separating axis cache against fixed shapes" << std::endl;
+
+  // A square turned 45 degrees, and a box off one of its corners, but
+  // inside its bounding box
+  RotMatrix<2> m;
+  m.rotation(numeric_constants<CoordType>::pi() / 4);
+  RotBox<2> diamond(Point<2>(0, 0), Vector<2>(2, 2), m);
+  diamond.moveCenterTo(Point<2>(0, 0));
+  AxisBox<2> corner(Point<2>(1.2f, 1.2f), Point<2>(1.3f, 1.3f));
+  AxisBox<2> far(Point<2>(5, 5), Point<2>(6, 6));
+
+  SeparatingAxisCache cache;
+  assert(cache.axis() == -1);
+
+  assert(!Intersect(diamond, far, false, cache));
+  assert(cache.axis() == 0);
+  assert(!Intersect(diamond, corner, false, cache));
+  assert(cache.axis() == 1);
+
+  // The axis stays put while it still separates the boxes
+  assert(!Intersect(diamond, corner, false, cache));
+  assert(cache.axis() == 1);
+  assert(!Intersect(diamond, far, false, cache));
+  assert(cache.axis() == 1);
+
+  cache.reset();
+  assert(cache.axis() == -1);
+  assert(!Intersect(diamond, far, false, cache));
+  assert(cache.axis() == 0);
+
+  // An overlapping pair leaves the cache alone
+  assert(Intersect(diamond, AxisBox<2>(Point<2>(-0.1f, -0.1f), Point<2>(0.1f, 0.1f)),
+                   false, cache));
+  assert(cache.axis() == 0);
+
+  // Two unit squares, apart along x, are separated by the edge of the
+  // second which ends at its corner 0, at x = 2
+  Polygon<2> s1, s2;
+  s1.addCorner(0, Point<2>(0, 0));
+  s1.addCorner(1, Point<2>(1, 0));
+  s1.addCorner(2, Point<2>(1, 1));
+  s1.addCorner(3, Point<2>(0, 1));
+  s2.addCorner(0, Point<2>(2, 0));
+  s2.addCorner(1, Point<2>(3, 0));
+  s2.addCorner(2, Point<2>(3, 1));
+  s2.addCorner(3, Point<2>(2, 1));
+
+  cache.reset();
+  assert(!Intersect(s1, s2, false, cache));
+  int axis = cache.axis();
+  assert(axis >= 0 && axis < 8);
+  s1.shift(Vector<2>(0.5f, 0));
+  assert(!Intersect(s1, s2, false, cache));
+  assert(cache.axis() == axis);
+  s1.shift(Vector<2>(0.6f, 0));
+  assert(Intersect(s1, s2, false, cache));
+  assert(cache.axis() == axis);
+}
+
+int main()
+{
+  MTRand rand(18);
+
+  test_boxes<2>(rand);
+  test_boxes<3>(rand);
+  test_polygons(rand);
+  test_exact();
+
+  return 0;
+}
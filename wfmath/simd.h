@@ -0,0 +1,83 @@
+// simd.h (Helpers for the SSE and AVX loops)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-17
+
+// Only included by the library's own source files which have vector
+// loops, that is point_array.cpp, intersect_many.cpp, raycast.cpp and
+// frustum.cpp.
+
+#ifndef WFMATH_SIMD_H
+#define WFMATH_SIMD_H
+
+#include <cstddef>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// The AVX loops are compiled in whenever the compiler can target x86,
+// and used if the CPU running the library supports them, so a library
+// built for plain x86-64 still gets them where it can. Each one is
+// marked WFMATH_TARGET_AVX, and only called after _CpuHasAVX().
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define WFMATH_AVX_DISPATCH
+#include <immintrin.h>
+#define WFMATH_TARGET_AVX __attribute__((target("avx")))
+#endif
+
+namespace WFMath {
+
+// True if the processor running the library supports AVX, and the
+// AVX kernels were compiled in. Defined in point_array.cpp.
+bool _CpuHasAVX();
+
+// Each lane of a where mask is set, and of b where it isn't
+
+#ifdef WFMATH_AVX_DISPATCH
+WFMATH_TARGET_AVX
+static inline __m256 _Select8(__m256 mask, __m256 a, __m256 b)
+{
+  return _mm256_or_ps(_mm256_and_ps(mask, a), _mm256_andnot_ps(mask, b));
+}
+#endif
+
+#if defined(__SSE2__)
+static inline __m128 _Select4(__m128 mask, __m128 a, __m128 b)
+{
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+#endif
+
+// The number of bits set in a mask of n candidates, one bit each
+static inline size_t _CountHits(const unsigned* mask, size_t n)
+{
+  size_t hits = 0;
+  for(size_t k = 0; k < (n + 31) / 32; ++k)
+    for(unsigned word = mask[k]; word != 0; word &= word - 1)
+      ++hits;
+  return hits;
+}
+
+} // namespace WFMath
+
+#endif  // WFMATH_SIMD_H
@@ -0,0 +1,260 @@
+// small_vector.h (A vector which keeps its first few elements inline)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-17
+
+#ifndef WFMATH_SMALL_VECTOR_H
+#define WFMATH_SMALL_VECTOR_H
+
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include <cstddef>
+
+namespace WFMath {
+
+/// The corner storage of Polygon<2> and Line<>
+/**
+ * This is the part of the std::vector interface they use, over storage
+ * which holds up to N elements inside the object itself. Only when it
+ * grows past that does it go to the heap, so copying or building a
+ * small shape doesn't allocate. The elements are always contiguous,
+ * and the iterators are plain pointers.
+ *
+ * Like std::vector, it keeps its capacity once on the heap, so storage
+ * which is reused doesn't keep allocating. A copy is inline if it
+ * fits, and shrink_to_fit() brings the elements back inline.
+ **/
+template<class T, size_t N>
+class _SmallVector
+{
+ public:
+  static_assert(N > 0, "_SmallVector needs room for at least one element");
+
+  typedef T value_type;
+  typedef size_t size_type;
+  typedef T* iterator;
+  typedef const T* const_iterator;
+
+  _SmallVector() : m_data(inlineData()), m_size(0), m_capacity(N) {}
+  _SmallVector(const _SmallVector& v) : m_data(inlineData()), m_size(0), m_capacity(N)
+  {assign(v.begin(), v.end());}
+  _SmallVector(_SmallVector&& v) : m_data(inlineData()), m_size(0), m_capacity(N)
+  {steal(v);}
+
+  ~_SmallVector() {destroy(m_data, m_data + m_size); release();}
+
+  _SmallVector& operator=(const _SmallVector& v)
+  {
+    if(this != &v)
+      assign(v.begin(), v.end());
+    return *this;
+  }
+  _SmallVector& operator=(_SmallVector&& v)
+  {
+    if(this != &v) {
+      clear();
+      release();
+      steal(v);
+    }
+    return *this;
+  }
+
+  size_type size() const {return m_size;}
+  bool empty() const {return m_size == 0;}
+  size_type capacity() const {return m_capacity;}
+  /// True if the elements are in the object itself, not on the heap
+  bool isInline() const {return m_data == inlineData();}
+
+  T* data() {return m_data;}
+  const T* data() const {return m_data;}
+
+  iterator begin() {return m_data;}
+  const_iterator begin() const {return m_data;}
+  iterator end() {return m_data + m_size;}
+  const_iterator end() const {return m_data + m_size;}
+
+  T& operator[](size_type i) {return m_data[i];}
+  const T& operator[](size_type i) const {return m_data[i];}
+  T& front() {return m_data[0];}
+  const T& front() const {return m_data[0];}
+  T& back() {return m_data[m_size - 1];}
+  const T& back() const {return m_data[m_size - 1];}
+
+  void reserve(size_type n) {if(n > m_capacity) grow(n);}
+  void shrink_to_fit();
+
+  void clear() {destroy(m_data, m_data + m_size); m_size = 0;}
+  void resize(size_type n);
+  void push_back(const T& t);
+  iterator insert(iterator pos, const T& t);
+  iterator erase(iterator pos);
+
+ private:
+  T* inlineData() {return reinterpret_cast<T*>(&m_inline);}
+  const T* inlineData() const {return reinterpret_cast<const T*>(&m_inline);}
+
+  static void destroy(T* begin, T* end) {for(; begin != end; ++begin) begin->~T();}
+
+  // Move to storage for at least n elements
+  void grow(size_type n);
+  // Give back the heap storage, if any, which must hold no elements
+  void release()
+  {
+    if(!isInline())
+      std::allocator<T>().deallocate(m_data, m_capacity);
+    m_data = inlineData();
+    m_capacity = N;
+  }
+  void assign(const T* begin, const T* end);
+  // Take the elements of v, which is left empty
+  void steal(_SmallVector& v);
+
+  typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type m_inline;
+  T* m_data;
+  size_type m_size;
+  size_type m_capacity;
+};
+
+template<class T, size_t N>
+void _SmallVector<T, N>::grow(size_type n)
+{
+  size_type capacity = std::max(n, 2 * m_capacity);
+  T* data = std::allocator<T>().allocate(capacity);
+  std::uninitialized_copy(std::make_move_iterator(m_data),
+                          std::make_move_iterator(m_data + m_size), data);
+  destroy(m_data, m_data + m_size);
+  release();
+  m_data = data;
+  m_capacity = capacity;
+}
+
+template<class T, size_t N>
+void _SmallVector<T, N>::shrink_to_fit()
+{
+  if(isInline() || m_size > N)
+    return;
+
+  T* heap = m_data;
+  size_type capacity = m_capacity;
+  std::uninitialized_copy(std::make_move_iterator(heap),
+                          std::make_move_iterator(heap + m_size), inlineData());
+  destroy(heap, heap + m_size);
+  std::allocator<T>().deallocate(heap, capacity);
+  m_data = inlineData();
+  m_capacity = N;
+}
+
+template<class T, size_t N>
+void _SmallVector<T, N>::resize(size_type n)
+{
+  if(n < m_size) {
+    destroy(m_data + n, m_data + m_size);
+  }
+  else {
+    reserve(n);
+    for(T* p = m_data + m_size; p != m_data + n; ++p)
+      new (p) T();
+  }
+  m_size = n;
+}
+
+template<class T, size_t N>
+void _SmallVector<T, N>::push_back(const T& t)
+{
+  if(m_size == m_capacity) {
+    T copy(t); // t may be one of ours
+    grow(m_size + 1);
+    new (m_data + m_size) T(std::move(copy));
+  }
+  else {
+    new (m_data + m_size) T(t);
+  }
+  ++m_size;
+}
+
+template<class T, size_t N>
+typename _SmallVector<T, N>::iterator _SmallVector<T, N>::insert(iterator pos, const T& t)
+{
+  size_type i = pos - m_data;
+  if(i == m_size) {
+    push_back(t);
+    return m_data + i;
+  }
+
+  T copy(t); // t may be one of ours, and about to move
+  if(m_size == m_capacity)
+    grow(m_size + 1);
+
+  new (m_data + m_size) T(std::move(m_data[m_size - 1]));
+  std::move_backward(m_data + i, m_data + m_size - 1, m_data + m_size);
+  m_data[i] = std::move(copy);
+  ++m_size;
+
+  return m_data + i;
+}
+
+template<class T, size_t N>
+typename _SmallVector<T, N>::iterator _SmallVector<T, N>::erase(iterator pos)
+{
+  std::move(pos + 1, m_data + m_size, pos);
+  --m_size;
+  m_data[m_size].~T();
+  return pos;
+}
+
+template<class T, size_t N>
+void _SmallVector<T, N>::assign(const T* begin, const T* end)
+{
+  size_type n = end - begin;
+
+  clear();
+  reserve(n);
+
+  std::uninitialized_copy(begin, end, m_data);
+  m_size = n;
+}
+
+template<class T, size_t N>
+void _SmallVector<T, N>::steal(_SmallVector& v)
+{
+  if(v.isInline()) {
+    std::uninitialized_copy(std::make_move_iterator(v.m_data),
+                            std::make_move_iterator(v.m_data + v.m_size), m_data);
+    m_size = v.m_size;
+    v.clear();
+  }
+  else {
+    m_data = v.m_data;
+    m_size = v.m_size;
+    m_capacity = v.m_capacity;
+    v.m_data = v.inlineData();
+    v.m_size = 0;
+    v.m_capacity = N;
+  }
+}
+
+} // namespace WFMath
+
+#endif  // WFMATH_SMALL_VECTOR_H
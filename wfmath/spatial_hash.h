@@ -0,0 +1,218 @@
+// spatial_hash.h (A uniform grid of Point<> and Ball<>, for neighbor queries)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifndef WFMATH_SPATIAL_HASH_H
+#define WFMATH_SPATIAL_HASH_H
+
+#include <wfmath/const.h>
+#include <wfmath/point.h>
+#include <wfmath/ball.h>
+#include <wfmath/intersect.h>
+
+#include <vector>
+#include <unordered_map>
+
+#include <cstddef>
+
+namespace WFMath {
+
+/// The integer coordinates of a cell of a SpatialHash<>
+template<int dim>
+struct _CellKey
+{
+  int c[dim];
+
+  bool operator==(const _CellKey& k) const
+  {
+    for(int i = 0; i < dim; ++i)
+      if(c[i] != k.c[i])
+        return false;
+    return true;
+  }
+};
+
+template<int dim>
+struct _CellKeyHash
+{
+  size_t operator()(const _CellKey<dim>& k) const
+  {
+    // Multiply by large odd constants, so that nearby cells spread out
+    static const size_t primes[] = {73856093u, 19349663u, 83492791u, 2654435761u};
+    size_t h = 0;
+    for(int i = 0; i < dim; ++i)
+      h ^= (size_t) (unsigned) k.c[i] * primes[i % 4];
+    return h;
+  }
+};
+
+/// A uniform grid hash of points and balls, for proximity queries
+/**
+ * Space is divided into cubes of a fixed size, and each object is
+ * listed in every cell its bounding box touches. Only cells which
+ * contain something are stored, in a hash table, so the world does not
+ * need to be bounded. Insertion, removal and movement are O(1)
+ * amortized. Movement within the same cells only updates the stored
+ * shape.
+ *
+ * The cell size should be about the radius of a typical query. Balls
+ * much larger than a cell are stored in many cells, so work but cost
+ * more to insert and move.
+ *
+ * Each object is identified by the handle returned by insert(). Handles
+ * stay the same until the object is removed, after which they may be
+ * reused.
+ *
+ * query() finishes with the exact Intersect() test against the query
+ * ball, and never allocates. Each object is reported once, even if it
+ * is in several of the cells searched. The visitor is called with the
+ * handle of each object found. It returns true to continue the query,
+ * or false to stop it.
+ **/
+template<int dim = 3>
+class SpatialHash
+{
+ public:
+  /// Construct an empty grid with the given cell size
+  explicit SpatialHash(CoordType cell_size);
+
+  /// The number of objects in the grid
+  size_t size() const {return m_count;}
+  /// True if the grid is empty
+  bool empty() const {return m_count == 0;}
+  /// Remove all objects
+  void clear();
+  /// Free the storage of cells which are now empty
+  /**
+   * Empty cells are kept by default, so that objects moving back and
+   * forth between cells do not reallocate.
+   **/
+  void prune();
+
+  /// The length of the side of each cell
+  CoordType cellSize() const {return m_cell_size;}
+
+  /// Add a point, returning its handle
+  size_t insert(const Point<dim>& p);
+  /// Add a ball, returning its handle
+  size_t insert(const Ball<dim>& b);
+  /// Remove an object
+  void remove(size_t handle);
+  /// Move an object, which becomes a point
+  void move(size_t handle, const Point<dim>& p);
+  /// Move an object, which becomes a ball
+  void move(size_t handle, const Ball<dim>& b);
+
+  /// True if the object is a point, false if it is a ball
+  bool isPoint(size_t handle) const {return m_entries[handle].is_point;}
+  /// The object, as a ball, with zero radius for a point
+  const Ball<dim>& shape(size_t handle) const {return m_entries[handle].shape;}
+
+  /// Visit every object which intersects region
+  template<class Visitor>
+  void query(const Ball<dim>& region, Visitor visit) const;
+  /// Append every object which intersects region to out
+  void query(const Ball<dim>& region, std::vector<size_t>& out) const;
+
+ private:
+  struct Entry
+  {
+    Ball<dim> shape;
+    // The range of cells the object is listed in
+    _CellKey<dim> low, high;
+    bool is_point;
+    // The next free entry, for entries on the free list
+    size_t next_free;
+    bool in_use;
+  };
+
+  typedef std::unordered_map<_CellKey<dim>, std::vector<size_t>, _CellKeyHash<dim> > CellMap;
+
+  _CellKey<dim> cellOf(const Point<dim>& p, CoordType offset) const;
+  // The range of cells an object is listed in
+  void cellRange(const Ball<dim>& b, _CellKey<dim>& low, _CellKey<dim>& high) const;
+  size_t add(const Ball<dim>& b, bool is_point);
+  void update(size_t handle, const Ball<dim>& b, bool is_point);
+  void link(size_t handle);
+  void unlink(size_t handle);
+
+  std::vector<Entry> m_entries;
+  CellMap m_cells;
+  size_t m_free;
+  size_t m_count;
+  CoordType m_cell_size;
+  CoordType m_inv_cell_size;
+};
+
+template<int dim>
+template<class Visitor>
+void SpatialHash<dim>::query(const Ball<dim>& region, Visitor visit) const
+{
+  // Intersect(Ball, Point) allows a relative error of epsilon
+  const CoordType r = region.radius() * (1 + numeric_constants<CoordType>::epsilon());
+  const _CellKey<dim> low = cellOf(region.center(), -r), high = cellOf(region.center(), r);
+  _CellKey<dim> cell = low;
+
+  // Step through every cell in [low, high], like an odometer
+  while(true) {
+    typename CellMap::const_iterator it = m_cells.find(cell);
+
+    if(it != m_cells.end()) {
+      const std::vector<size_t>& list = it->second;
+
+      for(size_t n = 0; n < list.size(); ++n) {
+        const Entry& e = m_entries[list[n]];
+
+        // An object in several of the cells searched is only reported
+        // from the lowest of them
+        bool first = true;
+        for(int i = 0; i < dim && first; ++i) {
+          int start = (e.low.c[i] > low.c[i]) ? e.low.c[i] : low.c[i];
+          first = (cell.c[i] == start);
+        }
+        if(!first)
+          continue;
+
+        bool hit = e.is_point ? Intersect(region, e.shape.center(), false)
+                              : Intersect(region, e.shape, false);
+        if(hit && !visit(list[n]))
+          return;
+      }
+    }
+
+    int i = 0;
+    for(; i < dim; ++i) {
+      if(cell.c[i] < high.c[i]) {
+        ++cell.c[i];
+        break;
+      }
+      cell.c[i] = low.c[i];
+    }
+    if(i == dim)
+      break;
+  }
+}
+
+} // namespace WFMath
+
+#endif  // WFMATH_SPATIAL_HASH_H
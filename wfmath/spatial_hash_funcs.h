@@ -0,0 +1,241 @@
+// spatial_hash_funcs.h (SpatialHash<> implementation)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifndef WFMATH_SPATIAL_HASH_FUNCS_H
+#define WFMATH_SPATIAL_HASH_FUNCS_H
+
+#include <wfmath/spatial_hash.h>
+
+#include <algorithm>
+#include <limits>
+
+#include <cmath>
+#include <cassert>
+
+namespace WFMath {
+
+template<int dim>
+SpatialHash<dim>::SpatialHash(CoordType cell_size)
+  : m_free((size_t) -1), m_count(0), m_cell_size(cell_size),
+    m_inv_cell_size(1 / cell_size)
+{
+  assert(cell_size > 0);
+}
+
+template<int dim>
+void SpatialHash<dim>::clear()
+{
+  m_entries.clear();
+  m_cells.clear();
+  m_free = (size_t) -1;
+  m_count = 0;
+}
+
+template<int dim>
+void SpatialHash<dim>::prune()
+{
+  for(typename CellMap::iterator it = m_cells.begin(); it != m_cells.end();) {
+    if(it->second.empty())
+      it = m_cells.erase(it);
+    else
+      ++it;
+  }
+}
+
+template<int dim>
+_CellKey<dim> SpatialHash<dim>::cellOf(const Point<dim>& p, CoordType offset) const
+{
+  _CellKey<dim> key;
+
+  for(int i = 0; i < dim; ++i) {
+    CoordType c = std::floor((p[i] + offset) * m_inv_cell_size);
+    assert(c > std::numeric_limits<int>::min() && c < std::numeric_limits<int>::max());
+    key.c[i] = (int) c;
+  }
+
+  return key;
+}
+
+template<int dim>
+void SpatialHash<dim>::cellRange(const Ball<dim>& b, _CellKey<dim>& low,
+                                 _CellKey<dim>& high) const
+{
+  // Rounding can let Intersect(Ball, Ball) accept balls which are a
+  // little further apart than their radii, so file a ball with the same
+  // relative slack query() gives the region, or two balls which touch on
+  // a cell boundary could each end up on their own side of it
+  const CoordType r = b.radius() * (1 + numeric_constants<CoordType>::epsilon());
+  low = cellOf(b.center(), -r);
+  high = cellOf(b.center(), r);
+}
+
+template<int dim>
+size_t SpatialHash<dim>::add(const Ball<dim>& b, bool is_point)
+{
+  assert(b.isValid());
+
+  size_t handle;
+
+  if(m_free != (size_t) -1) {
+    handle = m_free;
+    m_free = m_entries[handle].next_free;
+  }
+  else {
+    handle = m_entries.size();
+    m_entries.push_back(Entry());
+  }
+
+  Entry& e = m_entries[handle];
+  e.shape = b;
+  e.is_point = is_point;
+  e.in_use = true;
+  cellRange(b, e.low, e.high);
+
+  link(handle);
+  ++m_count;
+
+  return handle;
+}
+
+template<int dim>
+size_t SpatialHash<dim>::insert(const Point<dim>& p)
+{
+  return add(Ball<dim>(p, 0), true);
+}
+
+template<int dim>
+size_t SpatialHash<dim>::insert(const Ball<dim>& b)
+{
+  return add(b, false);
+}
+
+template<int dim>
+void SpatialHash<dim>::remove(size_t handle)
+{
+  assert(handle < m_entries.size() && m_entries[handle].in_use);
+
+  unlink(handle);
+
+  Entry& e = m_entries[handle];
+  e.in_use = false;
+  e.next_free = m_free;
+  m_free = handle;
+  --m_count;
+}
+
+template<int dim>
+void SpatialHash<dim>::move(size_t handle, const Point<dim>& p)
+{
+  update(handle, Ball<dim>(p, 0), true);
+}
+
+template<int dim>
+void SpatialHash<dim>::move(size_t handle, const Ball<dim>& b)
+{
+  update(handle, b, false);
+}
+
+template<int dim>
+void SpatialHash<dim>::update(size_t handle, const Ball<dim>& b, bool is_point)
+{
+  assert(handle < m_entries.size() && m_entries[handle].in_use);
+  assert(b.isValid());
+
+  Entry& e = m_entries[handle];
+  _CellKey<dim> low, high;
+  cellRange(b, low, high);
+
+  e.shape = b;
+  e.is_point = is_point;
+
+  // The common case, moving within the same cells
+  if(low == e.low && high == e.high)
+    return;
+
+  unlink(handle);
+  e.low = low;
+  e.high = high;
+  link(handle);
+}
+
+template<int dim>
+void SpatialHash<dim>::link(size_t handle)
+{
+  const Entry& e = m_entries[handle];
+  _CellKey<dim> cell = e.low;
+
+  while(true) {
+    m_cells[cell].push_back(handle);
+
+    int i = 0;
+    for(; i < dim; ++i) {
+      if(cell.c[i] < e.high.c[i]) {
+        ++cell.c[i];
+        break;
+      }
+      cell.c[i] = e.low.c[i];
+    }
+    if(i == dim)
+      break;
+  }
+}
+
+template<int dim>
+void SpatialHash<dim>::unlink(size_t handle)
+{
+  const Entry& e = m_entries[handle];
+  _CellKey<dim> cell = e.low;
+
+  while(true) {
+    typename CellMap::iterator it = m_cells.find(cell);
+    assert(it != m_cells.end());
+
+    std::vector<size_t>& list = it->second;
+    std::vector<size_t>::iterator pos = std::find(list.begin(), list.end(), handle);
+    assert(pos != list.end());
+    *pos = list.back();
+    list.pop_back();
+
+    int i = 0;
+    for(; i < dim; ++i) {
+      if(cell.c[i] < e.high.c[i]) {
+        ++cell.c[i];
+        break;
+      }
+      cell.c[i] = e.low.c[i];
+    }
+    if(i == dim)
+      break;
+  }
+}
+
+template<int dim>
+void SpatialHash<dim>::query(const Ball<dim>& region, std::vector<size_t>& out) const
+{
+  query(region, [&out](size_t handle) {out.push_back(handle); return true;});
+}
+
+} // namespace WFMath
+
+#endif  // WFMATH_SPATIAL_HASH_FUNCS_H
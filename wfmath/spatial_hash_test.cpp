@@ -0,0 +1,195 @@
+// spatial_hash_test.cpp (SpatialHash<> test functions)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#ifndef DEBUG
+#define DEBUG
+#endif
+
+#include "const.h"
+#include "vector.h"
+#include "point.h"
+#include "ball.h"
+#include "intersect.h"
+#include "spatial_hash.h"
+#include "randgen.h"
+
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+#include <cassert>
+
+using namespace WFMath;
+
+template<int dim>
+static Point<dim> random_point(MTRand& rand, CoordType world)
+{
+  Point<dim> p;
+  for(int i = 0; i < dim; ++i)
+    p[i] = (CoordType) (rand.rand() * 2 * world - world);
+  p.setValid();
+  return p;
+}
+
+// Compare query() against testing every live object
+template<int dim>
+static void check_grid(const SpatialHash<dim>& grid, const std::vector<size_t>& handles,
+                       MTRand& rand)
+{
+  std::vector<size_t> found, expected;
+
+  for(int n = 0; n < 30; ++n) {
+    Ball<dim> region(random_point<dim>(rand, 100), (CoordType) (rand.rand() * 40));
+
+    found.clear();
+    expected.clear();
+    grid.query(region, found);
+    for(size_t i = 0; i < handles.size(); ++i) {
+      size_t h = handles[i];
+      if(grid.isPoint(h) ? Intersect(region, grid.shape(h).center(), false)
+                         : Intersect(region, grid.shape(h), false))
+        expected.push_back(h);
+    }
+
+    // Each object is reported once
+    std::sort(found.begin(), found.end());
+    assert(std::adjacent_find(found.begin(), found.end()) == found.end());
+    std::sort(expected.begin(), expected.end());
+    assert(found == expected);
+  }
+
+  assert(grid.size() == handles.size());
+}
+
+template<int dim>
+void test_spatial_hash(MTRand& rand)
+{
+  std::cout << "Testing SpatialHash<" << dim << ">" << std::endl;
+
+  SpatialHash<dim> grid(15);
+  std::vector<size_t> handles;
+
+  for(size_t i = 0; i < 400; ++i)
+    handles.push_back(grid.insert(random_point<dim>(rand, 100)));
+  // Some balls are larger than a cell
+  for(size_t i = 0; i < 100; ++i)
+    handles.push_back(grid.insert(Ball<dim>(random_point<dim>(rand, 100),
+                                            (CoordType) (rand.rand() * 25))));
+
+  assert(grid.isPoint(handles[0]) && !grid.isPoint(handles[450]));
+
+  check_grid(grid, handles, rand);
+
+  // Small moves, mostly within the same cells, and teleports
+  Vector<dim> step;
+  for(int j = 0; j < dim; ++j)
+    step[j] = 0.5f;
+  step.setValid();
+
+  for(size_t i = 0; i < handles.size(); ++i) {
+    if(i % 3 == 0) {
+      if(grid.isPoint(handles[i]))
+        grid.move(handles[i], random_point<dim>(rand, 100));
+      else
+        grid.move(handles[i], Ball<dim>(random_point<dim>(rand, 100), 3));
+    }
+    else
+      grid.move(handles[i], Ball<dim>(grid.shape(handles[i]).center() + step,
+                                       grid.shape(handles[i]).radius()));
+  }
+
+  check_grid(grid, handles, rand);
+
+  // Removal, and reuse of the handles
+  std::vector<size_t> kept;
+  for(size_t i = 0; i < handles.size(); ++i) {
+    if(i % 4 == 1)
+      grid.remove(handles[i]);
+    else
+      kept.push_back(handles[i]);
+  }
+  grid.prune();
+
+  check_grid(grid, kept, rand);
+
+  for(size_t i = 0; i < 60; ++i)
+    kept.push_back(grid.insert(random_point<dim>(rand, 100)));
+
+  check_grid(grid, kept, rand);
+
+  // An object exactly on the boundary of the query ball is found
+  Point<dim> center = random_point<dim>(rand, 100), edge = center;
+  edge[0] += 20;
+  size_t h = grid.insert(edge);
+  bool found = false;
+  grid.query(Ball<dim>(center, 20), [&](size_t i) {found = found || (i == h); return true;});
+  assert(found);
+
+  // Two balls touching on a cell boundary, where rounding puts the
+  // stored ball's edge just short of it, and the query's just past it
+  const CoordType ulp = std::numeric_limits<CoordType>::epsilon();
+  SpatialHash<dim> unit(1);
+  Point<dim> c1, c2;
+  c1.setToOrigin();
+  c2.setToOrigin();
+  c1[0] = -8;
+  c2[0] = (CoordType) 0.0625 + 3 * ulp;
+  Ball<dim> stored(c1, 8 - 4 * ulp), region(c2, (CoordType) 0.0625);
+  assert(Intersect(region, stored, false));
+  h = unit.insert(stored);
+  std::vector<size_t> hits;
+  unit.query(region, hits);
+  assert(hits.size() == 1 && hits[0] == h);
+  // And the same after moving it there
+  unit.move(h, Ball<dim>(c2, 1));
+  unit.move(h, stored);
+  hits.clear();
+  unit.query(region, hits);
+  assert(hits.size() == 1 && hits[0] == h);
+
+  // Stopping early
+  size_t visits = 0;
+  grid.query(Ball<dim>(center, 1000), [&visits](size_t) {return ++visits < 5;});
+  assert(visits == 5);
+
+  grid.clear();
+  assert(grid.empty());
+  std::vector<size_t> none;
+  grid.query(Ball<dim>(center, 1000), none);
+  assert(none.empty());
+}
+
+int main()
+{
+  MTRand rand(3);
+
+  test_spatial_hash<2>(rand);
+  test_spatial_hash<3>(rand);
+
+  return 0;
+}
@@ -0,0 +1,250 @@
+// static_box_tree.h (A packed, read-only R-tree of AxisBox<>)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifndef WFMATH_STATIC_BOX_TREE_H
+#define WFMATH_STATIC_BOX_TREE_H
+
+#include <wfmath/const.h>
+#include <wfmath/point.h>
+#include <wfmath/axisbox.h>
+#include <wfmath/axisbox_tree.h>
+#include <wfmath/intersect.h>
+
+#include <vector>
+#include <new>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace WFMath {
+
+/// An allocator which aligns its storage to align bytes, e.g. a cache line
+template<class T, size_t align>
+struct _AlignedAllocator
+{
+  typedef T value_type;
+  template<class U> struct rebind {typedef _AlignedAllocator<U, align> other;};
+
+  _AlignedAllocator() {}
+  template<class U>
+  _AlignedAllocator(const _AlignedAllocator<U, align>&) {}
+
+  T* allocate(size_t n)
+  {
+    // operator new() aligns to at least sizeof(void*), so there is always
+    // room to store the original pointer just before the aligned one
+    char* raw = static_cast<char*>(::operator new(n * sizeof(T) + align));
+    char* aligned = raw + align - (reinterpret_cast<uintptr_t>(raw) % align);
+    reinterpret_cast<char**>(aligned)[-1] = raw;
+    return reinterpret_cast<T*>(aligned);
+  }
+  void deallocate(T* p, size_t)
+  {
+    ::operator delete(reinterpret_cast<char**>(p)[-1]);
+  }
+
+  template<class U>
+  bool operator==(const _AlignedAllocator<U, align>&) const {return true;}
+  template<class U>
+  bool operator!=(const _AlignedAllocator<U, align>&) const {return false;}
+};
+
+// words 32 bit words of padding for StaticBoxTree<>::Node. It is a base
+// class so that when words is zero it takes no space.
+template<size_t words>
+struct _NodePadding
+{
+  uint32_t padding[words];
+};
+
+template<>
+struct _NodePadding<0> {};
+
+/// A read-only R-tree of axis-aligned boxes, for geometry which never moves
+/**
+ * The tree is built once, by Sort-Tile-Recursive bulk loading of the
+ * bounding boxes of a range of shapes, and can't be changed afterwards.
+ * Queries report shapes by their position in that range, so the caller
+ * keeps the shapes themselves, in the same order.
+ *
+ * All the nodes are stored in one array aligned to a cache line, with
+ * the children of each node next to each other, and each node fits
+ * in half a cache line for dim <= 3.
+ *
+ * query() reports every shape whose bounding box overlaps or touches
+ * the query box. intersect(), containing() and containedBy() run the
+ * exact Intersect() or Contains() test on those candidates, and report
+ * only the shapes which pass it.
+ *
+ * The visitor passed to the query functions is called with the index
+ * of each shape found. It returns true to continue the query, or false
+ * to stop it.
+ **/
+template<int dim = 3>
+class StaticBoxTree
+{
+ public:
+  /// Construct an empty tree
+  StaticBoxTree() : m_num_items(0) {}
+  /// Construct a tree of the bounding boxes of a range of shapes
+  template<class Iter>
+  StaticBoxTree(Iter begin, Iter end) : m_num_items(0) {build(begin, end);}
+
+  /// Replace the contents of the tree with the bounding boxes of a range of shapes
+  template<class Iter>
+  void build(Iter begin, Iter end)
+  {
+    std::vector<AxisBox<dim> > boxes;
+    for(; begin != end; ++begin)
+      boxes.push_back(begin->boundingBox());
+    buildBoxes(boxes);
+  }
+  /// Replace the contents of the tree with a set of boxes
+  void buildBoxes(const std::vector<AxisBox<dim> >& boxes);
+
+  /// The number of shapes in the tree
+  size_t size() const {return m_num_items;}
+  /// True if the tree is empty
+  bool empty() const {return m_num_items == 0;}
+
+  /// The bounding box of everything in the tree
+  AxisBox<dim> boundingBox() const;
+
+  /// Visit every shape whose bounding box overlaps box
+  template<class Visitor>
+  void query(const AxisBox<dim>& box, Visitor visit) const;
+  /// Append every shape whose bounding box overlaps box to out
+  void query(const AxisBox<dim>& box, std::vector<size_t>& out) const;
+
+  /// Visit every shape for which Intersect(shape, q, proper) is true
+  /**
+   * shapes is the start of the range the tree was built from.
+   **/
+  template<class Iter, class Query, class Visitor>
+  void intersect(Iter shapes, const Query& q, bool proper, Visitor visit) const
+  {
+    query(candidateBox(q), [&](size_t i) {
+      return Intersect(shapes[i], q, proper) ? visit(i) : true;
+    });
+  }
+  /// Visit every shape for which Contains(shape, q, proper) is true
+  template<class Iter, class Query, class Visitor>
+  void containing(Iter shapes, const Query& q, bool proper, Visitor visit) const
+  {
+    query(candidateBox(q), [&](size_t i) {
+      return Contains(shapes[i], q, proper) ? visit(i) : true;
+    });
+  }
+  /// Visit every shape for which Contains(q, shape, proper) is true
+  template<class Iter, class Query, class Visitor>
+  void containedBy(Iter shapes, const Query& q, bool proper, Visitor visit) const
+  {
+    query(candidateBox(q), [&](size_t i) {
+      return Contains(q, shapes[i], proper) ? visit(i) : true;
+    });
+  }
+
+ private:
+  enum {node_size = 8};
+
+  // The words in a Node, and the words it needs to fill a multiple of
+  // 32 bytes. The array is aligned to a cache line, so that keeps
+  // nodes from straddling two. This is padding rather than alignas(32),
+  // which would make std::sort() pass nodes with an over-aligned type.
+  enum {
+    node_words = 2 * dim + 2,
+    node_padding = (node_words + 7) / 8 * 8 - node_words
+  };
+
+  // Both the shapes' boxes and the inner nodes. For the shapes' boxes,
+  // which come first in the array, first is the index of the shape.
+  // For the rest, the children are [first, first + count).
+  struct Node : _NodePadding<node_padding>
+  {
+    CoordType low[dim], high[dim];
+    uint32_t first, count;
+  };
+
+  typedef std::vector<Node, _AlignedAllocator<Node, 64> > NodeList;
+
+  void sortTiles(size_t begin, size_t end, int axis);
+
+  // The query box for the exact tests. Non-proper Intersect() and
+  // Contains() accept shapes up to epsilon apart, so grow the box by
+  // that much to keep them as candidates.
+  template<class Query>
+  static AxisBox<dim> candidateBox(const Query& q)
+  {
+    AxisBox<dim> box = q.boundingBox();
+    for(int i = 0; i < dim; ++i) {
+      box.lowCorner()[i] -= numeric_constants<CoordType>::epsilon();
+      box.highCorner()[i] += numeric_constants<CoordType>::epsilon();
+    }
+    return box;
+  }
+
+  static bool overlaps(const Node& n, const AxisBox<dim>& b)
+  {
+    for(int i = 0; i < dim; ++i)
+      if(n.low[i] > b.upperBound(i) || b.lowerBound(i) > n.high[i])
+        return false;
+    return true;
+  }
+
+  NodeList m_nodes;
+  size_t m_num_items;
+};
+
+template<int dim>
+template<class Visitor>
+void StaticBoxTree<dim>::query(const AxisBox<dim>& box, Visitor visit) const
+{
+  if(m_nodes.empty())
+    return;
+
+  _TreeStack stack;
+  // The root is always the last node
+  stack.push(m_nodes.size() - 1);
+
+  while(!stack.empty()) {
+    size_t i = stack.pop();
+    const Node& node = m_nodes[i];
+
+    if(!overlaps(node, box))
+      continue;
+
+    if(i < m_num_items) {
+      if(!visit((size_t) node.first))
+        return;
+    }
+    else {
+      for(uint32_t j = node.count; j-- > 0;)
+        stack.push(node.first + j);
+    }
+  }
+}
+
+} // namespace WFMath
+
+#endif  // WFMATH_STATIC_BOX_TREE_H
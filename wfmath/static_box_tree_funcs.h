@@ -0,0 +1,144 @@
+// static_box_tree_funcs.h (StaticBoxTree<> implementation)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifndef WFMATH_STATIC_BOX_TREE_FUNCS_H
+#define WFMATH_STATIC_BOX_TREE_FUNCS_H
+
+#include <wfmath/static_box_tree.h>
+
+#include <algorithm>
+
+#include <cmath>
+#include <cassert>
+
+namespace WFMath {
+
+template<int dim>
+void StaticBoxTree<dim>::buildBoxes(const std::vector<AxisBox<dim> >& boxes)
+{
+  static_assert(sizeof(CoordType) == sizeof(uint32_t), "Node is made of 32 bit words");
+  static_assert(sizeof(Node) % 32 == 0, "Node is padded to a multiple of 32 bytes");
+  assert(boxes.size() < (size_t) UINT32_MAX);
+
+  m_nodes.clear();
+  m_num_items = boxes.size();
+  // Each level has about 1/node_size as many nodes as the one below
+  m_nodes.reserve(m_num_items + m_num_items / (node_size - 1) + 8);
+
+  for(size_t i = 0; i < boxes.size(); ++i) {
+    assert(boxes[i].isValid());
+
+    Node node;
+    for(int j = 0; j < dim; ++j) {
+      node.low[j] = boxes[i].lowerBound(j);
+      node.high[j] = boxes[i].upperBound(j);
+    }
+    node.first = (uint32_t) i;
+    node.count = 0;
+    m_nodes.push_back(node);
+  }
+
+  // Build each level from the one below, until there is only a root
+
+  size_t level_begin = 0, level_end = m_nodes.size();
+
+  while(level_end - level_begin > 1) {
+    sortTiles(level_begin, level_end, 0);
+
+    for(size_t i = level_begin; i < level_end; i += node_size) {
+      Node parent = m_nodes[i];
+      parent.first = (uint32_t) i;
+      parent.count = (uint32_t) std::min<size_t>(node_size, level_end - i);
+
+      for(size_t j = i + 1; j < i + parent.count; ++j) {
+        for(int k = 0; k < dim; ++k) {
+          parent.low[k] = std::min(parent.low[k], m_nodes[j].low[k]);
+          parent.high[k] = std::max(parent.high[k], m_nodes[j].high[k]);
+        }
+      }
+
+      m_nodes.push_back(parent);
+    }
+
+    level_begin = level_end;
+    level_end = m_nodes.size();
+  }
+}
+
+// Sort-Tile-Recursive ordering of [begin, end). Sort by the centers on
+// one axis, cut into slabs which will fill a whole number of nodes, and
+// sort each slab on the next axis. Consecutive runs of node_size then
+// make compact nodes.
+template<int dim>
+void StaticBoxTree<dim>::sortTiles(size_t begin, size_t end, int axis)
+{
+  size_t n = end - begin;
+
+  if(n <= node_size)
+    return;
+
+  std::sort(m_nodes.begin() + begin, m_nodes.begin() + end,
+            [axis](const Node& a, const Node& b) {
+              return a.low[axis] + a.high[axis] < b.low[axis] + b.high[axis];
+            });
+
+  if(axis == dim - 1)
+    return;
+
+  size_t pages = (n + node_size - 1) / node_size;
+  size_t slabs = (size_t) std::ceil(std::pow((double) pages, 1.0 / (dim - axis)));
+  size_t slab_size = node_size * ((pages + slabs - 1) / slabs);
+
+  for(size_t i = begin; i < end; i += slab_size)
+    sortTiles(i, std::min(i + slab_size, end), axis + 1);
+}
+
+template<int dim>
+AxisBox<dim> StaticBoxTree<dim>::boundingBox() const
+{
+  if(m_nodes.empty())
+    return AxisBox<dim>();
+
+  const Node& root = m_nodes.back();
+  Point<dim> low, high;
+
+  for(int i = 0; i < dim; ++i) {
+    low[i] = root.low[i];
+    high[i] = root.high[i];
+  }
+  low.setValid();
+  high.setValid();
+
+  return AxisBox<dim>(low, high, true);
+}
+
+template<int dim>
+void StaticBoxTree<dim>::query(const AxisBox<dim>& box, std::vector<size_t>& out) const
+{
+  query(box, [&out](size_t i) {out.push_back(i); return true;});
+}
+
+} // namespace WFMath
+
+#endif  // WFMATH_STATIC_BOX_TREE_FUNCS_H
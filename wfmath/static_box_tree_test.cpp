@@ -0,0 +1,192 @@
+// static_box_tree_test.cpp (StaticBoxTree<> test functions)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#ifndef DEBUG
+#define DEBUG
+#endif
+
+#include "const.h"
+#include "vector.h"
+#include "point.h"
+#include "axisbox.h"
+#include "ball.h"
+#include "rotbox.h"
+#include "polygon.h"
+#include "intersect.h"
+#include "static_box_tree.h"
+#include "randgen.h"
+
+#include <vector>
+#include <algorithm>
+#include <iostream>
+
+#include <cassert>
+
+using namespace WFMath;
+
+template<int dim>
+static Point<dim> random_point(MTRand& rand, CoordType world)
+{
+  Point<dim> p;
+  for(int i = 0; i < dim; ++i)
+    p[i] = (CoordType) (rand.rand() * world);
+  p.setValid();
+  return p;
+}
+
+// Check the exact queries against testing every shape
+template<int dim, class Shape, class Query>
+static void check_queries(const StaticBoxTree<dim>& tree, const std::vector<Shape>& shapes,
+                          const Query& q)
+{
+  std::vector<size_t> found, expected;
+
+  tree.intersect(shapes.begin(), q, false, [&found](size_t i) {found.push_back(i); return true;});
+  for(size_t i = 0; i < shapes.size(); ++i)
+    if(Intersect(shapes[i], q, false))
+      expected.push_back(i);
+  std::sort(found.begin(), found.end());
+  assert(found == expected);
+
+  found.clear();
+  expected.clear();
+  tree.containing(shapes.begin(), q, false, [&found](size_t i) {found.push_back(i); return true;});
+  for(size_t i = 0; i < shapes.size(); ++i)
+    if(Contains(shapes[i], q, false))
+      expected.push_back(i);
+  std::sort(found.begin(), found.end());
+  assert(found == expected);
+}
+
+template<int dim, class Shape>
+static void check_box_queries(const StaticBoxTree<dim>& tree, const std::vector<Shape>& shapes,
+                              const AxisBox<dim>& box)
+{
+  std::vector<size_t> found, expected;
+
+  tree.query(box, found);
+  for(size_t i = 0; i < shapes.size(); ++i)
+    if(Intersect(shapes[i].boundingBox(), box, false))
+      expected.push_back(i);
+  std::sort(found.begin(), found.end());
+  // query() is a filter on the boxes, so may report a few extra
+  // shapes which are just within epsilon of box
+  assert(std::includes(found.begin(), found.end(), expected.begin(), expected.end()));
+
+  found.clear();
+  expected.clear();
+  tree.containedBy(shapes.begin(), box, false, [&found](size_t i) {found.push_back(i); return true;});
+  for(size_t i = 0; i < shapes.size(); ++i)
+    if(Contains(box, shapes[i], false))
+      expected.push_back(i);
+  std::sort(found.begin(), found.end());
+  assert(found == expected);
+}
+
+void test_static_tree_2d(MTRand& rand)
+{
+  std::cout << "Testing StaticBoxTree<2> with Polygon<2>" << std::endl;
+
+  std::vector<Polygon<2> > zones;
+
+  for(size_t i = 0; i < 400; ++i) {
+    Point<2> c = random_point<2>(rand, 1000);
+    Polygon<2> zone;
+    zone.addCorner(0, c + Vector<2>(0, (CoordType) (rand.rand() * 20 + 1)));
+    zone.addCorner(1, c + Vector<2>((CoordType) (rand.rand() * 20 + 1), 0));
+    zone.addCorner(2, c - Vector<2>((CoordType) (rand.rand() * 20 + 1), 0));
+    zones.push_back(zone);
+  }
+
+  StaticBoxTree<2> tree(zones.begin(), zones.end());
+  assert(tree.size() == zones.size());
+  assert(Contains(tree.boundingBox(), zones[17].boundingBox(), false));
+
+  for(int n = 0; n < 50; ++n) {
+    check_queries(tree, zones, random_point<2>(rand, 1000));
+    check_queries(tree, zones, Ball<2>(random_point<2>(rand, 1000), 30));
+    Point<2> p = random_point<2>(rand, 1000);
+    check_box_queries(tree, zones, AxisBox<2>(p, p + Vector<2>(80, 50)));
+  }
+
+  // Every point inside a zone finds that zone
+  Point<2> inside = zones[5].getCorner(0) + (zones[5].getCorner(1) - zones[5].getCorner(0)) * 0.25f;
+  std::vector<size_t> found;
+  tree.containing(zones.begin(), inside, false, [&found](size_t i) {found.push_back(i); return true;});
+  assert(std::find(found.begin(), found.end(), 5) != found.end());
+}
+
+void test_static_tree_3d(MTRand& rand)
+{
+  std::cout << "Testing StaticBoxTree<3> with RotBox<3>" << std::endl;
+
+  std::vector<RotBox<3> > buildings;
+
+  for(size_t i = 0; i < 500; ++i) {
+    RotMatrix<3> orient;
+    orient.rotationZ((CoordType) rand.rand() * 6);
+    buildings.push_back(RotBox<3>(random_point<3>(rand, 1000),
+        Vector<3>((CoordType) (rand.rand() * 30 + 1), (CoordType) (rand.rand() * 30 + 1),
+                  (CoordType) (rand.rand() * 60 + 1)), orient));
+  }
+
+  StaticBoxTree<3> tree(buildings.begin(), buildings.end());
+  assert(tree.size() == buildings.size());
+
+  for(int n = 0; n < 50; ++n) {
+    check_queries(tree, buildings, random_point<3>(rand, 1000));
+    check_queries(tree, buildings, Ball<3>(random_point<3>(rand, 1000), 40));
+    Point<3> p = random_point<3>(rand, 1000);
+    check_box_queries(tree, buildings, AxisBox<3>(p, p + Vector<3>(100, 70, 90)));
+  }
+
+  // Stopping early
+  size_t visits = 0;
+  tree.query(tree.boundingBox(), [&visits](size_t) {return ++visits < 10;});
+  assert(visits == 10);
+
+  // A tree of one shape, and an empty tree
+  StaticBoxTree<3> single(buildings.begin(), buildings.begin() + 1);
+  std::vector<size_t> found;
+  single.query(buildings[0].boundingBox(), found);
+  assert(found.size() == 1 && found[0] == 0);
+
+  StaticBoxTree<3> none;
+  assert(none.empty() && !none.boundingBox().isValid());
+  none.query(tree.boundingBox(), found);
+  assert(found.size() == 1);
+}
+
+int main()
+{
+  MTRand rand(99);
+
+  test_static_tree_2d(rand);
+  test_static_tree_3d(rand);
+
+  return 0;
+}
@@ -153,7 +153,7 @@ std::istream& operator>>(std::istream& is, Polygon<2>& r)
   char next;
   Point<2> p;
 
-  r.m_points.clear();
+  r.clear();
 
   do {
     is >> next;
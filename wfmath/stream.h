@@ -439,7 +439,7 @@ std::istream& operator>>(std::istream& is, Polygon<dim>& r)
 
   int pnum;
   for(i = read_list.begin(), pnum = 0; i != end; ++i, ++pnum)
-    r.m_poly[pnum] = i->p2;
+    r.m_poly.moveCorner(pnum, i->p2);
 
   return is;
 }
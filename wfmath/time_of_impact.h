@@ -0,0 +1,263 @@
+// time_of_impact.h (Time of impact functions for moving shapes)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifndef WFMATH_TIME_OF_IMPACT_H
+#define WFMATH_TIME_OF_IMPACT_H
+
+#include <wfmath/const.h>
+#include <wfmath/vector.h>
+#include <wfmath/point.h>
+#include <wfmath/axisbox.h>
+#include <wfmath/ball.h>
+#include <wfmath/segment.h>
+#include <wfmath/rotbox.h>
+#include <wfmath/polygon.h>
+#include <wfmath/distance.h>
+#include <wfmath/raycast.h>
+
+#include <vector>
+
+#include <cmath>
+
+namespace WFMath {
+
+// The functions below find the first t in [start, 1] at which s1,
+// moved by motion * t, touches s2. They return false if there is none.
+// The normal is the unit normal of s2 at the contact, pointing toward
+// s1, or zero if the shapes already overlap at t = 0.
+
+// Conservative advancement: for convex shapes moving in a straight
+// line, the distance between them shrinks no faster than the part of
+// the motion along the line between the closest points, so moving by
+// the distance over that speed can't pass the contact
+template<int dim, template<int> class Moving, template<int> class Shape>
+bool _AdvanceConvex(const Moving<dim>& s1, const Vector<dim>& motion,
+                    const Shape<dim>& s2, CoordType start, CoordType& t,
+                    Vector<dim>& normal)
+{
+  // Stop within this distance of contact, well above the error of
+  // the GJK distance
+  const CoordType tol = 64 * numeric_constants<CoordType>::epsilon()
+                        * (motion.mag() + s1.boundingSphere().radius());
+
+  normal.zero();
+  t = start;
+  Moving<dim> moved(s1);
+  if(t > 0)
+    moved.shift(motion * t);
+
+  for(int i = 0; i < 64; ++i) {
+    Point<dim> c1, c2;
+    CoordType dist = std::sqrt(_ClosestPoints(moved, s2, c1, c2,
+                                              std::numeric_limits<CoordType>::max(), 0));
+    if(dist > 0)
+      normal = (c1 - c2) / dist;
+    else if(i == 0)
+      return true; // Overlapping at the start
+
+    CoordType closing = 0;
+    for(int j = 0; j < dim; ++j)
+      closing -= motion[j] * normal[j];
+
+    // Shapes which start out touching only hit if they move closer
+    if(dist <= tol)
+      return i > 0 || closing > 0;
+    if(!(closing > 0))
+      return false; // Moving apart
+
+    // Aim to stop just short of tol
+    t += (dist - tol / 2) / closing;
+    if(t > 1)
+      return false;
+
+    moved = s1;
+    moved.shift(motion * t);
+  }
+
+  // Converging slowly, but t is still no later than the contact
+  return true;
+}
+
+template<int dim, template<int> class Moving, template<int> class Shape>
+inline bool _ConservativeAdvance(const Moving<dim>& s1, const Vector<dim>& motion,
+                                 const Shape<dim>& s2, CoordType start, CoordType& t,
+                                 Vector<dim>& normal)
+{
+  return _AdvanceConvex(s1, motion, s2, start, t, normal);
+}
+
+// A Polygon which is not convex is hit when its first triangle is
+template<int dim, template<int> class Moving>
+bool _ConservativeAdvance(const Moving<dim>& s1, const Vector<dim>& motion,
+                          const Polygon<dim>& p, CoordType start, CoordType& t,
+                          Vector<dim>& normal)
+{
+  if(p.numCorners() == 0)
+    return false;
+  if(p.numCorners() < 4 || p.isConvex())
+    return _AdvanceConvex(s1, motion, p, start, t, normal);
+
+  std::vector<_Triangle<dim> > triangles;
+  _Triangulate(p, triangles);
+
+  bool found = false;
+  for(size_t i = 0; i < triangles.size(); ++i) {
+    CoordType tri_t;
+    Vector<dim> tri_normal;
+    if(_AdvanceConvex(s1, motion, triangles[i], start, tri_t, tri_normal)
+       && (!found || tri_t < t)) {
+      t = tri_t;
+      normal = tri_normal;
+      found = true;
+    }
+  }
+  return found;
+}
+
+template<int dim, template<int> class Moving, template<int> class Shape>
+inline bool _TimeOfImpact(const Moving<dim>& s1, const Vector<dim>& motion,
+                          const Shape<dim>& s2, CoordType& t, Vector<dim>& normal)
+{
+  return _ConservativeAdvance(s1, motion, s2, 0, t, normal);
+}
+
+// Two balls touch when the center of one reaches the other grown by
+// its radius
+template<int dim>
+inline bool _TimeOfImpact(const Ball<dim>& b1, const Vector<dim>& motion,
+                          const Ball<dim>& b2, CoordType& t, Vector<dim>& normal)
+{
+  Point<dim> hit;
+  return _Raycast(b1.center(), motion, 1,
+                  Ball<dim>(b2.center(), b1.radius() + b2.radius()), t, hit, normal);
+}
+
+template<int dim>
+bool _TimeOfImpact(const Ball<dim>& b, const Vector<dim>& motion,
+                   const AxisBox<dim>& box, CoordType& t, Vector<dim>& normal)
+{
+  // The center has to reach the box with its corners rounded off by
+  // the radius. Cast it against the box grown by the radius, which
+  // holds that. If the hit is on a face, it's exact, otherwise the
+  // ball may pass the corner, so advance from there.
+  Vector<dim> r;
+  for(int i = 0; i < dim; ++i)
+    r[i] = b.radius();
+  r.setValid();
+
+  Point<dim> hit;
+  if(!_Raycast(b.center(), motion, 1,
+               AxisBox<dim>(box.lowCorner() - r, box.highCorner() + r), t, hit, normal))
+    return false;
+
+  int outside = 0;
+  for(int i = 0; i < dim; ++i)
+    if(hit[i] < box.lowCorner()[i] || hit[i] > box.highCorner()[i])
+      ++outside;
+  if(outside <= 1)
+    return true;
+
+  return _AdvanceConvex(b, motion, box, t, t, normal);
+}
+
+template<int dim>
+bool _TimeOfImpact(const Ball<dim>& b, const Vector<dim>& motion,
+                   const RotBox<dim>& r, CoordType& t, Vector<dim>& normal)
+{
+  // Work in the frame of the box, where it is an AxisBox
+  Point<dim> zero;
+  zero.setToOrigin();
+  Ball<dim> local(zero + Prod(r.orientation(), b.center() - r.corner0()), b.radius());
+  Vector<dim> local_normal;
+
+  if(!_TimeOfImpact(local, Prod(r.orientation(), motion),
+                    AxisBox<dim>(zero, zero + r.size()), t, local_normal))
+    return false;
+
+  normal = Prod(local_normal, r.orientation());
+  return true;
+}
+
+// Two boxes touch when the low corner of one reaches the other grown
+// by its size
+template<int dim>
+inline bool _TimeOfImpact(const AxisBox<dim>& b1, const Vector<dim>& motion,
+                          const AxisBox<dim>& b2, CoordType& t, Vector<dim>& normal)
+{
+  Point<dim> hit;
+  return _Raycast(b1.lowCorner(), motion, 1,
+                  AxisBox<dim>(b2.lowCorner() - (b1.highCorner() - b1.lowCorner()),
+                               b2.highCorner()), t, hit, normal);
+}
+
+// A box moving onto a ball is the ball moving onto the box backwards
+template<int dim>
+inline bool _TimeOfImpact(const AxisBox<dim>& box, const Vector<dim>& motion,
+                          const Ball<dim>& b, CoordType& t, Vector<dim>& normal)
+{
+  if(!_TimeOfImpact(b, -motion, box, t, normal))
+    return false;
+  normal = -normal;
+  return true;
+}
+
+/// The first time a moving Ball touches a shape
+/**
+ * The ball moves from its current position by motion, and t is set to
+ * the fraction of the motion at which it first touches the shape, in
+ * [0, 1]. normal is set to the unit normal of the shape at the contact,
+ * pointing toward the ball. Returns false if the ball never touches the
+ * shape during the motion. If the ball already overlaps the shape,
+ * t is 0 and normal is zero.
+ *
+ * The shape may be an AxisBox, Ball, RotBox, Segment or Polygon.
+ * Against a Ball, and against a face of an AxisBox or RotBox, the
+ * answer is exact. Otherwise it is found by conservative advancement
+ * with GJK distances, and t is the first time the shapes come within a
+ * small tolerance of touching, never later than the true contact. A
+ * Polygon which is not convex is split into triangles, as for
+ * Distance().
+ **/
+template<int dim, template<int> class Shape>
+inline bool TimeOfImpact(const Ball<dim>& b, const Vector<dim>& motion,
+                         const Shape<dim>& shape, CoordType& t, Vector<dim>& normal)
+{
+  return _TimeOfImpact(b, motion, shape, t, normal);
+}
+
+/// The first time a moving AxisBox touches a shape
+/**
+ * This works like TimeOfImpact() for a Ball. Against another AxisBox,
+ * and against a Ball which it meets with a face, the answer is exact.
+ **/
+template<int dim, template<int> class Shape>
+inline bool TimeOfImpact(const AxisBox<dim>& b, const Vector<dim>& motion,
+                         const Shape<dim>& shape, CoordType& t, Vector<dim>& normal)
+{
+  return _TimeOfImpact(b, motion, shape, t, normal);
+}
+
+} // namespace WFMath
+
+#endif  // WFMATH_TIME_OF_IMPACT_H
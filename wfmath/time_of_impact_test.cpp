@@ -0,0 +1,317 @@
+// time_of_impact_test.cpp (Time of impact test functions)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#ifndef DEBUG
+#define DEBUG
+#endif
+
+#include "const.h"
+#include "vector.h"
+#include "point.h"
+#include "rotmatrix.h"
+#include "axisbox.h"
+#include "ball.h"
+#include "segment.h"
+#include "rotbox.h"
+#include "polygon.h"
+#include "intersect.h"
+#include "polygon_intersect.h"
+#include "distance.h"
+#include "time_of_impact.h"
+#include "randgen.h"
+
+#include <iostream>
+
+#include <cassert>
+#include <cmath>
+
+using namespace WFMath;
+
+static const CoordType tolerance = 1e-2f;
+
+static CoordType random_coord(MTRand& rand, CoordType low, CoordType high)
+{
+  return low + (high - low) * (CoordType) rand.rand();
+}
+
+template<int dim>
+static Point<dim> random_point(MTRand& rand)
+{
+  Point<dim> p;
+  p.setToOrigin();
+  for(int i = 0; i < dim; ++i)
+    p[i] = random_coord(rand, -3, 3);
+  return p;
+}
+
+template<int dim>
+static Vector<dim> random_size(MTRand& rand)
+{
+  Vector<dim> v;
+  for(int i = 0; i < dim; ++i)
+    v[i] = random_coord(rand, 0.2f, 2);
+  v.setValid();
+  return v;
+}
+
+static RotMatrix<2> random_rotation(MTRand& rand, const RotMatrix<2>&)
+{
+  RotMatrix<2> m;
+  return m.rotation(random_coord(rand, -3, 3));
+}
+
+static RotMatrix<3> random_rotation(MTRand& rand, const RotMatrix<3>&)
+{
+  RotMatrix<3> m;
+  Vector<3> axis(random_coord(rand, -1, 1), 1, random_coord(rand, -1, 1));
+  return m.rotation(axis, random_coord(rand, -3, 3));
+}
+
+static Polygon<2> random_polygon(MTRand& rand, const Point<2>&)
+{
+  // A star shape, which is usually not convex
+  Point<2> center = random_point<2>(rand);
+  Polygon<2> p;
+  for(int i = 0; i < 7; ++i) {
+    CoordType angle = i * 2 * numeric_constants<CoordType>::pi() / 7,
+              r = random_coord(rand, 0.3f, 2);
+    p.addCorner(i, center + Vector<2>(r * std::cos(angle), r * std::sin(angle)));
+  }
+  return p;
+}
+
+static Polygon<3> random_polygon(MTRand& rand, const Point<3>&)
+{
+  Polygon<2> flat = random_polygon(rand, Point<2>());
+  RotMatrix<3> m = random_rotation(rand, RotMatrix<3>());
+  Point<3> origin = random_point<3>(rand);
+  Polygon<3> p;
+  for(size_t i = 0; i < flat.numCorners(); ++i) {
+    bool added = p.addCorner(i, origin + Prod(Vector<3>(flat[i][0], flat[i][1], 0), m),
+                             1e-3f);
+    assert(added);
+  }
+  return p;
+}
+
+template<int dim, template<int> class Moving, template<int> class Shape>
+static bool overlaps(const Moving<dim>& m, const Shape<dim>& s2, bool proper)
+{
+  return Intersect(m, s2, proper);
+}
+
+// Intersect() for a box and a polygon in 3D only tests a single point
+// where the box meets the plane of the polygon, so check the distance
+template<template<int> class Moving>
+static bool overlaps(const Moving<3>& m, const Polygon<3>& p, bool proper)
+{
+  return proper ? Distance(m, p) == 0 : Distance(m, p) < tolerance;
+}
+
+// Check a time of impact against Intersect() along the motion
+template<int dim, template<int> class Moving, template<int> class Shape>
+static bool check_toi(const Moving<dim>& s1, const Vector<dim>& motion,
+                      const Shape<dim>& s2)
+{
+  CoordType t;
+  Vector<dim> normal;
+  bool hit = TimeOfImpact(s1, motion, s2, t, normal);
+  CoordType end = hit ? t : 1;
+
+  // Nothing overlaps before the impact
+  for(int i = 0; i < 32; ++i) {
+    Moving<dim> m(s1);
+    m.shift(motion * (end * i / 32));
+    assert(!overlaps(m, s2, true) || (hit && t == 0));
+  }
+
+  if(!hit)
+    return false;
+
+  assert(t >= 0 && t <= 1);
+  Moving<dim> m(s1);
+  m.shift(motion * t);
+  assert(Distance(m, s2) < tolerance);
+
+  if(normal.sqrMag() == 0) {
+    assert(t == 0);
+    assert(overlaps(s1, s2, false));
+  }
+  else {
+    assert(std::fabs(normal.mag() - 1) < tolerance);
+    assert(Dot(normal, motion) <= tolerance);
+  }
+
+  return true;
+}
+
+template<int dim>
+static void test_exact()
+{
+  std::cout << "Testing " << dim << "D exact times of impact" << std::endl;
+
+  Point<dim> origin;
+  origin.setToOrigin();
+  Vector<dim> x, ones;
+  x.zero();
+  x[0] = 1;
+  ones.zero();
+  for(int i = 0; i < dim; ++i)
+    ones[i] = 1;
+
+  CoordType t;
+  Vector<dim> normal;
+
+  // Two balls, head on
+  Ball<dim> ball(origin - x * 5, 1);
+  assert(TimeOfImpact(ball, x * 10, Ball<dim>(origin, 1), t, normal));
+  assert(Equal(t, 0.3f));
+  assert(normal == -x);
+  assert(!TimeOfImpact(ball, x * 2, Ball<dim>(origin, 1), t, normal));
+  assert(!TimeOfImpact(ball, -x * 10, Ball<dim>(origin, 1), t, normal));
+
+  // Already overlapping
+  assert(TimeOfImpact(ball, x, Ball<dim>(origin - x * 4, 2), t, normal));
+  assert(t == 0 && normal.sqrMag() == 0);
+
+  // A small fast ball and a thin wall, which sub-stepping would miss
+  Ball<dim> bullet(origin - x * 5, 0.25f);
+  AxisBox<dim> wall(origin - ones * 2, origin + ones * 2);
+  wall.lowCorner()[0] = 0;
+  wall.highCorner()[0] = 0.05f;
+  assert(TimeOfImpact(bullet, x * 10, wall, t, normal));
+  assert(Equal(t, 0.475f));
+  assert(normal == -x);
+
+  RotMatrix<dim> m;
+  m.identity();
+  RotBox<dim> rwall(wall.lowCorner(), wall.highCorner() - wall.lowCorner(), m);
+  assert(TimeOfImpact(bullet, x * 10, rwall, t, normal));
+  assert(Equal(t, 0.475f));
+  assert(normal == -x);
+
+  // Past the edge of the wall, the ball meets the rounded corner
+  Vector<dim> side = ones - x;
+  Ball<dim> grazing(origin - x * 5 + side * (2 + 0.25f / std::sqrt((CoordType) 2 * (dim - 1))),
+                    0.5f);
+  assert(TimeOfImpact(grazing, x * 10, wall, t, normal));
+  assert(t > 0.45f && t < 0.5f);
+  assert(Dot(normal, side) > 0);
+
+  // A box onto a box
+  AxisBox<dim> box(origin - x * 5, origin - x * 5 + ones);
+  assert(TimeOfImpact(box, x * 10, wall, t, normal));
+  assert(Equal(t, 0.4f));
+  assert(normal == -x);
+
+  // A box onto a ball
+  assert(TimeOfImpact(box, x * 10, Ball<dim>(origin + ones * 0.5f, 0.5f), t, normal));
+  assert(Equal(t, 0.4f));
+  assert(normal == -x);
+
+  // A ball onto a segment, through its middle
+  Vector<dim> y;
+  y.zero();
+  y[1] = 1;
+  assert(TimeOfImpact(ball, x * 10, Segment<dim>(origin - y, origin + y), t, normal));
+  assert(std::fabs(t - 0.4f) < tolerance);
+  assert((normal + x).mag() < tolerance);
+}
+
+static void test_polygon()
+{
+  std::cout << "Testing times of impact with polygons" << std::endl;
+
+  // An L shape, where a ball moving down the notch meets the inner
+  // corner, though its convex hull would stop it earlier
+  Polygon<2> l;
+  l.addCorner(0, Point<2>(0, 0));
+  l.addCorner(1, Point<2>(3, 0));
+  l.addCorner(2, Point<2>(3, 1));
+  l.addCorner(3, Point<2>(1, 1));
+  l.addCorner(4, Point<2>(1, 3));
+  l.addCorner(5, Point<2>(0, 3));
+
+  CoordType t;
+  Vector<2> normal;
+  assert(TimeOfImpact(Ball<2>(Point<2>(2, 5), 0.5f), Vector<2>(0, -5), l, t, normal));
+  assert(std::fabs(t - 0.7f) < tolerance);
+  assert((normal - Vector<2>(0, 1)).mag() < tolerance);
+
+  assert(TimeOfImpact(AxisBox<2>(Point<2>(1.5f, 4), Point<2>(2.5f, 5)), Vector<2>(0, -5),
+                      l, t, normal));
+  assert(std::fabs(t - 0.6f) < tolerance);
+
+  assert(!TimeOfImpact(Ball<2>(Point<2>(5, 5), 0.5f), Vector<2>(0, -5), l, t, normal));
+}
+
+template<int dim>
+static void test_random(MTRand& rand)
+{
+  std::cout << "Testing " << dim << "D random times of impact" << std::endl;
+
+  int hits = 0;
+  for(int i = 0; i < 150; ++i) {
+    Ball<dim> ball(random_point<dim>(rand), random_coord(rand, 0.1f, 1));
+    Point<dim> low = random_point<dim>(rand);
+    AxisBox<dim> box(low, low + random_size<dim>(rand));
+    Vector<dim> motion = random_point<dim>(rand) - random_point<dim>(rand);
+
+    Point<dim> other_low = random_point<dim>(rand);
+    AxisBox<dim> other_box(other_low, other_low + random_size<dim>(rand));
+    Ball<dim> other_ball(random_point<dim>(rand), random_coord(rand, 0.1f, 1));
+    RotBox<dim> rbox(random_point<dim>(rand), random_size<dim>(rand),
+                     random_rotation(rand, RotMatrix<dim>()));
+    Segment<dim> segment(random_point<dim>(rand), random_point<dim>(rand));
+    Polygon<dim> poly = random_polygon(rand, Point<dim>());
+
+    hits += check_toi(ball, motion, other_box);
+    hits += check_toi(ball, motion, other_ball);
+    hits += check_toi(ball, motion, rbox);
+    hits += check_toi(ball, motion, segment);
+    hits += check_toi(ball, motion, poly);
+    hits += check_toi(box, motion, other_box);
+    hits += check_toi(box, motion, other_ball);
+    hits += check_toi(box, motion, rbox);
+    hits += check_toi(box, motion, segment);
+    hits += check_toi(box, motion, poly);
+  }
+  assert(hits > 50);
+}
+
+int main()
+{
+  MTRand rand(16);
+
+  test_exact<2>();
+  test_exact<3>();
+  test_polygon();
+  test_random<2>(rand);
+  test_random<3>(rand);
+
+  return 0;
+}
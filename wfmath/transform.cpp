@@ -0,0 +1,48 @@
+// transform.cpp (Transform<> implementation)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "transform_funcs.h"
+
+#include "quaternion.h"
+
+namespace WFMath {
+
+template<>
+Transform<3>::Transform(const Point<3>& origin, const Quaternion& rotation)
+  : m_origin(origin), m_rotation(rotation)
+{
+  updateInverse();
+}
+
+template class Transform<3>;
+template class Transform<2>;
+
+template Transform<3> Prod<3>(const Transform<3>&, const Transform<3>&);
+template Transform<2> Prod<2>(const Transform<2>&, const Transform<2>&);
+
+}
@@ -0,0 +1,159 @@
+// transform.h (A rotation followed by a translation)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifndef WFMATH_TRANSFORM_H
+#define WFMATH_TRANSFORM_H
+
+#include <wfmath/const.h>
+#include <wfmath/point.h>
+#include <wfmath/vector.h>
+#include <wfmath/rotmatrix.h>
+
+namespace WFMath {
+
+template<int dim> class Transform;
+
+/// returns the transform which applies t1 and then t2
+/**
+ * If t1 is the frame of a child object relative to its parent, and t2
+ * is the frame of the parent relative to the world, Prod(t1, t2) is the
+ * frame of the child relative to the world. This matches the order
+ * used by Prod() for RotMatrix.
+ **/
+template<int dim>
+Transform<dim> Prod(const Transform<dim>& t1, const Transform<dim>& t2);
+/// returns the transform which applies t1 and then t2
+template<int dim>
+Transform<dim> operator*(const Transform<dim>& t1, const Transform<dim>& t2);
+
+/// A coordinate frame, given by an origin and an orientation
+/**
+ * This holds the same pair of arguments as the toParentCoords(origin,
+ * rotation) and toLocalCoords(origin, rotation) members of the shape
+ * classes. The transforms of a chain of frames can be combined with
+ * Prod() once, instead of converting each shape through every frame
+ * in turn. Converting a shape through a Transform gives exactly the
+ * same answer as calling the shape's own member with origin() and
+ * rotation().
+ *
+ * Since the inverse of a RotMatrix is its transpose, toLocalCoords()
+ * needs no inverse at all. The origin of inverse() is computed when
+ * the transform is built, so inverse() only has to transpose the
+ * rotation.
+ **/
+template<int dim = 3>
+class Transform
+{
+ public:
+  /// Construct an uninitialized transform
+  Transform() {}
+  /// Construct a transform from an origin and an orientation
+  Transform(const Point<dim>& origin, const RotMatrix<dim>& rotation)
+    : m_origin(origin), m_rotation(rotation)
+  {updateInverse();}
+  /// Construct a translation, with no rotation
+  explicit Transform(const Point<dim>& origin);
+  /// 3D only: construct a transform from an origin and a Quaternion
+  /**
+   * The Quaternion is converted to a RotMatrix once, here.
+   **/
+  Transform(const Point<dim>& origin, const Quaternion& rotation);
+
+  bool isEqualTo(const Transform& t, CoordType epsilon = numeric_constants<CoordType>::epsilon()) const
+  {return m_origin.isEqualTo(t.m_origin, epsilon) && m_rotation.isEqualTo(t.m_rotation, epsilon);}
+  bool operator==(const Transform& t) const {return isEqualTo(t);}
+  bool operator!=(const Transform& t) const {return !isEqualTo(t);}
+
+  bool isValid() const {return m_origin.isValid() && m_rotation.isValid();}
+
+  /// Set the transform to the identity, which changes nothing
+  Transform& identity();
+
+  /// The origin of the local frame, in parent coordinates
+  const Point<dim>& origin() const {return m_origin;}
+  /// The orientation of the local frame
+  const RotMatrix<dim>& rotation() const {return m_rotation;}
+
+  /// The transform which undoes this one
+  Transform inverse() const
+  {return Transform(m_inv_origin, m_rotation.inverse(), m_origin);}
+
+  /// Convert a shape from local coordinates to parent coordinates
+  /**
+   * Works with any shape which has a toParentCoords(origin, rotation)
+   * member: Point, Ball, RotBox, Segment and Polygon.
+   **/
+  template<class Shape>
+  Shape toParentCoords(const Shape& s) const
+  {return s.toParentCoords(m_origin, m_rotation);}
+  /// Convert a vector from local coordinates to parent coordinates
+  Vector<dim> toParentCoords(const Vector<dim>& v) const
+  {return v * m_rotation;}
+  /// Convert an AxisBox to parent coordinates
+  /**
+   * The result is not axis aligned in general, so this returns a RotBox.
+   **/
+  RotBox<dim> toParentCoords(const AxisBox<dim>& b) const;
+
+  /// Convert a shape from parent coordinates to local coordinates
+  /**
+   * Works with any shape which has a toLocalCoords(origin, rotation)
+   * member: Point, Ball, RotBox, Segment and Polygon.
+   **/
+  template<class Shape>
+  Shape toLocalCoords(const Shape& s) const
+  {return s.toLocalCoords(m_origin, m_rotation);}
+  /// Convert a vector from parent coordinates to local coordinates
+  Vector<dim> toLocalCoords(const Vector<dim>& v) const
+  {return m_rotation * v;}
+  /// Convert an AxisBox to local coordinates
+  /**
+   * The result is not axis aligned in general, so this returns a RotBox.
+   **/
+  RotBox<dim> toLocalCoords(const AxisBox<dim>& b) const;
+
+  friend Transform Prod<dim>(const Transform& t1, const Transform& t2);
+
+ private:
+  Transform(const Point<dim>& origin, const RotMatrix<dim>& rotation,
+            const Point<dim>& inv_origin)
+    : m_origin(origin), m_rotation(rotation), m_inv_origin(inv_origin) {}
+
+  void updateInverse();
+
+  Point<dim> m_origin;
+  RotMatrix<dim> m_rotation;
+  // The origin of inverse(), its rotation is the inverse of m_rotation
+  Point<dim> m_inv_origin;
+};
+
+template<int dim>
+inline Transform<dim> operator*(const Transform<dim>& t1, const Transform<dim>& t2)
+{
+  return Prod(t1, t2);
+}
+
+} // namespace WFMath
+
+#endif  // WFMATH_TRANSFORM_H
@@ -0,0 +1,93 @@
+// transform_funcs.h (Transform<> implementation)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifndef WFMATH_TRANSFORM_FUNCS_H
+#define WFMATH_TRANSFORM_FUNCS_H
+
+#include <wfmath/transform.h>
+
+#include <wfmath/axisbox.h>
+#include <wfmath/rotbox.h>
+
+namespace WFMath {
+
+template<int dim>
+Transform<dim>::Transform(const Point<dim>& origin) : m_origin(origin)
+{
+  m_rotation.identity();
+  updateInverse();
+}
+
+template<int dim>
+Transform<dim>& Transform<dim>::identity()
+{
+  m_origin.setToOrigin();
+  m_rotation.identity();
+  m_inv_origin.setToOrigin();
+
+  return *this;
+}
+
+template<int dim>
+void Transform<dim>::updateInverse()
+{
+  // The point which inverse() takes to the origin is the one this takes
+  // the origin to, so the inverse origin is the origin in local coordinates
+  m_inv_origin = Point<dim>().setToOrigin().toLocalCoords(m_origin, m_rotation);
+}
+
+template<int dim>
+RotBox<dim> Transform<dim>::toParentCoords(const AxisBox<dim>& b) const
+{
+  RotMatrix<dim> ident;
+  ident.identity();
+
+  return RotBox<dim>(b.lowCorner(), b.highCorner() - b.lowCorner(), ident)
+         .toParentCoords(m_origin, m_rotation);
+}
+
+template<int dim>
+RotBox<dim> Transform<dim>::toLocalCoords(const AxisBox<dim>& b) const
+{
+  RotMatrix<dim> ident;
+  ident.identity();
+
+  return RotBox<dim>(b.lowCorner(), b.highCorner() - b.lowCorner(), ident)
+         .toLocalCoords(m_origin, m_rotation);
+}
+
+template<int dim>
+Transform<dim> Prod(const Transform<dim>& t1, const Transform<dim>& t2)
+{
+  Transform<dim> out(t1.m_origin.toParentCoords(t2.m_origin, t2.m_rotation),
+                     Prod(t1.m_rotation, t2.m_rotation), Point<dim>());
+
+  out.updateInverse();
+
+  return out;
+}
+
+} // namespace WFMath
+
+#endif  // WFMATH_TRANSFORM_FUNCS_H
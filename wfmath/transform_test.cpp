@@ -0,0 +1,171 @@
+// transform_test.cpp (Transform<> test functions)
+//
+//  The WorldForge Project
+//  Copyright (C) 2026  The WorldForge Project
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//  For information about WorldForge and its authors, please contact
+//  the Worldforge Web Site at http://www.worldforge.org.
+
+// Created: 2026-10-16
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#ifndef DEBUG
+#define DEBUG
+#endif
+
+#include "const.h"
+#include "vector.h"
+#include "point.h"
+#include "rotmatrix.h"
+#include "quaternion.h"
+#include "axisbox.h"
+#include "ball.h"
+#include "segment.h"
+#include "rotbox.h"
+#include "polygon.h"
+#include "transform.h"
+
+#include <iostream>
+
+#include <cassert>
+
+using namespace WFMath;
+
+template<int dim>
+void test_transform(const Point<dim>& origin, const RotMatrix<dim>& m,
+                    const Point<dim>& origin2, const RotMatrix<dim>& m2)
+{
+  std::cout << "Testing " << dim << "D Transform" << std::endl;
+
+  const CoordType eps = 100 * numeric_constants<CoordType>::epsilon();
+
+  Transform<dim> t(origin, m), t2(origin2, m2);
+
+  assert(t.isValid());
+  assert(!Transform<dim>().isValid());
+  assert(t.origin() == origin);
+  assert(t.rotation() == m);
+
+  Point<dim> p = origin2;
+  p += Vector<dim>(origin - Point<dim>().setToOrigin()) * 0.5f;
+  Vector<dim> v = origin2 - origin;
+
+  // A single transform gives exactly the same answer as the shape members
+
+  assert(t.toParentCoords(p) == p.toParentCoords(origin, m));
+  assert(t.toLocalCoords(p) == p.toLocalCoords(origin, m));
+  assert(t.toParentCoords(v) == v * m);
+  assert(t.toLocalCoords(v) == m * v);
+
+  Ball<dim> ball(p, 2);
+  assert(t.toParentCoords(ball) == ball.toParentCoords(origin, m));
+  assert(t.toLocalCoords(ball) == ball.toLocalCoords(origin, m));
+
+  Segment<dim> seg(p, origin);
+  assert(t.toParentCoords(seg) == seg.toParentCoords(origin, m));
+  assert(t.toLocalCoords(seg) == seg.toLocalCoords(origin, m));
+
+  RotBox<dim> rbox(p, v, m2);
+  assert(t.toParentCoords(rbox) == rbox.toParentCoords(origin, m));
+  assert(t.toLocalCoords(rbox) == rbox.toLocalCoords(origin, m));
+
+  AxisBox<dim> abox(p, origin2 + v);
+  RotBox<dim> converted = t.toParentCoords(abox);
+  assert(converted.size() == abox.highCorner() - abox.lowCorner());
+  assert(converted.corner0() == abox.lowCorner().toParentCoords(origin, m));
+  assert(Equal(t.toLocalCoords(converted).boundingBox(), abox, eps));
+
+  // The inverse undoes the transform
+
+  Transform<dim> inv = t.inverse();
+  assert(inv.isValid());
+  assert(Equal(inv.toParentCoords(t.toParentCoords(p)), p, eps));
+  assert(Equal(inv.toParentCoords(p), t.toLocalCoords(p), eps));
+  assert(Equal(inv.toLocalCoords(p), t.toParentCoords(p), eps));
+  assert(inv.inverse() == t);
+
+  // A composed transform matches applying the two in turn
+
+  Transform<dim> both = t * t2;
+  assert(both == Prod(t, t2));
+  assert(Equal(both.toParentCoords(p), t2.toParentCoords(t.toParentCoords(p)), eps));
+  assert(Equal(both.toLocalCoords(p), t.toLocalCoords(t2.toLocalCoords(p)), eps));
+  assert(Equal(both.toParentCoords(v), t2.toParentCoords(t.toParentCoords(v)), eps));
+  assert(Equal(both.inverse().toParentCoords(p), both.toLocalCoords(p), eps));
+  assert((t * t.inverse()).isEqualTo(Transform<dim>().identity(), eps));
+
+  RotBox<dim> twice = t2.toParentCoords(t.toParentCoords(rbox));
+  RotBox<dim> once = both.toParentCoords(rbox);
+  assert(Equal(once.corner0(), twice.corner0(), eps));
+  assert(once.orientation().isEqualTo(twice.orientation(), eps));
+
+  Transform<dim> shift(origin);
+  assert(shift.toParentCoords(p) == p.toParentCoords(origin));
+  assert(shift.toLocalCoords(p) == p.toLocalCoords(origin));
+
+  Transform<dim> ident;
+  ident.identity();
+  assert(ident.toParentCoords(p) == p);
+  assert(ident.inverse() == ident);
+}
+
+void test_quaternion_transform(const Point<3>& origin, const Quaternion& q)
+{
+  std::cout << "Testing Transform by Quaternion" << std::endl;
+
+  const CoordType eps = 100 * numeric_constants<CoordType>::epsilon();
+
+  Transform<3> t(origin, q);
+  Point<3> p(3, -1, 2);
+
+  assert(t.isEqualTo(Transform<3>(origin, RotMatrix<3>(q)), eps));
+  assert(Equal(t.toParentCoords(p), p.toParentCoords(origin, q), eps));
+  assert(Equal(t.toLocalCoords(p), p.toLocalCoords(origin, q), eps));
+
+  Polygon<3> poly;
+  poly.addCorner(0, Point<3>(1, 0, 1));
+  poly.addCorner(1, Point<3>(0, 1, 1));
+  poly.addCorner(2, Point<3>(-1, -1, 1));
+  assert(poly.isValid());
+
+  Polygon<3> parent = t.toParentCoords(poly), direct = poly.toParentCoords(origin, q);
+  assert(parent.numCorners() == 3);
+  for(size_t i = 0; i < 3; ++i) {
+    assert(Equal(parent.getCorner(i), direct.getCorner(i), eps));
+    assert(Equal(t.toLocalCoords(parent).getCorner(i), poly.getCorner(i), eps));
+  }
+}
+
+int main()
+{
+  RotMatrix<2> m2a, m2b;
+  RotMatrix<3> m3a, m3b;
+
+  m2a.rotation(numeric_constants<CoordType>::pi() / 7);
+  m2b.rotation(-numeric_constants<CoordType>::pi() / 3);
+  m3a.rotation(Vector<3>(1, 2, -1), numeric_constants<CoordType>::pi() / 5);
+  m3b.rotation(Vector<3>(0, -1, 3), 2.1f);
+
+  test_transform(Point<2>(1, -3), m2a, Point<2>(-2, 5), m2b);
+  test_transform(Point<3>(1, -3, 2), m3a, Point<3>(-2, 5, 0.5f), m3b);
+
+  test_quaternion_transform(Point<3>(4, 0, -1), Quaternion(Vector<3>(1, 1, 0), 0.7f));
+
+  return 0;
+}
@@ -103,7 +103,7 @@ CoordType Cross(const Vector<2>& v1, const Vector<2>& v2)
 {
   CoordType ans = v1[0] * v2[1] - v2[0] * v1[1];
 
-  return (ans >= v1._scaleEpsilon(v2)) ? ans : 0;
+  return (std::fabs(ans) >= v1._scaleEpsilon(v2)) ? ans : 0;
 }
 
 Vector<3> Cross(const Vector<3>& v1, const Vector<3>& v2)
@@ -203,6 +203,7 @@ template CoordType Dot<2>(const Vector<2> &, const Vector<2> &);
 template CoordType Angle<3>(const Vector<3> &, const Vector<3> &);
 
 template Vector<3> operator-<3>(const Vector<3> &);
+template Vector<2> operator-<2>(const Vector<2> &);
 
 template Vector<3> operator*<3>(CoordType, const Vector<3> &);
 template Vector<2> operator*<2>(CoordType, const Vector<2> &);
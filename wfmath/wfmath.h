@@ -41,8 +41,22 @@
 #include <wfmath/segment.h>
 #include <wfmath/rotbox.h>
 #include <wfmath/polygon.h>
+#include <wfmath/frustum.h>
+// Coordinate frames
+#include <wfmath/transform.h>
 // Shape intersection functions
 #include <wfmath/intersect.h>
+#include <wfmath/intersect_many.h>
+#include <wfmath/gjk.h>
+#include <wfmath/distance.h>
+#include <wfmath/raycast.h>
+#include <wfmath/time_of_impact.h>
+// Spatial indices
+#include <wfmath/axisbox_tree.h>
+#include <wfmath/static_box_tree.h>
+#include <wfmath/spatial_hash.h>
+#include <wfmath/prepared_polygon.h>
+#include <wfmath/prepared_rotbox.h>
 // Probability and statistics
 #include <wfmath/probability.h>
 #include <wfmath/timestamp.h>